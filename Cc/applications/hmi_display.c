@@ -6,6 +6,8 @@
  * Change Logs:
  * Date           Author       Notes
  * 2025-11-15     Cc           HMI Display Driver Implementation
+ * 2026-10-18     Cc           Take the received data from the serial ring without a copy per byte
+ * 2026-10-18     Cc           Send a frame and its tail with one vectored write
  */
 
 #include "hmi_display.h"
@@ -45,6 +47,32 @@ static void ringbuffer_write_byte(uint8_t byte)
     }
 }
 
+static void ringbuffer_write(const uint8_t *data, rt_size_t len)
+{
+    uint16_t part;
+
+    if (len > HMI_RINGBUFFER_SIZE - ring_buffer.length)
+    {
+        LOG_W("Ring buffer overflow!");
+        len = HMI_RINGBUFFER_SIZE - ring_buffer.length;
+    }
+
+    while (len > 0)
+    {
+        /* Up to the end of the buffer, then from its start */
+        part = HMI_RINGBUFFER_SIZE - ring_buffer.tail;
+        if (part > len)
+        {
+            part = len;
+        }
+        rt_memcpy(&ring_buffer.data[ring_buffer.tail], data, part);
+        ring_buffer.tail = (ring_buffer.tail + part) % HMI_RINGBUFFER_SIZE;
+        ring_buffer.length += part;
+        data += part;
+        len -= part;
+    }
+}
+
 static uint8_t ringbuffer_read_byte(uint16_t position)
 {
     if (position < ring_buffer.length)
@@ -79,12 +107,25 @@ static uint16_t ringbuffer_get_length(void)
 /* ==================== UART Operations ==================== */
 static rt_err_t hmi_uart_rx_indicate(rt_device_t dev, rt_size_t size)
 {
+    struct rt_serial_span span[2];
+    rt_ssize_t len;
     uint8_t ch;
 
-    /* Read all available data */
-    while (rt_device_read(dev, 0, &ch, 1) > 0)
+    /* Take all available data straight from the serial ring */
+    len = rt_serial_rx_peek((struct rt_serial_device *)dev, span);
+    if (len > 0)
     {
-        ringbuffer_write_byte(ch);
+        ringbuffer_write(span[0].buf, span[0].len);
+        ringbuffer_write(span[1].buf, span[1].len);
+        rt_serial_rx_consume((struct rt_serial_device *)dev, len);
+    }
+    else if (len < 0)
+    {
+        /* No serial ring in polling mode */
+        while (rt_device_read(dev, 0, &ch, 1) > 0)
+        {
+            ringbuffer_write_byte(ch);
+        }
     }
 
     /* Release semaphore to wake up receive thread */
@@ -108,12 +149,11 @@ static int hmi_send_raw(const char *data, rt_size_t len)
         return -RT_ERROR;
     }
 
-    /* Send data */
-    rt_device_write(hmi_serial, 0, data, len);
+    /* Send data and frame tail together */
+    static const uint8_t tail[3] = {HMI_FRAME_TAIL_0, HMI_FRAME_TAIL_1, HMI_FRAME_TAIL_2};
+    struct rt_serial_iovec iov[2] = {{data, len}, {tail, sizeof(tail)}};
 
-    /* Send frame tail */
-    uint8_t tail[3] = {HMI_FRAME_TAIL_0, HMI_FRAME_TAIL_1, HMI_FRAME_TAIL_2};
-    rt_device_write(hmi_serial, 0, tail, 3);
+    rt_serial_writev((struct rt_serial_device *)hmi_serial, iov, 2);
 
     return RT_EOK;
 }
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-11-7      SummerGift   first version
+ * 2026-10-18     Cc           register the memory class of the system heap
  */
 #include "drv_common.h"
 #include <board.h>
@@ -179,6 +180,10 @@ rt_weak void rt_hw_board_init(void)
 #if defined(RT_USING_HEAP)
     /* Heap initialization */
     rt_system_heap_init((void *)HEAP_BEGIN, (void *)HEAP_END);
+#ifdef RT_USING_MEMHEAP_HINT
+    /* the system heap is in AXI SRAM */
+    rt_memheap_class_register("heap", RT_MEM_FAST | RT_MEM_DMA);
+#endif
 #endif
 
 #ifdef RT_USING_PIN
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2024-01-24     yuanjie      first version
+ * 2026-10-18     Cc           register PSRAM as bulk memory
  */
 
 #include <board.h>
@@ -28,6 +29,9 @@ static int PSRAM_Init(void)
 #ifdef RT_USING_MEMHEAP_AS_HEAP
     /* If RT_USING_MEMHEAP_AS_HEAP is enabled, SDRAM is initialized to the heap */
     rt_memheap_init(&system_heap, "psram", (void *)PSRAM_BANK_ADDR, PSRAM_SIZE);
+#ifdef RT_USING_MEMHEAP_HINT
+    rt_memheap_class_register("psram", RT_MEM_BULK);
+#endif
 #endif
 
     return RT_EOK;
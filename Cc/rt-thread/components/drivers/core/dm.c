@@ -145,14 +145,18 @@ int rt_dm_dev_set_name(rt_device_t dev, const char *format, ...)
 {
     int n;
     va_list arg_ptr;
+    char name[RT_NAME_MAX];
 
     RT_ASSERT(dev != RT_NULL);
     RT_ASSERT(format != RT_NULL);
 
     va_start(arg_ptr, format);
-    n = rt_vsnprintf(dev->parent.name, RT_NAME_MAX, format, arg_ptr);
+    n = rt_vsnprintf(name, RT_NAME_MAX, format, arg_ptr);
     va_end(arg_ptr);
 
+    /* keep the object hash in step with the new name */
+    rt_object_set_name(&dev->parent, name);
+
     return n;
 }
 
@@ -53,11 +53,7 @@ rt_err_t rt_platform_driver_register(struct rt_platform_driver *pdrv)
     RT_ASSERT(pdrv != RT_NULL);
 
     pdrv->parent.bus = &platform_bus;
-#if RT_NAME_MAX > 0
-    rt_strcpy(pdrv->parent.parent.name, pdrv->name);
-#else
-    pdrv->parent.parent.name = pdrv->name;
-#endif
+    rt_object_set_name(&pdrv->parent.parent, pdrv->name);
     return rt_driver_register(&pdrv->parent);
 }
 
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#ifndef __DEV_SERIAL_LOOP_H__
+#define __DEV_SERIAL_LOOP_H__
+
+#include <rtthread.h>
+#include "dev_serial_v2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * @addtogroup Serial_v2
+ * @{
+ */
+
+#define RT_SERIAL_LOOP_ERR_NONE         0
+#define RT_SERIAL_LOOP_ERR_CORRUPT      1       /* one bit of the byte is flipped */
+#define RT_SERIAL_LOOP_ERR_DROP         2       /* the byte is lost, as on a framing error */
+
+/**
+ * @brief Counters of a software serial port
+ */
+struct rt_serial_loop_stats
+{
+    rt_size_t tx_bytes;                         /* bytes shifted out on the wire */
+    rt_size_t rx_bytes;                         /* bytes taken by the receiver */
+    rt_size_t rx_overruns;                      /* bytes lost, the receiver was full */
+    rt_size_t rx_errors;                        /* bytes lost, the line settings differ */
+    rt_size_t injected;                         /* errors injected on transmit */
+};
+
+/**
+ * @brief Software serial port
+ *
+ * The bytes move on the wire at the configured baud rate, driven by a hard
+ * timer whose callback plays the role of the uart interrupt. The receive and
+ * transmit sides run in interrupt or DMA mode, so the serial v2 framework sees
+ * the same events as with a real uart.
+ */
+struct rt_serial_loop
+{
+    struct rt_serial_device     serial;
+
+    struct rt_serial_loop      *peer;           /* the receiver on the other end of the wire */
+    struct rt_timer             wire;           /* the wire clock */
+    rt_uint32_t                 dma_flag;       /* RT_DEVICE_FLAG_DMA_RX and RT_DEVICE_FLAG_DMA_TX */
+    rt_uint32_t                 rx_mode;        /* RT_DEVICE_FLAG_INT_RX, RT_DEVICE_FLAG_DMA_RX or 0 */
+    rt_uint32_t                 tx_mode;        /* RT_DEVICE_FLAG_INT_TX, RT_DEVICE_FLAG_DMA_TX or 0 */
+    rt_bool_t                   tx_int;         /* the transmit interrupt is enabled */
+    rt_uint32_t                 bit_time;       /* baud rate credit carried to the next tick */
+
+    const rt_uint8_t           *dma_buf;
+    volatile rt_size_t          dma_len;
+    rt_size_t                   rx_pending;     /* received by DMA, not yet reported */
+
+    volatile int                rdr;            /* receive data register of the polling mode, -1 when empty */
+    volatile int                tdr;            /* transmit data register of the polling mode, -1 when empty */
+
+    rt_uint32_t                 err_kind;
+    rt_uint32_t                 err_every;
+    rt_uint32_t                 err_count;
+
+    struct rt_serial_loop_stats stats;
+};
+
+/**
+ * @brief Register a software serial port, wired to itself
+ * @param loop      the software serial port
+ * @param name      device name
+ * @param dma_flag  RT_DEVICE_FLAG_DMA_RX and RT_DEVICE_FLAG_DMA_TX to emulate the DMA modes,
+ *                  0 for the interrupt modes
+ * @return rt_err_t error code
+ * @ingroup  Serial_v2
+ */
+rt_err_t rt_serial_loop_register(struct rt_serial_loop *loop, const char *name, rt_uint32_t dma_flag);
+
+/**
+ * @brief Wire the transmitter of a port to the receiver of another one
+ * @param loop      the software serial port
+ * @param peer      the receiver of the bytes sent by loop, RT_NULL for loop itself
+ * @note Call it for both ports to get a full duplex pair.
+ * @ingroup  Serial_v2
+ */
+void rt_serial_loop_connect(struct rt_serial_loop *loop, struct rt_serial_loop *peer);
+
+/**
+ * @brief Select the interrupt or DMA modes of a closed port
+ * @param loop      the software serial port
+ * @param dma_flag  RT_DEVICE_FLAG_DMA_RX and RT_DEVICE_FLAG_DMA_TX, 0 for the interrupt modes
+ * @return rt_err_t -RT_EBUSY while the port is open
+ * @ingroup  Serial_v2
+ */
+rt_err_t rt_serial_loop_set_dma(struct rt_serial_loop *loop, rt_uint32_t dma_flag);
+
+/**
+ * @brief Inject errors on transmit
+ * @param loop      the software serial port
+ * @param kind      RT_SERIAL_LOOP_ERR_CORRUPT, RT_SERIAL_LOOP_ERR_DROP or RT_SERIAL_LOOP_ERR_NONE
+ * @param every     one byte in every is hit
+ * @ingroup  Serial_v2
+ */
+void rt_serial_loop_inject(struct rt_serial_loop *loop, rt_uint32_t kind, rt_uint32_t every);
+
+/**
+ * @brief Get the counters of a port
+ * @param loop      the software serial port
+ * @param stats     the counters
+ * @param clear     clear the counters after reading them
+ * @ingroup  Serial_v2
+ */
+void rt_serial_loop_get_stats(struct rt_serial_loop *loop, struct rt_serial_loop_stats *stats, rt_bool_t clear);
+
+/*! @}*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DEV_SERIAL_LOOP_H__ */
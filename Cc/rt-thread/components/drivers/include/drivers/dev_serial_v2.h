@@ -6,6 +6,8 @@
  * Change Logs:
  * Date           Author           Notes
  * 2021-06-01     KyleChan     first version
+ * 2026-10-18     Cc           add zero-copy rx peek/consume and tx reserve/commit
+ * 2026-10-18     Cc           add vectored write
  */
 
 #ifndef __DEV_SERIAL_V2_H__
@@ -181,6 +183,7 @@
 #define RT_SERIAL_TX_NON_BLOCKING       RT_DEVICE_FLAG_TX_NON_BLOCKING
 
 #define RT_DEVICE_CHECK_OPTMODE         0x20
+#define RT_SERIAL_CTRL_WRITEV           0x21    /* args: struct rt_serial_writev_args */
 
 #define RT_SERIAL_EVENT_RX_IND          0x01    /* Rx indication */
 #define RT_SERIAL_EVENT_TX_DONE         0x02    /* Tx complete   */
@@ -274,6 +277,37 @@ struct rt_serial_tx_fifo
     rt_uint8_t buffer[];
 };
 
+/**
+ * @brief Contiguous part of a serial ringbuffer
+ *
+ */
+struct rt_serial_span
+{
+    rt_uint8_t *buf;
+    rt_size_t   len;
+};
+
+/**
+ * @brief One buffer of a vectored write
+ *
+ */
+struct rt_serial_iovec
+{
+    const void *base;
+    rt_size_t   len;
+};
+
+/**
+ * @brief Arguments of the RT_SERIAL_CTRL_WRITEV control command
+ *
+ */
+struct rt_serial_writev_args
+{
+    const struct rt_serial_iovec *iov;
+    int                           iovcnt;
+    rt_ssize_t                    result;   /* out: the length written */
+};
+
 /**
  * @brief     serial device structure
  * 
@@ -350,6 +384,62 @@ rt_err_t rt_hw_serial_register(struct rt_serial_device      *serial,
 rt_err_t rt_hw_serial_register_tty(struct rt_serial_device *serial);
 
 
+/**
+ * @brief Get the received data in the rx ringbuffer without copying it
+ *
+ * @param serial    serial device
+ * @param span      the received data, span[1] holds the part after the wrap or is empty
+ * @return rt_ssize_t the length of the received data, -RT_ENOSYS without rx ringbuffer
+ * @note The data stays in the ringbuffer until rt_serial_rx_consume() is called.
+ * @ingroup  Serial_v2
+ */
+rt_ssize_t rt_serial_rx_peek(struct rt_serial_device *serial, struct rt_serial_span span[2]);
+
+/**
+ * @brief Release the processed data from the rx ringbuffer
+ *
+ * @param serial    serial device
+ * @param size      the length of the processed data
+ * @return rt_err_t error code
+ * @ingroup  Serial_v2
+ */
+rt_err_t rt_serial_rx_consume(struct rt_serial_device *serial, rt_size_t size);
+
+/**
+ * @brief Get the free space of the tx ringbuffer to build the data in place
+ *
+ * @param serial    serial device, opened with RT_DEVICE_FLAG_TX_NON_BLOCKING
+ * @param span      the free space, span[1] holds the part after the wrap or is empty
+ * @return rt_ssize_t the length of the free space, -RT_ENOSYS without tx ringbuffer
+ * @note Only one thread may fill the space, until rt_serial_tx_commit() is called.
+ * @ingroup  Serial_v2
+ */
+rt_ssize_t rt_serial_tx_reserve(struct rt_serial_device *serial, struct rt_serial_span span[2]);
+
+/**
+ * @brief Send the data built in the reserved space of the tx ringbuffer
+ *
+ * @param serial    serial device
+ * @param size      the length of the data, from the start of span[0]
+ * @return rt_err_t error code
+ * @ingroup  Serial_v2
+ */
+rt_err_t rt_serial_tx_commit(struct rt_serial_device *serial, rt_size_t size);
+
+/**
+ * @brief Write several buffers to a serial device with one call
+ *
+ * @param serial    serial device
+ * @param iov       the buffers
+ * @param iovcnt    the number of buffers
+ * @return rt_ssize_t the length written, short when the tx ringbuffer is full in non-blocking mode
+ * @note With a tx ringbuffer the buffers are queued back to back, no other writer comes between
+ *       them, and the driver is started once. The same write is reached by the
+ *       RT_SERIAL_CTRL_WRITEV control command, also from ioctl() on the device file.
+ * @ingroup  Serial_v2
+ */
+rt_ssize_t rt_serial_writev(struct rt_serial_device *serial, const struct rt_serial_iovec *iov, int iovcnt);
+
 /*! @}*/
 
 #endif
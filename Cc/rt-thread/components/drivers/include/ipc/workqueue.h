@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2021-08-01     Meco Man     remove rt_delayed_work_init() and rt_delayed_work structure
  * 2021-08-14     Jackistang   add comments for rt_work_init()
+ * 2026-10-18     Cc           add workqueue pool with work stealing and priority lanes
  */
 #ifndef WORKQUEUE_H__
 #define WORKQUEUE_H__
@@ -30,8 +31,41 @@ enum
 enum
 {
     RT_WORK_TYPE_DELAYED     = 0x0001,
+    RT_WORK_TYPE_HIGH        = 0x0002,     /* Work item runs in the high priority lane of a pool */
 };
 
+#ifdef RT_USING_WORKQUEUE_POOL
+/**
+ * work lanes of a pool worker, the high lane is always served first
+ */
+enum
+{
+    RT_WORK_LANE_HIGH        = 0,
+    RT_WORK_LANE_NORMAL,
+    RT_WORK_LANE_NR,
+};
+
+struct rt_workqueue_worker
+{
+    rt_list_t      lanes[RT_WORK_LANE_NR];  /* pending work of this worker */
+    struct rt_work *work_current;          /* current work of this worker */
+    rt_thread_t    thread;
+    struct rt_workqueue *queue;
+};
+
+struct rt_workqueue_stats
+{
+    rt_uint32_t    depth;                  /* pending work items */
+    rt_uint32_t    depth_max;
+    rt_uint32_t    done;                   /* finished work items */
+    rt_uint32_t    steals;                 /* work items taken from another worker */
+    rt_uint64_t    wait_ticks;             /* total ticks from submitting to running */
+    rt_tick_t      wait_max;
+    rt_uint64_t    exec_ticks;             /* total ticks spent in work functions */
+    rt_tick_t      exec_max;
+};
+#endif /* RT_USING_WORKQUEUE_POOL */
+
 /* workqueue implementation */
 struct rt_workqueue
 {
@@ -42,6 +76,13 @@ struct rt_workqueue
     struct rt_semaphore sem;
     rt_thread_t    work_thread;
     struct rt_spinlock spinlock;
+
+#ifdef RT_USING_WORKQUEUE_POOL
+    rt_uint8_t     worker_nr;
+    rt_uint8_t     worker_next;   /* round-robin start of submitting */
+    struct rt_workqueue_worker *workers;
+    struct rt_workqueue_stats stats;
+#endif /* RT_USING_WORKQUEUE_POOL */
 };
 
 struct rt_work
@@ -54,6 +95,9 @@ struct rt_work
     rt_uint16_t type;
     struct rt_timer timer;
     struct rt_workqueue *workqueue;
+#ifdef RT_USING_WORKQUEUE_POOL
+    rt_tick_t submit_tick;
+#endif /* RT_USING_WORKQUEUE_POOL */
 };
 
 #ifdef RT_USING_HEAP
@@ -70,6 +114,12 @@ rt_err_t rt_workqueue_cancel_work_sync(struct rt_workqueue *queue, struct rt_wor
 rt_err_t rt_workqueue_cancel_all_work(struct rt_workqueue *queue);
 rt_err_t rt_workqueue_urgent_work(struct rt_workqueue *queue, struct rt_work *work);
 
+#ifdef RT_USING_WORKQUEUE_POOL
+struct rt_workqueue *rt_workqueue_create_pool(const char *name, rt_uint16_t stack_size,
+                                              rt_uint8_t priority, rt_uint8_t worker_nr);
+rt_err_t rt_workqueue_get_stats(struct rt_workqueue *queue, struct rt_workqueue_stats *stats);
+#endif /* RT_USING_WORKQUEUE_POOL */
+
 #ifdef RT_USING_SYSTEM_WORKQUEUE
 rt_err_t rt_work_submit(struct rt_work *work, rt_tick_t ticks);
 rt_err_t rt_work_urgent(struct rt_work *work);
@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2012-01-08     bernard      first version.
  * 2014-07-12     bernard      Add workqueue implementation.
+ * 2026-10-18     Cc           add the software loopback serial ports
  */
 
 #ifndef __RT_DEVICE_H__
@@ -86,6 +87,9 @@ extern "C" {
 #ifdef RT_USING_SERIAL
 #ifdef RT_USING_SERIAL_V2
 #include "drivers/dev_serial_v2.h"
+#ifdef RT_SERIAL_USING_LOOPBACK
+#include "drivers/dev_serial_loop.h"
+#endif /* RT_SERIAL_USING_LOOPBACK */
 #else
 #include "drivers/dev_serial.h"
 #endif
@@ -10,6 +10,7 @@
  * 2021-08-14     Jackistang   add comments for function interface
  * 2022-01-16     Meco Man     add rt_work_urgent()
  * 2023-09-15     xqyjlj       perf rt_hw_interrupt_disable/enable
+ * 2026-10-18     Cc           add workqueue pool with work stealing and priority lanes
  */
 
 #include <rthw.h>
@@ -90,34 +91,258 @@ static void _workqueue_thread_entry(void *parameter)
     }
 }
 
-static rt_err_t _workqueue_submit_work(struct rt_workqueue *queue,
-                                       struct rt_work *work, rt_tick_t ticks)
+#ifdef RT_USING_WORKQUEUE_POOL
+/* whether the work is executing on any worker, must hold queue->spinlock */
+static rt_bool_t _workqueue_is_current(struct rt_workqueue *queue, struct rt_work *work)
 {
-    rt_base_t level;
+    rt_uint8_t index;
 
-    level = rt_spin_lock_irqsave(&(queue->spinlock));
+    for (index = 0; index < queue->worker_nr; index++)
+    {
+        if (queue->workers[index].work_current == work)
+            return RT_TRUE;
+    }
 
-    /* remove list */
-    rt_list_remove(&(work->list));
-    work->flags &= ~RT_WORK_STATE_PENDING;
+    return RT_FALSE;
+}
 
-    if (ticks == 0)
+/* put the work in a lane of an idle worker, or round-robin, must hold queue->spinlock */
+static void _workqueue_enqueue(struct rt_workqueue *queue, struct rt_work *work, rt_bool_t urgent)
+{
+    struct rt_workqueue_worker *worker = RT_NULL;
+    rt_uint8_t index, start, lane;
+
+    /* prefer a worker which has nothing to do */
+    for (index = 0; index < queue->worker_nr; index++)
     {
-        rt_list_insert_after(queue->work_list.prev, &(work->list));
-        work->flags |= RT_WORK_STATE_PENDING;
-        work->workqueue = queue;
+        worker = &(queue->workers[index]);
+        if (worker->work_current == RT_NULL &&
+            rt_list_isempty(&(worker->lanes[RT_WORK_LANE_HIGH])) &&
+            rt_list_isempty(&(worker->lanes[RT_WORK_LANE_NORMAL])))
+        {
+            break;
+        }
+    }
+
+    if (index == queue->worker_nr)
+    {
+        index = queue->worker_next;
+        queue->worker_next = (index + 1) % queue->worker_nr;
+    }
+    worker = &(queue->workers[index]);
+
+    lane = (urgent || (work->type & RT_WORK_TYPE_HIGH)) ? RT_WORK_LANE_HIGH : RT_WORK_LANE_NORMAL;
+    rt_list_insert_before(&(worker->lanes[lane]), &(work->list));
+    work->flags |= RT_WORK_STATE_PENDING;
+    work->workqueue = queue;
+    work->submit_tick = rt_tick_get();
+
+    queue->stats.depth ++;
+    if (queue->stats.depth > queue->stats.depth_max)
+        queue->stats.depth_max = queue->stats.depth;
+
+    /* wake up one suspended worker to run it or steal it, starting from the owner */
+    start = index;
+    do
+    {
+        worker = &(queue->workers[index]);
+        if (worker->work_current == RT_NULL && rt_thread_resume(worker->thread) == RT_EOK)
+            break;
+
+        index = (index + 1) % queue->worker_nr;
+    } while (index != start);
+}
 
-        /* whether the workqueue is doing work */
-        if (queue->work_current == RT_NULL)
+/* get the first work which is not executing on other workers */
+static struct rt_work *_workqueue_lane_first(struct rt_workqueue *queue, rt_list_t *lane)
+{
+    struct rt_work *work;
+
+    rt_list_for_each_entry(work, lane, list)
+    {
+        if (!_workqueue_is_current(queue, work))
+            return work;
+    }
+
+    return RT_NULL;
+}
+
+/* own lane first and then steal from the others, must hold queue->spinlock */
+static struct rt_work *_workqueue_pick_work(struct rt_workqueue *queue, struct rt_workqueue_worker *worker)
+{
+    struct rt_workqueue_worker *victim;
+    struct rt_work *work;
+    rt_uint8_t lane, index;
+
+    for (lane = 0; lane < RT_WORK_LANE_NR; lane++)
+    {
+        work = _workqueue_lane_first(queue, &(worker->lanes[lane]));
+        if (work != RT_NULL)
+            return work;
+
+        for (index = 0; index < queue->worker_nr; index++)
         {
-            /* resume work thread, and do a re-schedule if succeed */
-            rt_thread_resume(queue->work_thread);
-            rt_spin_unlock_irqrestore(&(queue->spinlock), level);
+            victim = &(queue->workers[index]);
+            if (victim == worker)
+                continue;
+
+            work = _workqueue_lane_first(queue, &(victim->lanes[lane]));
+            if (work != RT_NULL)
+            {
+                queue->stats.steals ++;
+                return work;
+            }
         }
-        else
+    }
+
+    return RT_NULL;
+}
+
+static void _workqueue_worker_entry(void *parameter)
+{
+    rt_base_t level;
+    rt_tick_t tick;
+    struct rt_work *work;
+    struct rt_workqueue *queue;
+    struct rt_workqueue_worker *worker;
+
+    worker = (struct rt_workqueue_worker *) parameter;
+    RT_ASSERT(worker != RT_NULL);
+    queue = worker->queue;
+
+    while (1)
+    {
+        level = rt_spin_lock_irqsave(&(queue->spinlock));
+        work = _workqueue_pick_work(queue, worker);
+        if (work == RT_NULL)
         {
+            /* no work to do or to steal, suspend self. */
+            rt_thread_suspend_with_flag(rt_thread_self(), RT_UNINTERRUPTIBLE);
+
+            /* release lock after suspend so we will not lost any wakeups */
             rt_spin_unlock_irqrestore(&(queue->spinlock), level);
+
+            rt_schedule();
+            continue;
         }
+
+        rt_list_remove(&(work->list));
+        worker->work_current = work;
+        work->flags &= ~RT_WORK_STATE_PENDING;
+        work->workqueue = RT_NULL;
+
+        tick = rt_tick_get() - work->submit_tick;
+        queue->stats.depth --;
+        queue->stats.wait_ticks += tick;
+        if (tick > queue->stats.wait_max)
+            queue->stats.wait_max = tick;
+        rt_spin_unlock_irqrestore(&(queue->spinlock), level);
+
+        /* do work */
+        tick = rt_tick_get();
+        work->work_func(work, work->work_data);
+        tick = rt_tick_get() - tick;
+
+        level = rt_spin_lock_irqsave(&(queue->spinlock));
+        /* clean current work */
+        worker->work_current = RT_NULL;
+        queue->stats.done ++;
+        queue->stats.exec_ticks += tick;
+        if (tick > queue->stats.exec_max)
+            queue->stats.exec_max = tick;
+        rt_spin_unlock_irqrestore(&(queue->spinlock), level);
+
+        /* ack work completion */
+        _workqueue_work_completion(queue);
+    }
+}
+
+/* must hold queue->spinlock */
+rt_inline void _workqueue_remove(struct rt_workqueue *queue, struct rt_work *work)
+{
+    rt_list_remove(&(work->list));
+    if (work->flags & RT_WORK_STATE_PENDING)
+    {
+        work->flags &= ~RT_WORK_STATE_PENDING;
+        queue->stats.depth --;
+    }
+}
+
+/* get the first pending work of the queue, must hold queue->spinlock */
+static struct rt_work *_workqueue_first_pending(struct rt_workqueue *queue)
+{
+    rt_uint8_t index, lane;
+
+    for (index = 0; index < queue->worker_nr; index++)
+    {
+        for (lane = 0; lane < RT_WORK_LANE_NR; lane++)
+        {
+            if (!rt_list_isempty(&(queue->workers[index].lanes[lane])))
+                return rt_list_first_entry(&(queue->workers[index].lanes[lane]), struct rt_work, list);
+        }
+    }
+
+    return RT_NULL;
+}
+#else
+rt_inline rt_bool_t _workqueue_is_current(struct rt_workqueue *queue, struct rt_work *work)
+{
+    return queue->work_current == work;
+}
+
+rt_inline void _workqueue_remove(struct rt_workqueue *queue, struct rt_work *work)
+{
+    RT_UNUSED(queue);
+
+    rt_list_remove(&(work->list));
+    work->flags &= ~RT_WORK_STATE_PENDING;
+}
+
+/* must hold queue->spinlock */
+static void _workqueue_enqueue(struct rt_workqueue *queue, struct rt_work *work, rt_bool_t urgent)
+{
+    if (urgent)
+    {
+        rt_list_insert_after(&queue->work_list, &(work->list));
+    }
+    else
+    {
+        rt_list_insert_after(queue->work_list.prev, &(work->list));
+    }
+    work->flags |= RT_WORK_STATE_PENDING;
+    work->workqueue = queue;
+
+    /* whether the workqueue is doing work */
+    if (queue->work_current == RT_NULL)
+    {
+        /* resume work thread, and do a re-schedule if succeed */
+        rt_thread_resume(queue->work_thread);
+    }
+}
+
+rt_inline struct rt_work *_workqueue_first_pending(struct rt_workqueue *queue)
+{
+    if (rt_list_isempty(&queue->work_list))
+        return RT_NULL;
+
+    return rt_list_first_entry(&queue->work_list, struct rt_work, list);
+}
+#endif /* RT_USING_WORKQUEUE_POOL */
+
+static rt_err_t _workqueue_submit_work(struct rt_workqueue *queue,
+                                       struct rt_work *work, rt_tick_t ticks)
+{
+    rt_base_t level;
+
+    level = rt_spin_lock_irqsave(&(queue->spinlock));
+
+    /* remove list */
+    _workqueue_remove(queue, work);
+
+    if (ticks == 0)
+    {
+        _workqueue_enqueue(queue, work, RT_FALSE);
+        rt_spin_unlock_irqrestore(&(queue->spinlock), level);
         return RT_EOK;
     }
     else if (ticks < RT_TICK_MAX / 2)
@@ -151,8 +376,7 @@ static rt_err_t _workqueue_cancel_work(struct rt_workqueue *queue, struct rt_wor
     rt_err_t err;
 
     level = rt_spin_lock_irqsave(&(queue->spinlock));
-    rt_list_remove(&(work->list));
-    work->flags &= ~RT_WORK_STATE_PENDING;
+    _workqueue_remove(queue, work);
     /* Timer started */
     if (work->flags & RT_WORK_STATE_SUBMITTING)
     {
@@ -160,12 +384,25 @@ static rt_err_t _workqueue_cancel_work(struct rt_workqueue *queue, struct rt_wor
         rt_timer_detach(&(work->timer));
         work->flags &= ~RT_WORK_STATE_SUBMITTING;
     }
-    err = queue->work_current != work ? RT_EOK : -RT_EBUSY;
+    err = _workqueue_is_current(queue, work) ? -RT_EBUSY : RT_EOK;
     work->workqueue = RT_NULL;
     rt_spin_unlock_irqrestore(&(queue->spinlock), level);
     return err;
 }
 
+/* whether a worker is executing the work, read under queue->spinlock */
+static rt_bool_t _workqueue_is_executing(struct rt_workqueue *queue, struct rt_work *work)
+{
+    rt_base_t level;
+    rt_bool_t current;
+
+    level = rt_spin_lock_irqsave(&(queue->spinlock));
+    current = _workqueue_is_current(queue, work);
+    rt_spin_unlock_irqrestore(&(queue->spinlock), level);
+
+    return current;
+}
+
 static void _delayed_work_timeout_handler(void *parameter)
 {
     struct rt_work *work;
@@ -182,22 +419,11 @@ static void _delayed_work_timeout_handler(void *parameter)
     /* remove delay list */
     rt_list_remove(&(work->list));
     /* insert work queue */
-    if (queue->work_current != work)
-    {
-        rt_list_insert_after(queue->work_list.prev, &(work->list));
-        work->flags |= RT_WORK_STATE_PENDING;
-    }
-    /* whether the workqueue is doing work */
-    if (queue->work_current == RT_NULL)
-    {
-        /* resume work thread, and do a re-schedule if succeed */
-        rt_thread_resume(queue->work_thread);
-        rt_spin_unlock_irqrestore(&(queue->spinlock), level);
-    }
-    else
+    if (!_workqueue_is_current(queue, work))
     {
-        rt_spin_unlock_irqrestore(&(queue->spinlock), level);
+        _workqueue_enqueue(queue, work, RT_FALSE);
     }
+    rt_spin_unlock_irqrestore(&(queue->spinlock), level);
 }
 
 /**
@@ -237,6 +463,9 @@ void rt_work_init(struct rt_work *work,
  */
 struct rt_workqueue *rt_workqueue_create(const char *name, rt_uint16_t stack_size, rt_uint8_t priority)
 {
+#ifdef RT_USING_WORKQUEUE_POOL
+    return rt_workqueue_create_pool(name, stack_size, priority, 1);
+#else
     struct rt_workqueue *queue = RT_NULL;
 
     queue = (struct rt_workqueue *)RT_KERNEL_MALLOC(sizeof(struct rt_workqueue));
@@ -262,8 +491,108 @@ struct rt_workqueue *rt_workqueue_create(const char *name, rt_uint16_t stack_siz
     }
 
     return queue;
+#endif /* RT_USING_WORKQUEUE_POOL */
 }
 
+#ifdef RT_USING_WORKQUEUE_POOL
+/**
+ * @brief Create a work queue served by a pool of worker threads.
+ *
+ * @note  Each worker has a high and a normal priority lane. Urgent work and work with
+ *        RT_WORK_TYPE_HIGH go to the high lane, which is served before any normal work.
+ *        An idle worker steals pending work from the others, and the same work item
+ *        never runs on two workers at once.
+ *
+ * @param name is a name of the worker threads.
+ *
+ * @param stack_size is stack size of each worker thread.
+ *
+ * @param priority is a priority of the worker threads.
+ *
+ * @param worker_nr is the number of worker threads.
+ *
+ * @return Return a pointer to the workqueue object. It will return RT_NULL if failed.
+ */
+struct rt_workqueue *rt_workqueue_create_pool(const char *name, rt_uint16_t stack_size,
+                                              rt_uint8_t priority, rt_uint8_t worker_nr)
+{
+    struct rt_workqueue *queue;
+    struct rt_workqueue_worker *worker;
+    rt_uint8_t index, lane;
+
+    RT_ASSERT(worker_nr > 0);
+
+    queue = (struct rt_workqueue *)RT_KERNEL_MALLOC(sizeof(struct rt_workqueue));
+    if (queue == RT_NULL)
+        return RT_NULL;
+
+    rt_memset(queue, 0, sizeof(struct rt_workqueue));
+    queue->workers = (struct rt_workqueue_worker *)RT_KERNEL_MALLOC(sizeof(struct rt_workqueue_worker) * worker_nr);
+    if (queue->workers == RT_NULL)
+    {
+        RT_KERNEL_FREE(queue);
+        return RT_NULL;
+    }
+
+    /* the lists are kept for the same layout, pending work lives in the lanes */
+    rt_list_init(&(queue->work_list));
+    rt_list_init(&(queue->delayed_list));
+    rt_sem_init(&(queue->sem), "wqueue", 0, RT_IPC_FLAG_FIFO);
+    rt_spin_lock_init(&(queue->spinlock));
+
+    for (index = 0; index < worker_nr; index++)
+    {
+        worker = &(queue->workers[index]);
+        for (lane = 0; lane < RT_WORK_LANE_NR; lane++)
+            rt_list_init(&(worker->lanes[lane]));
+        worker->work_current = RT_NULL;
+        worker->queue = queue;
+
+        worker->thread = rt_thread_create(name, _workqueue_worker_entry, worker, stack_size, priority, 10);
+        if (worker->thread == RT_NULL)
+        {
+            while (index--)
+                rt_thread_delete(queue->workers[index].thread);
+
+            rt_sem_detach(&(queue->sem));
+            RT_KERNEL_FREE(queue->workers);
+            RT_KERNEL_FREE(queue);
+            return RT_NULL;
+        }
+    }
+
+    queue->worker_nr = worker_nr;
+    queue->work_thread = queue->workers[0].thread;
+    for (index = 0; index < worker_nr; index++)
+        rt_thread_startup(queue->workers[index].thread);
+
+    return queue;
+}
+
+/**
+ * @brief Get the metrics of a work queue.
+ *
+ * @param queue is a pointer to the workqueue object.
+ *
+ * @param stats is a pointer to the buffer to store the metrics.
+ *
+ * @return RT_EOK       Success.
+ */
+rt_err_t rt_workqueue_get_stats(struct rt_workqueue *queue, struct rt_workqueue_stats *stats)
+{
+    rt_base_t level;
+
+    RT_ASSERT(queue != RT_NULL);
+    RT_ASSERT(stats != RT_NULL);
+
+    level = rt_spin_lock_irqsave(&(queue->spinlock));
+    rt_memcpy(stats, &(queue->stats), sizeof(struct rt_workqueue_stats));
+    rt_spin_unlock_irqrestore(&(queue->spinlock), level);
+
+    return RT_EOK;
+}
+#endif /* RT_USING_WORKQUEUE_POOL */
+
 /**
  * @brief Destroy a work queue.
  *
@@ -276,7 +605,15 @@ rt_err_t rt_workqueue_destroy(struct rt_workqueue *queue)
     RT_ASSERT(queue != RT_NULL);
 
     rt_workqueue_cancel_all_work(queue);
+#ifdef RT_USING_WORKQUEUE_POOL
+    while (queue->worker_nr--)
+    {
+        rt_thread_delete(queue->workers[queue->worker_nr].thread);
+    }
+    RT_KERNEL_FREE(queue->workers);
+#else
     rt_thread_delete(queue->work_thread);
+#endif /* RT_USING_WORKQUEUE_POOL */
     rt_sem_detach(&(queue->sem));
     RT_KERNEL_FREE(queue);
 
@@ -343,19 +680,9 @@ rt_err_t rt_workqueue_urgent_work(struct rt_workqueue *queue, struct rt_work *wo
 
     level = rt_spin_lock_irqsave(&(queue->spinlock));
     /* NOTE: the work MUST be initialized firstly */
-    rt_list_remove(&(work->list));
-    rt_list_insert_after(&queue->work_list, &(work->list));
-    /* whether the workqueue is doing work */
-    if (queue->work_current == RT_NULL)
-    {
-        /* resume work thread, and do a re-schedule if succeed */
-        rt_thread_resume(queue->work_thread);
-        rt_spin_unlock_irqrestore(&(queue->spinlock), level);
-    }
-    else
-    {
-        rt_spin_unlock_irqrestore(&(queue->spinlock), level);
-    }
+    _workqueue_remove(queue, work);
+    _workqueue_enqueue(queue, work, RT_TRUE);
+    rt_spin_unlock_irqrestore(&(queue->spinlock), level);
 
     return RT_EOK;
 }
@@ -392,10 +719,13 @@ rt_err_t rt_workqueue_cancel_work_sync(struct rt_workqueue *queue, struct rt_wor
     RT_ASSERT(queue != RT_NULL);
     RT_ASSERT(work != RT_NULL);
 
-    if (queue->work_current == work) /* it's current work in the queue */
+    if (_workqueue_is_executing(queue, work)) /* it's current work in the queue */
     {
-        /* wait for work completion */
-        rt_sem_take(&(queue->sem), RT_WAITING_FOREVER);
+        /* wait for work completion, other workers may complete first */
+        do
+        {
+            rt_sem_take(&(queue->sem), RT_WAITING_FOREVER);
+        } while (_workqueue_is_executing(queue, work));
     }
     else
     {
@@ -420,9 +750,8 @@ rt_err_t rt_workqueue_cancel_all_work(struct rt_workqueue *queue)
 
     /* cancel work */
     rt_enter_critical();
-    while (rt_list_isempty(&queue->work_list) == RT_FALSE)
+    while ((work = _workqueue_first_pending(queue)) != RT_NULL)
     {
-        work = rt_list_first_entry(&queue->work_list, struct rt_work, list);
         _workqueue_cancel_work(queue, work);
     }
     /* cancel delay work */
@@ -488,8 +817,13 @@ static int rt_work_sys_workqueue_init(void)
     if (sys_workq != RT_NULL)
         return RT_EOK;
 
+#ifdef RT_USING_WORKQUEUE_POOL
+    sys_workq = rt_workqueue_create_pool("sys workq", RT_SYSTEM_WORKQUEUE_STACKSIZE,
+                                         RT_SYSTEM_WORKQUEUE_PRIORITY, RT_SYSTEM_WORKQUEUE_WORKERS);
+#else
     sys_workq = rt_workqueue_create("sys workq", RT_SYSTEM_WORKQUEUE_STACKSIZE,
                                     RT_SYSTEM_WORKQUEUE_PRIORITY);
+#endif /* RT_USING_WORKQUEUE_POOL */
     RT_ASSERT(sys_workq != RT_NULL);
 
     return RT_EOK;
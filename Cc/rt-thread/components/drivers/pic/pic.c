@@ -90,11 +90,7 @@ void rt_pic_default_name(struct rt_pic *pic)
 {
     if (pic)
     {
-    #if RT_NAME_MAX > 0
-        rt_strncpy(pic->parent.name, "PIC", RT_NAME_MAX);
-    #else
-        pic->parent.name = "PIC";
-    #endif
+        rt_object_set_name(&pic->parent, "PIC");
     }
 }
 
@@ -0,0 +1,449 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+
+#define DBG_TAG    "serial.loop"
+#define DBG_LVL    DBG_INFO
+#include <rtdbg.h>
+
+#define LOOP_RX_FLAG    (RT_DEVICE_FLAG_INT_RX | RT_DEVICE_FLAG_DMA_RX)
+#define LOOP_TX_FLAG    (RT_DEVICE_FLAG_INT_TX | RT_DEVICE_FLAG_DMA_TX)
+
+/* the bits of a character on the line: start, data, parity and stop bits */
+static rt_uint32_t _loop_frame_bits(struct serial_configure *cfg)
+{
+    return 1 + cfg->data_bits + (cfg->parity != PARITY_NONE) + 1 + cfg->stop_bits;
+}
+
+/* a receiver with other line settings only sees framing errors */
+static rt_bool_t _loop_line_match(struct serial_configure *tx_cfg, struct serial_configure *rx_cfg)
+{
+    return tx_cfg->baud_rate == rx_cfg->baud_rate &&
+           tx_cfg->data_bits == rx_cfg->data_bits &&
+           tx_cfg->parity == rx_cfg->parity;
+}
+
+static void _loop_wire_start(struct rt_serial_loop *loop)
+{
+    if (!(loop->wire.parent.flag & RT_TIMER_FLAG_ACTIVATED))
+    {
+        rt_timer_start(&loop->wire);
+    }
+}
+
+/* the receiver takes one byte, in the mode it is opened with */
+static void _loop_rx_byte(struct rt_serial_loop *loop, rt_uint8_t ch)
+{
+    struct rt_serial_rx_fifo *rx_fifo;
+    struct rt_ringbuffer *rb;
+
+    if (!(loop->serial.parent.open_flag & RT_DEVICE_OFLAG_OPEN))
+    {
+        return;
+    }
+
+    rx_fifo = (struct rt_serial_rx_fifo *)loop->serial.serial_rx;
+    if (loop->rx_mode == RT_DEVICE_FLAG_DMA_RX)
+    {
+        /* the DMA writes behind the data of the ringbuffer,
+         * the RX_DMADONE event moves the write index */
+        rb = &rx_fifo->rb;
+        if (rt_ringbuffer_space_len(rb) <= loop->rx_pending)
+        {
+            loop->stats.rx_overruns++;
+            return;
+        }
+        rb->buffer_ptr[(rb->write_index + loop->rx_pending) % rb->buffer_size] = ch;
+        loop->rx_pending++;
+    }
+    else if (loop->rx_mode == RT_DEVICE_FLAG_INT_RX)
+    {
+        if (rt_ringbuffer_putchar(&rx_fifo->rb, ch) == 0)
+        {
+            loop->stats.rx_overruns++;
+        }
+        else
+        {
+            loop->stats.rx_bytes++;
+        }
+        rt_hw_serial_isr(&loop->serial, RT_SERIAL_EVENT_RX_IND);
+        return;
+    }
+    else
+    {
+        /* polling mode, the data register keeps the byte until getc() */
+        if (loop->rdr >= 0)
+        {
+            loop->stats.rx_overruns++;
+            return;
+        }
+        loop->rdr = ch;
+    }
+    loop->stats.rx_bytes++;
+}
+
+/* an idle line ends the DMA reception */
+static void _loop_rx_flush(struct rt_serial_loop *loop)
+{
+    rt_size_t rx_length;
+
+    if (loop->rx_pending)
+    {
+        rx_length = loop->rx_pending;
+        loop->rx_pending = 0;
+        rt_hw_serial_isr(&loop->serial, RT_SERIAL_EVENT_RX_DMADONE | (rx_length << 8));
+    }
+}
+
+/* one byte on the wire, the injected errors hit it here */
+static void _loop_wire_put(struct rt_serial_loop *loop, rt_uint8_t ch)
+{
+    struct rt_serial_loop *peer = loop->peer;
+
+    loop->stats.tx_bytes++;
+    if (loop->err_every && ++loop->err_count >= loop->err_every)
+    {
+        loop->err_count = 0;
+        loop->stats.injected++;
+        if (loop->err_kind == RT_SERIAL_LOOP_ERR_DROP)
+        {
+            peer->stats.rx_errors++;
+            return;
+        }
+        ch ^= 0x10;
+    }
+
+    if (!_loop_line_match(&loop->serial.config, &peer->serial.config))
+    {
+        peer->stats.rx_errors++;
+        return;
+    }
+    _loop_rx_byte(peer, ch);
+}
+
+/**
+  * @brief The wire clock, it runs in the tick interrupt as the uart interrupt.
+  * @param parameter The software serial port.
+  */
+static void _loop_wire_tick(void *parameter)
+{
+    struct rt_serial_loop *loop = (struct rt_serial_loop *)parameter;
+    struct rt_serial_tx_fifo *tx_fifo;
+    rt_uint32_t frame, slots;
+    rt_uint8_t ch;
+
+    /* the characters the line carries in one tick */
+    frame = _loop_frame_bits(&loop->serial.config) * RT_TICK_PER_SECOND;
+    loop->bit_time += loop->serial.config.baud_rate;
+    slots = loop->bit_time / frame;
+    loop->bit_time %= frame;
+
+    for (; slots; slots--)
+    {
+        if (loop->tdr >= 0)
+        {
+            ch = (rt_uint8_t)loop->tdr;
+            loop->tdr = -1;
+            _loop_wire_put(loop, ch);
+        }
+        else if (loop->dma_len)
+        {
+            _loop_wire_put(loop, *loop->dma_buf++);
+            if (--loop->dma_len == 0)
+            {
+                rt_hw_serial_isr(&loop->serial, RT_SERIAL_EVENT_TX_DMADONE);
+            }
+        }
+        else if (loop->tx_int)
+        {
+            tx_fifo = (struct rt_serial_tx_fifo *)loop->serial.serial_tx;
+            if (rt_ringbuffer_getchar(&tx_fifo->rb, &ch))
+            {
+                _loop_wire_put(loop, ch);
+            }
+            else
+            {
+                /* the transmit complete interrupt */
+                loop->tx_int = RT_FALSE;
+                rt_hw_serial_isr(&loop->serial, RT_SERIAL_EVENT_TX_DONE);
+            }
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    _loop_rx_flush(loop->peer);
+}
+
+static rt_err_t _loop_configure(struct rt_serial_device *serial, struct serial_configure *cfg)
+{
+    /* the wire clock reads the line settings from serial->config */
+    return RT_EOK;
+}
+
+static rt_err_t _loop_control(struct rt_serial_device *serial, int cmd, void *arg)
+{
+    struct rt_serial_loop *loop;
+    rt_ubase_t ctrl_arg = (rt_ubase_t)arg;
+    rt_base_t level;
+
+    RT_ASSERT(serial != RT_NULL);
+    loop = rt_container_of(serial, struct rt_serial_loop, serial);
+
+    if (ctrl_arg & (RT_DEVICE_FLAG_RX_BLOCKING | RT_DEVICE_FLAG_RX_NON_BLOCKING))
+    {
+        if (loop->dma_flag & RT_DEVICE_FLAG_DMA_RX)
+            ctrl_arg = RT_DEVICE_FLAG_DMA_RX;
+        else
+            ctrl_arg = RT_DEVICE_FLAG_INT_RX;
+    }
+    else if (ctrl_arg & (RT_DEVICE_FLAG_TX_BLOCKING | RT_DEVICE_FLAG_TX_NON_BLOCKING))
+    {
+        if (loop->dma_flag & RT_DEVICE_FLAG_DMA_TX)
+            ctrl_arg = RT_DEVICE_FLAG_DMA_TX;
+        else
+            ctrl_arg = RT_DEVICE_FLAG_INT_TX;
+    }
+
+    switch (cmd)
+    {
+    case RT_DEVICE_CTRL_CLR_INT:
+        level = rt_hw_interrupt_disable();
+        if (ctrl_arg & LOOP_RX_FLAG)
+        {
+            loop->rx_mode = 0;
+            loop->rx_pending = 0;
+        }
+        else if (ctrl_arg & LOOP_TX_FLAG)
+        {
+            loop->tx_mode = 0;
+            loop->tx_int = RT_FALSE;
+            loop->dma_len = 0;
+        }
+        rt_hw_interrupt_enable(level);
+        break;
+
+    case RT_DEVICE_CTRL_SET_INT:
+        if (ctrl_arg == RT_DEVICE_FLAG_INT_RX)
+            loop->rx_mode = RT_DEVICE_FLAG_INT_RX;
+        else if (ctrl_arg == RT_DEVICE_FLAG_INT_TX)
+            loop->tx_int = RT_TRUE;
+        break;
+
+    case RT_DEVICE_CTRL_CONFIG:
+        level = rt_hw_interrupt_disable();
+        if (ctrl_arg & LOOP_RX_FLAG)
+        {
+            loop->rx_mode = ctrl_arg;
+            loop->rx_pending = 0;
+        }
+        else if (ctrl_arg & LOOP_TX_FLAG)
+        {
+            loop->tx_mode = ctrl_arg;
+        }
+        rt_hw_interrupt_enable(level);
+        _loop_wire_start(loop);
+        break;
+
+    case RT_DEVICE_CHECK_OPTMODE:
+        if (ctrl_arg & RT_DEVICE_FLAG_DMA_TX)
+            return RT_SERIAL_TX_BLOCKING_NO_BUFFER;
+        else
+            return RT_SERIAL_TX_BLOCKING_BUFFER;
+
+    case RT_DEVICE_CTRL_CLOSE:
+        rt_timer_stop(&loop->wire);
+        loop->bit_time = 0;
+        loop->rdr = -1;
+        loop->tdr = -1;
+        break;
+    }
+
+    return RT_EOK;
+}
+
+static int _loop_putc(struct rt_serial_device *serial, char c)
+{
+    struct rt_serial_loop *loop;
+
+    RT_ASSERT(serial != RT_NULL);
+    loop = rt_container_of(serial, struct rt_serial_loop, serial);
+
+    /* an interrupt cannot wait for the wire clock */
+    if (rt_interrupt_get_nest() != 0)
+    {
+        _loop_wire_put(loop, (rt_uint8_t)c);
+        _loop_rx_flush(loop->peer);
+        return 1;
+    }
+
+    /* the wire clock empties the data register, wait as for the transmit complete flag */
+    _loop_wire_start(loop);
+    loop->tdr = (rt_uint8_t)c;
+    while (loop->tdr >= 0);
+
+    return 1;
+}
+
+static int _loop_getc(struct rt_serial_device *serial)
+{
+    struct rt_serial_loop *loop;
+    rt_base_t level;
+    int ch;
+
+    RT_ASSERT(serial != RT_NULL);
+    loop = rt_container_of(serial, struct rt_serial_loop, serial);
+
+    level = rt_hw_interrupt_disable();
+    ch = loop->rdr;
+    loop->rdr = -1;
+    rt_hw_interrupt_enable(level);
+
+    return ch;
+}
+
+static rt_ssize_t _loop_transmit(struct rt_serial_device     *serial,
+                                       rt_uint8_t           *buf,
+                                       rt_size_t             size,
+                                       rt_uint32_t           tx_flag)
+{
+    struct rt_serial_loop *loop;
+    rt_base_t level;
+
+    RT_ASSERT(serial != RT_NULL);
+    RT_ASSERT(buf != RT_NULL);
+    loop = rt_container_of(serial, struct rt_serial_loop, serial);
+
+    if (loop->tx_mode == RT_DEVICE_FLAG_DMA_TX)
+    {
+        level = rt_hw_interrupt_disable();
+        loop->dma_buf = buf;
+        loop->dma_len = size;
+        rt_hw_interrupt_enable(level);
+        return size;
+    }
+
+    _loop_control(serial, RT_DEVICE_CTRL_SET_INT, (void *)(rt_ubase_t)tx_flag);
+
+    return size;
+}
+
+static const struct rt_uart_ops _loop_ops =
+{
+    _loop_configure,
+    _loop_control,
+    _loop_putc,
+    _loop_getc,
+    _loop_transmit
+};
+
+rt_err_t rt_serial_loop_register(struct rt_serial_loop *loop, const char *name, rt_uint32_t dma_flag)
+{
+    struct serial_configure config = RT_SERIAL_CONFIG_DEFAULT;
+
+    RT_ASSERT(loop != RT_NULL);
+    RT_ASSERT(name != RT_NULL);
+
+    rt_memset(loop, 0, sizeof(*loop));
+    loop->serial.ops = &_loop_ops;
+    loop->serial.config = config;
+    loop->peer = loop;
+    loop->dma_flag = dma_flag & (RT_DEVICE_FLAG_DMA_RX | RT_DEVICE_FLAG_DMA_TX);
+    loop->rdr = -1;
+    loop->tdr = -1;
+    rt_timer_init(&loop->wire, name, _loop_wire_tick, loop, 1,
+                  RT_TIMER_FLAG_PERIODIC | RT_TIMER_FLAG_HARD_TIMER);
+
+    return rt_hw_serial_register(&loop->serial, name, RT_DEVICE_FLAG_RDWR, loop);
+}
+
+void rt_serial_loop_connect(struct rt_serial_loop *loop, struct rt_serial_loop *peer)
+{
+    rt_base_t level;
+
+    RT_ASSERT(loop != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    _loop_rx_flush(loop->peer);
+    loop->peer = peer ? peer : loop;
+    rt_hw_interrupt_enable(level);
+}
+
+rt_err_t rt_serial_loop_set_dma(struct rt_serial_loop *loop, rt_uint32_t dma_flag)
+{
+    RT_ASSERT(loop != RT_NULL);
+
+    if (loop->serial.parent.ref_count)
+    {
+        return -RT_EBUSY;
+    }
+    loop->dma_flag = dma_flag & (RT_DEVICE_FLAG_DMA_RX | RT_DEVICE_FLAG_DMA_TX);
+
+    return RT_EOK;
+}
+
+void rt_serial_loop_inject(struct rt_serial_loop *loop, rt_uint32_t kind, rt_uint32_t every)
+{
+    rt_base_t level;
+
+    RT_ASSERT(loop != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    loop->err_kind = kind;
+    loop->err_every = kind == RT_SERIAL_LOOP_ERR_NONE ? 0 : every;
+    loop->err_count = 0;
+    rt_hw_interrupt_enable(level);
+}
+
+void rt_serial_loop_get_stats(struct rt_serial_loop *loop, struct rt_serial_loop_stats *stats, rt_bool_t clear)
+{
+    rt_base_t level;
+
+    RT_ASSERT(loop != RT_NULL);
+    RT_ASSERT(stats != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    *stats = loop->stats;
+    if (clear)
+    {
+        rt_memset(&loop->stats, 0, sizeof(loop->stats));
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+static struct rt_serial_loop serial_loop[2];
+
+static int rt_hw_serial_loop_init(void)
+{
+    rt_err_t result;
+
+    result = rt_serial_loop_register(&serial_loop[0], "sloop0", 0);
+    if (result == RT_EOK)
+    {
+        result = rt_serial_loop_register(&serial_loop[1], "sloop1", 0);
+    }
+    if (result != RT_EOK)
+    {
+        LOG_E("register the software serial ports failed: %d", result);
+        return result;
+    }
+#ifdef RT_SERIAL_LOOPBACK_PAIRED
+    rt_serial_loop_connect(&serial_loop[0], &serial_loop[1]);
+    rt_serial_loop_connect(&serial_loop[1], &serial_loop[0]);
+#endif /* RT_SERIAL_LOOPBACK_PAIRED */
+
+    return RT_EOK;
+}
+INIT_DEVICE_EXPORT(rt_hw_serial_loop_init);
@@ -6,6 +6,8 @@
  * Change Logs:
  * Date           Author       Notes
  * 2021-06-01     KyleChan     first version
+ * 2026-10-18     Cc           add zero-copy rx peek/consume and tx reserve/commit
+ * 2026-10-18     Cc           add vectored write
  */
 
 #include <rthw.h>
@@ -296,6 +298,43 @@ static rt_ssize_t rt_serial_update_write_index(struct rt_ringbuffer  *rb,
 }
 
 
+/**
+  * @brief Hand the linear data at the read index of the tx ringbuffer to the driver.
+  * @param serial RT-thread serial device.
+  * @param tx_fifo The tx fifo of the serial device, tx_fifo->activated is set.
+  */
+static void _serial_fifo_tx_start(struct rt_serial_device    *serial,
+                                  struct rt_serial_tx_fifo   *tx_fifo)
+{
+    rt_uint8_t *put_ptr = RT_NULL;
+
+    /* Get the linear length buffer from rinbuffer */
+    tx_fifo->put_size = rt_serial_get_linear_buffer(&(tx_fifo->rb), &put_ptr);
+    /* Call the transmit interface for transmission */
+    serial->ops->transmit(serial,
+                          put_ptr,
+                          tx_fifo->put_size,
+                          RT_SERIAL_TX_NON_BLOCKING);
+}
+
+/**
+  * @brief Describe len bytes of a ringbuffer from index as contiguous spans.
+  * @param rb The ringbuffer.
+  * @param index The index of the first byte.
+  * @param len The length, it does not exceed the buffer size.
+  * @param span The spans, span[1] holds the part after the wrap or is empty.
+  */
+static void _serial_ring_span(struct rt_ringbuffer     *rb,
+                                    rt_size_t          index,
+                                    rt_size_t          len,
+                              struct rt_serial_span    span[2])
+{
+    span[0].buf = &rb->buffer_ptr[index];
+    span[0].len = rb->buffer_size - index > len ? len : rb->buffer_size - index;
+    span[1].buf = rb->buffer_ptr;
+    span[1].len = len - span[0].len;
+}
+
 /**
   * @brief Serial polling receive data routine, This function will receive data
   *        in a continuous loop by one by one byte.
@@ -598,14 +637,7 @@ static rt_ssize_t _serial_fifo_tx_nonblocking(struct rt_device        *dev,
 
         rt_hw_interrupt_enable(level);
 
-        rt_uint8_t *put_ptr = RT_NULL;
-        /* Get the linear length buffer from rinbuffer */
-        tx_fifo->put_size = rt_serial_get_linear_buffer(&(tx_fifo->rb), &put_ptr);
-        /* Call the transmit interface for transmission */
-        serial->ops->transmit(serial,
-                              put_ptr,
-                              tx_fifo->put_size,
-                              RT_SERIAL_TX_NON_BLOCKING);
+        _serial_fifo_tx_start(serial, tx_fifo);
         /* In tx_nonblocking mode, there is no need to call rt_completion_wait() APIs to wait
          * for the rt_current_thread to resume */
         return length;
@@ -625,6 +657,343 @@ static rt_ssize_t _serial_fifo_tx_nonblocking(struct rt_device        *dev,
 }
 
 
+/**
+  * @brief Get the received data in the rx ringbuffer without copying it.
+  *        The data stays in the ringbuffer until rt_serial_rx_consume().
+  * @param serial RT-thread serial device.
+  * @param span The received data, span[1] holds the part after the wrap of the ringbuffer or is empty.
+  * @return Return the length of the received data, -RT_ENOSYS when the device has no rx ringbuffer.
+  */
+rt_ssize_t rt_serial_rx_peek(struct rt_serial_device *serial, struct rt_serial_span span[2])
+{
+    struct rt_serial_rx_fifo *rx_fifo;
+    rt_base_t level;
+    rt_size_t len;
+
+    RT_ASSERT((serial != RT_NULL) && (span != RT_NULL));
+
+    rx_fifo = (struct rt_serial_rx_fifo *) serial->serial_rx;
+    if (rx_fifo == RT_NULL)
+    {
+        /* the polling mode has no ringbuffer */
+        span[0].len = span[1].len = 0;
+        return -RT_ENOSYS;
+    }
+
+    level = rt_hw_interrupt_disable();
+    len = rt_ringbuffer_data_len(&(rx_fifo->rb));
+    _serial_ring_span(&(rx_fifo->rb), rx_fifo->rb.read_index, len, span);
+    rt_hw_interrupt_enable(level);
+
+    return len;
+}
+
+/**
+  * @brief Release the data given by rt_serial_rx_peek() from the rx ringbuffer.
+  * @param serial RT-thread serial device.
+  * @param size The length of the processed data.
+  * @return Return the status of the operation, -RT_EINVAL when size is more than the received data.
+  */
+rt_err_t rt_serial_rx_consume(struct rt_serial_device *serial, rt_size_t size)
+{
+    struct rt_serial_rx_fifo *rx_fifo;
+    rt_base_t level;
+
+    RT_ASSERT(serial != RT_NULL);
+
+    rx_fifo = (struct rt_serial_rx_fifo *) serial->serial_rx;
+    if (rx_fifo == RT_NULL) return -RT_ENOSYS;
+
+    level = rt_hw_interrupt_disable();
+    if (size > rt_ringbuffer_data_len(&(rx_fifo->rb)))
+    {
+        rt_hw_interrupt_enable(level);
+        return -RT_EINVAL;
+    }
+    /* the size is in the used span, the 16 bits helpers would truncate it on a large buffer */
+    if (size >= (rt_size_t)rx_fifo->rb.buffer_size - rx_fifo->rb.read_index)
+    {
+        rx_fifo->rb.read_mirror = ~rx_fifo->rb.read_mirror;
+        rx_fifo->rb.read_index = size - (rx_fifo->rb.buffer_size - rx_fifo->rb.read_index);
+    }
+    else
+    {
+        rx_fifo->rb.read_index += size;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+/**
+  * @brief Get the free space of the tx ringbuffer to build the data in place.
+  *        Only one thread may fill it, until rt_serial_tx_commit().
+  * @param serial RT-thread serial device opened with RT_DEVICE_FLAG_TX_NON_BLOCKING.
+  * @param span The free space, span[1] holds the part after the wrap of the ringbuffer or is empty.
+  * @return Return the length of the free space, -RT_ENOSYS when the device has no tx ringbuffer.
+  */
+rt_ssize_t rt_serial_tx_reserve(struct rt_serial_device *serial, struct rt_serial_span span[2])
+{
+    struct rt_serial_tx_fifo *tx_fifo;
+    rt_base_t level;
+    rt_size_t len;
+
+    RT_ASSERT((serial != RT_NULL) && (span != RT_NULL));
+
+    tx_fifo = (struct rt_serial_tx_fifo *) serial->serial_tx;
+    if (tx_fifo == RT_NULL || !(serial->parent.open_flag & RT_SERIAL_TX_NON_BLOCKING))
+    {
+        /* the blocking modes send from the buffer of the caller */
+        span[0].len = span[1].len = 0;
+        return -RT_ENOSYS;
+    }
+
+    level = rt_hw_interrupt_disable();
+    len = rt_ringbuffer_space_len(&(tx_fifo->rb));
+    _serial_ring_span(&(tx_fifo->rb), tx_fifo->rb.write_index, len, span);
+    rt_hw_interrupt_enable(level);
+
+    return len;
+}
+
+/**
+  * @brief Queue the data built in the space given by rt_serial_tx_reserve(),
+  *        the driver sends it straight from the tx ringbuffer.
+  * @param serial RT-thread serial device.
+  * @param size The length of the data, from the start of span[0].
+  * @return Return the status of the operation, -RT_EINVAL when size is more than the free space.
+  */
+rt_err_t rt_serial_tx_commit(struct rt_serial_device *serial, rt_size_t size)
+{
+    struct rt_serial_tx_fifo *tx_fifo;
+    rt_bool_t activated;
+    rt_base_t level;
+
+    RT_ASSERT(serial != RT_NULL);
+
+    tx_fifo = (struct rt_serial_tx_fifo *) serial->serial_tx;
+    if (tx_fifo == RT_NULL || !(serial->parent.open_flag & RT_SERIAL_TX_NON_BLOCKING))
+    {
+        return -RT_ENOSYS;
+    }
+    if (size == 0) return RT_EOK;
+
+    level = rt_hw_interrupt_disable();
+    if (size > rt_ringbuffer_space_len(&(tx_fifo->rb)))
+    {
+        rt_hw_interrupt_enable(level);
+        return -RT_EINVAL;
+    }
+    /* the size is in the free span, the 16 bits helpers would truncate it on a large buffer */
+    if (size >= (rt_size_t)tx_fifo->rb.buffer_size - tx_fifo->rb.write_index)
+    {
+        tx_fifo->rb.write_mirror = ~tx_fifo->rb.write_mirror;
+        tx_fifo->rb.write_index = size - (tx_fifo->rb.buffer_size - tx_fifo->rb.write_index);
+    }
+    else
+    {
+        tx_fifo->rb.write_index += size;
+    }
+    /* start the transmission when the device is idle,
+     * otherwise the tx done interrupt sends the data */
+    activated = tx_fifo->activated;
+    tx_fifo->activated = RT_TRUE;
+    rt_hw_interrupt_enable(level);
+
+    if (activated == RT_FALSE)
+    {
+        _serial_fifo_tx_start(serial, tx_fifo);
+    }
+
+    return RT_EOK;
+}
+
+/**
+  * @brief Copy the segments from iov[*index] + *offset into the ringbuffer,
+  *        as many bytes as fit, and advance the position.
+  * @return Return the length of the copied data.
+  */
+static rt_size_t _serial_ring_putv(struct rt_ringbuffer            *rb,
+                                   const struct rt_serial_iovec    *iov,
+                                         int                        iovcnt,
+                                         int                       *index,
+                                         rt_size_t                 *offset)
+{
+    rt_size_t put, total = 0;
+
+    while (*index < iovcnt)
+    {
+        put = rt_ringbuffer_put(rb,
+                                (const rt_uint8_t *)iov[*index].base + *offset,
+                                iov[*index].len - *offset);
+        total += put;
+        *offset += put;
+        /* the ringbuffer is full */
+        if (*offset < iov[*index].len) break;
+
+        (*index)++;
+        *offset = 0;
+    }
+
+    return total;
+}
+
+/**
+  * @brief Send the segments one by one, with the routine of a single buffer.
+  * @return Return the final length of data transmit.
+  */
+static rt_ssize_t _serial_tx_each(struct rt_device                *dev,
+                                  const struct rt_serial_iovec    *iov,
+                                        int                        iovcnt,
+                                        rt_ssize_t               (*tx)(struct rt_device *dev,
+                                                                       rt_off_t pos,
+                                                                       const void *buffer,
+                                                                       rt_size_t size))
+{
+    rt_ssize_t total = 0, len;
+    int index;
+
+    for (index = 0; index < iovcnt; index++)
+    {
+        if (iov[index].len == 0) continue;
+
+        len = tx(dev, 0, iov[index].base, iov[index].len);
+        if (len <= 0) break;
+
+        total += len;
+        if ((rt_size_t)len < iov[index].len) break;
+    }
+
+    return total;
+}
+
+/**
+  * @brief Serial vectored transmit routine in tx_blocking mode with buffer.
+  *        The segments are gathered in the ringbuffer, one transmit() per ringbuffer fill.
+  * @return Return the final length of data transmit.
+  */
+static rt_ssize_t _serial_fifo_tx_blocking_bufv(struct rt_device                *dev,
+                                                const struct rt_serial_iovec    *iov,
+                                                      int                        iovcnt)
+{
+    struct rt_serial_device *serial;
+    struct rt_serial_tx_fifo *tx_fifo;
+    rt_size_t offset = 0, total = 0;
+    int index = 0;
+
+    serial = (struct rt_serial_device *)dev;
+    tx_fifo = (struct rt_serial_tx_fifo *) serial->serial_tx;
+
+    if (rt_thread_self() == RT_NULL || (serial->parent.open_flag & RT_DEVICE_FLAG_STREAM))
+    {
+        /* using poll tx when the scheduler not startup or in stream mode */
+        return _serial_tx_each(dev, iov, iovcnt, _serial_poll_tx);
+    }
+    /* When serial transmit in tx_blocking mode,
+     * if the activated mode is RT_TRUE, it will return directly */
+    if (tx_fifo->activated == RT_TRUE)  return 0;
+    tx_fifo->activated = RT_TRUE;
+
+    while (index < iovcnt)
+    {
+        tx_fifo->put_size = _serial_ring_putv(&(tx_fifo->rb), iov, iovcnt, &index, &offset);
+        if (tx_fifo->put_size == 0) break;
+
+        /* Call the transmit interface for transmission */
+        serial->ops->transmit(serial,
+                              tx_fifo->buffer,
+                              tx_fifo->put_size,
+                              RT_SERIAL_TX_BLOCKING);
+        total += tx_fifo->put_size;
+        /* Waiting for the transmission to complete */
+        rt_completion_wait(&(tx_fifo->tx_cpt), RT_WAITING_FOREVER);
+    }
+    /* Finally Inactivate the tx->fifo */
+    tx_fifo->activated = RT_FALSE;
+
+    return total;
+}
+
+/**
+  * @brief Serial vectored transmit routine in tx_nonblocking mode.
+  *        The segments are queued in one critical section, one transmit() starts them.
+  * @return Return the final length of data transmit.
+  */
+static rt_ssize_t _serial_fifo_tx_nonblockingv(struct rt_device                *dev,
+                                               const struct rt_serial_iovec    *iov,
+                                                     int                        iovcnt)
+{
+    struct rt_serial_device *serial;
+    struct rt_serial_tx_fifo *tx_fifo;
+    rt_size_t offset = 0, length;
+    rt_bool_t activated;
+    rt_base_t level;
+    int index = 0;
+
+    serial = (struct rt_serial_device *)dev;
+    tx_fifo = (struct rt_serial_tx_fifo *) serial->serial_tx;
+
+    level = rt_hw_interrupt_disable();
+    /* no other writer comes between the segments */
+    length = _serial_ring_putv(&(tx_fifo->rb), iov, iovcnt, &index, &offset);
+    activated = tx_fifo->activated;
+    if (length > 0)
+    {
+        tx_fifo->activated = RT_TRUE;
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (activated == RT_FALSE && length > 0)
+    {
+        _serial_fifo_tx_start(serial, tx_fifo);
+    }
+
+    return length;
+}
+
+/**
+  * @brief Write several buffers to the serial device with one call.
+  *        With a tx ringbuffer, the segments are queued back to back and the driver is started once;
+  *        otherwise they are sent one by one.
+  * @param serial RT-thread serial device.
+  * @param iov The segments.
+  * @param iovcnt The number of segments.
+  * @return Return the final length of data transmit, it is short when the tx ringbuffer is full
+  *         in tx_nonblocking mode.
+  */
+rt_ssize_t rt_serial_writev(struct rt_serial_device         *serial,
+                            const struct rt_serial_iovec    *iov,
+                                  int                        iovcnt)
+{
+    struct rt_device *dev;
+    struct rt_serial_tx_fifo *tx_fifo;
+
+    RT_ASSERT(serial != RT_NULL);
+    if (iovcnt <= 0) return 0;
+    RT_ASSERT(iov != RT_NULL);
+
+    dev = &(serial->parent);
+    tx_fifo = (struct rt_serial_tx_fifo *) serial->serial_tx;
+
+    if (serial->config.tx_bufsz == 0 || tx_fifo == RT_NULL)
+    {
+        return _serial_tx_each(dev, iov, iovcnt, _serial_poll_tx);
+    }
+
+    if (dev->open_flag & RT_SERIAL_TX_BLOCKING)
+    {
+        if ((tx_fifo->rb.buffer_ptr) == RT_NULL)
+        {
+            /* the driver sends from the buffer of the caller, one segment after another */
+            return _serial_tx_each(dev, iov, iovcnt, _serial_fifo_tx_blocking_nbuf);
+        }
+
+        return _serial_fifo_tx_blocking_bufv(dev, iov, iovcnt);
+    }
+
+    return _serial_fifo_tx_nonblockingv(dev, iov, iovcnt);
+}
+
 /**
   * @brief Enable serial transmit mode.
   * @param dev The pointer of device driver structure
@@ -1167,6 +1536,23 @@ static rt_err_t rt_serial_control(struct rt_device *dev,
             }
             break;
 
+        case RT_SERIAL_CTRL_WRITEV:
+            if (args != RT_NULL)
+            {
+                struct rt_serial_writev_args *writev_args = (struct rt_serial_writev_args *) args;
+
+                writev_args->result = rt_serial_writev(serial, writev_args->iov, writev_args->iovcnt);
+                if (writev_args->result < 0)
+                {
+                    ret = (rt_err_t)writev_args->result;
+                }
+            }
+            else
+            {
+                ret = -RT_EINVAL;
+            }
+            break;
+
         case RT_DEVICE_CTRL_CONSOLE_OFLAG:
             if (args)
             {
@@ -1622,15 +2008,8 @@ void rt_hw_serial_isr(struct rt_serial_device *serial, int event)
             if (rt_ringbuffer_data_len(&tx_fifo->rb))
             {
                 tx_fifo->activated = RT_TRUE;
-
-                rt_uint8_t *put_ptr  = RT_NULL;
-                /* Get the linear length buffer from rinbuffer */
-                tx_fifo->put_size = rt_serial_get_linear_buffer(&(tx_fifo->rb), &put_ptr);
                 /* Call the transmit interface for transmission again */
-                serial->ops->transmit(serial,
-                                    put_ptr,
-                                    tx_fifo->put_size,
-                                    RT_SERIAL_TX_NON_BLOCKING);
+                _serial_fifo_tx_start(serial, tx_fifo);
             }
 
             break;
@@ -317,7 +317,7 @@ long list_sem(void)
                     rt_kprintf("%-*.*s %03d %d:",
                                maxlen, RT_NAME_MAX,
                                sem->parent.parent.name,
-                               sem->value,
+                               (int)(sem->value & RT_SEM_VALUE_MAX),
                                rt_list_len(&sem->parent.suspend_thread));
                     rt_susp_list_print(&(sem->parent.suspend_thread));
                     rt_kprintf("\n");
@@ -327,7 +327,7 @@ long list_sem(void)
                     rt_kprintf("%-*.*s %03d %d\n",
                                maxlen, RT_NAME_MAX,
                                sem->parent.parent.name,
-                               sem->value,
+                               (int)(sem->value & RT_SEM_VALUE_MAX),
                                rt_list_len(&sem->parent.suspend_thread));
                 }
             }
@@ -8,6 +8,7 @@
  * 2013-03-30     Bernard      the first verion for finsh
  * 2014-01-03     Bernard      msh can execute module.
  * 2017-07-19     Aubr.Cool    limit argc to RT_FINSH_ARG_MAX
+ * 2026-10-18     Cc           add sorted command index
  */
 #include <rtthread.h>
 #include <string.h>
@@ -171,10 +172,125 @@ static int msh_split(char *cmd, rt_size_t length, char *argv[FINSH_ARG_MAX])
     return argc;
 }
 
-static cmd_function_t msh_get_cmd(char *cmd, int size)
+#ifdef FINSH_USING_CMD_INDEX
+/* the command table sorted by name, built once by msh_cmd_index_init() */
+static struct finsh_syscall **_cmd_index = RT_NULL;
+static int _cmd_index_nr = 0;
+
+/* compare a command name with the first size characters of cmd */
+static int _cmd_compare(const char *name, const char *cmd, int size)
+{
+    int result;
+
+    result = strncmp(name, cmd, size);
+    if (result == 0 && name[size] != '\0')
+        result = 1;
+
+    return result;
+}
+
+/* return the position of the first command not less than cmd */
+static int _cmd_lower_bound(const char *cmd, int size)
+{
+    int low = 0, high = _cmd_index_nr, mid;
+
+    while (low < high)
+    {
+        mid = low + (high - low) / 2;
+        if (_cmd_compare(_cmd_index[mid]->name, cmd, size) < 0)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+/**
+ * @brief Build the sorted command index used by the command lookup and the
+ *        auto completion.
+ *
+ * @note  Commands with the same name keep their table order, so the lookup
+ *        result is the same as the linear scan. Without the index (not built
+ *        yet or out of memory) the table is scanned linearly.
+ *
+ * @return RT_EOK on success, -RT_ENOMEM if the index can not be allocated.
+ */
+int msh_cmd_index_init(void)
 {
     struct finsh_syscall *index;
-    cmd_function_t cmd_func = RT_NULL;
+    struct finsh_syscall **table;
+    int nr = 0, count = 0, low, high, mid;
+
+    if (_cmd_index != RT_NULL)
+        return RT_EOK;
+
+    for (index = _syscall_table_begin;
+            index < _syscall_table_end;
+            FINSH_NEXT_SYSCALL(index))
+    {
+        nr++;
+    }
+
+    if (nr == 0)
+        return RT_EOK;
+
+    table = (struct finsh_syscall **)rt_malloc(nr * sizeof(struct finsh_syscall *));
+    if (table == RT_NULL)
+        return -RT_ENOMEM;
+
+    /* binary insertion after the equal names keeps the sort stable */
+    for (index = _syscall_table_begin;
+            index < _syscall_table_end;
+            FINSH_NEXT_SYSCALL(index))
+    {
+        low = 0;
+        high = count;
+        while (low < high)
+        {
+            mid = low + (high - low) / 2;
+            if (strcmp(table[mid]->name, index->name) <= 0)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+
+        rt_memmove(&table[low + 1], &table[low], (count - low) * sizeof(struct finsh_syscall *));
+        table[low] = index;
+        count++;
+    }
+
+    _cmd_index_nr = count;
+    _cmd_index = table;
+
+    return RT_EOK;
+}
+#endif /* FINSH_USING_CMD_INDEX */
+
+/**
+ * @brief Find a command in the command table.
+ *
+ * @param cmd is the command name, which need not be null-terminated.
+ *
+ * @param size is the length of the command name.
+ *
+ * @return the command entry or RT_NULL if there is no such command.
+ */
+struct finsh_syscall *msh_cmd_find(const char *cmd, int size)
+{
+    struct finsh_syscall *index;
+
+#ifdef FINSH_USING_CMD_INDEX
+    if (_cmd_index != RT_NULL)
+    {
+        int pos = _cmd_lower_bound(cmd, size);
+
+        if (pos < _cmd_index_nr && _cmd_compare(_cmd_index[pos]->name, cmd, size) == 0)
+            return _cmd_index[pos];
+
+        return RT_NULL;
+    }
+#endif /* FINSH_USING_CMD_INDEX */
 
     for (index = _syscall_table_begin;
             index < _syscall_table_end;
@@ -183,11 +299,24 @@ static cmd_function_t msh_get_cmd(char *cmd, int size)
         if (strncmp(index->name, cmd, size) == 0 &&
                 index->name[size] == '\0')
         {
-            cmd_func = (cmd_function_t)index->func;
-            break;
+            return index;
         }
     }
 
+    return RT_NULL;
+}
+
+static cmd_function_t msh_get_cmd(char *cmd, int size)
+{
+    struct finsh_syscall *index;
+    cmd_function_t cmd_func = RT_NULL;
+
+    index = msh_cmd_find(cmd, size);
+    if (index != RT_NULL)
+    {
+        cmd_func = (cmd_function_t)index->func;
+    }
+
     return cmd_func;
 }
 
@@ -717,6 +846,9 @@ void msh_auto_complete(char *prefix)
     int length, min_length;
     const char *name_ptr, *cmd_name;
     struct finsh_syscall *index;
+#ifdef FINSH_USING_CMD_INDEX
+    int pos, prefix_length;
+#endif /* FINSH_USING_CMD_INDEX */
 
     min_length = 0;
     name_ptr = RT_NULL;
@@ -755,6 +887,32 @@ void msh_auto_complete(char *prefix)
     }
 #endif /* DFS_USING_POSIX */
 
+#ifdef FINSH_USING_CMD_INDEX
+    /* the commands with this prefix are a contiguous range of the index */
+    if (_cmd_index != RT_NULL)
+    {
+        prefix_length = strlen(prefix);
+        for (pos = _cmd_lower_bound(prefix, prefix_length); pos < _cmd_index_nr; pos++)
+        {
+            cmd_name = (const char *) _cmd_index[pos]->name;
+            if (strncmp(prefix, cmd_name, prefix_length) != 0)
+                break;
+
+            if (min_length == 0)
+            {
+                name_ptr = cmd_name;
+                min_length = strlen(name_ptr);
+            }
+
+            length = str_common(name_ptr, cmd_name);
+            if (length < min_length)
+                min_length = length;
+
+            rt_kprintf("%s\n", cmd_name);
+        }
+    }
+    else
+#endif /* FINSH_USING_CMD_INDEX */
     /* checks in internal command */
     {
         for (index = _syscall_table_begin; index < _syscall_table_end; FINSH_NEXT_SYSCALL(index))
@@ -807,15 +965,10 @@ static msh_cmd_opt_t *msh_get_cmd_opt(char *opt_str)
         len = strlen(opt_str);
     }
 
-    for (index = _syscall_table_begin;
-            index < _syscall_table_end;
-            FINSH_NEXT_SYSCALL(index))
+    index = msh_cmd_find(opt_str, len);
+    if (index != RT_NULL)
     {
-        if (strncmp(index->name, opt_str, len) == 0 && index->name[len] == '\0')
-        {
-            opt = index->opt;
-            break;
-        }
+        opt = index->opt;
     }
 
     return opt;
@@ -13,8 +13,15 @@
 
 #include <rtthread.h>
 
+struct finsh_syscall;
+
 int msh_exec(char *cmd, rt_size_t length);
 void msh_auto_complete(char *prefix);
+struct finsh_syscall *msh_cmd_find(const char *cmd, int size);
+
+#ifdef FINSH_USING_CMD_INDEX
+int msh_cmd_index_init(void);
+#endif /* FINSH_USING_CMD_INDEX */
 
 int msh_exec_module(const char *cmd_line, int size);
 int msh_exec_script(const char *cmd_line, int size);
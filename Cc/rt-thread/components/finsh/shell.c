@@ -16,6 +16,7 @@
  *                             initialization when use GNU GCC compiler.
  * 2016-11-26     armink       add password authentication
  * 2018-07-02     aozima       add custom prompt support.
+ * 2026-10-18     Cc           build the command index at init
  */
 
 #include <rthw.h>
@@ -793,6 +794,12 @@ int finsh_system_init(void)
 
     finsh_system_function_init(ptr_begin, ptr_end);
 #endif
+#ifdef FINSH_USING_CMD_INDEX
+    if (msh_cmd_index_init() != RT_EOK)
+    {
+        rt_kprintf("no memory for command index\n");
+    }
+#endif /* FINSH_USING_CMD_INDEX */
 #endif
 
 #ifdef RT_USING_HEAP
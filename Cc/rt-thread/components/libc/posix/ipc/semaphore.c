@@ -172,7 +172,7 @@ int sem_getvalue(sem_t *sem, int *sval)
 
         return -1;
     }
-    *sval = sem->sem->value;
+    *sval = (int)(sem->sem->value & RT_SEM_VALUE_MAX);
 
     return 0;
 }
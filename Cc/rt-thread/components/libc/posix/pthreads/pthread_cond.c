@@ -252,7 +252,8 @@ rt_err_t _pthread_cond_timedwait(pthread_cond_t *cond,
         /* disable interrupt */
         temp = rt_hw_interrupt_disable();
 
-        if (sem->value > 0)
+        /* mask out the flag of pended threads kept by the fast path */
+        if ((sem->value & RT_SEM_VALUE_MAX) > 0)
         {
             /* semaphore is available */
             sem->value--;
@@ -286,6 +287,10 @@ rt_err_t _pthread_cond_timedwait(pthread_cond_t *cond,
 
                 /* Only support FIFO */
                 rt_list_insert_before(&(sem->parent.suspend_thread), &RT_THREAD_LIST_NODE(thread));
+#ifdef RT_USING_IPC_FAST_PATH
+                /* let rt_sem_release() take the slow path to wake us up */
+                sem->value = RT_SEM_FAST_WAITERS;
+#endif /* RT_USING_IPC_FAST_PATH */
 
                 /**
                 rt_ipc_list_suspend(&(sem->parent.suspend_thread),
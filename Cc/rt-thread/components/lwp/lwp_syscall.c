@@ -2700,7 +2700,7 @@ sysret_t sys_execve(const char *path, char *const argv[], char *const envp[])
          */
         RT_ASSERT(rt_list_entry(lwp->t_grp.prev, struct rt_thread, sibling) == thread);
 
-        strncpy(thread->parent.name, run_name + last_backslash, RT_NAME_MAX - 1);
+        rt_object_set_name(&thread->parent, run_name + last_backslash);
         strncpy(lwp->cmd, new_lwp->cmd, RT_NAME_MAX);
         rt_free(lwp->exe_file);
         lwp->exe_file = strndup(new_lwp->exe_file, DFS_PATH_MAX);
@@ -10,6 +10,7 @@
  *                             page management algorithm
  * 2023-02-20     WangXiaoyao  Multi-list page-management
  * 2023-11-28     Shell        Bugs fix for page_install on shadow region
+ * 2026-10-18     Cc           non-empty order bitmap, per-CPU hot page cache
  */
 #include <rtthread.h>
 
@@ -30,6 +31,7 @@
 
 RT_STATIC_ASSERT(order_huge_pg, RT_PAGE_MAX_ORDER > ARCH_PAGE_SHIFT - 2);
 RT_STATIC_ASSERT(size_width, sizeof(rt_size_t) == sizeof(void *));
+RT_STATIC_ASSERT(order_bitmap, RT_PAGE_MAX_ORDER <= sizeof(unsigned long) * 8);
 
 #ifdef RT_USING_SMART
 #include "lwp_arch_comm.h"
@@ -43,6 +45,9 @@ static struct rt_varea mpr_varea;
 
 static struct rt_page *page_list_low[RT_PAGE_MAX_ORDER];
 static struct rt_page *page_list_high[RT_PAGE_MAX_ORDER];
+/* bit n is set while page_list[n] is not empty */
+static unsigned long page_bitmap_low;
+static unsigned long page_bitmap_high;
 static RT_DEFINE_SPINLOCK(_spinlock);
 
 #define page_start ((rt_page_t)rt_mpr_start)
@@ -270,6 +275,19 @@ static inline struct rt_page *_buddy_get(struct rt_page *p,
     return rt_page_addr2page((void *)addr);
 }
 
+static inline unsigned long *_page_bitmap(rt_page_t page_list[])
+{
+    return page_list == page_list_high ? &page_bitmap_high : &page_bitmap_low;
+}
+
+/* the lowest order not below size_bits with a free block, -1 if none */
+static inline int _page_order_find(rt_page_t page_list[], rt_uint32_t size_bits)
+{
+    unsigned long mask = *_page_bitmap(page_list) & ~((1UL << size_bits) - 1);
+
+    return mask ? rt_hw_ctz(mask) : -1;
+}
+
 static void _page_remove(rt_page_t page_list[], struct rt_page *p, rt_uint32_t size_bits)
 {
     if (p->pre)
@@ -279,6 +297,10 @@ static void _page_remove(rt_page_t page_list[], struct rt_page *p, rt_uint32_t s
     else
     {
         page_list[size_bits] = p->next;
+        if (!p->next)
+        {
+            *_page_bitmap(page_list) &= ~(1UL << size_bits);
+        }
     }
 
     if (p->next)
@@ -299,6 +321,7 @@ static void _page_insert(rt_page_t page_list[], struct rt_page *p, rt_uint32_t s
     p->pre = 0;
     page_list[size_bits] = p;
     p->size_bits = size_bits;
+    *_page_bitmap(page_list) |= 1UL << size_bits;
 }
 
 static void _pages_ref_inc(struct rt_page *p, rt_uint32_t size_bits)
@@ -328,24 +351,12 @@ static int _pages_ref_get(struct rt_page *p, rt_uint32_t size_bits)
     return page_head->ref_cnt;
 }
 
-static int _pages_free(rt_page_t page_list[], struct rt_page *p, rt_uint32_t size_bits)
+/* give an unreferenced page group back to the buddy lists */
+static void _pages_merge(rt_page_t page_list[], struct rt_page *p, rt_uint32_t size_bits)
 {
     rt_uint32_t level = size_bits;
     struct rt_page *buddy;
 
-    RT_ASSERT(p >= page_start);
-    RT_ASSERT((char *)p < (char *)rt_mpr_start + rt_mpr_size);
-    RT_ASSERT(rt_kmem_v2p(p));
-    RT_ASSERT(p->ref_cnt > 0);
-    RT_ASSERT(p->size_bits == ARCH_ADDRESS_WIDTH_BITS);
-    RT_ASSERT(size_bits < RT_PAGE_MAX_ORDER);
-
-    p->ref_cnt--;
-    if (p->ref_cnt != 0)
-    {
-        return 0;
-    }
-
     while (level < RT_PAGE_MAX_ORDER - 1)
     {
         buddy = _buddy_get(p, level);
@@ -361,42 +372,45 @@ static int _pages_free(rt_page_t page_list[], struct rt_page *p, rt_uint32_t siz
         }
     }
     _page_insert(page_list, p, level);
+}
+
+static int _pages_free(rt_page_t page_list[], struct rt_page *p, rt_uint32_t size_bits)
+{
+    RT_ASSERT(p >= page_start);
+    RT_ASSERT((char *)p < (char *)rt_mpr_start + rt_mpr_size);
+    RT_ASSERT(rt_kmem_v2p(p));
+    RT_ASSERT(p->ref_cnt > 0);
+    RT_ASSERT(p->size_bits == ARCH_ADDRESS_WIDTH_BITS);
+    RT_ASSERT(size_bits < RT_PAGE_MAX_ORDER);
+
+    p->ref_cnt--;
+    if (p->ref_cnt != 0)
+    {
+        return 0;
+    }
+
+    _pages_merge(page_list, p, size_bits);
     return 1;
 }
 
 static struct rt_page *_pages_alloc(rt_page_t page_list[], rt_uint32_t size_bits)
 {
     struct rt_page *p;
+    int level;
 
-    if (page_list[size_bits])
+    level = _page_order_find(page_list, size_bits);
+    if (level < 0)
     {
-        p = page_list[size_bits];
-        _page_remove(page_list, p, size_bits);
+        return 0;
     }
-    else
-    {
-        rt_uint32_t level;
-
-        for (level = size_bits + 1; level < RT_PAGE_MAX_ORDER; level++)
-        {
-            if (page_list[level])
-            {
-                break;
-            }
-        }
-        if (level == RT_PAGE_MAX_ORDER)
-        {
-            return 0;
-        }
 
-        p = page_list[level];
-        _page_remove(page_list, p, level);
-        while (level > size_bits)
-        {
-            _page_insert(page_list, p, level - 1);
-            p = _buddy_get(p, level - 1);
-            level--;
-        }
+    p = page_list[level];
+    _page_remove(page_list, p, level);
+    while (level > size_bits)
+    {
+        _page_insert(page_list, p, level - 1);
+        p = _buddy_get(p, level - 1);
+        level--;
     }
     p->size_bits = ARCH_ADDRESS_WIDTH_BITS;
     p->ref_cnt = 1;
@@ -414,6 +428,10 @@ static void _early_page_remove(rt_page_t page_list[], rt_page_t page, rt_uint32_
     else
     {
         page_list[size_bits] = page_cont->next;
+        if (!page_cont->next)
+        {
+            *_page_bitmap(page_list) &= ~(1UL << size_bits);
+        }
     }
 
     if (page_cont->next)
@@ -440,41 +458,27 @@ static void _early_page_insert(rt_page_t page_list[], rt_page_t page, int size_b
     page_cont->pre = 0;
     page_list[size_bits] = page;
     page_cont->size_bits = size_bits;
+    *_page_bitmap(page_list) |= 1UL << size_bits;
 }
 
 static struct rt_page *_early_pages_alloc(rt_page_t page_list[], rt_uint32_t size_bits)
 {
     struct rt_page *p;
+    int level;
 
-    if (page_list[size_bits])
+    level = _page_order_find(page_list, size_bits);
+    if (level < 0)
     {
-        p = page_list[size_bits];
-        _early_page_remove(page_list, p, size_bits);
+        return 0;
     }
-    else
-    {
-        rt_uint32_t level;
-
-        for (level = size_bits + 1; level < RT_PAGE_MAX_ORDER; level++)
-        {
-            if (page_list[level])
-            {
-                break;
-            }
-        }
-        if (level == RT_PAGE_MAX_ORDER)
-        {
-            return 0;
-        }
 
-        p = page_list[level];
-        _early_page_remove(page_list, p, level);
-        while (level > size_bits)
-        {
-            _early_page_insert(page_list, p, level - 1);
-            p = _buddy_get(p, level - 1);
-            level--;
-        }
+    p = page_list[level];
+    _early_page_remove(page_list, p, level);
+    while (level > size_bits)
+    {
+        _early_page_insert(page_list, p, level - 1);
+        p = _buddy_get(p, level - 1);
+        level--;
     }
     rt_page_t page_cont = (rt_page_t)((char *)p + early_offset);
     page_cont->size_bits = ARCH_ADDRESS_WIDTH_BITS;
@@ -540,16 +544,191 @@ static rt_page_t *_flag_to_page_list(size_t flags)
     return page_list;
 }
 
+#if defined(RT_PAGE_USING_HOT_CACHE) && !defined(RT_DEBUGING_PAGE_LEAK)
+#define PAGE_HOT_CACHE
+
+/*
+ * Per-CPU cache of single pages of the lower region. A cached page keeps
+ * the allocated mark with no reference, so the buddy merge leaves it alone.
+ * The cache of a CPU is touched with its local interrupts disabled, and on
+ * SMP under its own lock, which is only contended when a failing allocation
+ * flushes the caches of all CPUs. The page lock is taken once per batch to
+ * refill or drain a cache.
+ */
+struct _page_hot_cache
+{
+#ifdef RT_USING_SMP
+    struct rt_spinlock lock;
+#endif /* RT_USING_SMP */
+    rt_uint32_t count;
+    rt_page_t pages[RT_PAGE_HOT_CACHE_SIZE];
+};
+
+static struct _page_hot_cache _hot_cache[RT_CPUS_NR];
+
+#ifdef RT_USING_SMP
+#define _hot_cache_self()       (&_hot_cache[rt_hw_cpu_id()])
+#define _hot_cache_lock(c)      rt_spin_lock(&(c)->lock)
+#define _hot_cache_unlock(c)    rt_spin_unlock(&(c)->lock)
+#else
+#define _hot_cache_self()       (&_hot_cache[0])
+#define _hot_cache_lock(c)
+#define _hot_cache_unlock(c)
+#endif /* RT_USING_SMP */
+
+static void _hot_cache_init(void)
+{
+    int i;
+
+    for (i = 0; i < RT_CPUS_NR; i++)
+    {
+        _hot_cache[i].count = 0;
+#ifdef RT_USING_SMP
+        rt_spin_lock_init(&_hot_cache[i].lock);
+#endif /* RT_USING_SMP */
+    }
+}
+
+static rt_page_t _hot_cache_alloc(void)
+{
+    struct _page_hot_cache *cache;
+    rt_page_t p = RT_NULL;
+    rt_base_t level;
+
+    level = rt_hw_local_irq_disable();
+    cache = _hot_cache_self();
+    _hot_cache_lock(cache);
+    if (cache->count == 0)
+    {
+        rt_spin_lock(&_spinlock);
+        while (cache->count < RT_PAGE_HOT_CACHE_BATCH)
+        {
+            p = _pages_alloc(page_list_low, 0);
+            if (!p)
+            {
+                break;
+            }
+            p->ref_cnt = 0;
+            cache->pages[cache->count++] = p;
+        }
+        rt_spin_unlock(&_spinlock);
+    }
+
+    if (cache->count)
+    {
+        p = cache->pages[--cache->count];
+        p->ref_cnt = 1;
+    }
+    _hot_cache_unlock(cache);
+    rt_hw_local_irq_enable(level);
+
+    return p;
+}
+
+static rt_bool_t _hot_cache_free(rt_page_t p)
+{
+    struct _page_hot_cache *cache;
+    rt_base_t level;
+    int i;
+
+    /* a shared page drops its reference under the page lock */
+    if (p->ref_cnt != 1)
+    {
+        return RT_FALSE;
+    }
+    RT_ASSERT(p->size_bits == ARCH_ADDRESS_WIDTH_BITS);
+
+    level = rt_hw_local_irq_disable();
+    cache = _hot_cache_self();
+    _hot_cache_lock(cache);
+    if (cache->count == RT_PAGE_HOT_CACHE_SIZE)
+    {
+        /* drain the coldest batch, the bottom of the stack */
+        rt_spin_lock(&_spinlock);
+        for (i = 0; i < RT_PAGE_HOT_CACHE_BATCH; i++)
+        {
+            _pages_merge(page_list_low, cache->pages[i], 0);
+        }
+        rt_spin_unlock(&_spinlock);
+
+        cache->count -= RT_PAGE_HOT_CACHE_BATCH;
+        rt_memmove(&cache->pages[0], &cache->pages[RT_PAGE_HOT_CACHE_BATCH],
+                   cache->count * sizeof(rt_page_t));
+    }
+    p->ref_cnt = 0;
+    cache->pages[cache->count++] = p;
+    _hot_cache_unlock(cache);
+    rt_hw_local_irq_enable(level);
+
+    return RT_TRUE;
+}
+
+/* give the pages of all hot caches back to the buddy lists, returns how many */
+static rt_size_t _hot_cache_flush(void)
+{
+    struct _page_hot_cache *cache;
+    rt_size_t count = 0;
+    rt_base_t level;
+    rt_uint32_t j;
+    int i;
+
+    for (i = 0; i < RT_CPUS_NR; i++)
+    {
+        cache = &_hot_cache[i];
+
+        level = rt_hw_local_irq_disable();
+        _hot_cache_lock(cache);
+        if (cache->count)
+        {
+            rt_spin_lock(&_spinlock);
+            for (j = 0; j < cache->count; j++)
+            {
+                _pages_merge(page_list_low, cache->pages[j], 0);
+            }
+            rt_spin_unlock(&_spinlock);
+
+            count += cache->count;
+            cache->count = 0;
+        }
+        _hot_cache_unlock(cache);
+        rt_hw_local_irq_enable(level);
+    }
+    return count;
+}
+
+/* pages held by the hot caches, counted as free */
+static rt_size_t _hot_cache_count(void)
+{
+    rt_size_t count = 0;
+    int i;
+
+    for (i = 0; i < RT_CPUS_NR; i++)
+    {
+        count += _hot_cache[i].count;
+    }
+    return count;
+}
+#endif /* defined(RT_PAGE_USING_HOT_CACHE) && !defined(RT_DEBUGING_PAGE_LEAK) */
+
 rt_inline void *_do_pages_alloc(rt_uint32_t size_bits, size_t flags)
 {
     void *alloc_buf = RT_NULL;
-    struct rt_page *p;
+    struct rt_page *p = RT_NULL;
     rt_base_t level;
     rt_page_t *page_list = _flag_to_page_list(flags);
 
-    level = rt_spin_lock_irqsave(&_spinlock);
-    p = pages_alloc_handler(page_list, size_bits);
-    rt_spin_unlock_irqrestore(&_spinlock, level);
+#ifdef PAGE_HOT_CACHE
+    if (size_bits == 0 && page_list == page_list_low && pages_alloc_handler == _pages_alloc)
+    {
+        p = _hot_cache_alloc();
+    }
+    if (!p)
+#endif /* PAGE_HOT_CACHE */
+    {
+        level = rt_spin_lock_irqsave(&_spinlock);
+        p = pages_alloc_handler(page_list, size_bits);
+        rt_spin_unlock_irqrestore(&_spinlock, level);
+    }
 
     if (!p && page_list != page_list_low)
     {
@@ -561,6 +740,16 @@ rt_inline void *_do_pages_alloc(rt_uint32_t size_bits, size_t flags)
         rt_spin_unlock_irqrestore(&_spinlock, level);
     }
 
+#ifdef PAGE_HOT_CACHE
+    /* the single pages parked in the hot caches may be what the lower region misses */
+    if (!p && pages_alloc_handler == _pages_alloc && _hot_cache_flush())
+    {
+        level = rt_spin_lock_irqsave(&_spinlock);
+        p = pages_alloc_handler(page_list_low, size_bits);
+        rt_spin_unlock_irqrestore(&_spinlock, level);
+    }
+#endif /* PAGE_HOT_CACHE */
+
     if (p)
     {
         alloc_buf = page_to_addr(p);
@@ -594,6 +783,15 @@ int rt_pages_free(void *addr, rt_uint32_t size_bits)
     if (p)
     {
         rt_base_t level;
+
+#ifdef PAGE_HOT_CACHE
+        if (size_bits == 0 && page_list == page_list_low &&
+            pages_alloc_handler == _pages_alloc && _hot_cache_free(p))
+        {
+            return 1;
+        }
+#endif /* PAGE_HOT_CACHE */
+
         level = rt_spin_lock_irqsave(&_spinlock);
         real_free = _pages_free(page_list, p, size_bits);
         if (real_free)
@@ -640,6 +838,10 @@ void list_page(void)
     }
 
     rt_spin_unlock_irqrestore(&_spinlock, level);
+#ifdef PAGE_HOT_CACHE
+    rt_kprintf("hot cache %ld\n", _hot_cache_count());
+    free += _hot_cache_count();
+#endif /* PAGE_HOT_CACHE */
     rt_kprintf("-------------------------------\n");
     rt_kprintf("Page Summary:\n => free/installed: 0x%lx/0x%lx (%ld/%ld KB)\n", free, installed, PGNR2SIZE(free), PGNR2SIZE(installed));
     rt_kprintf("-------------------------------\n");
@@ -674,6 +876,9 @@ void rt_page_get_info(rt_size_t *total_nr, rt_size_t *free_nr)
         }
     }
     rt_spin_unlock_irqrestore(&_spinlock, level);
+#ifdef PAGE_HOT_CACHE
+    total_free += _hot_cache_count();
+#endif /* PAGE_HOT_CACHE */
     *total_nr = page_nr;
     *free_nr = total_free;
 }
@@ -788,6 +993,11 @@ void rt_page_init(rt_region_t reg)
         page_list_low[i] = 0;
         page_list_high[i] = 0;
     }
+    page_bitmap_low = 0;
+    page_bitmap_high = 0;
+#ifdef PAGE_HOT_CACHE
+    _hot_cache_init();
+#endif /* PAGE_HOT_CACHE */
 
     /* map MPR area */
     err = rt_aspace_map_static(&rt_kernel_space, &mpr_varea, &rt_mpr_start,
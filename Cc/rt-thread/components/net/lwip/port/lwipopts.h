@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2022-02-23     Meco Man     integrate v1.4.1 v2.0.3 and v2.1.2 porting layer
  * 2022-02-25     xiangxistu   modify the default config through v1.4.1
+ * 2026-10-18     Cc           take the lwIP heap from DMA capable memory
  */
 
 #ifndef __LWIPOPTS_H__
@@ -284,6 +285,14 @@
 //#define MEMP_USE_CUSTOM_POOLS       1
 //#define MEM_SIZE                    (1024*64)
 
+#ifdef RT_LWIP_USING_MEM_HINT
+/* the lwIP heap is taken from the DMA capable memory class of the system heap */
+#define MEM_LIBC_MALLOC             1
+#define mem_clib_malloc(size)       rt_malloc_hint(size, RT_MEM_DMA)
+#define mem_clib_free               rt_free
+#define mem_clib_calloc(n, size)    rt_calloc_hint(n, size, RT_MEM_DMA)
+#endif /* RT_LWIP_USING_MEM_HINT */
+
 #define MEMP_MEM_MALLOC             0
 
 /* MEMP_NUM_PBUF: the number of memp struct pbufs. If the application
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#ifndef __CRC_H__
+#define __CRC_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The CRC algorithms, with their parameters and the CRC of "123456789"
+ */
+enum rt_crc_type
+{
+    RT_CRC_8,           /**< CRC-8/SMBUS: poly 0x07, init 0, not reflected, check 0xF4 */
+    RT_CRC_16,          /**< CRC-16/XMODEM: poly 0x1021, init 0, not reflected, check 0x31C3 */
+    RT_CRC_32,          /**< CRC-32/ISO-HDLC: poly 0x04C11DB7, init and xorout ~0, reflected, check 0xCBF43926 */
+    RT_CRC_32C,         /**< CRC-32C/Castagnoli: poly 0x1EDC6F41, init and xorout ~0, reflected, check 0xE3069283 */
+    RT_CRC_TYPE_NR
+};
+
+/*
+ * Each function takes the CRC of the data before, 0 at the start of a stream,
+ * and returns the CRC of all the data so far.
+ */
+rt_uint8_t rt_crc8(rt_uint8_t crc, const void *data, rt_size_t len);
+rt_uint16_t rt_crc16(rt_uint16_t crc, const void *data, rt_size_t len);
+rt_uint32_t rt_crc32(rt_uint32_t crc, const void *data, rt_size_t len);
+rt_uint32_t rt_crc32c(rt_uint32_t crc, const void *data, rt_size_t len);
+rt_uint32_t rt_crc(enum rt_crc_type type, rt_uint32_t crc, const void *data, rt_size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CRC_H__ */
@@ -0,0 +1,557 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+/*
+ * Allocation call-site profiler of the system heap.
+ *
+ * rt_malloc, rt_realloc, rt_calloc and rt_free report every block with the
+ * return address of their caller. The call sites are kept in a hash table of
+ * RT_HEAP_PROF_SITE_NR entries and the live blocks in a hash table of
+ * RT_HEAP_PROF_LIVE_NR entries. Both use linear probing limited to
+ * RT_HEAP_PROF_PROBE slots, so the cost of an event is bounded and the
+ * profiler never allocates memory itself:
+ *  - a call site not placed within the window is accounted to the overflow
+ *    site at index 0;
+ *  - a block not placed within the window is counted in allocs and bytes,
+ *    but neither in the live bytes nor the lifetimes, and it is reported as
+ *    dropped.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <heap_prof.h>
+
+#ifdef DFS_USING_POSIX
+#include <dfs_file.h>
+#include <unistd.h>
+#endif /* DFS_USING_POSIX */
+
+#define DBG_TAG    "heap.prof"
+#define DBG_LVL    DBG_INFO
+#include <rtdbg.h>
+
+#define HEAP_PROF_SITE_OTHER    0
+
+/**
+ * A block allocated while the profiler runs
+ */
+struct heap_prof_live
+{
+    void           *ptr;                        /**< the block, RT_NULL for a free slot */
+    rt_size_t       size;                       /**< requested size */
+    rt_tick_t       tick;                       /**< tick of the allocation */
+    rt_uint32_t     site;                       /**< index of the call site */
+};
+
+static struct heap_prof_site _sites[RT_HEAP_PROF_SITE_NR];
+static struct heap_prof_live _lives[RT_HEAP_PROF_LIVE_NR];
+static rt_uint32_t _dropped;
+static volatile rt_bool_t _running;
+static struct rt_spinlock _lock = RT_SPINLOCK_INIT;
+
+/* Fibonacci hashing, the low bits of an address carry little information */
+rt_inline rt_uint32_t _hash(rt_ubase_t value)
+{
+    rt_uint32_t hash = (rt_uint32_t)(value >> 2) * 2654435761u;
+
+    return hash ^ (hash >> 16);
+}
+
+static rt_uint32_t _site_get(rt_ubase_t caller)
+{
+    rt_uint32_t index;
+    int probe;
+
+    if (caller == 0)
+        return HEAP_PROF_SITE_OTHER;
+
+    /* sites are never removed while running, the first free slot ends the search */
+    index = 1 + _hash(caller) % (RT_HEAP_PROF_SITE_NR - 1);
+    for (probe = 0; probe < RT_HEAP_PROF_PROBE; probe++)
+    {
+        if (_sites[index].caller == caller)
+            return index;
+        if (_sites[index].caller == 0)
+        {
+            _sites[index].caller = caller;
+            return index;
+        }
+        if (++index == RT_HEAP_PROF_SITE_NR)
+            index = 1;
+    }
+
+    return HEAP_PROF_SITE_OTHER;
+}
+
+static struct heap_prof_live *_live_find(void *ptr)
+{
+    rt_uint32_t index;
+    int probe;
+
+    /* free slots do not end the search, the whole window is scanned */
+    index = _hash((rt_ubase_t)ptr) % RT_HEAP_PROF_LIVE_NR;
+    for (probe = 0; probe < RT_HEAP_PROF_PROBE; probe++)
+    {
+        if (_lives[index].ptr == ptr)
+            return &_lives[index];
+        if (++index == RT_HEAP_PROF_LIVE_NR)
+            index = 0;
+    }
+
+    return RT_NULL;
+}
+
+static void _live_retire(struct heap_prof_live *live)
+{
+    struct heap_prof_site *site = &_sites[live->site];
+    rt_tick_t life = rt_tick_get() - live->tick;
+
+    site->frees++;
+    site->live_bytes -= live->size;
+    site->life_sum += life;
+    if (life > site->life_max)
+        site->life_max = life;
+
+    live->ptr = RT_NULL;
+}
+
+static void _record_alloc(void *ptr, rt_size_t size, rt_ubase_t caller)
+{
+    struct heap_prof_live *slot = RT_NULL;
+    struct heap_prof_site *site;
+    rt_uint32_t index, site_index;
+    int probe;
+
+    site_index = _site_get(caller);
+    site = &_sites[site_index];
+    site->allocs++;
+    site->bytes += size;
+
+    index = _hash((rt_ubase_t)ptr) % RT_HEAP_PROF_LIVE_NR;
+    for (probe = 0; probe < RT_HEAP_PROF_PROBE; probe++)
+    {
+        /* a stale entry, the block was released behind the profiler */
+        if (_lives[index].ptr == ptr)
+            _live_retire(&_lives[index]);
+        if (_lives[index].ptr == RT_NULL && slot == RT_NULL)
+            slot = &_lives[index];
+        if (++index == RT_HEAP_PROF_LIVE_NR)
+            index = 0;
+    }
+
+    if (slot == RT_NULL)
+    {
+        _dropped++;
+        return;
+    }
+
+    slot->ptr  = ptr;
+    slot->size = size;
+    slot->tick = rt_tick_get();
+    slot->site = site_index;
+
+    site->live_bytes += size;
+    if (site->live_bytes > site->peak_bytes)
+        site->peak_bytes = site->live_bytes;
+}
+
+/**
+ * @brief This function records a block allocated from the system heap.
+ *
+ * @param ptr the allocated block.
+ *
+ * @param size the requested size.
+ *
+ * @param caller the return address of the allocation call.
+ */
+void rt_heap_prof_alloc(void *ptr, rt_size_t size, void *caller)
+{
+    rt_base_t level;
+
+    if (!_running || ptr == RT_NULL)
+        return;
+
+    level = rt_spin_lock_irqsave(&_lock);
+    _record_alloc(ptr, size, (rt_ubase_t)caller);
+    rt_spin_unlock_irqrestore(&_lock, level);
+}
+
+/**
+ * @brief This function records a block released to the system heap.
+ *
+ * @param ptr the released block.
+ */
+void rt_heap_prof_free(void *ptr)
+{
+    struct heap_prof_live *live;
+    rt_base_t level;
+
+    if (!_running || ptr == RT_NULL)
+        return;
+
+    level = rt_spin_lock_irqsave(&_lock);
+    live = _live_find(ptr);
+    if (live != RT_NULL)
+        _live_retire(live);
+    rt_spin_unlock_irqrestore(&_lock, level);
+}
+
+/**
+ * @brief This function records a block resized by rt_realloc.
+ *
+ * @param ptr the block before the call.
+ *
+ * @param nptr the block returned by the call.
+ *
+ * @param size the requested size.
+ *
+ * @param caller the return address of the realloc call.
+ */
+void rt_heap_prof_realloc(void *ptr, void *nptr, rt_size_t size, void *caller)
+{
+    struct heap_prof_live *live;
+    rt_base_t level;
+
+    /* a failed call leaves the old block untouched */
+    if (!_running || (nptr == RT_NULL && size != 0))
+        return;
+
+    level = rt_spin_lock_irqsave(&_lock);
+    if (ptr != RT_NULL)
+    {
+        live = _live_find(ptr);
+        if (live != RT_NULL)
+            _live_retire(live);
+    }
+    if (nptr != RT_NULL)
+        _record_alloc(nptr, size, (rt_ubase_t)caller);
+    rt_spin_unlock_irqrestore(&_lock, level);
+}
+
+/**
+ * @brief This function clears the statistics and starts profiling.
+ *
+ * @note  Blocks allocated before the start are not tracked.
+ */
+void heap_prof_start(void)
+{
+    rt_base_t level;
+
+    level = rt_spin_lock_irqsave(&_lock);
+    rt_memset(_sites, 0, sizeof(_sites));
+    rt_memset(_lives, 0, sizeof(_lives));
+    _dropped = 0;
+    _running = RT_TRUE;
+    rt_spin_unlock_irqrestore(&_lock, level);
+}
+RTM_EXPORT(heap_prof_start);
+
+/**
+ * @brief This function stops profiling, the statistics are kept.
+ */
+void heap_prof_stop(void)
+{
+    _running = RT_FALSE;
+}
+RTM_EXPORT(heap_prof_stop);
+
+/**
+ * @brief This function tells whether the profiler is running.
+ *
+ * @return RT_TRUE if it is running.
+ */
+rt_bool_t heap_prof_is_running(void)
+{
+    return _running;
+}
+RTM_EXPORT(heap_prof_is_running);
+
+/**
+ * @brief This function gets the statistics of a call site.
+ *
+ * @param index the index in the site table, 0 is the overflow site.
+ *
+ * @param site the buffer receiving the statistics.
+ *
+ * @return RT_EOK on success, -RT_EEMPTY if no allocation was made from the
+ *         slot, -RT_EINVAL if the index is out of the table.
+ */
+rt_err_t heap_prof_get_site(int index, struct heap_prof_site *site)
+{
+    rt_base_t level;
+
+    RT_ASSERT(site != RT_NULL);
+
+    if (index < 0 || index >= RT_HEAP_PROF_SITE_NR)
+        return -RT_EINVAL;
+
+    level = rt_spin_lock_irqsave(&_lock);
+    *site = _sites[index];
+    rt_spin_unlock_irqrestore(&_lock, level);
+
+    return site->allocs ? RT_EOK : -RT_EEMPTY;
+}
+RTM_EXPORT(heap_prof_get_site);
+
+/**
+ * @brief This function gets the number of allocations which found no free
+ *        slot in the live block table.
+ *
+ * @return the number of dropped allocations.
+ */
+rt_uint32_t heap_prof_get_dropped(void)
+{
+    return _dropped;
+}
+RTM_EXPORT(heap_prof_get_dropped);
+
+/**
+ * @brief This function gets the fragmentation of the system heap.
+ *
+ * @note  The index is 100 * (1 - largest free block / free bytes): 0 when the
+ *        free memory is one block, close to 100 when it is scattered.
+ *
+ * @param frag the buffer receiving the fragmentation.
+ */
+void heap_prof_get_frag(struct heap_prof_frag *frag)
+{
+    rt_size_t total = 0, used = 0, free;
+
+    RT_ASSERT(frag != RT_NULL);
+
+    rt_memory_info(&total, &used, RT_NULL);
+    frag->total    = total;
+    frag->used     = used;
+    frag->max_free = rt_memory_max_free();
+
+    free = total > used ? total - used : 0;
+    if (frag->max_free == 0 || free == 0)
+        frag->index = -1;
+    else if (frag->max_free >= free)
+        frag->index = 0;
+    else
+        frag->index = (int)(100 - (rt_uint64_t)frag->max_free * 100 / free);
+}
+RTM_EXPORT(heap_prof_get_frag);
+
+#if defined(DFS_USING_POSIX) || defined(RT_USING_FINSH)
+/* feed the export to the emitter, header first, then one record per site */
+static rt_err_t _export(rt_err_t (*emit)(const void *buf, rt_size_t len, void *arg), void *arg)
+{
+    struct heap_prof_header header;
+    struct heap_prof_record record;
+    struct heap_prof_site site;
+    struct heap_prof_frag frag;
+    rt_size_t max_used = 0;
+    rt_err_t result;
+    int index;
+
+    rt_memset(&header, 0, sizeof(header));
+    for (index = 0; index < RT_HEAP_PROF_SITE_NR; index++)
+    {
+        if (_sites[index].allocs != 0)
+            header.site_nr++;
+    }
+    heap_prof_get_frag(&frag);
+    rt_memory_info(RT_NULL, RT_NULL, &max_used);
+
+    header.magic           = HEAP_PROF_MAGIC;
+    header.version         = HEAP_PROF_VERSION;
+    header.flags           = _running ? HEAP_PROF_FLAG_RUNNING : 0;
+    header.tick_per_second = RT_TICK_PER_SECOND;
+    header.tick            = rt_tick_get();
+    header.dropped         = _dropped;
+    header.total           = frag.total;
+    header.used            = frag.used;
+    header.max_used        = max_used;
+    header.max_free        = frag.max_free;
+    result = emit(&header, sizeof(header), arg);
+
+    for (index = 0; index < RT_HEAP_PROF_SITE_NR && result == RT_EOK; index++)
+    {
+        if (heap_prof_get_site(index, &site) != RT_EOK)
+            continue;
+
+        /* a site filled while exporting is left out, the count stays right */
+        if (header.site_nr-- == 0)
+            break;
+
+        rt_memset(&record, 0, sizeof(record));
+        record.caller     = site.caller;
+        record.bytes      = site.bytes;
+        record.live_bytes = site.live_bytes;
+        record.peak_bytes = site.peak_bytes;
+        record.life_sum   = site.life_sum;
+        record.allocs     = site.allocs;
+        record.frees      = site.frees;
+        record.life_max   = site.life_max;
+        result = emit(&record, sizeof(record), arg);
+    }
+
+    return result;
+}
+#endif /* defined(DFS_USING_POSIX) || defined(RT_USING_FINSH) */
+
+#ifdef DFS_USING_POSIX
+static rt_err_t _export_file(const void *buf, rt_size_t len, void *arg)
+{
+    return write(*(int *)arg, buf, len) == (ssize_t)len ? RT_EOK : -RT_EIO;
+}
+
+/**
+ * @brief This function writes the statistics to a file, in the format read by
+ *        tools/heapprof.py.
+ *
+ * @param path the path of the file.
+ *
+ * @return RT_EOK on success, -RT_EIO if the file can not be written.
+ */
+rt_err_t heap_prof_export(const char *path)
+{
+    rt_err_t result;
+    int fd;
+
+    RT_ASSERT(path != RT_NULL);
+
+    fd = open(path, O_CREAT | O_WRONLY | O_TRUNC, 0);
+    if (fd < 0)
+        return -RT_EIO;
+
+    result = _export(_export_file, &fd);
+    close(fd);
+
+    return result;
+}
+RTM_EXPORT(heap_prof_export);
+#endif /* DFS_USING_POSIX */
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+#include <stdlib.h>
+
+static rt_err_t _export_console(const void *buf, rt_size_t len, void *arg)
+{
+    const rt_uint8_t *bytes = (const rt_uint8_t *)buf;
+    rt_size_t index;
+
+    /* one chunk per line, the host picks the lines out of the console log */
+    rt_kprintf("hprf:");
+    for (index = 0; index < len; index++)
+        rt_kprintf("%02x", bytes[index]);
+    rt_kprintf("\n");
+
+    return RT_EOK;
+}
+
+static void _show_frag(void)
+{
+    struct heap_prof_frag frag;
+
+    heap_prof_get_frag(&frag);
+    rt_kprintf("heap: total %d, used %d, free %d, largest free %d, ",
+               frag.total, frag.used, frag.total - frag.used, frag.max_free);
+    if (frag.index < 0)
+        rt_kprintf("fragmentation unknown\n");
+    else
+        rt_kprintf("fragmentation %d%%\n", frag.index);
+}
+
+static void _show_sites(int max_nr)
+{
+    rt_uint16_t order[RT_HEAP_PROF_SITE_NR];
+    struct heap_prof_site site;
+    int index, nr = 0, pos;
+    rt_uint32_t avg;
+
+    /* sort the sites by bytes allocated, the table is read without the lock */
+    for (index = 0; index < RT_HEAP_PROF_SITE_NR; index++)
+    {
+        if (_sites[index].allocs == 0)
+            continue;
+        for (pos = nr; pos > 0 && _sites[order[pos - 1]].bytes < _sites[index].bytes; pos--)
+            order[pos] = order[pos - 1];
+        order[pos] = index;
+        nr++;
+    }
+
+    rt_kprintf("caller     allocs     frees      bytes      live       peak       life avg   life max\n");
+    rt_kprintf("---------- ---------- ---------- ---------- ---------- ---------- ---------- ----------\n");
+    for (pos = 0; pos < nr && pos < max_nr; pos++)
+    {
+        if (heap_prof_get_site(order[pos], &site) != RT_EOK)
+            continue;
+
+        avg = site.frees ? (rt_uint32_t)(site.life_sum / site.frees) : 0;
+        if (site.caller == 0)
+            rt_kprintf("%-10s ", "(other)");
+        else
+            rt_kprintf("0x%08lx ", (unsigned long)site.caller);
+        rt_kprintf("%-10u %-10u %-10lu %-10lu %-10lu %-10u %-10u\n",
+                   site.allocs, site.frees, (unsigned long)site.bytes,
+                   (unsigned long)site.live_bytes, (unsigned long)site.peak_bytes,
+                   avg, site.life_max);
+    }
+    rt_kprintf("%d sites, %u dropped, lifetimes in ticks, profiler %s\n",
+               nr, _dropped, _running ? "running" : "stopped");
+}
+
+static int heapprof(int argc, char **argv)
+{
+    if (argc < 2)
+        goto __usage;
+
+    if (rt_strcmp(argv[1], "start") == 0)
+    {
+        heap_prof_start();
+    }
+    else if (rt_strcmp(argv[1], "stop") == 0)
+    {
+        heap_prof_stop();
+    }
+    else if (rt_strcmp(argv[1], "show") == 0)
+    {
+        _show_frag();
+        _show_sites(argc > 2 ? atoi(argv[2]) : RT_HEAP_PROF_SITE_NR);
+    }
+    else if (rt_strcmp(argv[1], "frag") == 0)
+    {
+        _show_frag();
+    }
+    else if (rt_strcmp(argv[1], "export") == 0)
+    {
+#ifdef DFS_USING_POSIX
+        if (argc > 2)
+        {
+            if (heap_prof_export(argv[2]) != RT_EOK)
+                rt_kprintf("write %s failed\n", argv[2]);
+            return 0;
+        }
+#endif /* DFS_USING_POSIX */
+        _export(_export_console, RT_NULL);
+    }
+    else
+    {
+        goto __usage;
+    }
+
+    return 0;
+
+__usage:
+    rt_kprintf("Usage:\n");
+    rt_kprintf("heapprof start          - clear the statistics and start profiling\n");
+    rt_kprintf("heapprof stop           - stop profiling\n");
+    rt_kprintf("heapprof show [n]       - show the n call sites allocating the most\n");
+    rt_kprintf("heapprof frag           - show the fragmentation of the heap\n");
+    rt_kprintf("heapprof export [file]  - export the statistics to a file or the console\n");
+
+    return 0;
+}
+MSH_CMD_EXPORT(heapprof, heap allocation profiler);
+#endif /* RT_USING_FINSH */
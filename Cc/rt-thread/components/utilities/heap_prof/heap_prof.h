@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#ifndef __HEAP_PROF_H__
+#define __HEAP_PROF_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HEAP_PROF_MAGIC         0x46525048      /* "HPRF" */
+#define HEAP_PROF_VERSION       1
+
+/* flags of the export header */
+#define HEAP_PROF_FLAG_RUNNING  0x0001          /* the profiler was running */
+
+/**
+ * Statistics of one allocation call site
+ */
+struct heap_prof_site
+{
+    rt_ubase_t      caller;                     /**< return address of the call, 0 for the overflow site */
+    rt_uint32_t     allocs;                     /**< number of allocations */
+    rt_uint32_t     frees;                      /**< number of tracked releases */
+    rt_uint64_t     bytes;                      /**< bytes allocated in total */
+    rt_size_t       live_bytes;                 /**< bytes still allocated */
+    rt_size_t       peak_bytes;                 /**< peak of the bytes still allocated */
+    rt_uint64_t     life_sum;                   /**< ticks the released blocks lived, summed */
+    rt_tick_t       life_max;                   /**< ticks the longest released block lived */
+};
+
+/**
+ * Fragmentation of the system heap
+ */
+struct heap_prof_frag
+{
+    rt_size_t       total;                      /**< size of the heap */
+    rt_size_t       used;                       /**< bytes in use */
+    rt_size_t       max_free;                   /**< largest free block, 0 if unknown */
+    int             index;                      /**< fragmentation in percent, -1 if unknown */
+};
+
+/**
+ * Header of the binary export, followed by site_nr records. Every field is in
+ * the byte order of the target, the magic tells the host which one it is.
+ */
+struct heap_prof_header
+{
+    rt_uint32_t     magic;                      /**< HEAP_PROF_MAGIC */
+    rt_uint16_t     version;                    /**< HEAP_PROF_VERSION */
+    rt_uint16_t     flags;                      /**< HEAP_PROF_FLAG_* */
+    rt_uint32_t     site_nr;                    /**< number of records */
+    rt_uint32_t     tick_per_second;            /**< unit of the lifetimes */
+    rt_uint32_t     tick;                       /**< tick of the export */
+    rt_uint32_t     dropped;                    /**< allocations not tracked as live */
+    rt_uint64_t     total;
+    rt_uint64_t     used;
+    rt_uint64_t     max_used;
+    rt_uint64_t     max_free;
+};
+
+/**
+ * One call site in the binary export
+ */
+struct heap_prof_record
+{
+    rt_uint64_t     caller;
+    rt_uint64_t     bytes;
+    rt_uint64_t     live_bytes;
+    rt_uint64_t     peak_bytes;
+    rt_uint64_t     life_sum;
+    rt_uint32_t     allocs;
+    rt_uint32_t     frees;
+    rt_uint32_t     life_max;
+    rt_uint32_t     reserved;
+};
+
+void heap_prof_start(void);
+void heap_prof_stop(void);
+rt_bool_t heap_prof_is_running(void);
+rt_err_t heap_prof_get_site(int index, struct heap_prof_site *site);
+rt_uint32_t heap_prof_get_dropped(void);
+void heap_prof_get_frag(struct heap_prof_frag *frag);
+#ifdef DFS_USING_POSIX
+rt_err_t heap_prof_export(const char *path);
+#endif /* DFS_USING_POSIX */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HEAP_PROF_H__ */
@@ -0,0 +1,649 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+/*
+ * Stack watermark auditor.
+ *
+ * Every stack is filled with '#' when its thread is initialised. The idle hook
+ * scans at most RT_STACK_AUDIT_SCAN_SIZE bytes of one stack per idle loop,
+ * from the end the stack grows towards up to the deepest use already known,
+ * so a pass over a stack gets shorter as its peak settles. The threads are
+ * visited in the order of the object list, one pass each per round.
+ *
+ * RT_STACK_AUDIT_THREAD_NR threads are tracked. The record of an exited thread
+ * is kept for the report until its slot is taken by a new thread; a thread
+ * finding no slot is counted as untracked.
+ *
+ * The stack of a deleted thread is released by the idle thread after the idle
+ * hooks ran, so on a single core a pass never reads a released stack. With
+ * RT_USING_SMP the system thread releases it and a pass racing with the
+ * release may record a bogus peak for the exiting thread.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <stack_audit.h>
+
+#ifdef DFS_USING_POSIX
+#include <dfs_file.h>
+#include <unistd.h>
+#endif /* DFS_USING_POSIX */
+
+#define DBG_TAG    "stack.audit"
+#define DBG_LVL    DBG_INFO
+#include <rtdbg.h>
+
+/* a word of the fill pattern */
+#define STACK_AUDIT_FILL_WORD   ((rt_ubase_t)~0 / 0xff * '#')
+#define STACK_AUDIT_WORD_MASK   (sizeof(rt_ubase_t) - 1)
+
+struct stack_audit_entry
+{
+    rt_thread_t     thread;                     /* RT_NULL once the thread is gone */
+    rt_uint8_t      *stack_addr;
+    rt_uint32_t     stack_size;                 /* 0 for a free slot */
+    rt_uint32_t     peak;
+    rt_tick_t       peak_tick;
+    rt_uint32_t     scan;                       /* bytes checked in the current pass */
+    rt_uint8_t      seen;                       /* visited in the current round */
+    char            name[RT_NAME_MAX];
+};
+
+static struct stack_audit_entry _entries[RT_STACK_AUDIT_THREAD_NR];
+static struct stack_audit_entry *_current;      /* the entry of the pass in progress */
+static rt_thread_t _cursor;                     /* the thread visited last, only compared */
+static rt_uint32_t _rounds;
+static rt_uint32_t _untracked;
+static rt_bool_t _running;
+static RT_DEFINE_SPINLOCK(_lock);
+
+/**
+ * @brief Check 'from' up to 'to' bytes in from the far end of a stack for the
+ *        fill pattern.
+ *
+ * @return the offset of the first byte not matching, 'to' if all of them match.
+ */
+static rt_uint32_t _scan(const rt_uint8_t *stack, rt_uint32_t size, rt_uint32_t from, rt_uint32_t to)
+{
+#ifdef ARCH_CPU_STACK_GROWS_UPWARD
+    const rt_uint8_t *ptr = stack + size - 1 - from;
+
+    /* the far end is the top, walk down to the first aligned word */
+    while (from < to && ((rt_ubase_t)(ptr + 1) & STACK_AUDIT_WORD_MASK) && *ptr == '#')
+    {
+        from++;
+        ptr--;
+    }
+    while (to - from >= sizeof(rt_ubase_t) &&
+           *(const rt_ubase_t *)(ptr + 1 - sizeof(rt_ubase_t)) == STACK_AUDIT_FILL_WORD)
+    {
+        from += sizeof(rt_ubase_t);
+        ptr -= sizeof(rt_ubase_t);
+    }
+    while (from < to && *ptr == '#')
+    {
+        from++;
+        ptr--;
+    }
+#else
+    const rt_uint8_t *ptr = stack + from;
+
+    RT_UNUSED(size);
+
+    /* the far end is the bottom, walk up to the first aligned word */
+    while (from < to && ((rt_ubase_t)ptr & STACK_AUDIT_WORD_MASK) && *ptr == '#')
+    {
+        from++;
+        ptr++;
+    }
+    while (to - from >= sizeof(rt_ubase_t) && *(const rt_ubase_t *)ptr == STACK_AUDIT_FILL_WORD)
+    {
+        from += sizeof(rt_ubase_t);
+        ptr += sizeof(rt_ubase_t);
+    }
+    while (from < to && *ptr == '#')
+    {
+        from++;
+        ptr++;
+    }
+#endif /* ARCH_CPU_STACK_GROWS_UPWARD */
+
+    return from;
+}
+
+/* whether the thread of the entry is still listed and running on the same stack */
+static rt_bool_t _entry_alive(struct stack_audit_entry *entry)
+{
+    struct rt_object_information *info;
+    struct rt_list_node *node;
+    rt_thread_t thread;
+    rt_bool_t alive = RT_FALSE;
+
+    info = rt_object_get_information(RT_Object_Class_Thread);
+    rt_spin_lock(&info->spinlock);
+    rt_list_for_each(node, &info->object_list)
+    {
+        thread = (rt_thread_t)rt_list_entry(node, struct rt_object, list);
+        if (thread == entry->thread)
+        {
+            alive = (RT_SCHED_CTX(thread).stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE &&
+                    (rt_uint8_t *)thread->stack_addr == entry->stack_addr &&
+                    thread->stack_size == entry->stack_size;
+            break;
+        }
+    }
+    rt_spin_unlock(&info->spinlock);
+
+    return alive;
+}
+
+/* retire the threads not seen in the round just finished */
+static void _round_end(void)
+{
+    int index;
+
+    for (index = 0; index < RT_STACK_AUDIT_THREAD_NR; index++)
+    {
+        if (!_entries[index].seen)
+            _entries[index].thread = RT_NULL;
+        _entries[index].seen = 0;
+    }
+    _rounds++;
+}
+
+/* the entry of a thread, a new one if it is not tracked yet */
+static struct stack_audit_entry *_entry_get(rt_thread_t thread)
+{
+    struct stack_audit_entry *entry, *slot = RT_NULL;
+    int index;
+
+    for (index = 0; index < RT_STACK_AUDIT_THREAD_NR; index++)
+    {
+        entry = &_entries[index];
+        if (entry->thread == thread &&
+            entry->stack_addr == (rt_uint8_t *)thread->stack_addr &&
+            entry->stack_size == thread->stack_size &&
+            rt_strncmp(entry->name, thread->parent.name, RT_NAME_MAX) == 0)
+        {
+            entry->seen = 1;
+            return entry;
+        }
+
+        /* prefer a free slot over the record of an exited thread */
+        if (entry->thread == RT_NULL &&
+            (slot == RT_NULL || (slot->stack_size != 0 && entry->stack_size == 0)))
+        {
+            slot = entry;
+        }
+    }
+
+    if (slot == RT_NULL)
+    {
+        _untracked++;
+        return RT_NULL;
+    }
+
+    rt_memset(slot, 0, sizeof(*slot));
+    slot->thread = thread;
+    slot->stack_addr = (rt_uint8_t *)thread->stack_addr;
+    slot->stack_size = thread->stack_size;
+    slot->seen = 1;
+    rt_strncpy(slot->name, thread->parent.name, RT_NAME_MAX);
+
+    return slot;
+}
+
+/* move the cursor to the next thread in the object list, its entry */
+static struct stack_audit_entry *_entry_next(void)
+{
+    struct rt_object_information *info;
+    struct stack_audit_entry *entry = RT_NULL;
+    struct rt_list_node *node, *next;
+    rt_thread_t thread;
+    int wraps = 0;
+
+    info = rt_object_get_information(RT_Object_Class_Thread);
+    rt_spin_lock(&info->spinlock);
+
+    /* start over from the head if the last thread visited is gone */
+    next = info->object_list.next;
+    rt_list_for_each(node, &info->object_list)
+    {
+        if ((rt_thread_t)rt_list_entry(node, struct rt_object, list) == _cursor)
+        {
+            next = node->next;
+            break;
+        }
+    }
+
+    for (; ; next = next->next)
+    {
+        if (next == &info->object_list)
+        {
+            _round_end();
+            next = next->next;
+            /* nothing but exiting threads */
+            if (next == &info->object_list || ++wraps > 1)
+                break;
+        }
+
+        thread = (rt_thread_t)rt_list_entry(next, struct rt_object, list);
+        _cursor = thread;
+        if ((RT_SCHED_CTX(thread).stat & RT_THREAD_STAT_MASK) == RT_THREAD_CLOSE ||
+            thread->stack_addr == RT_NULL || thread->stack_size == 0)
+        {
+            /* an exiting thread is left out, it retires at the end of the round */
+            continue;
+        }
+
+        entry = _entry_get(thread);
+        break;
+    }
+
+    rt_spin_unlock(&info->spinlock);
+
+    return entry;
+}
+
+/* scan up to 'budget' bytes of the stack whose pass is in progress */
+static void _audit_step(rt_uint32_t budget)
+{
+    struct stack_audit_entry *entry;
+    rt_uint8_t *stack_addr;
+    rt_uint32_t stack_size, start, limit, end, found;
+    rt_base_t level;
+
+    level = rt_spin_lock_irqsave(&_lock);
+
+    entry = _current;
+    if (entry != RT_NULL && !_entry_alive(entry))
+    {
+        entry->thread = RT_NULL;
+        entry = RT_NULL;
+    }
+    if (entry == RT_NULL)
+    {
+        entry = _entry_next();
+        _current = entry;
+        if (entry == RT_NULL)
+        {
+            rt_spin_unlock_irqrestore(&_lock, level);
+            return;
+        }
+    }
+
+    /* only the part of the stack never seen in use is checked */
+    limit = entry->stack_size - entry->peak;
+    end = entry->scan + budget;
+    if (end > limit || end < entry->scan)
+        end = limit;
+    start = entry->scan;
+    stack_addr = entry->stack_addr;
+    stack_size = entry->stack_size;
+
+    rt_spin_unlock_irqrestore(&_lock, level);
+
+    /* the fill is only read, the interrupts stay enabled for the scan */
+    found = _scan(stack_addr, stack_size, start, end);
+
+    level = rt_spin_lock_irqsave(&_lock);
+
+    /* another step or a reset may have moved the pass on meanwhile */
+    if (_current != entry || entry->scan != start ||
+        entry->stack_addr != stack_addr || entry->stack_size != stack_size)
+    {
+        rt_spin_unlock_irqrestore(&_lock, level);
+        return;
+    }
+
+    if (found < end)
+    {
+        entry->peak = entry->stack_size - found;
+        entry->peak_tick = rt_tick_get();
+        LOG_D("%.*s: new peak %u of %u bytes", RT_NAME_MAX, entry->name, entry->peak, entry->stack_size);
+    }
+
+    if (found < end || end == limit)
+    {
+        entry->scan = 0;
+        _current = RT_NULL;
+    }
+    else
+    {
+        entry->scan = end;
+    }
+
+    rt_spin_unlock_irqrestore(&_lock, level);
+}
+
+static void _audit_idle(void)
+{
+    if (_running)
+        _audit_step(RT_STACK_AUDIT_SCAN_SIZE);
+}
+
+/**
+ * @brief Suggest a stack size for a peak use: the peak with a margin of
+ *        RT_STACK_AUDIT_MARGIN percent, aligned to RT_ALIGN_SIZE.
+ *
+ * @param peak is the deepest use of the stack in bytes.
+ *
+ * @return the suggested size, 0 if the stack was never scanned.
+ */
+rt_uint32_t stack_audit_suggest(rt_uint32_t peak)
+{
+    if (peak == 0)
+        return 0;
+
+    return RT_ALIGN(peak + peak * RT_STACK_AUDIT_MARGIN / 100, RT_ALIGN_SIZE);
+}
+RTM_EXPORT(stack_audit_suggest);
+
+/**
+ * @brief Start auditing from the idle hook, the statistics are kept.
+ *
+ * @return RT_EOK on success, -RT_EFULL if the idle hook list is full.
+ */
+rt_err_t stack_audit_start(void)
+{
+    rt_err_t result = RT_EOK;
+
+    if (!_running)
+    {
+        result = rt_thread_idle_sethook(_audit_idle);
+        if (result == RT_EOK)
+            _running = RT_TRUE;
+        else
+            LOG_E("no idle hook left, increase RT_IDLE_HOOK_LIST_SIZE");
+    }
+
+    return result;
+}
+RTM_EXPORT(stack_audit_start);
+
+/**
+ * @brief Stop auditing, the statistics are kept.
+ */
+void stack_audit_stop(void)
+{
+    if (_running)
+    {
+        _running = RT_FALSE;
+        rt_thread_idle_delhook(_audit_idle);
+    }
+}
+RTM_EXPORT(stack_audit_stop);
+
+rt_bool_t stack_audit_is_running(void)
+{
+    return _running;
+}
+RTM_EXPORT(stack_audit_is_running);
+
+/**
+ * @brief Forget every thread and peak recorded.
+ */
+void stack_audit_reset(void)
+{
+    rt_base_t level;
+
+    level = rt_spin_lock_irqsave(&_lock);
+    rt_memset(_entries, 0, sizeof(_entries));
+    _current = RT_NULL;
+    _cursor = RT_NULL;
+    _untracked = 0;
+    rt_spin_unlock_irqrestore(&_lock, level);
+}
+RTM_EXPORT(stack_audit_reset);
+
+/**
+ * @brief Run a full round over every thread now, in the caller, so the
+ *        statistics are up to date before a report or an export.
+ *
+ * @note The stack is scanned RT_STACK_AUDIT_SCAN_SIZE bytes at a time.
+ */
+void stack_audit_scan_all(void)
+{
+    rt_uint32_t round = _rounds;
+
+    /* finish the round in progress, then run a whole one */
+    while (_rounds - round < 2)
+        _audit_step(RT_STACK_AUDIT_SCAN_SIZE);
+}
+RTM_EXPORT(stack_audit_scan_all);
+
+static void _entry_info(struct stack_audit_entry *entry, struct stack_audit_info *info)
+{
+    rt_strncpy(info->name, entry->name, RT_NAME_MAX);
+    info->stack_size = entry->stack_size;
+    info->peak = entry->peak;
+    info->peak_tick = entry->peak_tick;
+    info->suggested = stack_audit_suggest(entry->peak);
+    info->alive = entry->thread != RT_NULL;
+}
+
+/**
+ * @brief Get the stack usage recorded in a slot.
+ *
+ * @param index is the slot, 0 to RT_STACK_AUDIT_THREAD_NR - 1.
+ *
+ * @param info is the buffer to store the usage.
+ *
+ * @return RT_EOK on success, -RT_EINVAL if the index is out of range,
+ *         -RT_EEMPTY if the slot is free.
+ */
+rt_err_t stack_audit_get(int index, struct stack_audit_info *info)
+{
+    rt_err_t result = -RT_EEMPTY;
+    rt_base_t level;
+
+    RT_ASSERT(info != RT_NULL);
+
+    if (index < 0 || index >= RT_STACK_AUDIT_THREAD_NR)
+        return -RT_EINVAL;
+
+    level = rt_spin_lock_irqsave(&_lock);
+    if (_entries[index].stack_size != 0)
+    {
+        _entry_info(&_entries[index], info);
+        result = RT_EOK;
+    }
+    rt_spin_unlock_irqrestore(&_lock, level);
+
+    return result;
+}
+RTM_EXPORT(stack_audit_get);
+
+/**
+ * @brief Get the stack usage recorded for a running thread.
+ *
+ * @param thread is the thread.
+ *
+ * @param info is the buffer to store the usage.
+ *
+ * @return RT_EOK on success, -RT_ENOENT if the thread is not tracked.
+ */
+rt_err_t stack_audit_get_thread(rt_thread_t thread, struct stack_audit_info *info)
+{
+    rt_err_t result = -RT_ENOENT;
+    rt_base_t level;
+    int index;
+
+    RT_ASSERT(thread != RT_NULL);
+    RT_ASSERT(info != RT_NULL);
+
+    level = rt_spin_lock_irqsave(&_lock);
+    for (index = 0; index < RT_STACK_AUDIT_THREAD_NR; index++)
+    {
+        if (_entries[index].thread == thread &&
+            _entries[index].stack_addr == (rt_uint8_t *)thread->stack_addr)
+        {
+            _entry_info(&_entries[index], info);
+            result = RT_EOK;
+            break;
+        }
+    }
+    rt_spin_unlock_irqrestore(&_lock, level);
+
+    return result;
+}
+RTM_EXPORT(stack_audit_get_thread);
+
+#ifdef DFS_USING_POSIX
+/**
+ * @brief Export the report as CSV, one line per thread. The application calls
+ *        it on its shutdown path to keep the peaks of a whole run.
+ *
+ * @param path is the file to write.
+ *
+ * @return RT_EOK on success, -RT_EIO if the file can not be written.
+ */
+rt_err_t stack_audit_export(const char *path)
+{
+    struct stack_audit_info info;
+    rt_err_t result = RT_EOK;
+    char line[RT_NAME_MAX + 64];
+    int index, len, fd;
+
+    RT_ASSERT(path != RT_NULL);
+
+    fd = open(path, O_CREAT | O_WRONLY | O_TRUNC, 0);
+    if (fd < 0)
+        return -RT_EIO;
+
+    len = rt_snprintf(line, sizeof(line), "thread,stack_size,peak,peak_ms,suggested,alive\n");
+    if (write(fd, line, len) != len)
+        result = -RT_EIO;
+
+    for (index = 0; index < RT_STACK_AUDIT_THREAD_NR && result == RT_EOK; index++)
+    {
+        if (stack_audit_get(index, &info) != RT_EOK)
+            continue;
+
+        len = rt_snprintf(line, sizeof(line), "%.*s,%u,%u,%u,%u,%d\n",
+                          RT_NAME_MAX, info.name, info.stack_size, info.peak,
+                          (rt_uint32_t)((rt_uint64_t)info.peak_tick * 1000 / RT_TICK_PER_SECOND),
+                          info.suggested, info.alive);
+        if (write(fd, line, len) != len)
+            result = -RT_EIO;
+    }
+    close(fd);
+
+    return result;
+}
+RTM_EXPORT(stack_audit_export);
+#endif /* DFS_USING_POSIX */
+
+#ifdef RT_STACK_AUDIT_AUTO_START
+static int stack_audit_init(void)
+{
+    stack_audit_start();
+
+    return 0;
+}
+INIT_APP_EXPORT(stack_audit_init);
+#endif /* RT_STACK_AUDIT_AUTO_START */
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void _show(void)
+{
+    struct stack_audit_info info;
+    rt_uint32_t total = 0, suggested = 0;
+    int index, nr = 0;
+
+    rt_kprintf("%-*.*s size       peak       used peak at ms suggest    save\n",
+               RT_NAME_MAX, RT_NAME_MAX, "thread");
+    for (index = 0; index < RT_NAME_MAX; index++)
+        rt_kprintf("-");
+    rt_kprintf(" ---------- ---------- ---- ---------- ---------- ----------\n");
+
+    for (index = 0; index < RT_STACK_AUDIT_THREAD_NR; index++)
+    {
+        if (stack_audit_get(index, &info) != RT_EOK)
+            continue;
+
+        rt_kprintf("%-*.*s %-10u %-10u %3u%% %-10u %-10u %d%s\n",
+                   RT_NAME_MAX, RT_NAME_MAX, info.name, info.stack_size, info.peak,
+                   info.peak * 100 / info.stack_size,
+                   (rt_uint32_t)((rt_uint64_t)info.peak_tick * 1000 / RT_TICK_PER_SECOND),
+                   info.suggested, (int)info.stack_size - (int)info.suggested,
+                   !info.alive ? " (exited)" : info.peak >= info.stack_size ? " (overflow)" : "");
+        if (info.alive && info.suggested != 0)
+        {
+            total += info.stack_size;
+            suggested += info.suggested;
+        }
+        nr++;
+    }
+
+    rt_kprintf("%d threads, %u untracked, %u rounds, auditor %s\n",
+               nr, _untracked, _rounds, _running ? "running" : "stopped");
+    rt_kprintf("running threads: %u bytes of stack, %u suggested, %d reclaimable\n",
+               total, suggested, (int)total - (int)suggested);
+}
+
+static int stackaudit(int argc, char **argv)
+{
+    if (argc < 2)
+        goto __usage;
+
+    if (rt_strcmp(argv[1], "start") == 0)
+    {
+        stack_audit_start();
+    }
+    else if (rt_strcmp(argv[1], "stop") == 0)
+    {
+        stack_audit_stop();
+    }
+    else if (rt_strcmp(argv[1], "show") == 0)
+    {
+        _show();
+    }
+    else if (rt_strcmp(argv[1], "scan") == 0)
+    {
+        stack_audit_scan_all();
+        _show();
+    }
+    else if (rt_strcmp(argv[1], "reset") == 0)
+    {
+        stack_audit_reset();
+    }
+#ifdef DFS_USING_POSIX
+    else if (rt_strcmp(argv[1], "export") == 0 && argc > 2)
+    {
+        stack_audit_scan_all();
+        if (stack_audit_export(argv[2]) != RT_EOK)
+            rt_kprintf("write %s failed\n", argv[2]);
+    }
+#endif /* DFS_USING_POSIX */
+    else
+    {
+        goto __usage;
+    }
+
+    return 0;
+
+__usage:
+    rt_kprintf("Usage:\n");
+    rt_kprintf("stackaudit start        - start auditing from the idle hook\n");
+    rt_kprintf("stackaudit stop         - stop auditing\n");
+    rt_kprintf("stackaudit show         - show the peaks and the suggested stack sizes\n");
+    rt_kprintf("stackaudit scan         - scan every stack now, then show them\n");
+    rt_kprintf("stackaudit reset        - forget the threads and peaks recorded\n");
+#ifdef DFS_USING_POSIX
+    rt_kprintf("stackaudit export file  - scan every stack now, then export them as CSV\n");
+#endif /* DFS_USING_POSIX */
+
+    return 0;
+}
+MSH_CMD_EXPORT(stackaudit, thread stack watermark auditor);
+#endif /* RT_USING_FINSH */
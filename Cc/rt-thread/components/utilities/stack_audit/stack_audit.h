@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#ifndef __STACK_AUDIT_H__
+#define __STACK_AUDIT_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Stack usage of one audited thread
+ */
+struct stack_audit_info
+{
+    char            name[RT_NAME_MAX];          /**< name of the thread */
+    rt_uint32_t     stack_size;                 /**< size of the stack */
+    rt_uint32_t     peak;                       /**< deepest use of the stack in bytes */
+    rt_tick_t       peak_tick;                  /**< tick the peak was first seen */
+    rt_uint32_t     suggested;                  /**< stack size suggested from the peak */
+    rt_bool_t       alive;                      /**< RT_FALSE once the thread has exited */
+};
+
+rt_err_t stack_audit_start(void);
+void stack_audit_stop(void);
+rt_bool_t stack_audit_is_running(void);
+void stack_audit_reset(void);
+void stack_audit_scan_all(void);
+rt_err_t stack_audit_get(int index, struct stack_audit_info *info);
+rt_err_t stack_audit_get_thread(rt_thread_t thread, struct stack_audit_info *info);
+rt_uint32_t stack_audit_suggest(rt_uint32_t peak);
+#ifdef DFS_USING_POSIX
+rt_err_t stack_audit_export(const char *path);
+#endif /* DFS_USING_POSIX */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STACK_AUDIT_H__ */
@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2021-01-07     ChenYong     first version
  * 2021-12-20     armink       add multi-instance version
+ * 2026-10-18     Cc           write sector aligned buffers from a flush thread
  */
 
 #include <rtthread.h>
@@ -18,16 +19,19 @@
 
 #ifdef ULOG_BACKEND_USING_FILE
 
-#if defined(ULOG_ASYNC_OUTPUT_THREAD_STACK) && (ULOG_ASYNC_OUTPUT_THREAD_STACK < 2048)
-#error "The value of ULOG_ASYNC_OUTPUT_THREAD_STACK must be greater than 2048."
+#if ULOG_FILE_BE_THREAD_STACK < 2048
+#error "The value of ULOG_FILE_BE_THREAD_STACK must be at least 2048."
 #endif
 
+/* the buffers are also aligned to the cache line for the DMA of the storage */
+#define ULOG_FILE_BE_BUF_ALIGN      32
+
 /* rotate the log file xxx_n-1.log => xxx_n.log, and xxx.log => xxx_0.log */
 static rt_bool_t ulog_file_rotate(struct ulog_file_be *be)
 {
 #define SUFFIX_LEN          10
     /* mv xxx_n-1.log => xxx_n.log, and xxx.log => xxx_0.log */
-    static char old_path[ULOG_FILE_PATH_LEN], new_path[ULOG_FILE_PATH_LEN];
+    char old_path[ULOG_FILE_PATH_LEN], new_path[ULOG_FILE_PATH_LEN];
     int index = 0, err = 0, file_fd = 0;
     rt_bool_t result = RT_FALSE;
     size_t base_len = 0;
@@ -41,6 +45,13 @@ static rt_bool_t ulog_file_rotate(struct ulog_file_be *be)
         close(be->cur_log_file_fd);
     }
 
+    if (be->file_max_num < 2)
+    {
+        /* a single file starts over */
+        unlink(be->cur_log_file_path);
+        result = RT_TRUE;
+    }
+
     for (index = be->file_max_num - 2; index >= 0; --index)
     {
         rt_snprintf(old_path + base_len, SUFFIX_LEN, index ? "_%d.log" : ".log", index - 1);
@@ -70,56 +81,195 @@ static rt_bool_t ulog_file_rotate(struct ulog_file_be *be)
 __exit:
     /* reopen the file */
     be->cur_log_file_fd = open(be->cur_log_file_path, O_CREAT | O_RDWR | O_APPEND);
+    be->cur_file_size = 0;
 
     return result;
 }
 
-static void ulog_file_backend_flush_with_buf(struct ulog_backend *backend)
+/* hand the buffer being filled to the flush thread, the caller holds be->lock */
+static rt_bool_t ulog_file_buf_seal(struct ulog_file_be *be)
 {
-    struct ulog_file_be *be = (struct ulog_file_be *) backend;
-    rt_size_t file_size = 0, write_size = 0;
+    if (be->buf_len[be->buf_fill] == 0 || be->buf_sealed >= ULOG_FILE_BE_BUF_NUM - 1)
+    {
+        return RT_FALSE;
+    }
+
+    be->buf_sealed++;
+    be->buf_fill = (be->buf_fill + 1) % ULOG_FILE_BE_BUF_NUM;
+
+    return RT_TRUE;
+}
 
-    if (be->enable == RT_FALSE || be->buf_ptr_now == be->file_buf)
+static rt_err_t ulog_file_open(struct ulog_file_be *be)
+{
+    if (be->cur_log_file_fd >= 0)
     {
-        return;
+        return RT_EOK;
     }
+
+    /* check log file directory  */
+    if (access(be->cur_log_dir_path, F_OK) < 0)
+    {
+        mkdir(be->cur_log_dir_path, 0);
+    }
+    /* open file */
+    rt_snprintf(be->cur_log_file_path, ULOG_FILE_PATH_LEN, "%s/%s.log", be->cur_log_dir_path, be->parent.name);
+    be->cur_log_file_fd = open(be->cur_log_file_path, O_CREAT | O_RDWR | O_APPEND);
     if (be->cur_log_file_fd < 0)
     {
-        /* check log file directory  */
-        if (access(be->cur_log_dir_path, F_OK) < 0)
-        {
-            mkdir(be->cur_log_dir_path, 0);
-        }
-        /* open file */
-        rt_snprintf(be->cur_log_file_path, ULOG_FILE_PATH_LEN, "%s/%s.log", be->cur_log_dir_path, be->parent.name);
-        be->cur_log_file_fd = open(be->cur_log_file_path, O_CREAT | O_RDWR | O_APPEND);
-        if (be->cur_log_file_fd < 0)
+        rt_kprintf("ulog file(%s) open failed.", be->cur_log_file_path);
+        return -RT_ERROR;
+    }
+    be->cur_file_size = lseek(be->cur_log_file_fd, 0, SEEK_END);
+
+    return RT_EOK;
+}
+
+static void ulog_file_write(struct ulog_file_be *be, const rt_uint8_t *buf, rt_size_t len)
+{
+    int write_size;
+
+    if (be->cur_file_size > 0 && be->cur_file_size + len > be->file_max_size)
+    {
+        if (!ulog_file_rotate(be) || be->cur_log_file_fd < 0)
         {
-            rt_kprintf("ulog file(%s) open failed.", be->cur_log_file_path);
+            rt_atomic_add(&be->dropped, len);
             return;
         }
     }
 
-    file_size = lseek(be->cur_log_file_fd, 0, SEEK_END);
-    if (file_size >= (be->file_max_size - be->buf_size * 2))
+    write_size = write(be->cur_log_file_fd, buf, len);
+    if (write_size > 0)
+    {
+        be->cur_file_size += write_size;
+    }
+    if (write_size != (int)len)
+    {
+        rt_atomic_add(&be->dropped, write_size > 0 ? len - write_size : len);
+    }
+}
+
+/* write the sealed buffers in order, then a note of the bytes lost since the last one */
+static void ulog_file_write_sealed(struct ulog_file_be *be)
+{
+    char note[48];
+    rt_uint32_t dropped;
+    rt_uint8_t index;
+    rt_base_t level;
+    rt_bool_t written = RT_FALSE, line_end = RT_FALSE;
+    int note_len;
+
+    /* the buffers are kept until the backend is enabled */
+    if (be->enable == RT_FALSE || ulog_file_open(be) != RT_EOK)
+    {
+        return;
+    }
+
+    while (be->buf_sealed > 0)
+    {
+        index = be->buf_write;
+        ulog_file_write(be, be->file_buf + index * be->buf_size, be->buf_len[index]);
+        /* a full buffer may end in the middle of a log */
+        line_end = be->file_buf[index * be->buf_size + be->buf_len[index] - 1] == '\n';
+        written = RT_TRUE;
+
+        level = rt_spin_lock_irqsave(&be->lock);
+        be->buf_len[index] = 0;
+        be->buf_write = (index + 1) % ULOG_FILE_BE_BUF_NUM;
+        be->buf_sealed--;
+        rt_spin_unlock_irqrestore(&be->lock, level);
+    }
+
+    /* the note waits for a log end, the count goes on until then */
+    if (line_end && rt_atomic_load(&be->dropped) > 0)
     {
-        if (!ulog_file_rotate(be))
+        dropped = (rt_uint32_t)rt_atomic_exchange(&be->dropped, 0);
+        be->dropped_total += dropped;
+        note_len = rt_snprintf(note, sizeof(note), "[ulog] %u bytes dropped" ULOG_NEWLINE_SIGN, dropped);
+        ulog_file_write(be, (const rt_uint8_t *)note, note_len);
+        written = RT_TRUE;
+    }
+
+    if (written)
+    {
+        /* flush file cache, once for the whole batch */
+        fsync(be->cur_log_file_fd);
+    }
+}
+
+static void ulog_file_backend_entry(void *parameter)
+{
+    struct ulog_file_be *be = (struct ulog_file_be *)parameter;
+    rt_base_t level;
+    rt_err_t result;
+
+    while (!be->quit)
+    {
+        result = rt_sem_take(&be->notice, be->flush_period);
+        /* a log waited for the flush period */
+        if (result == -RT_ETIMEOUT)
         {
-            return;
+            level = rt_spin_lock_irqsave(&be->lock);
+            ulog_file_buf_seal(be);
+            rt_spin_unlock_irqrestore(&be->lock, level);
         }
+        ulog_file_write_sealed(be);
+
+        if (be->flush_req)
+        {
+            /* the buffer of the requester may not have fit in the sealed ones */
+            be->flush_req = RT_FALSE;
+            level = rt_spin_lock_irqsave(&be->lock);
+            ulog_file_buf_seal(be);
+            rt_spin_unlock_irqrestore(&be->lock, level);
+            ulog_file_write_sealed(be);
+            rt_sem_release(&be->flushed);
+        }
+    }
+
+    /* the last logs */
+    level = rt_spin_lock_irqsave(&be->lock);
+    ulog_file_buf_seal(be);
+    rt_spin_unlock_irqrestore(&be->lock, level);
+    ulog_file_write_sealed(be);
+    if (be->cur_log_file_fd >= 0)
+    {
+        close(be->cur_log_file_fd);
+        be->cur_log_file_fd = -1;
     }
 
-    write_size = (rt_size_t)(be->buf_ptr_now - be->file_buf);
-    /* write to the file */
-    if (write(be->cur_log_file_fd, be->file_buf, write_size) != write_size)
+    rt_sem_release(&be->flushed);
+}
+
+static void ulog_file_backend_flush_with_buf(struct ulog_backend *backend)
+{
+    struct ulog_file_be *be = (struct ulog_file_be *) backend;
+    rt_bool_t wait;
+    rt_base_t level;
+
+    if (be->enable == RT_FALSE)
     {
         return;
     }
-    /* flush file cache */
-    fsync(be->cur_log_file_fd);
 
-    /* point be->buf_ptr_now at the head of be->file_buf[be->buf_size] */
-    be->buf_ptr_now = be->file_buf;
+    /* wait for the write in the thread context only */
+    wait = rt_scheduler_is_available() && rt_thread_self() != be->flush_thread;
+    if (wait)
+    {
+        /* the answer of an earlier request that timed out */
+        while (rt_sem_trytake(&be->flushed) == RT_EOK);
+    }
+
+    level = rt_spin_lock_irqsave(&be->lock);
+    ulog_file_buf_seal(be);
+    rt_spin_unlock_irqrestore(&be->lock, level);
+    be->flush_req = RT_TRUE;
+    rt_sem_release(&be->notice);
+
+    if (wait)
+    {
+        rt_sem_take(&be->flushed, RT_TICK_PER_SECOND * 2);
+    }
 }
 
 static void ulog_file_backend_output_with_buf(struct ulog_backend *backend, rt_uint32_t level,
@@ -127,39 +277,47 @@ static void ulog_file_backend_output_with_buf(struct ulog_backend *backend, rt_u
 {
     struct ulog_file_be *be = (struct ulog_file_be *)backend;
     rt_size_t copy_len = 0, free_len = 0;
-    const unsigned char *buf_ptr_end = be->file_buf + be->buf_size;
+    rt_bool_t notice = RT_FALSE;
+    rt_uint8_t *buf;
+    rt_base_t lock_level;
 
+    lock_level = rt_spin_lock_irqsave(&be->lock);
+    /* free space length, in this buffer and the ones not waiting for the write */
+    free_len = be->buf_size - be->buf_len[be->buf_fill] + (ULOG_FILE_BE_BUF_NUM - 1 - be->buf_sealed) * be->buf_size;
+    if (len > free_len)
+    {
+        /* the whole log is dropped, the producer is not blocked */
+        rt_atomic_add(&be->dropped, len);
+        len = 0;
+    }
     while (len)
     {
-        /* free space length */
-        free_len = buf_ptr_end - be->buf_ptr_now;
-        /* copy the log to the mem buffer */
-        if (len > free_len)
-        {
-            copy_len = free_len;
-        }
-        else
+        buf = be->file_buf + be->buf_fill * be->buf_size;
+        free_len = be->buf_size - be->buf_len[be->buf_fill];
+        if (free_len == 0)
         {
-            copy_len = len;
+            ulog_file_buf_seal(be);
+            notice = RT_TRUE;
+            continue;
         }
-        rt_memcpy(be->buf_ptr_now, log, copy_len);
+        /* copy the log to the mem buffer */
+        copy_len = len > free_len ? free_len : len;
+        rt_memcpy(buf + be->buf_len[be->buf_fill], log, copy_len);
         /* update data pos */
-        be->buf_ptr_now += copy_len;
+        be->buf_len[be->buf_fill] += copy_len;
         len -= copy_len;
         log += copy_len;
+    }
+    /* the severe logs are written at once */
+    if (!is_raw && level <= be->flush_level && ulog_file_buf_seal(be))
+    {
+        notice = RT_TRUE;
+    }
+    rt_spin_unlock_irqrestore(&be->lock, lock_level);
 
-        RT_ASSERT(be->buf_ptr_now <= buf_ptr_end);
-        /* check the log buffer remain size */
-        if (buf_ptr_end == be->buf_ptr_now)
-        {
-            ulog_file_backend_flush_with_buf(backend);
-            if (buf_ptr_end == be->buf_ptr_now)
-            {
-                /* There is no space, indicating that the data cannot be refreshed
-                   to the back end of the file Discard data and exit directly */
-                break;
-            }
-        }
+    if (notice)
+    {
+        rt_sem_release(&be->notice);
     }
 }
 
@@ -167,26 +325,53 @@ static void ulog_file_backend_output_with_buf(struct ulog_backend *backend, rt_u
 int ulog_file_backend_init(struct ulog_file_be *be, const char *name, const char *dir_path, rt_size_t max_num,
         rt_size_t max_size, rt_size_t buf_size)
 {
-    be->file_buf = rt_calloc(1, buf_size);
+    /* whole sectors, a full buffer leaves the file end on a sector boundary */
+    buf_size = RT_ALIGN(buf_size, ULOG_FILE_BE_SECTOR_SIZE);
+    /* the buffer length MUST less than file size */
+    RT_ASSERT(buf_size < max_size);
+
+    be->file_buf = rt_malloc_align(buf_size * ULOG_FILE_BE_BUF_NUM, ULOG_FILE_BE_BUF_ALIGN);
     if (!be->file_buf)
     {
         rt_kprintf("Warning: NO MEMORY for %s file backend\n", name);
         return -RT_ENOMEM;
     }
-    /* temporarily store the start address of the ulog file buffer */
-    be->buf_ptr_now = be->file_buf;
+    rt_memset(be->buf_len, 0, sizeof(be->buf_len));
+    be->buf_fill = 0;
+    be->buf_write = 0;
+    be->buf_sealed = 0;
     be->cur_log_file_fd = -1;
+    be->cur_file_size = 0;
     be->file_max_num = max_num;
     be->file_max_size = max_size;
     be->buf_size = buf_size;
     be->enable = RT_FALSE;
+    ulog_file_backend_set_flush(be, ULOG_FILE_BE_FLUSH_PERIOD, ULOG_FILE_BE_FLUSH_LEVEL);
+    be->flush_req = RT_FALSE;
+    be->quit = RT_FALSE;
+    rt_atomic_store(&be->dropped, 0);
+    be->dropped_total = 0;
     rt_strncpy(be->cur_log_dir_path, dir_path, ULOG_FILE_PATH_LEN);
-    /* the buffer length MUST less than file size */
-    RT_ASSERT(be->buf_size < be->file_max_size);
+    rt_spin_lock_init(&be->lock);
+    rt_sem_init(&be->notice, name, 0, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&be->flushed, name, 0, RT_IPC_FLAG_FIFO);
+
+    be->flush_thread = rt_thread_create(name, ulog_file_backend_entry, be, ULOG_FILE_BE_THREAD_STACK,
+                                        ULOG_FILE_BE_THREAD_PRIORITY, 20);
+    if (be->flush_thread == RT_NULL)
+    {
+        rt_kprintf("Warning: NO MEMORY for %s file backend\n", name);
+        rt_sem_detach(&be->notice);
+        rt_sem_detach(&be->flushed);
+        rt_free_align(be->file_buf);
+        be->file_buf = RT_NULL;
+        return -RT_ENOMEM;
+    }
 
     be->parent.output = ulog_file_backend_output_with_buf;
     be->parent.flush = ulog_file_backend_flush_with_buf;
     ulog_backend_register((ulog_backend_t) be, name, RT_FALSE);
+    rt_thread_startup(be->flush_thread);
 
     return 0;
 }
@@ -194,22 +379,22 @@ int ulog_file_backend_init(struct ulog_file_be *be, const char *name, const char
 /* uninitialize the ulog file backend */
 int ulog_file_backend_deinit(struct ulog_file_be *be)
 {
-    if (be->cur_log_file_fd >= 0)
-    {
-        /* flush log to file */
-        ulog_file_backend_flush_with_buf((ulog_backend_t)be);
-        /* close */
-        close(be->cur_log_file_fd);
-        be->cur_log_file_fd = -1;
-    }
+    ulog_backend_unregister((ulog_backend_t)be);
 
-    if (!be->file_buf)
+    /* the thread writes the rest and closes the file */
+    while (rt_sem_trytake(&be->flushed) == RT_EOK);
+    be->quit = RT_TRUE;
+    rt_sem_release(&be->notice);
+    rt_sem_take(&be->flushed, RT_WAITING_FOREVER);
+    rt_sem_detach(&be->notice);
+    rt_sem_detach(&be->flushed);
+
+    if (be->file_buf)
     {
-        rt_free(be->file_buf);
+        rt_free_align(be->file_buf);
         be->file_buf = RT_NULL;
     }
 
-    ulog_backend_unregister((ulog_backend_t)be);
     return 0;
 }
 
@@ -223,4 +408,29 @@ void ulog_file_backend_disable(struct ulog_file_be *be)
     be->enable = RT_FALSE;
 }
 
+/**
+ * set when the buffered logs are written
+ *
+ * @param be the file backend
+ * @param period_ms max time in ms a log waits in the buffer, 0: until the buffer is full
+ * @param level the logs of this level or a more severe one are written at once
+ */
+void ulog_file_backend_set_flush(struct ulog_file_be *be, rt_uint32_t period_ms, rt_uint32_t level)
+{
+    be->flush_period = period_ms ? rt_tick_from_millisecond(period_ms) : RT_WAITING_FOREVER;
+    be->flush_level = level;
+}
+
+/**
+ * get the bytes lost since the backend was initialized
+ *
+ * @param be the file backend
+ *
+ * @return the lost bytes, to full buffers or failed writes
+ */
+rt_size_t ulog_file_backend_dropped(struct ulog_file_be *be)
+{
+    return be->dropped_total + rt_atomic_load(&be->dropped);
+}
+
 #endif /* ULOG_BACKEND_USING_FILE */
@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2021-01-07     ChenYong     first version
  * 2021-12-20     armink       add multi-instance version
+ * 2026-10-18     Cc           write sector aligned buffers from a flush thread
  */
 
 #ifndef _ULOG_BE_H_
@@ -18,6 +19,34 @@
 #define ULOG_FILE_PATH_LEN   128
 #endif
 
+/* the buffers of a file backend, filled in turn */
+#ifndef ULOG_FILE_BE_BUF_NUM
+#define ULOG_FILE_BE_BUF_NUM           2
+#endif
+
+/* the buffer size is rounded up to whole sectors */
+#ifndef ULOG_FILE_BE_SECTOR_SIZE
+#define ULOG_FILE_BE_SECTOR_SIZE       512
+#endif
+
+/* max time in ms a log waits in the buffer */
+#ifndef ULOG_FILE_BE_FLUSH_PERIOD
+#define ULOG_FILE_BE_FLUSH_PERIOD      1000
+#endif
+
+/* the logs of this level or a more severe one are written at once */
+#ifndef ULOG_FILE_BE_FLUSH_LEVEL
+#define ULOG_FILE_BE_FLUSH_LEVEL       LOG_LVL_ERROR
+#endif
+
+#ifndef ULOG_FILE_BE_THREAD_STACK
+#define ULOG_FILE_BE_THREAD_STACK      2048
+#endif
+
+#ifndef ULOG_FILE_BE_THREAD_PRIORITY
+#define ULOG_FILE_BE_THREAD_PRIORITY   29
+#endif
+
 struct ulog_file_be
 {
     struct ulog_backend parent;
@@ -27,8 +56,27 @@ struct ulog_file_be
     rt_size_t buf_size;
     rt_bool_t enable;
 
+    /* ULOG_FILE_BE_BUF_NUM buffers of buf_size, one is filled, the sealed ones wait for the write */
     rt_uint8_t *file_buf;
-    rt_uint8_t *buf_ptr_now;
+    rt_size_t buf_len[ULOG_FILE_BE_BUF_NUM];
+    rt_uint8_t buf_fill;
+    rt_uint8_t buf_write;
+    volatile rt_uint8_t buf_sealed;
+    struct rt_spinlock lock;
+
+    /* the flush thread and its thresholds */
+    rt_thread_t flush_thread;
+    struct rt_semaphore notice;
+    struct rt_semaphore flushed;
+    rt_int32_t flush_period;
+    rt_uint32_t flush_level;
+    volatile rt_bool_t flush_req;
+    volatile rt_bool_t quit;
+
+    rt_size_t cur_file_size;
+    /* bytes lost since the last note in the file, and before it */
+    rt_atomic_t dropped;
+    rt_size_t dropped_total;
 
     char cur_log_file_path[ULOG_FILE_PATH_LEN];
     char cur_log_dir_path[ULOG_FILE_PATH_LEN];
@@ -40,5 +88,7 @@ int ulog_file_backend_init(struct ulog_file_be *be, const char *name, const char
 int ulog_file_backend_deinit(struct ulog_file_be *be);
 void ulog_file_backend_enable(struct ulog_file_be *be);
 void ulog_file_backend_disable(struct ulog_file_be *be);
+void ulog_file_backend_set_flush(struct ulog_file_be *be, rt_uint32_t period_ms, rt_uint32_t level);
+rt_size_t ulog_file_backend_dropped(struct ulog_file_be *be);
 
 #endif /* _ULOG_BE_H_ */
@@ -6,6 +6,9 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-08-25     armink       the first version
+ * 2026-10-18     Cc           place the async output buffer in bulk memory
+ * 2026-10-18     Cc           add binary log mode
+ * 2026-10-18     Cc           hash the tag's level filter, add the tag rate limit
  */
 
 #include <stdarg.h>
@@ -70,6 +73,66 @@
 #error "the log line buffer size must more than 80"
 #endif
 
+#ifdef ULOG_USING_BINARY
+#if (ULOG_BINARY_BUF_SIZE & (ULOG_BINARY_BUF_SIZE - 1)) != 0
+#error "the binary log buffer size must be a power of two"
+#endif
+
+/* the stride of a record in the ring */
+#define ULOG_BIN_ALIGN(len)            RT_ALIGN(len, sizeof(rt_atomic_t))
+
+/* lock-free ring of binary records, any context can write, one reader drains it */
+struct ulog_bin_ring
+{
+    /* bytes reserved by the writers */
+    rt_atomic_t head;
+    /* bytes released by the reader */
+    rt_atomic_t tail;
+    /* records lost to a full ring */
+    rt_atomic_t dropped;
+    rt_atomic_t buf[ULOG_BINARY_BUF_SIZE / sizeof(rt_atomic_t)];
+};
+#endif /* ULOG_USING_BINARY */
+
+#ifdef ULOG_USING_FILTER
+/*
+ * the cached level is 'generation << 8 | level', the generation moves on each filter change
+ * and skips 0, which marks an empty entry
+ */
+#define ULOG_TAG_LVL_GEN_MASK          0xFFFFFF
+/* the words holding a tag as far as the filter compares it */
+#define ULOG_TAG_KEY_WORDS             (RT_ALIGN(ULOG_FILTER_TAG_MAX_LEN + 1, sizeof(rt_atomic_t)) / sizeof(rt_atomic_t))
+
+/* a tag copied into whole words, zero padded */
+union ulog_tag_key
+{
+    rt_atomic_t word[ULOG_TAG_KEY_WORDS];
+    char str[ULOG_TAG_KEY_WORDS * sizeof(rt_atomic_t)];
+};
+
+/* a tag's level resolved by its content, the sequence is odd while the entry is written */
+struct ulog_tag_lvl_cache
+{
+    rt_atomic_t seq;
+    rt_atomic_t value;
+    rt_atomic_t tag[ULOG_TAG_KEY_WORDS];
+};
+#endif /* ULOG_USING_FILTER */
+
+#ifdef ULOG_USING_RATE_LIMIT
+/* token bucket of a tag, one log costs RT_TICK_PER_SECOND tokens */
+struct ulog_rate_bucket
+{
+    rt_bool_t used;
+    char tag[ULOG_FILTER_TAG_MAX_LEN + 1];
+    rt_uint32_t tokens;
+    rt_tick_t last_tick;
+    /* logs suppressed since the last report and in total */
+    rt_uint32_t suppressed;
+    rt_uint32_t suppressed_total;
+};
+#endif /* ULOG_USING_RATE_LIMIT */
+
 struct rt_ulog
 {
     rt_bool_t init_ok;
@@ -95,17 +158,44 @@ struct rt_ulog
     struct rt_semaphore async_notice;
 #endif
 
+#ifdef ULOG_USING_BINARY
+    /* binary records, one ring for each CPU */
+    struct ulog_bin_ring bin_ring[RT_CPUS_NR];
+    /* set while a reader drains the rings */
+    rt_atomic_t bin_reading;
+    rt_bool_t bin_async_enabled;
+    /* the line buffer of the deferred formatting */
+    char log_buf_bin[ULOG_LINE_BUF_SIZE + 1];
+#endif /* ULOG_USING_BINARY */
+
 #ifdef ULOG_USING_FILTER
     struct
     {
         /* all tag's level filter */
         rt_slist_t tag_lvl_list;
+        /* the same filters hashed by the tag */
+        rt_slist_t tag_lvl_hash[ULOG_FILTER_TAG_HASH_SIZE];
+        rt_size_t tag_lvl_num;
+        rt_atomic_t tag_lvl_gen;
+        struct ulog_tag_lvl_cache tag_lvl_cache[ULOG_FILTER_TAG_CACHE_SIZE];
         /* global filter level, tag and keyword */
         rt_uint32_t level;
         char tag[ULOG_FILTER_TAG_MAX_LEN + 1];
         char keyword[ULOG_FILTER_KW_MAX_LEN + 1];
     } filter;
 #endif /* ULOG_USING_FILTER */
+
+#ifdef ULOG_USING_RATE_LIMIT
+    struct
+    {
+        struct ulog_rate_bucket bucket[ULOG_RATE_LIMIT_TAG_NR];
+        rt_uint32_t rate;
+        rt_uint32_t burst;
+        rt_tick_t report_tick;
+        /* set while the suppressed logs are reported */
+        rt_atomic_t reporting;
+    } rate;
+#endif /* ULOG_USING_RATE_LIMIT */
 };
 
 /* level output info */
@@ -139,6 +229,9 @@ static const char * const color_output_info[] =
 /* ulog local object */
 static struct rt_ulog ulog = { 0 };
 static RT_DEFINE_SPINLOCK(_spinlock);
+#ifdef ULOG_USING_RATE_LIMIT
+static RT_DEFINE_SPINLOCK(_rate_spinlock);
+#endif /* ULOG_USING_RATE_LIMIT */
 
 rt_size_t ulog_strcpy(rt_size_t cur_len, char *dst, const char *src)
 {
@@ -625,6 +718,196 @@ static void do_output(rt_uint32_t level, const char *tag, rt_bool_t is_raw, cons
     }
 }
 
+#if defined(ULOG_USING_FILTER) || defined(ULOG_USING_RATE_LIMIT)
+/* FNV-1a of the tag, as far as the filter compares it */
+static rt_uint32_t tag_hash(const char *tag)
+{
+    rt_uint32_t hash = 2166136261UL;
+    rt_size_t len;
+
+    for (len = 0; len < ULOG_FILTER_TAG_MAX_LEN && tag[len] != '\0'; len++)
+    {
+        hash ^= (rt_uint8_t)tag[len];
+        hash *= 16777619UL;
+    }
+
+    return hash;
+}
+#endif /* defined(ULOG_USING_FILTER) || defined(ULOG_USING_RATE_LIMIT) */
+
+#ifdef ULOG_USING_RATE_LIMIT
+
+/*
+ * add the tokens of the ticks since the last refill, the caller holds _rate_spinlock
+ * and passes the rate it read under the lock, never 0
+ */
+static void rate_bucket_refill(struct ulog_rate_bucket *bucket, rt_uint32_t rate, rt_tick_t now)
+{
+    rt_uint32_t capacity = ulog.rate.burst * RT_TICK_PER_SECOND;
+    rt_tick_t elapsed = now - bucket->last_tick;
+
+    bucket->last_tick = now;
+    if (elapsed > capacity / rate)
+    {
+        bucket->tokens = capacity;
+    }
+    else
+    {
+        bucket->tokens += elapsed * rate;
+        if (bucket->tokens > capacity)
+        {
+            bucket->tokens = capacity;
+        }
+    }
+}
+
+/* find the bucket of the tag, RT_NULL when the table is full */
+static struct ulog_rate_bucket *rate_bucket_get(const char *tag)
+{
+    struct ulog_rate_bucket *bucket;
+    rt_size_t index = tag_hash(tag) % ULOG_RATE_LIMIT_TAG_NR, probe;
+
+    for (probe = 0; probe < ULOG_RATE_LIMIT_TAG_NR; probe++)
+    {
+        bucket = &ulog.rate.bucket[(index + probe) % ULOG_RATE_LIMIT_TAG_NR];
+        if (!bucket->used)
+        {
+            /* a new tag starts with a full bucket, the tag is copied as the caller may reuse it */
+            bucket->used = RT_TRUE;
+            rt_strncpy(bucket->tag, tag, ULOG_FILTER_TAG_MAX_LEN);
+            bucket->tag[ULOG_FILTER_TAG_MAX_LEN] = '\0';
+            bucket->tokens = ulog.rate.burst * RT_TICK_PER_SECOND;
+            bucket->last_tick = rt_tick_get();
+            return bucket;
+        }
+        else if (!rt_strncmp(bucket->tag, tag, ULOG_FILTER_TAG_MAX_LEN))
+        {
+            return bucket;
+        }
+    }
+
+    return RT_NULL;
+}
+
+/* take a token of the tag, RT_FALSE if its log is suppressed */
+static rt_bool_t rate_limit_take(const char *tag)
+{
+    struct ulog_rate_bucket *bucket;
+    rt_bool_t allowed = RT_TRUE;
+    rt_uint32_t rate;
+    rt_base_t level;
+
+    /* a hint only, ulog_rate_limit_set() may disable it before the lock is taken */
+    if (ulog.rate.rate == 0)
+    {
+        return RT_TRUE;
+    }
+
+    level = rt_spin_lock_irqsave(&_rate_spinlock);
+    rate = ulog.rate.rate;
+    /* the tags out of the table are not limited */
+    bucket = rate > 0 ? rate_bucket_get(tag) : RT_NULL;
+    if (bucket)
+    {
+        rate_bucket_refill(bucket, rate, rt_tick_get());
+        if (bucket->tokens >= RT_TICK_PER_SECOND)
+        {
+            bucket->tokens -= RT_TICK_PER_SECOND;
+        }
+        else
+        {
+            bucket->suppressed++;
+            bucket->suppressed_total++;
+            allowed = RT_FALSE;
+        }
+    }
+    rt_spin_unlock_irqrestore(&_rate_spinlock, level);
+
+    return allowed;
+}
+
+/* report the suppressed logs once in a period, from the thread context */
+static void rate_limit_report_check(void)
+{
+    rt_tick_t now = rt_tick_get();
+
+    if (rt_interrupt_get_nest() == 0
+            && now - ulog.rate.report_tick >= rt_tick_from_millisecond(ULOG_RATE_LIMIT_REPORT_PERIOD))
+    {
+        ulog.rate.report_tick = now;
+        ulog_rate_limit_flush();
+    }
+}
+
+/**
+ * set the rate limit of each tag
+ *
+ * @param rate logs per second of each tag, 0: disable the rate limit
+ * @param burst logs a tag can output at once
+ */
+void ulog_rate_limit_set(rt_uint32_t rate, rt_uint32_t burst)
+{
+    rt_base_t level;
+    int index;
+
+    RT_ASSERT(rate == 0 || burst > 0);
+
+    level = rt_spin_lock_irqsave(&_rate_spinlock);
+    ulog.rate.rate = rate;
+    ulog.rate.burst = burst;
+    for (index = 0; index < ULOG_RATE_LIMIT_TAG_NR; index++)
+    {
+        ulog.rate.bucket[index].tokens = burst * RT_TICK_PER_SECOND;
+    }
+    rt_spin_unlock_irqrestore(&_rate_spinlock, level);
+}
+
+/**
+ * output a warning with the count of the suppressed logs of each tag,
+ * the tags still over their rate are reported later
+ */
+void ulog_rate_limit_flush(void)
+{
+    struct ulog_rate_bucket *bucket;
+    rt_uint32_t suppressed;
+    char tag[ULOG_FILTER_TAG_MAX_LEN + 1];
+    rt_base_t level;
+    int index;
+
+    if (!ulog.init_ok || rt_atomic_flag_test_and_set(&ulog.rate.reporting))
+    {
+        return;
+    }
+
+    for (index = 0; index < ULOG_RATE_LIMIT_TAG_NR; index++)
+    {
+        bucket = &ulog.rate.bucket[index];
+        suppressed = 0;
+
+        level = rt_spin_lock_irqsave(&_rate_spinlock);
+        if (bucket->used && bucket->suppressed > 0 && ulog.rate.rate > 0)
+        {
+            /* the report takes a token like the logs of the tag */
+            rate_bucket_refill(bucket, ulog.rate.rate, rt_tick_get());
+            if (bucket->tokens >= RT_TICK_PER_SECOND)
+            {
+                suppressed = bucket->suppressed;
+                bucket->suppressed = 0;
+                rt_memcpy(tag, bucket->tag, sizeof(tag));
+            }
+        }
+        rt_spin_unlock_irqrestore(&_rate_spinlock, level);
+
+        if (suppressed > 0)
+        {
+            ulog_output(LOG_LVL_WARNING, tag, RT_TRUE, "%u logs suppressed", suppressed);
+        }
+    }
+
+    rt_atomic_flag_clear(&ulog.rate.reporting);
+}
+#endif /* ULOG_USING_RATE_LIMIT */
+
 /**
  * output the log by variable argument list
  *
@@ -658,6 +941,10 @@ void ulog_voutput(rt_uint32_t level, const char *tag, rt_bool_t newline, const r
         return;
     }
 
+#ifdef ULOG_USING_RATE_LIMIT
+    rate_limit_report_check();
+#endif /* ULOG_USING_RATE_LIMIT */
+
 #ifdef ULOG_USING_FILTER
     /* level filter */
 #ifndef ULOG_USING_SYSLOG
@@ -679,6 +966,14 @@ void ulog_voutput(rt_uint32_t level, const char *tag, rt_bool_t newline, const r
     }
 #endif /* ULOG_USING_FILTER */
 
+#ifdef ULOG_USING_RATE_LIMIT
+    /* the assert logs are never suppressed */
+    if (level != LOG_LVL_ASSERT && !rate_limit_take(tag))
+    {
+        return;
+    }
+#endif /* ULOG_USING_RATE_LIMIT */
+
     /* get log buffer */
     log_buf = get_log_buf();
 
@@ -837,161 +1132,1020 @@ void ulog_hexdump(const char *tag, rt_size_t width, const rt_uint8_t *buf, rt_si
     va_end(args);
 }
 
-#ifdef ULOG_USING_FILTER
-/**
- * Set the filter's level by different backend.
- * The log on this backend which level is less than it will stop output.
- *
- * @param be_name backend name
- * @param level The filter level. When the level is LOG_FILTER_LVL_SILENT, the log enter silent mode.
- *        When the level is LOG_FILTER_LVL_ALL, it will remove this tag's level filer.
- *        Then all level log will resume output.
- *
- * @return  0 : success
- *         -10: level is out of range
- */
-int ulog_be_lvl_filter_set(const char *be_name, rt_uint32_t level)
+#ifdef ULOG_USING_BINARY
+/* argument classes of the conversions of a binary log */
+enum ulog_bin_arg
 {
-    rt_slist_t *node = RT_NULL;
-    ulog_backend_t backend;
-    int result = RT_EOK;
-
-    if (level > LOG_FILTER_LVL_ALL)
-        return -RT_EINVAL;
-
-    if (!ulog.init_ok)
-        return result;
+    ULOG_BIN_ARG_NONE,
+    ULOG_BIN_ARG_INT,
+    ULOG_BIN_ARG_LONG,
+    ULOG_BIN_ARG_LLONG,
+    ULOG_BIN_ARG_SIZE,
+    ULOG_BIN_ARG_PTR,
+    ULOG_BIN_ARG_DOUBLE,
+    ULOG_BIN_ARG_STR,
+};
 
-    for (node = rt_slist_first(&ulog.backend_list); node; node = rt_slist_next(node))
-    {
-        backend = rt_slist_entry(node, struct ulog_backend, list);
-        if (rt_strncmp(backend->name, be_name, RT_NAME_MAX) == 0)
-        {
-            backend->out_level = level;
-        }
-    }
+/* one argument of any class */
+union ulog_bin_value
+{
+    int i;
+    long l;
+    long long ll;
+    rt_size_t z;
+    void *p;
+    double d;
+};
 
-    return result;
-}
+static const rt_uint8_t bin_arg_size[] =
+{
+    0,
+    sizeof(int),
+    sizeof(long),
+    sizeof(long long),
+    sizeof(rt_size_t),
+    sizeof(void *),
+    sizeof(double),
+    0,
+};
 
 /**
- * Set the filter's level by different tag.
- * The log on this tag which level is less than it will stop output.
- *
- * example:
- *     // the example tag log enter silent mode
- *     ulog_set_filter_lvl("example", LOG_FILTER_LVL_SILENT);
- *     // the example tag log which level is less than INFO level will stop output
- *     ulog_set_filter_lvl("example", LOG_LVL_INFO);
- *     // remove example tag's level filter, all level log will resume output
- *     ulog_set_filter_lvl("example", LOG_FILTER_LVL_ALL);
+ * parse a conversion by the rules of rt_vsnprintf()
  *
- * @param tag log tag
- * @param level The filter level. When the level is LOG_FILTER_LVL_SILENT, the log enter silent mode.
- *        When the level is LOG_FILTER_LVL_ALL, it will remove this tag's level filer.
- *        Then all level log will resume output.
+ * @param fmt the character after '%'
+ * @param stars the number of '*' arguments taken before the value
+ * @param arg the argument class of the value
  *
- * @return  0 : success
- *         -5 : no memory
- *         -10: level is out of range
+ * @return the conversion character
  */
-int ulog_tag_lvl_filter_set(const char *tag, rt_uint32_t level)
+static const char *bin_parse(const char *fmt, int *stars, enum ulog_bin_arg *arg)
 {
-    rt_slist_t *node;
-    ulog_tag_lvl_filter_t tag_lvl = RT_NULL;
-    int result = RT_EOK;
+    char qualifier = 0;
 
-    if (level > LOG_FILTER_LVL_ALL)
-        return -RT_EINVAL;
+    *stars = 0;
+    while (*fmt == '-' || *fmt == '+' || *fmt == ' ' || *fmt == '#' || *fmt == '0')
+        fmt++;
 
-    if (!ulog.init_ok)
-        return result;
+    if (*fmt == '*')
+    {
+        (*stars)++;
+        fmt++;
+    }
+    else
+    {
+        while (*fmt >= '0' && *fmt <= '9')
+            fmt++;
+    }
 
-    /* lock output */
-    output_lock();
-    /* find the tag in list */
-    for (node = rt_slist_first(ulog_tag_lvl_list_get()); node; node = rt_slist_next(node))
+    if (*fmt == '.')
     {
-        tag_lvl = rt_slist_entry(node, struct ulog_tag_lvl_filter, list);
-        if (!rt_strncmp(tag_lvl->tag, tag, ULOG_FILTER_TAG_MAX_LEN))
+        fmt++;
+        if (*fmt == '*')
         {
-            break;
+            (*stars)++;
+            fmt++;
         }
         else
         {
-            tag_lvl = RT_NULL;
+            while (*fmt >= '0' && *fmt <= '9')
+                fmt++;
         }
     }
-    /* find OK */
-    if (tag_lvl)
+
+    if (*fmt == 'h' || *fmt == 'l' ||
+#ifdef RT_KPRINTF_USING_LONGLONG
+        *fmt == 'L' ||
+#endif /* RT_KPRINTF_USING_LONGLONG */
+        *fmt == 'z')
     {
-        if (level == LOG_FILTER_LVL_ALL)
+        qualifier = *fmt++;
+#ifdef RT_KPRINTF_USING_LONGLONG
+        if (qualifier == 'l' && *fmt == 'l')
         {
-            /* remove current tag's level filter when input level is the lowest level */
-            rt_slist_remove(ulog_tag_lvl_list_get(), &tag_lvl->list);
-            rt_free(tag_lvl);
+            qualifier = 'L';
+            fmt++;
         }
+#endif /* RT_KPRINTF_USING_LONGLONG */
+        if (qualifier == 'h' && *fmt == 'h')
+            fmt++;
+    }
+
+    switch (*fmt)
+    {
+    case 'c':
+        *arg = ULOG_BIN_ARG_INT;
+        break;
+    case 's':
+        *arg = ULOG_BIN_ARG_STR;
+        break;
+    case 'p':
+        *arg = ULOG_BIN_ARG_PTR;
+        break;
+    case 'b':
+    case 'o':
+    case 'x':
+    case 'X':
+    case 'd':
+    case 'i':
+    case 'u':
+        if (qualifier == 'L')
+            *arg = ULOG_BIN_ARG_LLONG;
+        else if (qualifier == 'l')
+            *arg = ULOG_BIN_ARG_LONG;
+        else if (qualifier == 'z')
+            *arg = ULOG_BIN_ARG_SIZE;
         else
+            *arg = ULOG_BIN_ARG_INT;
+        break;
+    case 'e':
+    case 'E':
+    case 'G':
+    case 'g':
+    case 'f':
+    case 'F':
+        *arg = ULOG_BIN_ARG_DOUBLE;
+        break;
+    default:
+        *arg = ULOG_BIN_ARG_NONE;
+        break;
+    }
+
+    return fmt;
+}
+
+/* copy the arguments of the format, stops at the first one which does not fit */
+static rt_size_t bin_pack(rt_uint8_t *buf, const char *format, va_list args)
+{
+    rt_uint8_t *pos = buf, *end = buf + ULOG_BINARY_ARGS_SIZE;
+    union ulog_bin_value value;
+    enum ulog_bin_arg arg;
+    const char *str;
+    rt_size_t len;
+    int stars;
+
+    for (; *format != '\0'; format++)
+    {
+        if (*format != '%')
+            continue;
+
+        format = bin_parse(format + 1, &stars, &arg);
+        for (; stars > 0; stars--)
         {
-            /* update level */
-            tag_lvl->level = level;
+            value.i = va_arg(args, int);
+            if (pos + sizeof(int) > end)
+                return pos - buf;
+            rt_memcpy(pos, &value, sizeof(int));
+            pos += sizeof(int);
         }
-    }
-    else
-    {
-        /* only add the new tag's level filer when level is not LOG_FILTER_LVL_ALL */
-        if (level != LOG_FILTER_LVL_ALL)
+
+        switch (arg)
         {
-            /* new a tag's level filter */
-            tag_lvl = (ulog_tag_lvl_filter_t)rt_malloc(sizeof(struct ulog_tag_lvl_filter));
-            if (tag_lvl)
-            {
-                rt_memset(tag_lvl->tag, 0 , sizeof(tag_lvl->tag));
-                rt_strncpy(tag_lvl->tag, tag, ULOG_FILTER_TAG_MAX_LEN);
-                tag_lvl->level = level;
-                rt_slist_append(ulog_tag_lvl_list_get(), &tag_lvl->list);
-            }
-            else
-            {
-                result = -RT_ENOMEM;
-            }
+        case ULOG_BIN_ARG_INT:
+            value.i = va_arg(args, int);
+            break;
+        case ULOG_BIN_ARG_LONG:
+            value.l = va_arg(args, long);
+            break;
+        case ULOG_BIN_ARG_LLONG:
+            value.ll = va_arg(args, long long);
+            break;
+        case ULOG_BIN_ARG_SIZE:
+            value.z = va_arg(args, rt_size_t);
+            break;
+        case ULOG_BIN_ARG_PTR:
+            value.p = va_arg(args, void *);
+            break;
+        case ULOG_BIN_ARG_DOUBLE:
+            value.d = va_arg(args, double);
+            break;
+        case ULOG_BIN_ARG_STR:
+            /* the characters, as the string may be gone when it is formatted */
+            str = va_arg(args, const char *);
+            if (str == RT_NULL)
+                str = "(NULL)";
+            len = rt_strnlen(str, ULOG_BINARY_STR_MAX);
+            if (pos + 1 + len > end)
+                return pos - buf;
+            *pos++ = (rt_uint8_t)len;
+            rt_memcpy(pos, str, len);
+            pos += len;
+            break;
+        default:
+            break;
         }
+
+        if (bin_arg_size[arg] != 0)
+        {
+            if (pos + bin_arg_size[arg] > end)
+                return pos - buf;
+            rt_memcpy(pos, &value, bin_arg_size[arg]);
+            pos += bin_arg_size[arg];
+        }
+
+        if (*format == '\0')
+            break;
     }
-    /* unlock output */
-    output_unlock();
 
-    return result;
+    return pos - buf;
 }
 
 /**
- * get the level on tag's level filer
+ * reserve a record of len bytes, padding to the end of the ring first if it would wrap
  *
- * @param tag log tag
+ * @param ring the ring
+ * @param len the record length
+ * @param was_empty is set when the ring held nothing before
  *
- * @return It will return the lowest level when tag was not found.
- *         Other level will return when tag was found.
+ * @return the record, RT_NULL when the ring is full
  */
-rt_uint32_t ulog_tag_lvl_filter_get(const char *tag)
+static struct ulog_bin_head *bin_reserve(struct ulog_bin_ring *ring, rt_size_t len, rt_bool_t *was_empty)
 {
-    rt_slist_t *node;
-    ulog_tag_lvl_filter_t tag_lvl = RT_NULL;
-    rt_uint32_t level = LOG_FILTER_LVL_ALL;
-
-    if (!ulog.init_ok)
-        return level;
+    rt_atomic_t head, pos, need;
+    struct ulog_bin_head *pad;
 
-    /* lock output */
-    output_lock();
-    /* find the tag in list */
-    for (node = rt_slist_first(ulog_tag_lvl_list_get()); node; node = rt_slist_next(node))
+    len = ULOG_BIN_ALIGN(len);
+    head = rt_atomic_load(&ring->head);
+    do
     {
-        tag_lvl = rt_slist_entry(node, struct ulog_tag_lvl_filter, list);
-        if (!rt_strncmp(tag_lvl->tag, tag, ULOG_FILTER_TAG_MAX_LEN))
+        pos = head & (ULOG_BINARY_BUF_SIZE - 1);
+        need = len;
+        if (pos + len > ULOG_BINARY_BUF_SIZE)
+            need += ULOG_BINARY_BUF_SIZE - pos;
+
+        if (head + need - rt_atomic_load(&ring->tail) > ULOG_BINARY_BUF_SIZE)
         {
-            level = tag_lvl->level;
-            break;
+            rt_atomic_add(&ring->dropped, 1);
+            return RT_NULL;
         }
+    } while (!rt_atomic_compare_exchange_strong(&ring->head, &head, head + need));
+
+    *was_empty = (head == rt_atomic_load(&ring->tail));
+    if (need != len)
+    {
+        /* the reader skips the rest of the ring */
+        pad = (struct ulog_bin_head *)((rt_uint8_t *)ring->buf + pos);
+        rt_atomic_store(&pad->ctrl, ULOG_BIN_CTRL(ULOG_BIN_MAGIC_PAD, 0, ULOG_BINARY_BUF_SIZE - pos));
+        pos = 0;
+    }
+
+    return (struct ulog_bin_head *)((rt_uint8_t *)ring->buf + pos);
+}
+
+/* the oldest committed record, RT_NULL when there is none or it is still being written */
+static struct ulog_bin_head *bin_peek(struct ulog_bin_ring *ring)
+{
+    rt_atomic_t tail, ctrl;
+    struct ulog_bin_head *head;
+
+    for (tail = rt_atomic_load(&ring->tail); tail != rt_atomic_load(&ring->head); tail = rt_atomic_load(&ring->tail))
+    {
+        head = (struct ulog_bin_head *)((rt_uint8_t *)ring->buf + (tail & (ULOG_BINARY_BUF_SIZE - 1)));
+        ctrl = rt_atomic_load(&head->ctrl);
+        if (ULOG_BIN_CTRL_MAGIC(ctrl) == ULOG_BIN_MAGIC)
+            return head;
+        if (ULOG_BIN_CTRL_MAGIC(ctrl) != ULOG_BIN_MAGIC_PAD)
+            break;
+
+        rt_memset(head, 0, ULOG_BIN_CTRL_LEN(ctrl));
+        rt_atomic_add(&ring->tail, ULOG_BIN_CTRL_LEN(ctrl));
     }
+
+    return RT_NULL;
+}
+
+/* give the record back to the writers, zeroed so that no stale magic is found later */
+static void bin_release(struct ulog_bin_ring *ring, struct ulog_bin_head *head)
+{
+    rt_size_t len = ULOG_BIN_ALIGN(ULOG_BIN_CTRL_LEN(rt_atomic_load(&head->ctrl)));
+
+    rt_memset(head, 0, len);
+    rt_atomic_add(&ring->tail, len);
+}
+
+/**
+ * record a binary log, the text is formatted later
+ *
+ * @note It takes no lock and can be called from any context, including ISR.
+ *
+ * @param level level
+ * @param tag tag, a string constant
+ * @param format output format, a string constant
+ * @param args variable argument list
+ */
+void ulog_bin_voutput(rt_uint32_t level, const char *tag, const char *format, va_list args)
+{
+    rt_uint8_t buf[ULOG_BINARY_ARGS_SIZE];
+    struct ulog_bin_ring *ring;
+    struct ulog_bin_head *head;
+    rt_bool_t was_empty;
+    rt_size_t len;
+
+    RT_ASSERT(tag);
+    RT_ASSERT(format);
+    RT_ASSERT(level <= LOG_LVL_DBG);
+
+    if (!ulog.init_ok)
+    {
+        return;
+    }
+
+#ifdef ULOG_USING_FILTER
+    /* the global level here, the others when the record is formatted */
+    if (level > ulog.filter.level)
+    {
+        return;
+    }
+#endif /* ULOG_USING_FILTER */
+
+#ifdef ULOG_USING_RATE_LIMIT
+    if (level != LOG_LVL_ASSERT && !rate_limit_take(tag))
+    {
+        return;
+    }
+#endif /* ULOG_USING_RATE_LIMIT */
+
+    len = bin_pack(buf, format, args);
+#ifdef RT_USING_SMP
+    ring = &ulog.bin_ring[rt_hw_cpu_id()];
+#else
+    ring = &ulog.bin_ring[0];
+#endif /* RT_USING_SMP */
+    head = bin_reserve(ring, sizeof(struct ulog_bin_head) + len, &was_empty);
+    if (head == RT_NULL)
+    {
+        return;
+    }
+
+    head->format = (rt_ubase_t)format;
+    head->tag = (rt_ubase_t)tag;
+    head->tick = rt_tick_get();
+    rt_memcpy(head + 1, buf, len);
+    /* commit, the reader stops at a record without magic */
+    rt_atomic_store(&head->ctrl, ULOG_BIN_CTRL(ULOG_BIN_MAGIC, level, sizeof(struct ulog_bin_head) + len));
+
+#ifdef ULOG_USING_ASYNC_OUTPUT
+    /* the reader drains all records on one notice, it may be waiting for this one to be committed */
+    if (was_empty || (rt_atomic_load(&ring->tail) & (ULOG_BINARY_BUF_SIZE - 1)) ==
+                     (rt_atomic_t)((rt_uint8_t *)head - (rt_uint8_t *)ring->buf))
+    {
+        rt_sem_release(&ulog.async_notice);
+    }
+#endif /* ULOG_USING_ASYNC_OUTPUT */
+}
+
+/**
+ * record a binary log
+ *
+ * @param level level
+ * @param tag tag, a string constant
+ * @param format output format, a string constant
+ * @param ... args
+ */
+void ulog_bin_output(rt_uint32_t level, const char *tag, const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    ulog_bin_voutput(level, tag, format, args);
+    va_end(args);
+}
+
+/* take len bytes of the arguments, RT_FALSE when they have run out */
+rt_inline rt_bool_t bin_take(const rt_uint8_t **pos, const rt_uint8_t *end, void *value, rt_size_t len)
+{
+    if (*pos + len > end)
+    {
+        return RT_FALSE;
+    }
+    rt_memcpy(value, *pos, len);
+    *pos += len;
+
+    return RT_TRUE;
+}
+
+/* format one conversion with the '*' arguments taken before it */
+#define BIN_SNPRINTF(value)                                                                          \
+    ((stars == 0) ? rt_snprintf(buf + log_len, size - log_len, spec, value) :                        \
+     (stars == 1) ? rt_snprintf(buf + log_len, size - log_len, spec, star[0], value) :               \
+                    rt_snprintf(buf + log_len, size - log_len, spec, star[0], star[1], value))
+
+/**
+ * format the text of a binary log record, without head and newline
+ *
+ * @param head the record, the format must still be mapped at its address
+ * @param buf output buffer
+ * @param size buffer size, including the string end sign
+ *
+ * @return the text length, the text stops at an argument cut off by ULOG_BINARY_ARGS_SIZE
+ */
+rt_size_t ulog_bin_format(const struct ulog_bin_head *head, char *buf, rt_size_t size)
+{
+    const char *format = (const char *)head->format, *conv;
+    const rt_uint8_t *pos = (const rt_uint8_t *)(head + 1);
+    const rt_uint8_t *end = (const rt_uint8_t *)head + ULOG_BIN_CTRL_LEN(head->ctrl);
+    char spec[16], str[ULOG_BINARY_STR_MAX + 1];
+    union ulog_bin_value value;
+    enum ulog_bin_arg arg;
+    rt_size_t log_len = 0, spec_len;
+    int stars, star[2], index, fmt_result;
+    rt_uint32_t dropped = 0;
+    rt_uint8_t str_len;
+
+    RT_ASSERT(head);
+    RT_ASSERT(buf);
+    RT_ASSERT(size > 0);
+
+    if (format == RT_NULL)
+    {
+        /* a drop notice */
+        bin_take(&pos, end, &dropped, sizeof(rt_uint32_t));
+        fmt_result = rt_snprintf(buf, size, "%u logs dropped", dropped);
+        return (fmt_result > -1 && (rt_size_t)fmt_result < size) ? (rt_size_t)fmt_result : size - 1;
+    }
+
+    while (*format != '\0' && log_len + 1 < size)
+    {
+        if (*format != '%')
+        {
+            buf[log_len++] = *format++;
+            continue;
+        }
+
+        conv = bin_parse(format + 1, &stars, &arg);
+        for (index = 0; index < stars; index++)
+        {
+            if (!bin_take(&pos, end, &star[index], sizeof(int)))
+                goto __exit;
+        }
+
+        /* rt_snprintf() with the conversion alone gives the same text as inside the format */
+        spec_len = conv - format + (*conv != '\0');
+        if (spec_len >= sizeof(spec))
+            goto __exit;
+        rt_memcpy(spec, format, spec_len);
+        spec[spec_len] = '\0';
+
+        switch (arg)
+        {
+        case ULOG_BIN_ARG_STR:
+            if (!bin_take(&pos, end, &str_len, 1) || !bin_take(&pos, end, str, str_len))
+                goto __exit;
+            str[str_len] = '\0';
+            fmt_result = BIN_SNPRINTF(str);
+            break;
+        case ULOG_BIN_ARG_NONE:
+            fmt_result = BIN_SNPRINTF(0);
+            break;
+        default:
+            if (!bin_take(&pos, end, &value, bin_arg_size[arg]))
+                goto __exit;
+            if (arg == ULOG_BIN_ARG_INT)
+                fmt_result = BIN_SNPRINTF(value.i);
+            else if (arg == ULOG_BIN_ARG_LONG)
+                fmt_result = BIN_SNPRINTF(value.l);
+            else if (arg == ULOG_BIN_ARG_LLONG)
+                fmt_result = BIN_SNPRINTF(value.ll);
+            else if (arg == ULOG_BIN_ARG_SIZE)
+                fmt_result = BIN_SNPRINTF(value.z);
+            else if (arg == ULOG_BIN_ARG_PTR)
+                fmt_result = BIN_SNPRINTF(value.p);
+            else
+                fmt_result = BIN_SNPRINTF(value.d);
+            break;
+        }
+
+        if (fmt_result > -1 && log_len + fmt_result < size)
+            log_len += fmt_result;
+        else
+            log_len = size - 1;
+        format = conv + (*conv != '\0');
+    }
+
+__exit:
+    buf[log_len] = '\0';
+
+    return log_len;
+}
+
+/* ulog_head_formater() with the tick of the record, the thread is not recorded */
+static rt_size_t bin_head_formater(char *log_buf, rt_uint32_t level, const char *tag, rt_tick_t tick)
+{
+    rt_size_t log_len = 0;
+
+#ifdef ULOG_USING_COLOR
+    if (color_output_info[level])
+    {
+        log_len += ulog_strcpy(log_len, log_buf + log_len, CSI_START);
+        log_len += ulog_strcpy(log_len, log_buf + log_len, color_output_info[level]);
+    }
+#endif /* ULOG_USING_COLOR */
+
+#ifdef ULOG_OUTPUT_TIME
+    log_buf[log_len] = '[';
+    log_len += 1 + ulog_ultoa(log_buf + log_len + 1, tick);
+    log_buf[log_len++] = ']';
+#endif /* ULOG_OUTPUT_TIME */
+
+#ifdef ULOG_OUTPUT_LEVEL
+#ifdef ULOG_OUTPUT_TIME
+    log_len += ulog_strcpy(log_len, log_buf + log_len, " ");
+#endif
+    log_len += ulog_strcpy(log_len, log_buf + log_len, level_output_info[level]);
+#endif /* ULOG_OUTPUT_LEVEL */
+
+#ifdef ULOG_OUTPUT_TAG
+#if !defined(ULOG_OUTPUT_LEVEL) && defined(ULOG_OUTPUT_TIME)
+    log_len += ulog_strcpy(log_len, log_buf + log_len, " ");
+#endif
+    log_len += ulog_strcpy(log_len, log_buf + log_len, tag);
+#endif /* ULOG_OUTPUT_TAG */
+
+    log_len += ulog_strcpy(log_len, log_buf + log_len, ": ");
+
+    return log_len;
+}
+
+/* format a record as a log line and output it to all backends */
+static void bin_output_record(const struct ulog_bin_head *head)
+{
+    rt_uint32_t level = ULOG_BIN_CTRL_LEVEL(head->ctrl);
+    const char *tag = head->format ? (const char *)head->tag : "ulog";
+    char *log_buf = ulog.log_buf_bin;
+    rt_size_t log_len;
+
+#ifdef ULOG_USING_FILTER
+    if (level > ulog_tag_lvl_filter_get(tag) || !rt_strstr(tag, ulog.filter.tag))
+    {
+        return;
+    }
+#endif /* ULOG_USING_FILTER */
+
+    log_len = bin_head_formater(log_buf, level, tag, head->tick);
+    log_len += ulog_bin_format(head, log_buf + log_len, ULOG_LINE_BUF_SIZE - log_len);
+    log_len = ulog_tail_formater(log_buf, log_len, RT_TRUE, level);
+
+#ifdef ULOG_USING_FILTER
+    if (ulog.filter.keyword[0] != '\0' && !rt_strstr(log_buf, ulog.filter.keyword))
+    {
+        return;
+    }
+#endif /* ULOG_USING_FILTER */
+
+    ulog_output_to_all_backend(level, tag, RT_FALSE, log_buf, log_len);
+}
+
+/* a drop notice for the records lost since the last one, RT_FALSE if there were none */
+static rt_bool_t bin_drop_notice(struct ulog_bin_ring *ring, struct ulog_bin_head *notice)
+{
+    rt_uint32_t dropped = (rt_uint32_t)rt_atomic_exchange(&ring->dropped, 0);
+
+    if (dropped == 0)
+    {
+        return RT_FALSE;
+    }
+
+    notice->ctrl = ULOG_BIN_CTRL(ULOG_BIN_MAGIC, LOG_LVL_WARNING, sizeof(struct ulog_bin_head) + sizeof(rt_uint32_t));
+    notice->format = 0;
+    notice->tag = 0;
+    notice->tick = rt_tick_get();
+    rt_memcpy(notice + 1, &dropped, sizeof(rt_uint32_t));
+
+    return RT_TRUE;
+}
+
+/**
+ * format the binary logs to all backends
+ *
+ * @note ulog_async_output() and ulog_flush() call it, nothing is done while it is disabled.
+ */
+void ulog_bin_async_output(void)
+{
+    rt_atomic_t notice[ULOG_BIN_ALIGN(sizeof(struct ulog_bin_head) + sizeof(rt_uint32_t)) / sizeof(rt_atomic_t)];
+    struct ulog_bin_head *head;
+    int cpu;
+
+    if (!ulog.init_ok || !ulog.bin_async_enabled)
+    {
+        return;
+    }
+    /* another reader is at it */
+    if (rt_atomic_flag_test_and_set(&ulog.bin_reading))
+    {
+        return;
+    }
+
+    for (cpu = 0; cpu < RT_CPUS_NR; cpu++)
+    {
+        if (bin_drop_notice(&ulog.bin_ring[cpu], (struct ulog_bin_head *)notice))
+        {
+            bin_output_record((struct ulog_bin_head *)notice);
+        }
+        while ((head = bin_peek(&ulog.bin_ring[cpu])) != RT_NULL)
+        {
+            bin_output_record(head);
+            bin_release(&ulog.bin_ring[cpu], head);
+        }
+    }
+
+    rt_atomic_flag_clear(&ulog.bin_reading);
+#ifdef ULOG_USING_RATE_LIMIT
+    rate_limit_report_check();
+#endif /* ULOG_USING_RATE_LIMIT */
+}
+
+/**
+ * enable or disable the formatting of the binary logs on the target
+ * the records are left for ulog_bin_read() when it is disabled
+ *
+ * @param enabled RT_TRUE: enabled, RT_FALSE: disabled
+ */
+void ulog_bin_async_output_enabled(rt_bool_t enabled)
+{
+    ulog.bin_async_enabled = enabled;
+#ifdef ULOG_USING_ASYNC_OUTPUT
+    /* the writers signal an empty ring only, wake the reader for the records kept meanwhile */
+    if (enabled && ulog.init_ok)
+    {
+        rt_sem_release(&ulog.async_notice);
+    }
+#endif /* ULOG_USING_ASYNC_OUTPUT */
+}
+
+/**
+ * take the binary log records out for decoding on the host
+ *
+ * @param buf output buffer aligned to rt_atomic_t, whole records are copied, each aligned as in the ring
+ * @param size buffer size
+ *
+ * @return the copied size, 0 when there is no record or another reader is at it
+ */
+rt_size_t ulog_bin_read(void *buf, rt_size_t size)
+{
+    rt_atomic_t notice[ULOG_BIN_ALIGN(sizeof(struct ulog_bin_head) + sizeof(rt_uint32_t)) / sizeof(rt_atomic_t)];
+    struct ulog_bin_head *head;
+    rt_size_t read_len = 0, len;
+    int cpu;
+
+    RT_ASSERT(buf);
+
+    if (!ulog.init_ok || rt_atomic_flag_test_and_set(&ulog.bin_reading))
+    {
+        return 0;
+    }
+
+    for (cpu = 0; cpu < RT_CPUS_NR; cpu++)
+    {
+        if (bin_drop_notice(&ulog.bin_ring[cpu], (struct ulog_bin_head *)notice))
+        {
+            len = ULOG_BIN_ALIGN(ULOG_BIN_CTRL_LEN(notice[0]));
+            if (read_len + len > size)
+            {
+                /* keep the count for the next read */
+                rt_atomic_add(&ulog.bin_ring[cpu].dropped, *(rt_uint32_t *)((struct ulog_bin_head *)notice + 1));
+                break;
+            }
+            rt_memcpy((rt_uint8_t *)buf + read_len, notice, len);
+            read_len += len;
+        }
+        while ((head = bin_peek(&ulog.bin_ring[cpu])) != RT_NULL)
+        {
+            /* the padding is zero in the ring as well */
+            len = ULOG_BIN_ALIGN(ULOG_BIN_CTRL_LEN(head->ctrl));
+            if (read_len + len > size)
+            {
+                goto __exit;
+            }
+            rt_memcpy((rt_uint8_t *)buf + read_len, head, len);
+            read_len += len;
+            bin_release(&ulog.bin_ring[cpu], head);
+        }
+    }
+
+__exit:
+    rt_atomic_flag_clear(&ulog.bin_reading);
+
+    return read_len;
+}
+
+#ifdef ULOG_USING_ASYNC_OUTPUT
+#define BIN_PENDING_NONE    0
+#define BIN_PENDING_READY   1
+#define BIN_PENDING_BUSY    2
+
+/*
+ * what the reader finds in the rings: BIN_PENDING_READY for a committed record,
+ * BIN_PENDING_BUSY when the oldest record is reserved but not committed yet,
+ * BIN_PENDING_NONE while the records are kept for ulog_bin_read()
+ */
+static int bin_pending(void)
+{
+    struct ulog_bin_head *head;
+    rt_atomic_t pos, ctrl;
+    int cpu, pending = BIN_PENDING_NONE;
+
+    /* ulog_bin_async_output() leaves them in the rings, do not wake up for them */
+    if (!ulog.bin_async_enabled)
+    {
+        return BIN_PENDING_NONE;
+    }
+
+    for (cpu = 0; cpu < RT_CPUS_NR; cpu++)
+    {
+        /* look only, the padding is skipped by the reader */
+        for (pos = rt_atomic_load(&ulog.bin_ring[cpu].tail); pos != rt_atomic_load(&ulog.bin_ring[cpu].head);
+             pos += ULOG_BIN_CTRL_LEN(ctrl))
+        {
+            head = (struct ulog_bin_head *)((rt_uint8_t *)ulog.bin_ring[cpu].buf + (pos & (ULOG_BINARY_BUF_SIZE - 1)));
+            ctrl = rt_atomic_load(&head->ctrl);
+            if (ULOG_BIN_CTRL_MAGIC(ctrl) == ULOG_BIN_MAGIC)
+                return BIN_PENDING_READY;
+            if (ULOG_BIN_CTRL_MAGIC(ctrl) != ULOG_BIN_MAGIC_PAD)
+            {
+                pending = BIN_PENDING_BUSY;
+                break;
+            }
+        }
+    }
+
+    return pending;
+}
+#endif /* ULOG_USING_ASYNC_OUTPUT */
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void ulog_bin(uint8_t argc, char **argv)
+{
+    rt_atomic_t buf[ULOG_BIN_ALIGN(sizeof(struct ulog_bin_head) + ULOG_BINARY_ARGS_SIZE) / sizeof(rt_atomic_t)];
+    rt_size_t len, index, total = 0;
+    int cpu;
+
+    if (argc > 1 && !rt_strcmp(argv[1], "dump"))
+    {
+        /* records are copied one by one, bigger chunks would not fit on the stack */
+        while ((len = ulog_bin_read(buf, sizeof(buf))) > 0)
+        {
+            rt_kprintf("ulgb:");
+            for (index = 0; index < len; index++)
+            {
+                rt_kprintf("%02x", ((rt_uint8_t *)buf)[index]);
+            }
+            rt_kprintf("\n");
+            total += len;
+        }
+        rt_kprintf("%u bytes\n", (rt_uint32_t)total);
+    }
+    else if (argc > 2 && !rt_strcmp(argv[1], "text"))
+    {
+        ulog_bin_async_output_enabled(!rt_strcmp(argv[2], "on"));
+    }
+    else if (argc == 1)
+    {
+        rt_kprintf("text output: %s\n", ulog.bin_async_enabled ? "on" : "off");
+        for (cpu = 0; cpu < RT_CPUS_NR; cpu++)
+        {
+            rt_kprintf("cpu %d: %u of %u bytes used, %u logs dropped\n", cpu,
+                       (rt_uint32_t)(rt_atomic_load(&ulog.bin_ring[cpu].head) - rt_atomic_load(&ulog.bin_ring[cpu].tail)),
+                       ULOG_BINARY_BUF_SIZE, (rt_uint32_t)rt_atomic_load(&ulog.bin_ring[cpu].dropped));
+        }
+    }
+    else
+    {
+        rt_kprintf("Please input: ulog_bin [dump | text on|off]\n");
+        rt_kprintf("  dump: print the records as 'ulgb:' lines for tools/ulog_bin.py\n");
+        rt_kprintf("  text: format the records on the target or keep them for dump\n");
+    }
+}
+MSH_CMD_EXPORT(ulog_bin, Show or dump the ulog binary logs);
+#endif /* RT_USING_FINSH */
+#endif /* ULOG_USING_BINARY */
+
+#ifdef ULOG_USING_FILTER
+/**
+ * Set the filter's level by different backend.
+ * The log on this backend which level is less than it will stop output.
+ *
+ * @param be_name backend name
+ * @param level The filter level. When the level is LOG_FILTER_LVL_SILENT, the log enter silent mode.
+ *        When the level is LOG_FILTER_LVL_ALL, it will remove this tag's level filer.
+ *        Then all level log will resume output.
+ *
+ * @return  0 : success
+ *         -10: level is out of range
+ */
+int ulog_be_lvl_filter_set(const char *be_name, rt_uint32_t level)
+{
+    rt_slist_t *node = RT_NULL;
+    ulog_backend_t backend;
+    int result = RT_EOK;
+
+    if (level > LOG_FILTER_LVL_ALL)
+        return -RT_EINVAL;
+
+    if (!ulog.init_ok)
+        return result;
+
+    for (node = rt_slist_first(&ulog.backend_list); node; node = rt_slist_next(node))
+    {
+        backend = rt_slist_entry(node, struct ulog_backend, list);
+        if (rt_strncmp(backend->name, be_name, RT_NAME_MAX) == 0)
+        {
+            backend->out_level = level;
+        }
+    }
+
+    return result;
+}
+
+static ulog_tag_lvl_filter_t tag_lvl_find(rt_slist_t *bucket, const char *tag)
+{
+    rt_slist_t *node;
+    ulog_tag_lvl_filter_t tag_lvl;
+
+    for (node = rt_slist_first(bucket); node; node = rt_slist_next(node))
+    {
+        tag_lvl = rt_slist_entry(node, struct ulog_tag_lvl_filter, hash_list);
+        if (!rt_strncmp(tag_lvl->tag, tag, ULOG_FILTER_TAG_MAX_LEN))
+        {
+            return tag_lvl;
+        }
+    }
+
+    return RT_NULL;
+}
+
+/* write a cache entry, the caller holds the output lock */
+static void tag_lvl_cache_store(struct ulog_tag_lvl_cache *cache, const union ulog_tag_key *key, rt_ubase_t value)
+{
+    rt_atomic_t seq = rt_atomic_load(&cache->seq);
+    rt_size_t index;
+
+    rt_atomic_store(&cache->seq, seq + 1);
+    rt_atomic_store(&cache->value, (rt_atomic_t)value);
+    for (index = 0; index < ULOG_TAG_KEY_WORDS; index++)
+    {
+        rt_atomic_store(&cache->tag[index], key->word[index]);
+    }
+    rt_atomic_store(&cache->seq, seq + 2);
+}
+
+/* move to the next generation, the caller holds the output lock */
+static void tag_lvl_cache_invalidate(void)
+{
+    static const union ulog_tag_key empty;
+    rt_ubase_t gen;
+    int index;
+
+    gen = (rt_atomic_load(&ulog.filter.tag_lvl_gen) + 1) & ULOG_TAG_LVL_GEN_MASK;
+    if (gen == 0)
+    {
+        /* the generation wrapped, empty the entries before the oldest ones match again */
+        for (index = 0; index < ULOG_FILTER_TAG_CACHE_SIZE; index++)
+        {
+            tag_lvl_cache_store(&ulog.filter.tag_lvl_cache[index], &empty, 0);
+        }
+        gen = 1;
+    }
+    rt_atomic_store(&ulog.filter.tag_lvl_gen, (rt_atomic_t)gen);
+}
+
+/**
+ * Set the filter's level by different tag.
+ * The log on this tag which level is less than it will stop output.
+ *
+ * example:
+ *     // the example tag log enter silent mode
+ *     ulog_set_filter_lvl("example", LOG_FILTER_LVL_SILENT);
+ *     // the example tag log which level is less than INFO level will stop output
+ *     ulog_set_filter_lvl("example", LOG_LVL_INFO);
+ *     // remove example tag's level filter, all level log will resume output
+ *     ulog_set_filter_lvl("example", LOG_FILTER_LVL_ALL);
+ *
+ * @param tag log tag
+ * @param level The filter level. When the level is LOG_FILTER_LVL_SILENT, the log enter silent mode.
+ *        When the level is LOG_FILTER_LVL_ALL, it will remove this tag's level filer.
+ *        Then all level log will resume output.
+ *
+ * @return  0 : success
+ *         -5 : no memory
+ *         -10: level is out of range
+ */
+int ulog_tag_lvl_filter_set(const char *tag, rt_uint32_t level)
+{
+    rt_slist_t *bucket;
+    ulog_tag_lvl_filter_t tag_lvl;
+    int result = RT_EOK;
+
+    if (level > LOG_FILTER_LVL_ALL)
+        return -RT_EINVAL;
+
+    if (!ulog.init_ok)
+        return result;
+
+    /* lock output */
+    output_lock();
+    bucket = &ulog.filter.tag_lvl_hash[tag_hash(tag) % ULOG_FILTER_TAG_HASH_SIZE];
+    tag_lvl = tag_lvl_find(bucket, tag);
+    /* find OK */
+    if (tag_lvl)
+    {
+        if (level == LOG_FILTER_LVL_ALL)
+        {
+            /* remove current tag's level filter when input level is the lowest level */
+            rt_slist_remove(ulog_tag_lvl_list_get(), &tag_lvl->list);
+            rt_slist_remove(bucket, &tag_lvl->hash_list);
+            ulog.filter.tag_lvl_num--;
+            rt_free(tag_lvl);
+        }
+        else
+        {
+            /* update level */
+            tag_lvl->level = level;
+        }
+    }
+    else
+    {
+        /* only add the new tag's level filer when level is not LOG_FILTER_LVL_ALL */
+        if (level != LOG_FILTER_LVL_ALL)
+        {
+            /* new a tag's level filter */
+            tag_lvl = (ulog_tag_lvl_filter_t)rt_malloc(sizeof(struct ulog_tag_lvl_filter));
+            if (tag_lvl)
+            {
+                rt_memset(tag_lvl->tag, 0 , sizeof(tag_lvl->tag));
+                rt_strncpy(tag_lvl->tag, tag, ULOG_FILTER_TAG_MAX_LEN);
+                tag_lvl->level = level;
+                rt_slist_init(&tag_lvl->hash_list);
+                rt_slist_append(ulog_tag_lvl_list_get(), &tag_lvl->list);
+                rt_slist_append(bucket, &tag_lvl->hash_list);
+                ulog.filter.tag_lvl_num++;
+            }
+            else
+            {
+                result = -RT_ENOMEM;
+            }
+        }
+    }
+    /* the cached levels are stale now */
+    tag_lvl_cache_invalidate();
+    /* unlock output */
+    output_unlock();
+
+    return result;
+}
+
+/**
+ * get the level on tag's level filer
+ *
+ * @param tag log tag
+ *
+ * @note The level is cached by the tag's content, a tag may live in any buffer.
+ *
+ * @return It will return the lowest level when tag was not found.
+ *         Other level will return when tag was found.
+ */
+rt_uint32_t ulog_tag_lvl_filter_get(const char *tag)
+{
+    struct ulog_tag_lvl_cache *cache;
+    ulog_tag_lvl_filter_t tag_lvl;
+    union ulog_tag_key key;
+    rt_uint32_t level = LOG_FILTER_LVL_ALL, hash;
+    rt_ubase_t gen, value;
+    rt_atomic_t seq;
+    rt_size_t index;
+
+    if (!ulog.init_ok || ulog.filter.tag_lvl_num == 0)
+        return level;
+
+    rt_memset(&key, 0, sizeof(key));
+    rt_strncpy(key.str, tag, ULOG_FILTER_TAG_MAX_LEN);
+    hash = tag_hash(tag);
+
+    /* the level cached for this tag, valid when the sequence did not move while reading */
+    gen = rt_atomic_load(&ulog.filter.tag_lvl_gen) & ULOG_TAG_LVL_GEN_MASK;
+    cache = &ulog.filter.tag_lvl_cache[hash % ULOG_FILTER_TAG_CACHE_SIZE];
+    seq = rt_atomic_load(&cache->seq);
+    if ((seq & 1) == 0)
+    {
+        value = rt_atomic_load(&cache->value);
+        for (index = 0; index < ULOG_TAG_KEY_WORDS && rt_atomic_load(&cache->tag[index]) == key.word[index]; index++);
+        if (index == ULOG_TAG_KEY_WORDS && (value >> 8) == gen && rt_atomic_load(&cache->seq) == seq)
+        {
+            return value & 0xFF;
+        }
+    }
+
+    /* lock output */
+    output_lock();
+    /* find the tag in table */
+    tag_lvl = tag_lvl_find(&ulog.filter.tag_lvl_hash[hash % ULOG_FILTER_TAG_HASH_SIZE], tag);
+    if (tag_lvl)
+    {
+        level = tag_lvl->level;
+    }
+    /* the generation does not move while the lock is held */
+    gen = rt_atomic_load(&ulog.filter.tag_lvl_gen) & ULOG_TAG_LVL_GEN_MASK;
+    tag_lvl_cache_store(cache, &key, gen << 8 | level);
     /* unlock output */
     output_unlock();
 
@@ -1256,6 +2410,51 @@ MSH_CMD_EXPORT(ulog_filter, Show ulog filter settings);
 #endif /* RT_USING_FINSH */
 #endif /* ULOG_USING_FILTER */
 
+#if defined(ULOG_USING_RATE_LIMIT) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+static void ulog_rate(uint8_t argc, char **argv)
+{
+    struct ulog_rate_bucket *bucket;
+    int index;
+
+    if (argc > 2)
+    {
+        if (atoi(argv[1]) >= 0 && atoi(argv[2]) > 0)
+        {
+            ulog_rate_limit_set(atoi(argv[1]), atoi(argv[2]));
+        }
+        else
+        {
+            rt_kprintf("Please input: ulog_rate <logs per second, 0: disable> <burst>.\n");
+        }
+        return;
+    }
+
+    rt_kprintf("--------------------------------------\n");
+    if (ulog.rate.rate == 0)
+    {
+        rt_kprintf("ulog rate limit: disabled\n");
+    }
+    else
+    {
+        rt_kprintf("ulog rate limit: %u logs/s, burst %u\n", ulog.rate.rate, ulog.rate.burst);
+    }
+    rt_kprintf("--------------------------------------\n");
+    rt_kprintf("suppressed logs of each tag:\n");
+    for (index = 0; index < ULOG_RATE_LIMIT_TAG_NR; index++)
+    {
+        bucket = &ulog.rate.bucket[index];
+        if (bucket->used && bucket->suppressed_total > 0)
+        {
+            rt_kprintf("%-*.*s: %u\n", ULOG_FILTER_TAG_MAX_LEN, ULOG_FILTER_TAG_MAX_LEN, bucket->tag,
+                       bucket->suppressed_total);
+        }
+    }
+}
+MSH_CMD_EXPORT(ulog_rate, Show or set ulog rate limit of each tag);
+#endif /* defined(ULOG_USING_RATE_LIMIT) && defined(RT_USING_FINSH) */
+
 rt_err_t ulog_backend_register(ulog_backend_t backend, const char *name, rt_bool_t support_color)
 {
     rt_base_t level;
@@ -1346,6 +2545,10 @@ void ulog_async_output(void)
     rt_rbb_blk_t log_blk;
     ulog_frame_t log_frame;
 
+#ifdef ULOG_USING_BINARY
+    ulog_bin_async_output();
+#endif /* ULOG_USING_BINARY */
+
     if (!ulog.async_enabled)
     {
         return;
@@ -1398,6 +2601,26 @@ void ulog_async_output_enabled(rt_bool_t enabled)
 rt_err_t ulog_async_waiting_log(rt_int32_t time)
 {
     rt_sem_control(&ulog.async_notice, RT_IPC_CMD_RESET, RT_NULL);
+#ifdef ULOG_USING_BINARY
+    switch (bin_pending())
+    {
+    case BIN_PENDING_READY:
+        /* the notice of a record written before the reset is gone */
+        return RT_EOK;
+    case BIN_PENDING_BUSY:
+        /*
+         * the writer signals when it commits the record, look again after a
+         * tick in case it is not scheduled, without spinning meanwhile
+         */
+        if (time < 0 || time > 1)
+        {
+            time = 1;
+        }
+        break;
+    default:
+        break;
+    }
+#endif /* ULOG_USING_BINARY */
     return rt_sem_take(&ulog.async_notice, time);
 }
 
@@ -1439,8 +2662,14 @@ void ulog_flush(void)
     if (!ulog.init_ok)
         return;
 
+#ifdef ULOG_USING_RATE_LIMIT
+    ulog_rate_limit_flush();
+#endif
+
 #ifdef ULOG_USING_ASYNC_OUTPUT
     ulog_async_output();
+#elif defined(ULOG_USING_BINARY)
+    ulog_bin_async_output();
 #endif
 
     /* flush all backends */
@@ -1454,8 +2683,38 @@ void ulog_flush(void)
     }
 }
 
+#if defined(ULOG_USING_ASYNC_OUTPUT) && defined(ULOG_USING_MEM_HINT)
+/* rt_rbb_create() with the log storage in bulk memory, rt_rbb_destroy() frees it */
+static rt_rbb_t async_rbb_create(rt_size_t buf_size, rt_size_t blk_max_num)
+{
+    rt_rbb_t rbb;
+    rt_uint8_t *buf;
+    rt_rbb_blk_t blk_set;
+
+    rbb = (rt_rbb_t)rt_malloc(sizeof(struct rt_rbb));
+    buf = (rt_uint8_t *)rt_malloc_hint(buf_size, RT_MEM_BULK);
+    blk_set = (rt_rbb_blk_t)rt_malloc(sizeof(struct rt_rbb_blk) * blk_max_num);
+    if (rbb == RT_NULL || buf == RT_NULL || blk_set == RT_NULL)
+    {
+        rt_free(blk_set);
+        rt_free(buf);
+        rt_free(rbb);
+        return RT_NULL;
+    }
+    rt_rbb_init(rbb, buf, buf_size, blk_set, blk_max_num);
+
+    return rbb;
+}
+#else
+#define async_rbb_create               rt_rbb_create
+#endif /* defined(ULOG_USING_ASYNC_OUTPUT) && defined(ULOG_USING_MEM_HINT) */
+
 int ulog_init(void)
 {
+#ifdef ULOG_USING_FILTER
+    int index;
+#endif
+
     if (ulog.init_ok)
         return 0;
 
@@ -1465,13 +2724,17 @@ int ulog_init(void)
 
 #ifdef ULOG_USING_FILTER
     rt_slist_init(ulog_tag_lvl_list_get());
+    for (index = 0; index < ULOG_FILTER_TAG_HASH_SIZE; index++)
+    {
+        rt_slist_init(&ulog.filter.tag_lvl_hash[index]);
+    }
 #endif
 
 #ifdef ULOG_USING_ASYNC_OUTPUT
     RT_ASSERT(ULOG_ASYNC_OUTPUT_STORE_LINES >= 2);
     ulog.async_enabled = RT_TRUE;
     /* async output ring block buffer */
-    ulog.async_rbb = rt_rbb_create(RT_ALIGN(ULOG_ASYNC_OUTPUT_BUF_SIZE, RT_ALIGN_SIZE), ULOG_ASYNC_OUTPUT_STORE_LINES);
+    ulog.async_rbb = async_rbb_create(RT_ALIGN(ULOG_ASYNC_OUTPUT_BUF_SIZE, RT_ALIGN_SIZE), ULOG_ASYNC_OUTPUT_STORE_LINES);
     if (ulog.async_rbb == RT_NULL)
     {
         rt_kprintf("Error: ulog init failed! No memory for async rbb.\n");
@@ -1485,6 +2748,15 @@ int ulog_init(void)
     ulog_global_filter_lvl_set(LOG_FILTER_LVL_ALL);
 #endif
 
+#ifdef ULOG_USING_BINARY
+    ulog.bin_async_enabled = RT_TRUE;
+#endif
+
+#ifdef ULOG_USING_RATE_LIMIT
+    ulog.rate.rate = ULOG_RATE_LIMIT_RATE;
+    ulog.rate.burst = ULOG_RATE_LIMIT_BURST;
+#endif
+
     ulog.init_ok = RT_TRUE;
 
     return 0;
@@ -1539,6 +2811,8 @@ void ulog_deinit(void)
             tag_lvl = rt_slist_entry(node, struct ulog_tag_lvl_filter, list);
             rt_free(tag_lvl);
         }
+        ulog.filter.tag_lvl_num = 0;
+        tag_lvl_cache_invalidate();
     }
 #endif /* ULOG_USING_FILTER */
 
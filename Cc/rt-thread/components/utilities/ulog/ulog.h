@@ -6,6 +6,8 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-08-25     armink       the first version
+ * 2026-10-18     Cc           add binary log mode
+ * 2026-10-18     Cc           hash the tag's level filter, add the tag rate limit
  */
 
 #ifndef _ULOG_H_
@@ -70,6 +72,14 @@ void ulog_global_filter_kw_set(const char *keyword);
 const char *ulog_global_filter_kw_get(void);
 #endif /* ULOG_USING_FILTER */
 
+#ifdef ULOG_USING_RATE_LIMIT
+/*
+ * rate limit of each tag
+ */
+void ulog_rate_limit_set(rt_uint32_t rate, rt_uint32_t burst);
+void ulog_rate_limit_flush(void);
+#endif /* ULOG_USING_RATE_LIMIT */
+
 /*
  * flush all backends's log
  */
@@ -84,6 +94,20 @@ void ulog_async_output_enabled(rt_bool_t enabled);
 rt_err_t ulog_async_waiting_log(rt_int32_t time);
 #endif
 
+#ifdef ULOG_USING_BINARY
+/*
+ * binary log API, LOG_X is routed to ulog_bin_output() in this mode
+ *
+ * NOTE: The format and the tag must be string constants, only their addresses are recorded.
+ */
+void ulog_bin_output(rt_uint32_t level, const char *tag, const char *format, ...);
+void ulog_bin_voutput(rt_uint32_t level, const char *tag, const char *format, va_list args);
+void ulog_bin_async_output(void);
+void ulog_bin_async_output_enabled(rt_bool_t enabled);
+rt_size_t ulog_bin_read(void *buf, rt_size_t size);
+rt_size_t ulog_bin_format(const struct ulog_bin_head *head, char *buf, rt_size_t size);
+#endif /* ULOG_USING_BINARY */
+
 /*
  * dump the hex format data to log
  */
@@ -6,6 +6,8 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-08-25     armink       the first version
+ * 2026-10-18     Cc           add binary log mode
+ * 2026-10-18     Cc           hash the tag's level filter, add the tag rate limit
  */
 
 #ifndef _ULOG_DEF_H_
@@ -76,25 +78,33 @@ extern "C" {
     #endif
 #endif /* !defined(LOG_LVL) */
 
-#if (LOG_LVL >= LOG_LVL_DBG) && (ULOG_OUTPUT_LVL >= LOG_LVL_DBG)
+#if (LOG_LVL >= LOG_LVL_DBG) && (ULOG_OUTPUT_LVL >= LOG_LVL_DBG) && defined(ULOG_USING_BINARY)
+    #define ulog_d(TAG, ...)           ulog_bin_output(LOG_LVL_DBG, TAG, __VA_ARGS__)
+#elif (LOG_LVL >= LOG_LVL_DBG) && (ULOG_OUTPUT_LVL >= LOG_LVL_DBG)
     #define ulog_d(TAG, ...)           ulog_output(LOG_LVL_DBG, TAG, RT_TRUE, __VA_ARGS__)
 #else
     #define ulog_d(TAG, ...)
 #endif /* (LOG_LVL >= LOG_LVL_DBG) && (ULOG_OUTPUT_LVL >= LOG_LVL_DBG) */
 
-#if (LOG_LVL >= LOG_LVL_INFO) && (ULOG_OUTPUT_LVL >= LOG_LVL_INFO)
+#if (LOG_LVL >= LOG_LVL_INFO) && (ULOG_OUTPUT_LVL >= LOG_LVL_INFO) && defined(ULOG_USING_BINARY)
+    #define ulog_i(TAG, ...)           ulog_bin_output(LOG_LVL_INFO, TAG, __VA_ARGS__)
+#elif (LOG_LVL >= LOG_LVL_INFO) && (ULOG_OUTPUT_LVL >= LOG_LVL_INFO)
     #define ulog_i(TAG, ...)           ulog_output(LOG_LVL_INFO, TAG, RT_TRUE, __VA_ARGS__)
 #else
     #define ulog_i(TAG, ...)
 #endif /* (LOG_LVL >= LOG_LVL_INFO) && (ULOG_OUTPUT_LVL >= LOG_LVL_INFO) */
 
-#if (LOG_LVL >= LOG_LVL_WARNING) && (ULOG_OUTPUT_LVL >= LOG_LVL_WARNING)
+#if (LOG_LVL >= LOG_LVL_WARNING) && (ULOG_OUTPUT_LVL >= LOG_LVL_WARNING) && defined(ULOG_USING_BINARY)
+    #define ulog_w(TAG, ...)           ulog_bin_output(LOG_LVL_WARNING, TAG, __VA_ARGS__)
+#elif (LOG_LVL >= LOG_LVL_WARNING) && (ULOG_OUTPUT_LVL >= LOG_LVL_WARNING)
     #define ulog_w(TAG, ...)           ulog_output(LOG_LVL_WARNING, TAG, RT_TRUE, __VA_ARGS__)
 #else
     #define ulog_w(TAG, ...)
 #endif /* (LOG_LVL >= LOG_LVL_WARNING) && (ULOG_OUTPUT_LVL >= LOG_LVL_WARNING) */
 
-#if (LOG_LVL >= LOG_LVL_ERROR) && (ULOG_OUTPUT_LVL >= LOG_LVL_ERROR)
+#if (LOG_LVL >= LOG_LVL_ERROR) && (ULOG_OUTPUT_LVL >= LOG_LVL_ERROR) && defined(ULOG_USING_BINARY)
+    #define ulog_e(TAG, ...)           ulog_bin_output(LOG_LVL_ERROR, TAG, __VA_ARGS__)
+#elif (LOG_LVL >= LOG_LVL_ERROR) && (ULOG_OUTPUT_LVL >= LOG_LVL_ERROR)
     #define ulog_e(TAG, ...)           ulog_output(LOG_LVL_ERROR, TAG, RT_TRUE, __VA_ARGS__)
 #else
     #define ulog_e(TAG, ...)
@@ -172,18 +182,73 @@ extern "C" {
 #define ULOG_FILTER_KW_MAX_LEN         15
 #endif
 
+/* buckets of the tag's level filter table */
+#ifndef ULOG_FILTER_TAG_HASH_SIZE
+#define ULOG_FILTER_TAG_HASH_SIZE      16
+#endif
+
+/* tag's levels cached by the tag content */
+#ifndef ULOG_FILTER_TAG_CACHE_SIZE
+#define ULOG_FILTER_TAG_CACHE_SIZE     64
+#endif
+
+/* logs per second of each tag */
+#ifndef ULOG_RATE_LIMIT_RATE
+#define ULOG_RATE_LIMIT_RATE           20
+#endif
+
+/* logs a tag can output at once */
+#ifndef ULOG_RATE_LIMIT_BURST
+#define ULOG_RATE_LIMIT_BURST          40
+#endif
+
+/* max tags tracked by the rate limit */
+#ifndef ULOG_RATE_LIMIT_TAG_NR
+#define ULOG_RATE_LIMIT_TAG_NR         32
+#endif
+
+/* period of the suppressed logs report, in ms */
+#ifndef ULOG_RATE_LIMIT_REPORT_PERIOD
+#define ULOG_RATE_LIMIT_REPORT_PERIOD  1000
+#endif
+
 #ifndef ULOG_NEWLINE_SIGN
 #define ULOG_NEWLINE_SIGN              "\r\n"
 #endif
 
 #define ULOG_FRAME_MAGIC               0x10
 
+/* binary log buffer size of each CPU */
+#ifndef ULOG_BINARY_BUF_SIZE
+#define ULOG_BINARY_BUF_SIZE           2048
+#endif
+
+/* max size of the arguments of one binary log */
+#ifndef ULOG_BINARY_ARGS_SIZE
+#define ULOG_BINARY_ARGS_SIZE          64
+#endif
+
+/* max length of a string argument of a binary log */
+#ifndef ULOG_BINARY_STR_MAX
+#define ULOG_BINARY_STR_MAX            32
+#endif
+
+#define ULOG_BIN_MAGIC                 0xB1
+#define ULOG_BIN_MAGIC_PAD             0xB0
+
+#define ULOG_BIN_CTRL(magic, level, len)   ((rt_uint32_t)(magic) | ((rt_uint32_t)(level) << 8) | ((rt_uint32_t)(len) << 16))
+#define ULOG_BIN_CTRL_MAGIC(ctrl)          ((rt_uint32_t)(ctrl) & 0xFF)
+#define ULOG_BIN_CTRL_LEVEL(ctrl)          (((rt_uint32_t)(ctrl) >> 8) & 0xFF)
+#define ULOG_BIN_CTRL_LEN(ctrl)            (((rt_uint32_t)(ctrl) >> 16) & 0xFFFF)
+
 /* tag's level filter */
 struct ulog_tag_lvl_filter
 {
     char tag[ULOG_FILTER_TAG_MAX_LEN + 1];
     rt_uint32_t level;
     rt_slist_t list;
+    /* node of the hashed table */
+    rt_slist_t hash_list;
 };
 typedef struct ulog_tag_lvl_filter *ulog_tag_lvl_filter_t;
 
@@ -199,6 +264,21 @@ struct ulog_frame
 };
 typedef struct ulog_frame *ulog_frame_t;
 
+/*
+ * binary log record, followed by the raw arguments in the order of the format:
+ * '*' width and precision and %c as int, integers by their qualifier, %p as a
+ * pointer, %e %f %g as double and %s as a length byte and the characters.
+ * All in the CPU's byte order, packed, records aligned to rt_atomic_t.
+ */
+struct ulog_bin_head
+{
+    rt_atomic_t ctrl;       /* magic, level and record length, written last */
+    rt_ubase_t format;      /* address of the format string, 0 for a drop notice */
+    rt_ubase_t tag;         /* address of the tag string */
+    rt_uint32_t tick;       /* tick of the call */
+};
+typedef struct ulog_bin_head *ulog_bin_head_t;
+
 struct ulog_backend
 {
     char name[RT_NAME_MAX];
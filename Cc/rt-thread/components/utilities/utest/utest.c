@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-11-19     MurphyZhao   the first version
+ * 2026-10-18     Cc           add the benchmark clock helpers
  */
 
 #include <rtthread.h>
@@ -14,6 +15,9 @@
 
 #include "utest.h"
 #include <utest_log.h>
+#ifdef RT_USING_CPUTIME
+#include <drivers/cputime.h>
+#endif
 
 #undef DBG_TAG
 #undef DBG_LVL
@@ -358,6 +362,24 @@ utest_t utest_handle_get(void)
     return (utest_t)&local_utest;
 }
 
+rt_uint64_t utest_bench_now(void)
+{
+#ifdef RT_USING_CPUTIME
+    return clock_cpu_gettime();
+#else
+    return rt_tick_get();
+#endif /* RT_USING_CPUTIME */
+}
+
+rt_uint32_t utest_bench_us(rt_uint64_t time)
+{
+#ifdef RT_USING_CPUTIME
+    return (rt_uint32_t)clock_cpu_microsecond(time);
+#else
+    return (rt_uint32_t)(time * 1000000 / RT_TICK_PER_SECOND);
+#endif /* RT_USING_CPUTIME */
+}
+
 void utest_unit_run(test_unit_func func, const char *unit_func_name)
 {
     // LOG_I("[==========] utest unit name: (%s)", unit_func_name);
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2018-11-19     MurphyZhao   the first version
+ * 2026-10-18     Cc           add the benchmark clock helpers
  */
 
 #ifndef __UTEST_H__
@@ -113,6 +114,33 @@ void utest_unit_run(test_unit_func func, const char *unit_func_name);
 */
 utest_t utest_handle_get(void);
 
+/**
+ * utest_bench_now
+ *
+ * @brief Get the timestamp used by the benchmark testcases.
+ *        It counts CPU cycles with RT_USING_CPUTIME and OS ticks otherwise.
+ *        Ticks are too coarse to compare short runs, so timing asserts
+ *        should only be made when RT_USING_CPUTIME is defined.
+ *
+ * @param void
+ *
+ * @return The current timestamp.
+ *
+*/
+rt_uint64_t utest_bench_now(void);
+
+/**
+ * utest_bench_us
+ *
+ * @brief Convert an interval of `utest_bench_now` into microseconds.
+ *
+ * @param time The interval between two timestamps.
+ *
+ * @return The interval in microseconds.
+ *
+*/
+rt_uint32_t utest_bench_us(rt_uint64_t time);
+
 /**
  * UTEST_NAME_MAX_LEN
  *
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include <ymodem.h>
+#include <fal.h>
+#include <stdlib.h>
+
+/* the data goes to the flash in blocks of one STX packet */
+#define RYM_FAL_BLK_SZ  1024
+
+struct fal_ctx
+{
+    struct rym_ctx parent;
+    const struct fal_partition *part;
+    /* the erase granularity of the flash */
+    rt_size_t erase_sz;
+    /* where the block goes in the partition */
+    rt_uint32_t offset;
+    /* the partition is erased up to here */
+    rt_uint32_t erased;
+    /* the bytes of the file still to come, -1 when the size is unknown */
+    int flen;
+    /* a file header came, the partition takes a single file */
+    rt_bool_t begun;
+    rt_size_t fill;
+    rt_uint8_t block[RYM_FAL_BLK_SZ];
+};
+
+static rt_err_t _rym_fal_flush(struct fal_ctx *fctx)
+{
+    const struct fal_partition *part = fctx->part;
+    rt_uint32_t end, size;
+
+    if (fctx->fill == 0)
+        return RT_EOK;
+
+    /* pad the last block with the value of the erased flash */
+    end = fctx->offset + RYM_FAL_BLK_SZ;
+    if (end > part->len)
+        end = part->len;
+    if (fctx->offset + fctx->fill > end)
+        return -RT_EFULL;
+    rt_memset(fctx->block + fctx->fill, 0xFF, end - fctx->offset - fctx->fill);
+
+    /* erase just ahead of the write */
+    if (end > fctx->erased)
+    {
+        size = (end - fctx->erased + fctx->erase_sz - 1) / fctx->erase_sz * fctx->erase_sz;
+        if (fctx->erased + size > part->len)
+            size = part->len - fctx->erased;
+        if (fal_partition_erase(part, fctx->erased, size) < 0)
+            return -RT_EIO;
+        fctx->erased += size;
+    }
+
+    if (fal_partition_write(part, fctx->offset, fctx->block, end - fctx->offset) < 0)
+        return -RT_EIO;
+
+    fctx->offset = end;
+    fctx->fill = 0;
+
+    return RT_EOK;
+}
+
+static enum rym_code _rym_fal_begin(
+    struct rym_ctx *ctx,
+    rt_uint8_t *buf,
+    rt_size_t len)
+{
+    struct fal_ctx *fctx = (struct fal_ctx *)ctx;
+
+    /* the next file of a batch would be written over the first one */
+    if (fctx->begun)
+    {
+        rt_kprintf("%s takes a single file.\n", fctx->part->name);
+        return RYM_CODE_CAN;
+    }
+
+    /* the file name, then the file size */
+    fctx->flen = atoi(1 + (const char *)buf + rt_strnlen((const char *)buf, len - 1));
+    if (fctx->flen == 0)
+        fctx->flen = -1;
+    if (fctx->flen > (int)fctx->part->len)
+    {
+        rt_kprintf("the file of %d bytes does not fit in %s.\n", fctx->flen, fctx->part->name);
+        return RYM_CODE_CAN;
+    }
+
+    fctx->offset = 0;
+    fctx->erased = 0;
+    fctx->fill = 0;
+    fctx->begun = RT_TRUE;
+
+    return RYM_CODE_ACK;
+}
+
+static enum rym_code _rym_fal_data(
+    struct rym_ctx *ctx,
+    rt_uint8_t *buf,
+    rt_size_t len)
+{
+    struct fal_ctx *fctx = (struct fal_ctx *)ctx;
+    rt_size_t copy;
+
+    if (fctx->flen != -1)
+    {
+        if (len > (rt_size_t)fctx->flen)
+            len = fctx->flen;
+        fctx->flen -= len;
+    }
+
+    while (len)
+    {
+        copy = RYM_FAL_BLK_SZ - fctx->fill;
+        if (copy > len)
+            copy = len;
+        rt_memcpy(fctx->block + fctx->fill, buf, copy);
+        fctx->fill += copy;
+        buf += copy;
+        len -= copy;
+
+        if (fctx->fill == RYM_FAL_BLK_SZ && _rym_fal_flush(fctx) != RT_EOK)
+        {
+            rt_kprintf("write %s at 0x%08x failed.\n", fctx->part->name, fctx->offset);
+            return RYM_CODE_CAN;
+        }
+    }
+
+    return RYM_CODE_ACK;
+}
+
+static enum rym_code _rym_fal_end(
+    struct rym_ctx *ctx,
+    rt_uint8_t *buf,
+    rt_size_t len)
+{
+    struct fal_ctx *fctx = (struct fal_ctx *)ctx;
+
+    if (_rym_fal_flush(fctx) != RT_EOK)
+    {
+        rt_kprintf("write %s at 0x%08x failed.\n", fctx->part->name, fctx->offset);
+        return RYM_CODE_CAN;
+    }
+
+    return RYM_CODE_ACK;
+}
+
+rt_err_t rym_recv_to_fal(rt_device_t dev, const char *part_name, int handshake_timeout)
+{
+    const struct fal_partition *part;
+    const struct fal_flash_dev *flash;
+    struct fal_ctx *fctx;
+    rt_err_t res;
+
+    RT_ASSERT(dev);
+    RT_ASSERT(part_name);
+
+    part = fal_partition_find(part_name);
+    if (part == RT_NULL)
+        return -RT_EINVAL;
+    flash = fal_flash_device_find(part->flash_name);
+    if (flash == RT_NULL || flash->blk_size == 0)
+        return -RT_EINVAL;
+
+    fctx = rt_calloc(1, sizeof(*fctx));
+    if (fctx == RT_NULL)
+        return -RT_ENOMEM;
+    fctx->part = part;
+    fctx->erase_sz = flash->blk_size;
+
+#ifdef YMODEM_USING_PIPELINE
+    res = rym_recv_on_device_pipelined(&fctx->parent, dev, RT_DEVICE_OFLAG_RDWR | RT_DEVICE_FLAG_INT_RX,
+                                       _rym_fal_begin, _rym_fal_data, _rym_fal_end, handshake_timeout);
+#else
+    res = rym_recv_on_device(&fctx->parent, dev, RT_DEVICE_OFLAG_RDWR | RT_DEVICE_FLAG_INT_RX,
+                             _rym_fal_begin, _rym_fal_data, _rym_fal_end, handshake_timeout);
+#endif /* YMODEM_USING_PIPELINE */
+    rt_free(fctx);
+
+    return res;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static rt_err_t ry_fal(uint8_t argc, char **argv)
+{
+    rt_err_t res;
+    rt_device_t dev;
+
+    if (argc < 2)
+    {
+        rt_kprintf("invalid partition name.\n");
+        return -RT_ERROR;
+    }
+    if (argc > 2)
+        dev = rt_device_find(argv[2]);
+    else
+        dev = rt_console_get_device();
+    if (!dev)
+    {
+        rt_kprintf("could not find device.\n");
+        return -RT_ERROR;
+    }
+
+    res = rym_recv_to_fal(dev, argv[1], 1000);
+    if (res != RT_EOK)
+        rt_kprintf("receive to %s failed: %d\n", argv[1], res);
+
+    return res;
+}
+MSH_CMD_EXPORT(ry_fal, YMODEM Receive to a FAL partition e.g: ry_fal partition [uart0] default by console.);
+
+#endif /* RT_USING_FINSH */
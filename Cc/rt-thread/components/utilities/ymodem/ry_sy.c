@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2019-12-09     Steven Liu   the first version
  * 2021-04-14     Meco Man     Check the file path's legitimacy of 'sy' command
+ * 2026-10-18     Cc           receive with the pipeline when it is enabled
  */
 
 #include <rtthread.h>
@@ -204,8 +205,13 @@ static rt_err_t rym_download_file(rt_device_t idev,const char *file_path)
     ctx->fd = -1;
     rt_strncpy(ctx->fpath, file_path, DFS_PATH_MAX);
     RT_ASSERT(idev);
+#ifdef YMODEM_USING_PIPELINE
+    res = rym_recv_on_device_pipelined(&ctx->parent, idev, RT_DEVICE_OFLAG_RDWR | RT_DEVICE_FLAG_INT_RX,
+                                       _rym_recv_begin, _rym_recv_data, _rym_recv_end, 1000);
+#else
     res = rym_recv_on_device(&ctx->parent, idev, RT_DEVICE_OFLAG_RDWR | RT_DEVICE_FLAG_INT_RX,
                              _rym_recv_begin, _rym_recv_data, _rym_recv_end, 1000);
+#endif /* YMODEM_USING_PIPELINE */
     rt_free(ctx);
 
     return res;
@@ -8,79 +8,13 @@
  * Date           Author       Notes
  * 2013-04-14     Grissiom     initial implementation
  * 2019-12-09     Steven Liu   add YMODEM send protocol
+ * 2026-10-18     Cc           use the CRC library
+ * 2026-10-18     Cc           add the pipelined receive
  */
 
 #include <rthw.h>
 #include "ymodem.h"
-
-#ifdef YMODEM_USING_CRC_TABLE
-static const rt_uint16_t ccitt_table[256] =
-{
-    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
-    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
-    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
-    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
-    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
-    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
-    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
-    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
-    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
-    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
-    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
-    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
-    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
-    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
-    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
-    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
-    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
-    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
-    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
-    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
-    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
-    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
-    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
-    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
-    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
-    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
-    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
-    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
-    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
-    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
-    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
-    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
-};
-static rt_uint16_t CRC16(unsigned char *q, int len)
-{
-    rt_uint16_t crc = 0;
-
-    while (len-- > 0)
-        crc = (crc << 8) ^ ccitt_table[((crc >> 8) ^ *q++) & 0xff];
-    return crc;
-}
-#else
-static rt_uint16_t CRC16(unsigned char *q, int len)
-{
-    rt_uint16_t crc;
-    char i;
-
-    crc = 0;
-    while (--len >= 0)
-    {
-        crc = crc ^ (int) * q++ << 8;
-        i = 8;
-        do
-        {
-            if (crc & 0x8000)
-                crc = crc << 1 ^ 0x1021;
-            else
-                crc = crc << 1;
-        }
-        while (--i);
-    }
-
-    return (crc);
-}
-#endif
+#include "crc.h"
 
 // we could only use global varible because we could not use
 // rt_device_t->user_data(it is used by the serial driver)...
@@ -163,7 +97,7 @@ static rt_err_t _rym_send_packet(
         return -RT_ERROR;
     }
 
-    send_crc = CRC16(ctx->buf + 3, packetlen - 5);
+    send_crc = rt_crc16(0, ctx->buf + 3, packetlen - 5);
     ctx->buf[0] = code;
     ctx->buf[1] = index;
     ctx->buf[2] = index_inv;
@@ -186,6 +120,100 @@ static rt_ssize_t _rym_putchar(struct rym_ctx *ctx, rt_uint8_t code)
     return 1;
 }
 
+static void _rym_send_can(struct rym_ctx *ctx)
+{
+    rt_size_t i;
+
+    /* the spec require multiple CAN */
+    for (i = 0; i < RYM_END_SESSION_SEND_CAN_NUM; i++)
+    {
+        _rym_putchar(ctx, RYM_CODE_CAN);
+    }
+}
+
+#ifdef YMODEM_USING_PIPELINE
+static void _rym_writer_entry(void *parameter)
+{
+    struct rym_ctx *ctx = (struct rym_ctx *)parameter;
+
+    while (1)
+    {
+        rt_sem_take(&ctx->write_sem, RT_WAITING_FOREVER);
+        /* no packet, the session is over */
+        if (ctx->spare_len == 0)
+            break;
+        ctx->spare_code = ctx->on_data(ctx, ctx->spare + 3, ctx->spare_len);
+        rt_sem_release(&ctx->idle_sem);
+    }
+    rt_sem_release(&ctx->idle_sem);
+}
+
+/* wait until the packet given to the writer is written, returns its code */
+static enum rym_code _rym_writer_wait(struct rym_ctx *ctx)
+{
+    rt_sem_take(&ctx->idle_sem, RT_WAITING_FOREVER);
+    rt_sem_release(&ctx->idle_sem);
+
+    return ctx->spare_code;
+}
+
+/* hand the packet in ctx->buf to the writer, ctx->buf gets the free buffer */
+static void _rym_writer_put(struct rym_ctx *ctx, rt_size_t data_sz)
+{
+    rt_uint8_t *buf = ctx->buf;
+
+    rt_sem_take(&ctx->idle_sem, RT_WAITING_FOREVER);
+    ctx->buf = ctx->spare;
+    ctx->spare = buf;
+    ctx->spare_len = data_sz;
+    rt_sem_release(&ctx->write_sem);
+}
+
+static rt_err_t _rym_writer_start(struct rym_ctx *ctx)
+{
+    rt_uint8_t priority;
+
+    ctx->spare = rt_malloc(_RYM_STX_PKG_SZ);
+    if (ctx->spare == RT_NULL)
+        return -RT_ENOMEM;
+
+    ctx->spare_code = RYM_CODE_ACK;
+    rt_sem_init(&ctx->write_sem, "rymwr", 0, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&ctx->idle_sem, "rymidle", 1, RT_IPC_FLAG_FIFO);
+    /* below the receiver, which must not wait for a write to drain the uart */
+    priority = RT_SCHED_PRIV(rt_thread_self()).current_priority;
+    if (priority < RT_THREAD_PRIORITY_MAX - 1)
+        priority++;
+    ctx->writer = rt_thread_create("rymwr", _rym_writer_entry, ctx, YMODEM_PIPELINE_STACK_SIZE,
+                                   priority, 10);
+    if (ctx->writer == RT_NULL)
+    {
+        rt_sem_detach(&ctx->write_sem);
+        rt_sem_detach(&ctx->idle_sem);
+        rt_free(ctx->spare);
+        return -RT_ENOMEM;
+    }
+    rt_thread_startup(ctx->writer);
+
+    return RT_EOK;
+}
+
+static void _rym_writer_stop(struct rym_ctx *ctx)
+{
+    if (ctx->writer == RT_NULL)
+        return;
+
+    /* an empty packet ends the writer, which releases idle_sem on its way out */
+    _rym_writer_put(ctx, 0);
+    rt_sem_take(&ctx->idle_sem, RT_WAITING_FOREVER);
+    ctx->writer = RT_NULL;
+
+    rt_sem_detach(&ctx->write_sem);
+    rt_sem_detach(&ctx->idle_sem);
+    rt_free(ctx->spare);
+}
+#endif /* YMODEM_USING_PIPELINE */
+
 static rt_ssize_t _rym_getchar(struct rym_ctx *ctx)
 {
     rt_uint8_t getc_ack;
@@ -248,7 +276,7 @@ static rt_err_t _rym_do_handshake(
         return -RYM_ERR_SEQ;
 
     recv_crc = (rt_uint16_t)(*(ctx->buf + data_sz - 2) << 8) | *(ctx->buf + data_sz - 1);
-    cal_crc = CRC16(ctx->buf + 3, data_sz - 5);
+    cal_crc = rt_crc16(0, ctx->buf + 3, data_sz - 5);
     if (recv_crc != cal_crc)
         return -RYM_ERR_CRC;
 
@@ -346,10 +374,24 @@ static rt_err_t _rym_trans_data(
 
     /* sanity check */
     recv_crc = (rt_uint16_t)(*(ctx->buf + tsz - 1) << 8) | *(ctx->buf + tsz);
-    if (recv_crc != CRC16(ctx->buf + 3, data_sz))
+    if (recv_crc != rt_crc16(0, ctx->buf + 3, data_sz))
         return -RYM_ERR_CRC;
 
     /* congratulations, check passed. */
+#ifdef YMODEM_USING_PIPELINE
+    if (ctx->writer)
+    {
+        /* the buffer of the packet before is free once it is written */
+        *code = _rym_writer_wait(ctx);
+        if (*code == RYM_CODE_CAN)
+            return RT_EOK;
+
+        /* ACK at once, the next packet comes in while this one is written */
+        _rym_writer_put(ctx, data_sz);
+        *code = RYM_CODE_ACK;
+        return RT_EOK;
+    }
+#endif /* YMODEM_USING_PIPELINE */
     if (ctx->on_data)
         *code = ctx->on_data(ctx, ctx->buf + 3, data_sz);
     else
@@ -368,7 +410,7 @@ static rt_err_t _rym_do_trans(struct rym_ctx *ctx)
     {
         rt_err_t err;
         enum rym_code code;
-        rt_size_t data_sz, i;
+        rt_size_t data_sz;
 
         code = _rym_read_code(ctx,
                               RYM_WAIT_PKG_TICK);
@@ -381,6 +423,14 @@ static rt_err_t _rym_do_trans(struct rym_ctx *ctx)
                 data_sz = 1024;
                 break;
             case RYM_CODE_EOT:
+#ifdef YMODEM_USING_PIPELINE
+                /* on_end comes next, all the data has to be written */
+                if (ctx->writer && _rym_writer_wait(ctx) == RYM_CODE_CAN)
+                {
+                    _rym_send_can(ctx);
+                    return -RYM_ERR_CAN;
+                }
+#endif /* YMODEM_USING_PIPELINE */
                 return RT_EOK;
             default:
                 errors++;
@@ -417,11 +467,7 @@ static rt_err_t _rym_do_trans(struct rym_ctx *ctx)
         switch (code)
         {
             case RYM_CODE_CAN:
-                /* the spec require multiple CAN */
-                for (i = 0; i < RYM_END_SESSION_SEND_CAN_NUM; i++)
-                {
-                    _rym_putchar(ctx, RYM_CODE_CAN);
-                }
+                _rym_send_can(ctx);
                 return -RYM_ERR_CAN;
             case RYM_CODE_ACK:
                 _rym_putchar(ctx, RYM_CODE_ACK);
@@ -477,8 +523,11 @@ static rt_err_t _rym_do_fin(struct rym_ctx *ctx)
     ctx->stage = RYM_STAGE_FINISHING;
     /* we already got one EOT in the caller. invoke the callback if there is
      * one. */
-    if (ctx->on_end)
-        ctx->on_end(ctx, ctx->buf + 3, 128);
+    if (ctx->on_end && ctx->on_end(ctx, ctx->buf + 3, 128) != RYM_CODE_ACK)
+    {
+        _rym_send_can(ctx);
+        return -RYM_ERR_CAN;
+    }
 
     _rym_putchar(ctx, RYM_CODE_NAK);
     code = _rym_read_code(ctx, RYM_WAIT_PKG_TICK);
@@ -510,14 +559,17 @@ static rt_err_t _rym_do_fin(struct rym_ctx *ctx)
         return -RYM_ERR_SEQ;
 
     recv_crc = (rt_uint16_t)(*(ctx->buf + _RYM_SOH_PKG_SZ - 2) << 8) | *(ctx->buf + _RYM_SOH_PKG_SZ - 1);
-    if (recv_crc != CRC16(ctx->buf + 3, _RYM_SOH_PKG_SZ - 5))
+    if (recv_crc != rt_crc16(0, ctx->buf + 3, _RYM_SOH_PKG_SZ - 5))
         return -RYM_ERR_CRC;
 
     /*next file transmission*/
     if (ctx->buf[3] != 0)
     {
         if (ctx->on_begin && ctx->on_begin(ctx, ctx->buf + 3, data_sz - 5) != RYM_CODE_ACK)
+        {
+            _rym_send_can(ctx);
             return -RYM_ERR_CAN;
+        }
         return RT_EOK;
     }
 
@@ -577,7 +629,8 @@ static rt_err_t _rym_do_send_fin(struct rym_ctx *ctx)
 
 static rt_err_t _rym_do_recv(
     struct rym_ctx *ctx,
-    int handshake_timeout)
+    int handshake_timeout,
+    rt_bool_t pipelined)
 {
     rt_err_t err;
 
@@ -587,26 +640,30 @@ static rt_err_t _rym_do_recv(
     if (ctx->buf == RT_NULL)
         return -RT_ENOMEM;
 
-    err = _rym_do_handshake(ctx, handshake_timeout);
-    if (err != RT_EOK)
+#ifdef YMODEM_USING_PIPELINE
+    ctx->writer = RT_NULL;
+    if (pipelined && ctx->on_data && _rym_writer_start(ctx) != RT_EOK)
     {
         rt_free(ctx->buf);
-        return err;
+        return -RT_ENOMEM;
     }
-    while (1)
+#endif /* YMODEM_USING_PIPELINE */
+
+    err = _rym_do_handshake(ctx, handshake_timeout);
+    while (err == RT_EOK)
     {
         err = _rym_do_trans(ctx);
-
-        err = _rym_do_fin(ctx);
         if (err != RT_EOK)
-        {
-            rt_free(ctx->buf);
-            return err;
-        }
+            break;
 
-        if (ctx->stage == RYM_STAGE_FINISHED)
+        err = _rym_do_fin(ctx);
+        if (err != RT_EOK || ctx->stage == RYM_STAGE_FINISHED)
             break;
     }
+
+#ifdef YMODEM_USING_PIPELINE
+    _rym_writer_stop(ctx);
+#endif /* YMODEM_USING_PIPELINE */
     rt_free(ctx->buf);
     return err;
 }
@@ -648,14 +705,15 @@ static rt_err_t _rym_do_send(
     return err;
 }
 
-rt_err_t rym_recv_on_device(
+static rt_err_t _rym_recv_on_device(
     struct rym_ctx *ctx,
     rt_device_t dev,
     rt_uint16_t oflag,
     rym_callback on_begin,
     rym_callback on_data,
     rym_callback on_end,
-    int handshake_timeout)
+    int handshake_timeout,
+    rt_bool_t pipelined)
 {
     rt_err_t res;
     rt_err_t (*odev_rx_ind)(rt_device_t dev, rt_size_t size);
@@ -686,7 +744,7 @@ rt_err_t rym_recv_on_device(
     if (res != RT_EOK)
         goto __exit;
 
-    res = _rym_do_recv(ctx, handshake_timeout);
+    res = _rym_do_recv(ctx, handshake_timeout, pipelined);
 
     rt_device_close(dev);
 
@@ -705,6 +763,34 @@ __exit:
     return res;
 }
 
+rt_err_t rym_recv_on_device(
+    struct rym_ctx *ctx,
+    rt_device_t dev,
+    rt_uint16_t oflag,
+    rym_callback on_begin,
+    rym_callback on_data,
+    rym_callback on_end,
+    int handshake_timeout)
+{
+    return _rym_recv_on_device(ctx, dev, oflag, on_begin, on_data, on_end,
+                               handshake_timeout, RT_FALSE);
+}
+
+#ifdef YMODEM_USING_PIPELINE
+rt_err_t rym_recv_on_device_pipelined(
+    struct rym_ctx *ctx,
+    rt_device_t dev,
+    rt_uint16_t oflag,
+    rym_callback on_begin,
+    rym_callback on_data,
+    rym_callback on_end,
+    int handshake_timeout)
+{
+    return _rym_recv_on_device(ctx, dev, oflag, on_begin, on_data, on_end,
+                               handshake_timeout, RT_TRUE);
+}
+#endif /* YMODEM_USING_PIPELINE */
+
 rt_err_t rym_send_on_device(
     struct rym_ctx *ctx,
     rt_device_t dev,
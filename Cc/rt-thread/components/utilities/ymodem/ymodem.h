@@ -9,6 +9,7 @@
  * 2013-04-14     Grissiom     initial implementation
  * 2019-12-09     Steven Liu   add YMODEM send protocol
  * 2022-08-04     Meco Man     move error codes to rym_code to silence warnings
+ * 2026-10-18     Cc           add the pipelined receive and the FAL receiver
  */
 
 #ifndef __YMODEM_H__
@@ -110,6 +111,20 @@ struct rym_ctx
     struct rt_semaphore sem;
 
     rt_device_t dev;
+
+#ifdef YMODEM_USING_PIPELINE
+    /* the writer thread of the pipelined receive, RT_NULL when not used */
+    rt_thread_t writer;
+    /* the packet buffer owned by the writer, ctx->buf is the other one */
+    rt_uint8_t *spare;
+    rt_size_t spare_len;
+    /* the code returned by on_data for the last packet written */
+    enum rym_code spare_code;
+    /* a packet is handed to the writer */
+    struct rt_semaphore write_sem;
+    /* the writer is idle */
+    struct rt_semaphore idle_sem;
+#endif /* YMODEM_USING_PIPELINE */
 };
 
 /* recv a file on device dev with ymodem session ctx.
@@ -130,8 +145,9 @@ struct rym_ctx
  *
  * @param on_end The callback will be invoked when one transmission is
  * finished. The data should be 128 bytes of NULL. You can do some cleaning job
- * in this callback such as closing the file. The return value of this callback
- * is ignored. As above, this parameter can be NULL if you don't need such
+ * in this callback such as closing the file. Any return value other than
+ * RYM_CODE_ACK, e.g. when the last data could not be saved, cancels the
+ * session. As above, this parameter can be NULL if you don't need such
  * function.
  *
  * @param handshake_timeout the timeout when hand shaking. The unit is in
@@ -141,6 +157,34 @@ rt_err_t rym_recv_on_device(struct rym_ctx *ctx, rt_device_t dev, rt_uint16_t of
                             rym_callback on_begin, rym_callback on_data, rym_callback on_end,
                             int handshake_timeout);
 
+#ifdef YMODEM_USING_PIPELINE
+/* recv a file like rym_recv_on_device, with on_data called in a writer thread.
+ *
+ * A packet whose CRC passes is handed to the writer and ACKed at once, the
+ * next one is received into a second buffer while it is written, so a slow
+ * on_data such as a flash write overlaps the transfer instead of adding to
+ * it. When on_data returns RYM_CODE_CAN, that packet has been ACKed already
+ * and the session is cancelled on the next packet or the EOT. on_begin and
+ * on_end are called in the receiving thread while the writer is idle.
+ */
+rt_err_t rym_recv_on_device_pipelined(struct rym_ctx *ctx, rt_device_t dev, rt_uint16_t oflag,
+                                      rym_callback on_begin, rym_callback on_data, rym_callback on_end,
+                                      int handshake_timeout);
+#endif /* YMODEM_USING_PIPELINE */
+
+#ifdef YMODEM_USING_FAL
+/* recv a file on device dev into the FAL partition part_name.
+ *
+ * The data is written in blocks of 1024 bytes and the flash is erased just
+ * ahead of the writes. The partition must be as large as the size in the
+ * first packet.
+ *
+ * @param handshake_timeout the timeout when hand shaking. The unit is in
+ * second.
+ */
+rt_err_t rym_recv_to_fal(rt_device_t dev, const char *part_name, int handshake_timeout);
+#endif /* YMODEM_USING_FAL */
+
 /* send a file on device dev with ymodem session ctx.
  *
  * If an error happens, you can get where it is failed from ctx->stage.
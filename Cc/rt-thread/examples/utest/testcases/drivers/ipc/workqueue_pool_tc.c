@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include "utest.h"
+
+#define POOL_WORKERS        3
+#define SHORT_WORKS         32
+#define BLOCK_MS            200
+
+static struct rt_semaphore block_sem;
+static struct rt_semaphore done_sem;
+static volatile rt_uint32_t done_count;
+static volatile rt_uint32_t running;
+static volatile rt_uint32_t running_max;
+static char order[4];
+static volatile int order_index;
+
+static struct rt_work short_works[SHORT_WORKS];
+static struct rt_work block_work;
+
+static void _block_func(struct rt_work *work, void *work_data)
+{
+    rt_sem_take(&block_sem, rt_tick_from_millisecond(BLOCK_MS));
+}
+
+static void _short_func(struct rt_work *work, void *work_data)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    running++;
+    if (running > running_max)
+        running_max = running;
+    rt_hw_interrupt_enable(level);
+
+    rt_thread_yield();
+
+    level = rt_hw_interrupt_disable();
+    running--;
+    done_count++;
+    rt_hw_interrupt_enable(level);
+
+    rt_sem_release(&done_sem);
+}
+
+static void _order_func(struct rt_work *work, void *work_data)
+{
+    order[order_index++] = (char)(rt_ubase_t)work_data;
+}
+
+static void test_pool_compat(void)
+{
+    struct rt_workqueue *queue;
+    struct rt_workqueue_stats stats;
+    struct rt_work work;
+
+    queue = rt_workqueue_create_pool("wq_cpt", 2048, UTEST_THR_PRIORITY - 1, POOL_WORKERS);
+    uassert_not_null(queue);
+
+    done_count = 0;
+    rt_work_init(&work, _short_func, RT_NULL);
+
+    uassert_int_equal(rt_workqueue_dowork(queue, &work), RT_EOK);
+    uassert_int_equal(rt_sem_take(&done_sem, RT_TICK_PER_SECOND), RT_EOK);
+
+    /* delayed work is moved into a lane when its timer fires */
+    uassert_int_equal(rt_workqueue_submit_work(queue, &work, 10), RT_EOK);
+    uassert_int_equal(rt_sem_take(&done_sem, 5), -RT_ETIMEOUT);
+    uassert_int_equal(rt_sem_take(&done_sem, RT_TICK_PER_SECOND), RT_EOK);
+
+    /* cancel a pending delayed work */
+    uassert_int_equal(rt_workqueue_submit_work(queue, &work, 10), RT_EOK);
+    uassert_int_equal(rt_workqueue_cancel_work(queue, &work), RT_EOK);
+    uassert_int_equal(rt_sem_take(&done_sem, 20), -RT_ETIMEOUT);
+
+    uassert_int_equal(rt_workqueue_urgent_work(queue, &work), RT_EOK);
+    uassert_int_equal(rt_sem_take(&done_sem, RT_TICK_PER_SECOND), RT_EOK);
+    uassert_int_equal(done_count, 3);
+
+    rt_workqueue_get_stats(queue, &stats);
+    uassert_int_equal(stats.done, 3);
+    uassert_int_equal(stats.depth, 0);
+    uassert_true(stats.depth_max >= 1);
+
+    rt_workqueue_destroy(queue);
+}
+
+static void test_pool_lanes(void)
+{
+    struct rt_workqueue *queue;
+    struct rt_work works[3];
+
+    /* a single worker shows the lane order */
+    queue = rt_workqueue_create_pool("wq_lane", 2048, UTEST_THR_PRIORITY - 1, 1);
+    uassert_not_null(queue);
+
+    order_index = 0;
+    rt_memset(order, 0, sizeof(order));
+    rt_work_init(&block_work, _block_func, RT_NULL);
+    rt_work_init(&works[0], _order_func, (void *)'a');
+    rt_work_init(&works[1], _order_func, (void *)'b');
+    rt_work_init(&works[2], _order_func, (void *)'c');
+    works[2].type |= RT_WORK_TYPE_HIGH;
+
+    rt_workqueue_dowork(queue, &block_work);
+    rt_workqueue_dowork(queue, &works[0]);
+    rt_workqueue_dowork(queue, &works[1]);
+    rt_workqueue_dowork(queue, &works[2]);
+    rt_sem_release(&block_sem);
+
+    rt_thread_mdelay(50);
+    uassert_str_equal(order, "cab");
+
+    rt_workqueue_destroy(queue);
+}
+
+static rt_tick_t _run_blocked(rt_uint8_t worker_nr, struct rt_workqueue_stats *stats)
+{
+    struct rt_workqueue *queue;
+    rt_tick_t tick;
+    int i;
+
+    queue = rt_workqueue_create_pool("wq_blk", 2048, UTEST_THR_PRIORITY - 1, worker_nr);
+    if (queue == RT_NULL)
+        return RT_TICK_MAX;
+
+    done_count = 0;
+    running_max = 0;
+    rt_work_init(&block_work, _block_func, RT_NULL);
+    for (i = 0; i < SHORT_WORKS; i++)
+        rt_work_init(&short_works[i], _short_func, RT_NULL);
+
+    tick = rt_tick_get();
+    /* the blocking work is first and holds one worker for BLOCK_MS */
+    rt_workqueue_dowork(queue, &block_work);
+    for (i = 0; i < SHORT_WORKS; i++)
+        rt_workqueue_dowork(queue, &short_works[i]);
+
+    for (i = 0; i < SHORT_WORKS; i++)
+        rt_sem_take(&done_sem, RT_WAITING_FOREVER);
+    tick = rt_tick_get() - tick;
+
+    rt_workqueue_get_stats(queue, stats);
+    rt_workqueue_cancel_work_sync(queue, &block_work);
+    rt_workqueue_destroy(queue);
+
+    return tick;
+}
+
+static void test_pool_blocking_bench(void)
+{
+    struct rt_workqueue_stats stats;
+    rt_tick_t single, pool;
+
+    single = _run_blocked(1, &stats);
+    uassert_int_equal(done_count, SHORT_WORKS);
+    uassert_int_equal(running_max, 1);
+    LOG_I("1 worker : %d short works in %d ms, wait max %d ms, exec max %d ms",
+          SHORT_WORKS, (int)(single * 1000 / RT_TICK_PER_SECOND),
+          (int)(stats.wait_max * 1000 / RT_TICK_PER_SECOND),
+          (int)(stats.exec_max * 1000 / RT_TICK_PER_SECOND));
+
+    pool = _run_blocked(POOL_WORKERS, &stats);
+    uassert_int_equal(done_count, SHORT_WORKS);
+    LOG_I("%d workers: %d short works in %d ms, wait max %d ms, steals %d, concurrency %d",
+          POOL_WORKERS, SHORT_WORKS, (int)(pool * 1000 / RT_TICK_PER_SECOND),
+          (int)(stats.wait_max * 1000 / RT_TICK_PER_SECOND), (int)stats.steals, (int)running_max);
+
+    /* the short works do not wait behind the blocking one */
+    uassert_true(single >= rt_tick_from_millisecond(BLOCK_MS));
+    uassert_true(pool < single);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_sem_init(&block_sem, "wq_blk", 0, RT_IPC_FLAG_PRIO);
+    rt_sem_init(&done_sem, "wq_done", 0, RT_IPC_FLAG_PRIO);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&block_sem);
+    rt_sem_detach(&done_sem);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_pool_compat);
+    UTEST_UNIT_RUN(test_pool_lanes);
+    UTEST_UNIT_RUN(test_pool_blocking_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.drivers.workqueue_pool_tc", utest_tc_init, utest_tc_cleanup, 30);
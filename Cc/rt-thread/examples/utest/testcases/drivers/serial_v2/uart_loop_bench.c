@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+#include <rtdevice.h>
+
+#define TC_UART_TX_NAME "sloop0"
+#define TC_UART_RX_NAME "sloop1"
+#define TC_UART_BAUD    BAUD_RATE_921600
+#define TC_UART_BYTES   (16 * 1024)
+
+#ifdef UTEST_SERIAL_LOOP_TC
+
+#define CHUNK_LEN       64
+#define RX_BUFSZ        1024
+#define TX_BUFSZ        256
+#define ERR_BYTES       1000
+#define ERR_EVERY       50
+
+struct bench_case
+{
+    const char *name;
+    rt_uint32_t dma_flag;
+    rt_uint16_t oflag;
+    rt_uint16_t tx_bufsz;
+};
+
+/* a thread cannot poll the one byte receive register at these rates, the receive side is never polled */
+static const struct bench_case bench_cases[] =
+{
+    {"poll tx",          0,
+     RT_DEVICE_FLAG_RX_NON_BLOCKING | RT_DEVICE_FLAG_TX_BLOCKING,     0},
+    {"int blocking",     0,
+     RT_DEVICE_FLAG_RX_BLOCKING | RT_DEVICE_FLAG_TX_BLOCKING,         TX_BUFSZ},
+    {"int non-blocking", 0,
+     RT_DEVICE_FLAG_RX_NON_BLOCKING | RT_DEVICE_FLAG_TX_NON_BLOCKING, TX_BUFSZ},
+    {"dma blocking",     RT_DEVICE_FLAG_DMA_RX | RT_DEVICE_FLAG_DMA_TX,
+     RT_DEVICE_FLAG_RX_BLOCKING | RT_DEVICE_FLAG_TX_BLOCKING,         TX_BUFSZ},
+    {"dma non-blocking", RT_DEVICE_FLAG_DMA_RX | RT_DEVICE_FLAG_DMA_TX,
+     RT_DEVICE_FLAG_RX_NON_BLOCKING | RT_DEVICE_FLAG_TX_NON_BLOCKING, TX_BUFSZ},
+};
+
+static struct rt_serial_loop *tx_port, *rx_port;
+static rt_sem_t rx_sem, tx_done;
+static volatile rt_uint64_t rx_stamp;
+static volatile rt_uint32_t spin_count;
+static volatile rt_bool_t spin_run;
+static rt_uint8_t recv_buf[RX_BUFSZ];
+
+static rt_err_t uart_rx_indicate(rt_device_t device, rt_size_t size)
+{
+    rx_stamp = utest_bench_now();
+    rt_sem_release(rx_sem);
+    return RT_EOK;
+}
+
+/* the lowest priority thread, it counts while the cpu has nothing else to do */
+static void spin_entry(void *parameter)
+{
+    while (spin_run)
+    {
+        spin_count++;
+    }
+}
+
+static void writer_entry(void *parameter)
+{
+    rt_device_t dev = &tx_port->serial.parent;
+    rt_uint8_t buf[CHUNK_LEN];
+    rt_uint32_t sent, len, index, written;
+
+    for (sent = 0; sent < TC_UART_BYTES; sent += len)
+    {
+        len = TC_UART_BYTES - sent < CHUNK_LEN ? TC_UART_BYTES - sent : CHUNK_LEN;
+        for (index = 0; index < len; index++)
+        {
+            buf[index] = (rt_uint8_t)(sent + index);
+        }
+        /* the non-blocking write takes what the tx ringbuffer holds */
+        for (index = 0; index < len; index += written)
+        {
+            written = rt_device_write(dev, 0, buf + index, len - index);
+            if (written == 0)
+            {
+                rt_thread_delay(1);
+            }
+        }
+    }
+    rt_sem_release(tx_done);
+}
+
+static rt_err_t uart_open(rt_uint32_t dma_flag, rt_uint16_t oflag, rt_uint16_t tx_bufsz)
+{
+    struct serial_configure config = RT_SERIAL_CONFIG_DEFAULT;
+    rt_err_t result;
+
+    config.baud_rate = TC_UART_BAUD;
+    config.rx_bufsz = RX_BUFSZ;
+    config.tx_bufsz = tx_bufsz;
+    rt_serial_loop_set_dma(tx_port, dma_flag);
+    rt_serial_loop_set_dma(rx_port, dma_flag);
+    rt_device_control(&tx_port->serial.parent, RT_DEVICE_CTRL_CONFIG, &config);
+    rt_device_control(&rx_port->serial.parent, RT_DEVICE_CTRL_CONFIG, &config);
+
+    result = rt_device_open(&tx_port->serial.parent, oflag);
+    if (result != RT_EOK)
+    {
+        return result;
+    }
+    result = rt_device_open(&rx_port->serial.parent, oflag);
+    if (result != RT_EOK)
+    {
+        rt_device_close(&tx_port->serial.parent);
+        return result;
+    }
+    rt_device_set_rx_indicate(&rx_port->serial.parent, uart_rx_indicate);
+
+    return RT_EOK;
+}
+
+static void uart_close(void)
+{
+    rt_device_close(&rx_port->serial.parent);
+    rt_device_close(&tx_port->serial.parent);
+}
+
+/* the received bytes go up by one, 'next' is the expected one */
+static rt_uint32_t uart_check(rt_uint8_t *buf, rt_size_t len, rt_uint32_t *next)
+{
+    rt_uint32_t errors = 0;
+    rt_size_t index;
+
+    for (index = 0; index < len; index++, (*next)++)
+    {
+        if (buf[index] != (rt_uint8_t)*next)
+        {
+            errors++;
+        }
+    }
+
+    return errors;
+}
+
+static void tc_uart_loop_errors(void)
+{
+    struct rt_serial_loop_stats stats;
+    rt_uint8_t buf[CHUNK_LEN];
+    rt_uint32_t sent, recv = 0, next = 0, errors = 0, index, len;
+    rt_device_t dev;
+
+    if (uart_open(0, RT_DEVICE_FLAG_RX_NON_BLOCKING | RT_DEVICE_FLAG_TX_BLOCKING, TX_BUFSZ) != RT_EOK)
+    {
+        uassert_true(RT_FALSE);
+        return;
+    }
+    dev = &rx_port->serial.parent;
+    rt_serial_loop_get_stats(rx_port, &stats, RT_TRUE);
+
+    /* one byte in ERR_EVERY has a flipped bit */
+    rt_serial_loop_inject(tx_port, RT_SERIAL_LOOP_ERR_CORRUPT, ERR_EVERY);
+    for (sent = 0; sent < ERR_BYTES; sent += len)
+    {
+        len = ERR_BYTES - sent < CHUNK_LEN ? ERR_BYTES - sent : CHUNK_LEN;
+        for (index = 0; index < len; index++)
+        {
+            buf[index] = (rt_uint8_t)(sent + index);
+        }
+        rt_device_write(&tx_port->serial.parent, 0, buf, len);
+    }
+    while (recv < ERR_BYTES && rt_sem_take(rx_sem, rt_tick_from_millisecond(100)) == RT_EOK)
+    {
+        len = rt_device_read(dev, 0, recv_buf, RX_BUFSZ);
+        errors += uart_check(recv_buf, len, &next);
+        recv += len;
+    }
+    uassert_int_equal(recv, ERR_BYTES);
+    uassert_int_equal(errors, ERR_BYTES / ERR_EVERY);
+
+    /* one byte in ERR_EVERY is lost */
+    rt_serial_loop_inject(tx_port, RT_SERIAL_LOOP_ERR_DROP, ERR_EVERY);
+    rt_device_write(&tx_port->serial.parent, 0, recv_buf, ERR_BYTES);
+    recv = 0;
+    while (rt_sem_take(rx_sem, rt_tick_from_millisecond(100)) == RT_EOK)
+    {
+        recv += rt_device_read(dev, 0, recv_buf, RX_BUFSZ);
+    }
+    uassert_int_equal(recv, ERR_BYTES - ERR_BYTES / ERR_EVERY);
+
+    rt_serial_loop_inject(tx_port, RT_SERIAL_LOOP_ERR_NONE, 0);
+    rt_serial_loop_get_stats(rx_port, &stats, RT_TRUE);
+    uassert_int_equal(stats.rx_errors, ERR_BYTES / ERR_EVERY);
+    uassert_int_equal(stats.rx_overruns, 0);
+    uart_close();
+}
+
+/* the bytes a case moves, the time it takes and the idle count of the cpu */
+static rt_bool_t uart_bench(const struct bench_case *bc, rt_uint64_t *elapsed, rt_uint32_t *idle,
+                            rt_uint64_t *latency_sum, rt_uint64_t *latency_max, rt_uint32_t *reads)
+{
+    struct rt_serial_loop_stats stats;
+    rt_device_t dev = &rx_port->serial.parent;
+    rt_thread_t writer;
+    rt_uint32_t recv = 0, next = 0, errors = 0, len;
+    rt_uint64_t start, latency;
+
+    if (uart_open(bc->dma_flag, bc->oflag, bc->tx_bufsz) != RT_EOK)
+    {
+        LOG_E("%s: open failed.", bc->name);
+        return RT_FALSE;
+    }
+    rt_serial_loop_get_stats(rx_port, &stats, RT_TRUE);
+    writer = rt_thread_create("loop_tx", writer_entry, RT_NULL, 1024, rt_thread_self()->current_priority, 10);
+    if (writer == RT_NULL)
+    {
+        uart_close();
+        return RT_FALSE;
+    }
+
+    *latency_sum = *latency_max = 0;
+    *reads = 0;
+    spin_count = 0;
+    start = utest_bench_now();
+    rt_thread_startup(writer);
+    while (recv < TC_UART_BYTES)
+    {
+        if (bc->oflag & RT_DEVICE_FLAG_RX_BLOCKING)
+        {
+            len = TC_UART_BYTES - recv < CHUNK_LEN ? TC_UART_BYTES - recv : CHUNK_LEN;
+            len = rt_device_read(dev, 0, recv_buf, len);
+        }
+        else
+        {
+            if (rt_sem_take(rx_sem, rt_tick_from_millisecond(1000)) != RT_EOK)
+            {
+                LOG_E("%s: receive timeout, %d of %d bytes.", bc->name, recv, TC_UART_BYTES);
+                break;
+            }
+            len = rt_device_read(dev, 0, recv_buf, RX_BUFSZ);
+        }
+        if (len == 0)
+        {
+            continue;
+        }
+        /* from the last receive interrupt to the reader */
+        latency = utest_bench_now() - rx_stamp;
+        *latency_sum += latency;
+        if (latency > *latency_max)
+        {
+            *latency_max = latency;
+        }
+        (*reads)++;
+        errors += uart_check(recv_buf, len, &next);
+        recv += len;
+    }
+    *elapsed = utest_bench_now() - start;
+    *idle = spin_count;
+
+    rt_sem_take(tx_done, rt_tick_from_millisecond(1000));
+    rt_serial_loop_get_stats(rx_port, &stats, RT_TRUE);
+    uart_close();
+    while (rt_sem_trytake(rx_sem) == RT_EOK);
+
+    if (recv != TC_UART_BYTES || errors || stats.rx_overruns)
+    {
+        LOG_E("%s: %d of %d bytes, %d errors, %d overruns.", bc->name, recv, TC_UART_BYTES, errors, (int)stats.rx_overruns);
+        return RT_FALSE;
+    }
+
+    return RT_TRUE;
+}
+
+static void tc_uart_loop_bench(void)
+{
+    rt_uint64_t elapsed, calib_time, latency_sum, latency_max, busy;
+    rt_uint32_t calib_count, idle, reads, which;
+    rt_thread_t spinner;
+
+    spin_run = RT_TRUE;
+    spinner = rt_thread_create("loop_spin", spin_entry, RT_NULL, 512, RT_THREAD_PRIORITY_MAX - 2, 10);
+    uassert_not_null(spinner);
+    if (spinner == RT_NULL)
+    {
+        return;
+    }
+    rt_thread_startup(spinner);
+
+    /* the count of an idle cpu */
+    spin_count = 0;
+    calib_time = utest_bench_now();
+    rt_thread_mdelay(200);
+    calib_count = spin_count;
+    calib_time = utest_bench_now() - calib_time;
+
+    for (which = 0; which < sizeof(bench_cases) / sizeof(bench_cases[0]); which++)
+    {
+        if (!uart_bench(&bench_cases[which], &elapsed, &idle, &latency_sum, &latency_max, &reads))
+        {
+            uassert_true(RT_FALSE);
+            continue;
+        }
+        if (elapsed == 0)
+        {
+            elapsed = 1;
+        }
+        /* the time the spinner did not get is the time of the serial path */
+        busy = calib_count ? (rt_uint64_t)idle * calib_time / calib_count : 0;
+        busy = busy < elapsed ? elapsed - busy : 0;
+        LOG_I("%-16s %7u B/s, latency avg %5u us max %5u us, cpu %5u ns/B",
+              bench_cases[which].name,
+              (rt_uint32_t)((rt_uint64_t)TC_UART_BYTES * 1000000 / (utest_bench_us(elapsed) ? utest_bench_us(elapsed) : 1)),
+              reads ? utest_bench_us(latency_sum / reads) : 0, utest_bench_us(latency_max),
+              (rt_uint32_t)((rt_uint64_t)utest_bench_us(busy) * 1000 / TC_UART_BYTES));
+    }
+
+    spin_run = RT_FALSE;
+    rt_thread_mdelay(10);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_device_t tx_dev, rx_dev;
+
+    tx_dev = rt_device_find(TC_UART_TX_NAME);
+    rx_dev = rt_device_find(TC_UART_RX_NAME);
+    if (tx_dev == RT_NULL || rx_dev == RT_NULL)
+    {
+        LOG_E("find %s or %s device failed!", TC_UART_TX_NAME, TC_UART_RX_NAME);
+        return -RT_ERROR;
+    }
+    tx_port = rt_container_of(tx_dev, struct rt_serial_loop, serial.parent);
+    rx_port = rt_container_of(rx_dev, struct rt_serial_loop, serial.parent);
+
+    rx_sem = rt_sem_create("loop_rx", 0, RT_IPC_FLAG_PRIO);
+    tx_done = rt_sem_create("loop_tx", 0, RT_IPC_FLAG_PRIO);
+    if (rx_sem == RT_NULL || tx_done == RT_NULL)
+    {
+        if (rx_sem)
+            rt_sem_delete(rx_sem);
+        if (tx_done)
+            rt_sem_delete(tx_done);
+        return -RT_ENOMEM;
+    }
+    rt_serial_loop_connect(tx_port, rx_port);
+    rt_serial_loop_connect(rx_port, tx_port);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+#ifndef RT_SERIAL_LOOPBACK_PAIRED
+    rt_serial_loop_connect(tx_port, RT_NULL);
+    rt_serial_loop_connect(rx_port, RT_NULL);
+#endif /* RT_SERIAL_LOOPBACK_PAIRED */
+    rt_serial_loop_set_dma(tx_port, 0);
+    rt_serial_loop_set_dma(rx_port, 0);
+    rt_sem_delete(rx_sem);
+    rt_sem_delete(tx_done);
+    rx_sem = tx_done = RT_NULL;
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(tc_uart_loop_errors);
+    UTEST_UNIT_RUN(tc_uart_loop_bench);
+}
+
+UTEST_TC_EXPORT(testcase, "testcases.drivers.uart_loop_bench", utest_tc_init, utest_tc_cleanup, 60);
+
+#endif /* UTEST_SERIAL_LOOP_TC */
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+#include <rtdevice.h>
+
+#define TC_UART_DEVICE_NAME "uart2"
+#define TC_UART_FRAMES 200
+
+
+#ifdef UTEST_SERIAL_TC
+
+#define TEST_UART_NAME            TC_UART_DEVICE_NAME
+
+/* a small protocol frame: header, payload, tail */
+#define FRAME_HEAD_LEN  2
+#define FRAME_DATA_LEN  8
+#define FRAME_TAIL_LEN  3
+#define FRAME_LEN       (FRAME_HEAD_LEN + FRAME_DATA_LEN + FRAME_TAIL_LEN)
+#define BATCH_BUFSZ     (BSP_UART2_TX_BUFSIZE < BSP_UART2_RX_BUFSIZE ? BSP_UART2_TX_BUFSIZE : BSP_UART2_RX_BUFSIZE)
+#define BATCH_FRAMES    (BATCH_BUFSZ / FRAME_LEN)
+
+static struct rt_serial_device *serial;
+static const rt_uint8_t frame_head[FRAME_HEAD_LEN] = {0x55, 0xAA};
+static const rt_uint8_t frame_tail[FRAME_TAIL_LEN] = {0xFF, 0xFF, 0xFF};
+static rt_uint8_t frame_data[FRAME_DATA_LEN];
+static rt_uint8_t recv_buf[BATCH_BUFSZ];
+
+static void _frame_data(rt_uint32_t seq)
+{
+    rt_memset(frame_data, (rt_uint8_t)seq, sizeof(frame_data));
+    rt_memcpy(frame_data, &seq, sizeof(seq));
+}
+
+static rt_bool_t _send_frame(rt_bool_t vectored)
+{
+    struct rt_serial_iovec iov[3] =
+    {
+        {frame_head, FRAME_HEAD_LEN},
+        {frame_data, FRAME_DATA_LEN},
+        {frame_tail, FRAME_TAIL_LEN},
+    };
+    rt_size_t len;
+
+    if (vectored)
+    {
+        return rt_serial_writev(serial, iov, 3) == FRAME_LEN;
+    }
+
+    len = rt_device_write(&serial->parent, 0, frame_head, FRAME_HEAD_LEN);
+    len += rt_device_write(&serial->parent, 0, frame_data, FRAME_DATA_LEN);
+    len += rt_device_write(&serial->parent, 0, frame_tail, FRAME_TAIL_LEN);
+
+    return len == FRAME_LEN;
+}
+
+/* the frames of a batch come back on the RX pin, wired to the TX pin */
+static rt_bool_t _check_batch(rt_uint32_t seq, rt_uint32_t frames)
+{
+    rt_uint32_t len = 0, timeout = 0, index;
+    rt_uint8_t *frame;
+
+    while (len < frames * FRAME_LEN && timeout++ < 1000)
+    {
+        len += rt_device_read(&serial->parent, 0, recv_buf + len, frames * FRAME_LEN - len);
+        rt_thread_mdelay(1);
+    }
+    if (len != frames * FRAME_LEN)
+    {
+        LOG_E("received %d of %d bytes.", len, frames * FRAME_LEN);
+        return RT_FALSE;
+    }
+
+    for (index = 0; index < frames; index++)
+    {
+        frame = recv_buf + index * FRAME_LEN;
+        _frame_data(seq + index);
+        if (rt_memcmp(frame, frame_head, FRAME_HEAD_LEN) ||
+            rt_memcmp(frame + FRAME_HEAD_LEN, frame_data, FRAME_DATA_LEN) ||
+            rt_memcmp(frame + FRAME_HEAD_LEN + FRAME_DATA_LEN, frame_tail, FRAME_TAIL_LEN))
+        {
+            LOG_E("frame %d is different.", seq + index);
+            return RT_FALSE;
+        }
+    }
+
+    return RT_TRUE;
+}
+
+/* returns the time spent in the write calls, 0 on an error */
+static rt_uint64_t uart_frames(rt_bool_t vectored)
+{
+    struct rt_serial_tx_fifo *tx_fifo = (struct rt_serial_tx_fifo *)serial->serial_tx;
+    rt_uint64_t start, elapsed = 0;
+    rt_uint32_t seq, index, frames;
+
+    for (seq = 0; seq < TC_UART_FRAMES; seq += frames)
+    {
+        frames = TC_UART_FRAMES - seq < BATCH_FRAMES ? TC_UART_FRAMES - seq : BATCH_FRAMES;
+        for (index = 0; index < frames; index++)
+        {
+            /* only the write calls are timed, the frames fit in the tx ringbuffer */
+            _frame_data(seq + index);
+            start = utest_bench_now();
+            if (!_send_frame(vectored))
+            {
+                return 0;
+            }
+            elapsed += utest_bench_now() - start;
+        }
+        /* the line is slower than the calls, wait for it */
+        while (tx_fifo->activated)
+        {
+            rt_thread_mdelay(1);
+        }
+        if (!_check_batch(seq, frames))
+        {
+            return 0;
+        }
+    }
+
+    return elapsed ? elapsed : 1;
+}
+
+/* the frames sent per second in 'time' of the write calls */
+static rt_uint32_t _frame_rate(rt_uint64_t time)
+{
+    rt_uint32_t us = utest_bench_us(time);
+
+    return us ? (rt_uint32_t)(TC_UART_FRAMES * 1000000ULL / us) : 0;
+}
+
+static void tc_uart_writev(void)
+{
+    rt_uint64_t write_time, writev_time;
+    rt_err_t result;
+
+    serial = (struct rt_serial_device *)rt_device_find(TEST_UART_NAME);
+    if (serial == RT_NULL)
+    {
+        LOG_E("find %s device failed!\n", TEST_UART_NAME);
+        uassert_not_null(serial);
+        return;
+    }
+
+    /* reinitialize */
+    struct serial_configure config = RT_SERIAL_CONFIG_DEFAULT;
+    config.baud_rate = BAUD_RATE_115200;
+    config.rx_bufsz = BSP_UART2_RX_BUFSIZE;
+    config.tx_bufsz = BSP_UART2_TX_BUFSIZE;
+    rt_device_control(&serial->parent, RT_DEVICE_CTRL_CONFIG, &config);
+
+    result = rt_device_open(&serial->parent, RT_DEVICE_FLAG_RX_NON_BLOCKING | RT_DEVICE_FLAG_TX_NON_BLOCKING);
+    uassert_int_equal(result, RT_EOK);
+    if (result != RT_EOK)
+    {
+        return;
+    }
+
+    write_time = uart_frames(RT_FALSE);
+    writev_time = uart_frames(RT_TRUE);
+    rt_device_close(&serial->parent);
+
+    uassert_true(write_time != 0);
+    uassert_true(writev_time != 0);
+    if (write_time == 0 || writev_time == 0)
+    {
+        return;
+    }
+    LOG_I("%d byte frames: 3 writes %u frames/s, writev %u frames/s", FRAME_LEN,
+          _frame_rate(write_time), _frame_rate(writev_time));
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    LOG_I("UART TEST: Please connect Tx and Rx directly for self testing.");
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    serial = RT_NULL;
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(tc_uart_writev);
+}
+
+UTEST_TC_EXPORT(testcase, "testcases.drivers.uart_writev", utest_tc_init, utest_tc_cleanup, 30);
+
+#endif /* UTEST_SERIAL_TC */
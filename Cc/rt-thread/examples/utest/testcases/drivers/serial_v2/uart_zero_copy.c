@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+#include <rtdevice.h>
+#include <stdlib.h>
+
+#define TC_UART_DEVICE_NAME "uart2"
+#define TC_UART_SEND_TIMES 100
+
+
+#ifdef UTEST_SERIAL_TC
+
+#define TEST_UART_NAME            TC_UART_DEVICE_NAME
+
+static struct rt_serial_device *serial;
+static rt_sem_t rx_sem;
+
+static rt_err_t uart_find(void)
+{
+    serial = (struct rt_serial_device *)rt_device_find(TEST_UART_NAME);
+
+    if (serial == RT_NULL)
+    {
+        LOG_E("find %s device failed!\n", TEST_UART_NAME);
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t uart_rx_indicate(rt_device_t device, rt_size_t size)
+{
+    rt_sem_release(rx_sem);
+    return RT_EOK;
+}
+
+/* build the data in the tx ringbuffer, the TX pin is wired to the RX pin */
+static rt_uint32_t uart_send(rt_uint8_t *next, rt_uint32_t len)
+{
+    struct rt_serial_span span[2];
+    rt_ssize_t space;
+    rt_uint32_t i;
+
+    space = rt_serial_tx_reserve(serial, span);
+    if (space <= 0)
+    {
+        return 0;
+    }
+    if ((rt_uint32_t)space < len)
+    {
+        len = space;
+    }
+    for (i = 0; i < len; i++)
+    {
+        if (i < span[0].len)
+            span[0].buf[i] = (*next)++;
+        else
+            span[1].buf[i - span[0].len] = (*next)++;
+    }
+    rt_serial_tx_commit(serial, len);
+
+    return len;
+}
+
+/* check the data in place in the rx ringbuffer */
+static rt_bool_t uart_recv(rt_uint8_t *expect, rt_uint32_t *recv_len)
+{
+    struct rt_serial_span span[2];
+    rt_ssize_t len;
+    rt_uint32_t i, j;
+
+    len = rt_serial_rx_peek(serial, span);
+    if (len <= 0)
+    {
+        return len == 0;
+    }
+    for (i = 0; i < 2; i++)
+    {
+        for (j = 0; j < span[i].len; j++)
+        {
+            if (span[i].buf[j] != *expect)
+            {
+                LOG_E("Read Different data -> expect: %x, current data: %x.", *expect, span[i].buf[j]);
+                return RT_FALSE;
+            }
+            (*expect)++;
+        }
+    }
+    *recv_len += len;
+
+    return rt_serial_rx_consume(serial, len) == RT_EOK;
+}
+
+static rt_err_t uart_api(rt_uint32_t test_len)
+{
+    rt_uint8_t send_next = 0, recv_next = 0;
+    rt_uint32_t send_len = 0, recv_len = 0;
+    rt_err_t result = RT_EOK;
+
+    result = uart_find();
+    if (result != RT_EOK)
+    {
+        return -RT_ERROR;
+    }
+
+    rx_sem = rt_sem_create("rx_sem", 0, RT_IPC_FLAG_PRIO);
+    if (rx_sem == RT_NULL)
+    {
+        LOG_E("Init rx_sem failed.");
+        return -RT_ERROR;
+    }
+
+    /* reinitialize */
+    struct serial_configure config = RT_SERIAL_CONFIG_DEFAULT;
+    config.baud_rate = BAUD_RATE_115200;
+    config.rx_bufsz = BSP_UART2_RX_BUFSIZE;
+    config.tx_bufsz = BSP_UART2_TX_BUFSIZE;
+    rt_device_control(&serial->parent, RT_DEVICE_CTRL_CONFIG, &config);
+
+    result = rt_device_open(&serial->parent, RT_DEVICE_FLAG_RX_NON_BLOCKING | RT_DEVICE_FLAG_TX_NON_BLOCKING);
+    if (result != RT_EOK)
+    {
+        LOG_E("Open uart device failed.");
+        rt_sem_delete(rx_sem);
+        return -RT_ERROR;
+    }
+    rt_device_set_rx_indicate(&serial->parent, uart_rx_indicate);
+
+    /* more than the free space or the received data is refused */
+    if (rt_serial_tx_commit(serial, BSP_UART2_TX_BUFSIZE + 1) != -RT_EINVAL ||
+        rt_serial_rx_consume(serial, BSP_UART2_RX_BUFSIZE + 1) != -RT_EINVAL)
+    {
+        LOG_E("An oversized commit or consume is accepted.");
+        result = -RT_ERROR;
+    }
+
+    while (result == RT_EOK && recv_len < test_len)
+    {
+        if (send_len < test_len)
+        {
+            send_len += uart_send(&send_next, test_len - send_len);
+        }
+        if (rt_sem_take(rx_sem, rt_tick_from_millisecond(1000)) != RT_EOK)
+        {
+            LOG_E("receive timeout, %d of %d bytes.", recv_len, test_len);
+            result = -RT_ETIMEOUT;
+            break;
+        }
+        if (!uart_recv(&recv_next, &recv_len))
+        {
+            result = -RT_ERROR;
+            break;
+        }
+    }
+
+    rt_sem_delete(rx_sem);
+    rt_device_close(&serial->parent);
+    return result;
+}
+
+static void tc_uart_api(void)
+{
+    rt_uint32_t times = 0;
+    rt_uint32_t num = 0;
+
+    while (TC_UART_SEND_TIMES - times)
+    {
+        num = (rand() % 1000) + 1;
+        if (uart_api(num) == RT_EOK)
+            LOG_I("data_lens [%3d], it is correct to read and write data. [%d] times testing.", num, ++times);
+        else
+        {
+            LOG_E("uart test error");
+            break;
+        }
+    }
+    uassert_true(times == TC_UART_SEND_TIMES);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    LOG_I("UART TEST: Please connect Tx and Rx directly for self testing.");
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rx_sem = RT_NULL;
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(tc_uart_api);
+}
+
+UTEST_TC_EXPORT(testcase, "testcases.drivers.uart_zero_copy", utest_tc_init, utest_tc_cleanup, 30);
+
+#endif /* UTEST_SERIAL_TC */
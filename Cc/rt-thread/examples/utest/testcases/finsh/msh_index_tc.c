@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include <finsh.h>
+#include <msh.h>
+#include "utest.h"
+
+#define BENCH_ROUNDS    16
+
+static volatile int bench_calls;
+
+static int _bench_cmd(int argc, char **argv)
+{
+    bench_calls += argc;
+    return 0;
+}
+
+/* 256 commands named msh_bench_00 .. msh_bench_ff */
+#define _BENCH_CMD(h, l)    MSH_FUNCTION_EXPORT_CMD(_bench_cmd, msh_bench_##h##l, msh index bench, 0)
+#define _BENCH_CMD16(h)                                                 \
+    _BENCH_CMD(h, 0) _BENCH_CMD(h, 1) _BENCH_CMD(h, 2) _BENCH_CMD(h, 3) \
+    _BENCH_CMD(h, 4) _BENCH_CMD(h, 5) _BENCH_CMD(h, 6) _BENCH_CMD(h, 7) \
+    _BENCH_CMD(h, 8) _BENCH_CMD(h, 9) _BENCH_CMD(h, a) _BENCH_CMD(h, b) \
+    _BENCH_CMD(h, c) _BENCH_CMD(h, d) _BENCH_CMD(h, e) _BENCH_CMD(h, f)
+
+_BENCH_CMD16(0) _BENCH_CMD16(1) _BENCH_CMD16(2) _BENCH_CMD16(3)
+_BENCH_CMD16(4) _BENCH_CMD16(5) _BENCH_CMD16(6) _BENCH_CMD16(7)
+_BENCH_CMD16(8) _BENCH_CMD16(9) _BENCH_CMD16(a) _BENCH_CMD16(b)
+_BENCH_CMD16(c) _BENCH_CMD16(d) _BENCH_CMD16(e) _BENCH_CMD16(f)
+
+/* the linear scan, as the lookup does without the index */
+static struct finsh_syscall *_linear_find(const char *cmd, int size)
+{
+    struct finsh_syscall *index;
+
+    for (index = _syscall_table_begin;
+            index < _syscall_table_end;
+            FINSH_NEXT_SYSCALL(index))
+    {
+        if (rt_strncmp(index->name, cmd, size) == 0 && index->name[size] == '\0')
+            return index;
+    }
+
+    return RT_NULL;
+}
+
+static void test_cmd_find(void)
+{
+    struct finsh_syscall *index;
+    int count = 0;
+
+    /* every command resolves to the same entry as the linear scan */
+    for (index = _syscall_table_begin;
+            index < _syscall_table_end;
+            FINSH_NEXT_SYSCALL(index))
+    {
+        uassert_true(msh_cmd_find(index->name, rt_strlen(index->name)) ==
+                     _linear_find(index->name, rt_strlen(index->name)));
+        count++;
+    }
+    uassert_true(count >= 256);
+
+    index = msh_cmd_find("msh_bench_7f", 12);
+    uassert_not_null(index);
+    uassert_str_equal(index->name, "msh_bench_7f");
+
+    /* the name need not be terminated */
+    index = msh_cmd_find("msh_bench_7f -x", 12);
+    uassert_not_null(index);
+    uassert_str_equal(index->name, "msh_bench_7f");
+
+    uassert_null(msh_cmd_find("msh_bench_7", 11));
+    uassert_null(msh_cmd_find("msh_bench_7f0", 13));
+    uassert_null(msh_cmd_find("msh_bench_zz", 12));
+    uassert_null(msh_cmd_find("", 0));
+}
+
+static void test_cmd_exec(void)
+{
+    char line[] = "msh_bench_a5 1 2";
+
+    bench_calls = 0;
+    uassert_int_equal(msh_exec(line, rt_strlen(line)), 0);
+    uassert_int_equal(bench_calls, 3);
+}
+
+static void test_cmd_complete(void)
+{
+    char prefix[FINSH_CMD_SIZE] = "msh_bench_e";
+
+    msh_auto_complete(prefix);
+    uassert_str_equal(prefix, "msh_bench_e");
+
+    rt_strcpy(prefix, "msh_bench_e3");
+    msh_auto_complete(prefix);
+    uassert_str_equal(prefix, "msh_bench_e3");
+}
+
+static void test_cmd_bench(void)
+{
+    static const char digits[] = "0123456789abcdef";
+    char name[] = "msh_bench_00";
+    rt_uint64_t start, indexed = 0, linear = 0;
+    int round, i;
+
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (i = 0; i < 256; i++)
+        {
+            name[10] = digits[i >> 4];
+            name[11] = digits[i & 0xf];
+
+            start = utest_bench_now();
+            msh_cmd_find(name, 12);
+            indexed += utest_bench_now() - start;
+
+            start = utest_bench_now();
+            _linear_find(name, 12);
+            linear += utest_bench_now() - start;
+        }
+    }
+
+    /* total time of BENCH_ROUNDS lookups of each of the 256 commands */
+#ifdef RT_USING_CPUTIME
+    LOG_I("%-8s %12s", "lookup", "cycles");
+#else
+    LOG_I("%-8s %12s", "lookup", "ticks");
+#endif /* RT_USING_CPUTIME */
+    LOG_I("%-8s %12u", "index", (rt_uint32_t)indexed);
+    LOG_I("%-8s %12u", "linear", (rt_uint32_t)linear);
+
+#ifdef RT_USING_CPUTIME
+    uassert_true(indexed <= linear);
+#endif /* RT_USING_CPUTIME */
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    return msh_cmd_index_init();
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_cmd_find);
+    UTEST_UNIT_RUN(test_cmd_exec);
+    UTEST_UNIT_RUN(test_cmd_complete);
+    UTEST_UNIT_RUN(test_cmd_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.finsh.msh_index_tc", utest_tc_init, utest_tc_cleanup, 10);
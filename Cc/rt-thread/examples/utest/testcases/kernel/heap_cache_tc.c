@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+#define BENCH_PAIRS     4096
+#define BENCH_SIZE      512
+
+/* the index of the class serving size */
+static int _class_of(rt_size_t size)
+{
+    struct rt_heap_cache_stat stat;
+    int index;
+
+    for (index = 0; rt_heap_cache_get_stat(index, &stat) == RT_EOK; index++)
+    {
+        if (size <= stat.size)
+            return index;
+    }
+
+    return -1;
+}
+
+static int _class_nr(void)
+{
+    struct rt_heap_cache_stat stat;
+    int index = 0;
+
+    while (rt_heap_cache_get_stat(index, &stat) == RT_EOK)
+        index++;
+
+    return index;
+}
+
+static void test_heap_cache_hit(void)
+{
+    struct rt_heap_cache_stat before, after;
+    void *ptr, *again;
+    int index;
+
+    index = _class_of(100);
+    uassert_true(index >= 0);
+    rt_heap_cache_flush();
+
+    rt_heap_cache_get_stat(index, &before);
+    uassert_int_equal(before.cached, 0);
+    ptr = rt_malloc(100);
+    uassert_not_null(ptr);
+    rt_heap_cache_get_stat(index, &after);
+    uassert_int_equal(after.misses, before.misses + 1);
+    /* the miss refilled a batch */
+    uassert_int_equal(after.cached, RT_HEAP_CACHE_BATCH - 1);
+
+    /* the block just released is handed out again */
+    rt_free(ptr);
+    again = rt_malloc(before.size);
+    uassert_true(again == ptr);
+    rt_heap_cache_get_stat(index, &after);
+    uassert_int_equal(after.hits, before.hits + 1);
+    rt_free(again);
+
+    uassert_int_equal(rt_heap_cache_get_stat(_class_nr(), &after), -RT_EINVAL);
+}
+
+static void test_heap_cache_classes(void)
+{
+    struct rt_heap_cache_stat stat;
+    rt_size_t total, used, cached_used;
+    void *ptr;
+
+    /* the common buffer sizes fit a class, the others waste a quarter at most */
+    rt_heap_cache_get_stat(_class_of(512), &stat);
+    uassert_int_equal(stat.size, 512);
+    rt_heap_cache_get_stat(_class_of(2048), &stat);
+    uassert_int_equal(stat.size, 2048);
+    rt_heap_cache_get_stat(_class_of(1040), &stat);
+    uassert_true(stat.size >= 1040 && stat.size <= 1040 + 1040 / 4);
+
+    /* the cached blocks count as free, only the overhead of the heap stays */
+    rt_heap_cache_flush();
+    rt_memory_info(&total, &used, RT_NULL);
+    ptr = rt_malloc(512);
+    uassert_not_null(ptr);
+    rt_free(ptr);
+    rt_memory_info(&total, &cached_used, RT_NULL);
+    uassert_true(cached_used < used + 512);
+}
+
+static void test_heap_cache_realloc(void)
+{
+    struct rt_heap_cache_stat stat;
+    rt_uint8_t *ptr, *nptr;
+    rt_size_t large;
+    int i;
+
+    rt_heap_cache_get_stat(_class_nr() - 1, &stat);
+    large = stat.size * 2;
+
+    ptr = rt_malloc(20);
+    uassert_not_null(ptr);
+    for (i = 0; i < 20; i++)
+        ptr[i] = (rt_uint8_t)i;
+
+    /* same class, same block */
+    nptr = rt_realloc(ptr, 30);
+    uassert_true(nptr == ptr);
+
+    /* a larger class, then a block beyond every class */
+    nptr = rt_realloc(ptr, 100);
+    uassert_not_null(nptr);
+    ptr = rt_realloc(nptr, large);
+    uassert_not_null(ptr);
+    nptr = rt_realloc(ptr, large + 64);
+    uassert_not_null(nptr);
+    ptr = rt_realloc(nptr, 16);
+    uassert_not_null(ptr);
+    for (i = 0; i < 16; i++)
+        uassert_int_equal(ptr[i], i);
+
+    uassert_null(rt_realloc(ptr, 0));
+    uassert_null(rt_malloc(0));
+}
+
+#ifdef RT_USING_MEMHEAP_AS_HEAP
+static rt_uint8_t foreign_pool[2048];
+
+static void test_heap_cache_foreign(void)
+{
+    struct rt_memheap heap;
+    rt_size_t used, after;
+    rt_uint8_t *ptr;
+    int i;
+
+    uassert_int_equal(rt_memheap_init(&heap, "hc_tc", foreign_pool, sizeof(foreign_pool)), RT_EOK);
+    rt_memheap_info(&heap, RT_NULL, &used, RT_NULL);
+
+    /* a block outside the system heap has no header, rt_free hands it back */
+    ptr = rt_memheap_alloc(&heap, 100);
+    uassert_not_null(ptr);
+    for (i = 0; i < 100; i++)
+        ptr[i] = (rt_uint8_t)i;
+    ptr = rt_realloc(ptr, 200);
+    uassert_not_null(ptr);
+    for (i = 0; i < 100; i++)
+        uassert_int_equal(ptr[i], i);
+    rt_free(ptr);
+
+    rt_memheap_info(&heap, RT_NULL, &after, RT_NULL);
+    uassert_int_equal(after, used);
+    rt_memheap_detach(&heap);
+}
+#endif /* RT_USING_MEMHEAP_AS_HEAP */
+
+static void test_heap_cache_trim(void)
+{
+    struct rt_heap_cache_stat stat;
+    void *blocks[RT_HEAP_CACHE_DEPTH + RT_HEAP_CACHE_BATCH];
+    rt_uint32_t drains;
+    rt_size_t i;
+    int index;
+
+    index = _class_of(64);
+    rt_heap_cache_get_stat(index, &stat);
+    drains = stat.drains;
+
+    for (i = 0; i < sizeof(blocks) / sizeof(blocks[0]); i++)
+    {
+        blocks[i] = rt_malloc(64);
+        uassert_not_null(blocks[i]);
+    }
+    for (i = 0; i < sizeof(blocks) / sizeof(blocks[0]); i++)
+        rt_free(blocks[i]);
+
+    /* the cache never holds more than its depth */
+    rt_heap_cache_get_stat(index, &stat);
+    uassert_true(stat.cached <= RT_HEAP_CACHE_DEPTH);
+    uassert_true(stat.drains > drains);
+
+    /* blocks unused over a whole period are given back */
+    rt_heap_cache_trim();
+    rt_heap_cache_trim();
+    rt_heap_cache_get_stat(index, &stat);
+    uassert_int_equal(stat.cached, 0);
+}
+
+static void test_heap_cache_bench(void)
+{
+    rt_uint64_t start, hot, cold = 0;
+    void *ptr;
+    int i;
+
+    /* warm the class up */
+    rt_free(rt_malloc(BENCH_SIZE));
+
+    start = utest_bench_now();
+    for (i = 0; i < BENCH_PAIRS; i++)
+    {
+        ptr = rt_malloc(BENCH_SIZE);
+        rt_free(ptr);
+    }
+    hot = utest_bench_now() - start;
+
+    /* every allocation misses and goes to the heap backend */
+    for (i = 0; i < BENCH_PAIRS; i++)
+    {
+        rt_heap_cache_flush();
+        start = utest_bench_now();
+        ptr = rt_malloc(BENCH_SIZE);
+        rt_free(ptr);
+        cold += utest_bench_now() - start;
+    }
+
+#ifdef RT_USING_CPUTIME
+    LOG_I("%d x %d bytes malloc/free pairs: cached %u cyc/pair, missed %u cyc/pair",
+          BENCH_PAIRS, BENCH_SIZE, (rt_uint32_t)(hot / BENCH_PAIRS), (rt_uint32_t)(cold / BENCH_PAIRS));
+#else
+    LOG_I("%d x %d bytes malloc/free pairs: cached %u ticks, missed %u ticks",
+          BENCH_PAIRS, BENCH_SIZE, (rt_uint32_t)hot, (rt_uint32_t)cold);
+#endif /* RT_USING_CPUTIME */
+
+#ifdef RT_USING_CPUTIME
+    uassert_true(hot <= cold);
+#endif /* RT_USING_CPUTIME */
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_heap_cache_flush();
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_heap_cache_hit);
+    UTEST_UNIT_RUN(test_heap_cache_classes);
+    UTEST_UNIT_RUN(test_heap_cache_realloc);
+#ifdef RT_USING_MEMHEAP_AS_HEAP
+    UTEST_UNIT_RUN(test_heap_cache_foreign);
+#endif /* RT_USING_MEMHEAP_AS_HEAP */
+    UTEST_UNIT_RUN(test_heap_cache_trim);
+    UTEST_UNIT_RUN(test_heap_cache_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.heap_cache_tc", utest_tc_init, utest_tc_cleanup, 10);
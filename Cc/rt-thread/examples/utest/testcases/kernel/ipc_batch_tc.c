@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+#define BURST_MAX       64
+#define MSG_SIZE        8
+
+/* each benchmark round runs for this many ticks */
+#define BENCH_TICKS     (RT_TICK_PER_SECOND / 10)
+
+static rt_mailbox_t test_mb;
+static rt_mq_t test_mq;
+
+static rt_ubase_t mails[BURST_MAX];
+static rt_uint8_t msgs[BURST_MAX][MSG_SIZE];
+static rt_size_t lengths[BURST_MAX];
+
+static struct rt_semaphore consumer_done;
+
+static void test_mb_batch(void)
+{
+    rt_ssize_t ret;
+    int i;
+
+    for (i = 0; i < BURST_MAX; i++)
+        mails[i] = i + 1;
+
+    ret = rt_mb_send_batch(test_mb, mails, BURST_MAX, RT_WAITING_NO);
+    uassert_int_equal(ret, BURST_MAX);
+    ret = rt_mb_send_batch(test_mb, mails, 1, RT_WAITING_NO);
+    uassert_int_equal(ret, -RT_EFULL);
+
+    rt_memset(mails, 0, sizeof(mails));
+    ret = rt_mb_recv_batch(test_mb, mails, 10, RT_WAITING_NO);
+    uassert_int_equal(ret, 10);
+    uassert_int_equal(mails[0], 1);
+    uassert_int_equal(mails[9], 10);
+
+    /* only the mails which fit are sent */
+    ret = rt_mb_send_batch(test_mb, mails, 20, RT_WAITING_NO);
+    uassert_int_equal(ret, 10);
+
+    ret = rt_mb_recv_batch(test_mb, mails, BURST_MAX, RT_WAITING_NO);
+    uassert_int_equal(ret, BURST_MAX);
+    uassert_int_equal(mails[0], 11);
+    uassert_int_equal(mails[BURST_MAX - 11], BURST_MAX);
+    uassert_int_equal(mails[BURST_MAX - 10], 1);
+    uassert_int_equal(mails[BURST_MAX - 1], 10);
+    uassert_int_equal(test_mb->entry, 0);
+
+    ret = rt_mb_recv_batch(test_mb, mails, BURST_MAX, 5);
+    uassert_int_equal(ret, -RT_ETIMEOUT);
+}
+
+static void test_mq_batch(void)
+{
+    rt_ssize_t ret;
+    int i;
+
+    for (i = 0; i < BURST_MAX; i++)
+        rt_memset(msgs[i], i, MSG_SIZE);
+
+    ret = rt_mq_send_batch(test_mq, msgs, MSG_SIZE, BURST_MAX, RT_WAITING_NO);
+    uassert_int_equal(ret, BURST_MAX);
+    ret = rt_mq_send_batch(test_mq, msgs, MSG_SIZE, 1, RT_WAITING_NO);
+    uassert_int_equal(ret, -RT_EFULL);
+    uassert_int_equal(test_mq->entry, BURST_MAX);
+
+    /* single receive sees the batch in order */
+    ret = rt_mq_recv(test_mq, msgs[0], MSG_SIZE, RT_WAITING_NO);
+    uassert_int_equal(ret, MSG_SIZE);
+    uassert_int_equal(msgs[0][0], 0);
+
+    /* only the messages which fit are sent */
+    ret = rt_mq_send_batch(test_mq, msgs, MSG_SIZE, 2, RT_WAITING_NO);
+    uassert_int_equal(ret, 1);
+
+    rt_memset(msgs, 0xff, sizeof(msgs));
+    ret = rt_mq_recv_batch(test_mq, msgs, MSG_SIZE, BURST_MAX - 1, lengths, RT_WAITING_NO);
+    uassert_int_equal(ret, BURST_MAX - 1);
+    for (i = 0; i < ret; i++)
+    {
+        uassert_int_equal(lengths[i], MSG_SIZE);
+        uassert_int_equal(msgs[i][0], i + 1);
+        uassert_int_equal(msgs[i][MSG_SIZE - 1], i + 1);
+    }
+    uassert_int_equal(test_mq->entry, 1);
+
+    ret = rt_mq_recv_batch(test_mq, msgs, MSG_SIZE, BURST_MAX, lengths, RT_WAITING_NO);
+    uassert_int_equal(ret, 1);
+    uassert_int_equal(test_mq->entry, 0);
+
+    /* the freed slots are reusable by the single path */
+    for (i = 0; i < BURST_MAX; i++)
+        uassert_int_equal(rt_mq_send(test_mq, msgs[i], MSG_SIZE), RT_EOK);
+    uassert_int_equal(rt_mq_send(test_mq, msgs[0], MSG_SIZE), -RT_EFULL);
+    rt_mq_control(test_mq, RT_IPC_CMD_RESET, RT_NULL);
+
+    ret = rt_mq_recv_batch(test_mq, msgs, MSG_SIZE, BURST_MAX, RT_NULL, 5);
+    uassert_int_equal(ret, -RT_ETIMEOUT);
+}
+
+static void _batch_consumer_entry(void *parameter)
+{
+    rt_ssize_t ret;
+    int total = 0;
+
+    while (total < BURST_MAX)
+    {
+        ret = rt_mb_recv_batch(test_mb, mails, BURST_MAX, RT_WAITING_FOREVER);
+        if (ret < 0)
+            break;
+        total += ret;
+    }
+
+    rt_sem_release(&consumer_done);
+}
+
+static void test_mb_batch_wakeup(void)
+{
+    rt_thread_t consumer;
+    rt_ubase_t values[BURST_MAX];
+    rt_ssize_t ret;
+    int sent = 0;
+    int i;
+
+    for (i = 0; i < BURST_MAX; i++)
+        values[i] = i;
+
+    /* a blocked batch receiver is woken by a batch sender */
+    consumer = rt_thread_create("mb_bat", _batch_consumer_entry, RT_NULL,
+                                UTEST_THR_STACK_SIZE, RT_THREAD_PRIORITY_MAX - 3, 10);
+    uassert_not_null(consumer);
+    rt_thread_startup(consumer);
+    rt_thread_mdelay(10);
+
+    while (sent < BURST_MAX)
+    {
+        ret = rt_mb_send_batch(test_mb, &values[sent], BURST_MAX - sent, RT_WAITING_FOREVER);
+        uassert_true(ret > 0);
+        sent += ret;
+    }
+
+    uassert_int_equal(rt_sem_take(&consumer_done, RT_TICK_PER_SECOND), RT_EOK);
+}
+
+static rt_uint32_t _bench_mb(rt_size_t burst, rt_bool_t batch)
+{
+    rt_tick_t start, elapsed;
+    rt_uint32_t items = 0;
+    rt_size_t i;
+
+    start = rt_tick_get();
+    do
+    {
+        if (batch)
+        {
+            rt_mb_send_batch(test_mb, mails, burst, RT_WAITING_NO);
+            rt_mb_recv_batch(test_mb, mails, burst, RT_WAITING_NO);
+        }
+        else
+        {
+            for (i = 0; i < burst; i++)
+                rt_mb_send(test_mb, mails[i]);
+            for (i = 0; i < burst; i++)
+                rt_mb_recv(test_mb, &mails[i], RT_WAITING_NO);
+        }
+        items += burst;
+        elapsed = rt_tick_get() - start;
+    } while (elapsed < BENCH_TICKS);
+
+    /* nanoseconds per item for one send plus one receive */
+    return (rt_uint32_t)((rt_uint64_t)elapsed * (1000000000ULL / RT_TICK_PER_SECOND) / items);
+}
+
+static rt_uint32_t _bench_mq(rt_size_t burst, rt_bool_t batch)
+{
+    rt_tick_t start, elapsed;
+    rt_uint32_t items = 0;
+    rt_size_t i;
+
+    start = rt_tick_get();
+    do
+    {
+        if (batch)
+        {
+            rt_mq_send_batch(test_mq, msgs, MSG_SIZE, burst, RT_WAITING_NO);
+            rt_mq_recv_batch(test_mq, msgs, MSG_SIZE, burst, RT_NULL, RT_WAITING_NO);
+        }
+        else
+        {
+            for (i = 0; i < burst; i++)
+                rt_mq_send(test_mq, msgs[i], MSG_SIZE);
+            for (i = 0; i < burst; i++)
+                rt_mq_recv(test_mq, msgs[i], MSG_SIZE, RT_WAITING_NO);
+        }
+        items += burst;
+        elapsed = rt_tick_get() - start;
+    } while (elapsed < BENCH_TICKS);
+
+    return (rt_uint32_t)((rt_uint64_t)elapsed * (1000000000ULL / RT_TICK_PER_SECOND) / items);
+}
+
+static void test_batch_bench(void)
+{
+    rt_size_t burst;
+
+    LOG_I("%6s %12s %12s %12s %12s", "burst", "mb(ns)", "mb_bat(ns)", "mq(ns)", "mq_bat(ns)");
+    for (burst = 1; burst <= BURST_MAX; burst <<= 1)
+    {
+        LOG_I("%6d %12u %12u %12u %12u", (int)burst,
+              _bench_mb(burst, RT_FALSE), _bench_mb(burst, RT_TRUE),
+              _bench_mq(burst, RT_FALSE), _bench_mq(burst, RT_TRUE));
+    }
+    uassert_int_equal(test_mb->entry, 0);
+    uassert_int_equal(test_mq->entry, 0);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    test_mb = rt_mb_create("mb_bat", BURST_MAX, RT_IPC_FLAG_PRIO);
+    if (test_mb == RT_NULL)
+        return -RT_ENOMEM;
+
+    test_mq = rt_mq_create("mq_bat", MSG_SIZE, BURST_MAX, RT_IPC_FLAG_PRIO);
+    if (test_mq == RT_NULL)
+    {
+        rt_mb_delete(test_mb);
+        return -RT_ENOMEM;
+    }
+
+    rt_sem_init(&consumer_done, "bat_done", 0, RT_IPC_FLAG_PRIO);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_mb_delete(test_mb);
+    rt_mq_delete(test_mq);
+    rt_sem_detach(&consumer_done);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_mb_batch);
+    UTEST_UNIT_RUN(test_mq_batch);
+    UTEST_UNIT_RUN(test_mb_batch_wakeup);
+    UTEST_UNIT_RUN(test_batch_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.ipc_batch_tc", utest_tc_init, utest_tc_cleanup, 60);
@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+#define STRESS_THREADS      4
+#define STRESS_LOOPS        2000
+#define PRIO_HIGH           (UTEST_THR_PRIORITY - 1)
+#define PRIO_LOW            (UTEST_THR_PRIORITY + 2)
+
+/* each benchmark round runs this many operations */
+#define BENCH_LOOPS         10000
+
+static struct rt_semaphore test_sem;
+static struct rt_mutex test_mutex;
+static struct rt_semaphore worker_done;
+static struct rt_semaphore ping_sem;
+static struct rt_semaphore pong_sem;
+
+static volatile rt_uint32_t shared_counter;
+static volatile rt_bool_t bench_running;
+
+static void test_sem_fastpath(void)
+{
+    rt_tick_t tick;
+    int i;
+
+    rt_sem_control(&test_sem, RT_IPC_CMD_RESET, (void *)2);
+    rt_sem_control(&test_sem, RT_IPC_CMD_SET_VLIMIT, (void *)3);
+
+    uassert_int_equal(rt_sem_trytake(&test_sem), RT_EOK);
+    uassert_int_equal(rt_sem_trytake(&test_sem), RT_EOK);
+    uassert_int_equal(rt_sem_trytake(&test_sem), -RT_ETIMEOUT);
+
+    for (i = 0; i < 3; i++)
+        uassert_int_equal(rt_sem_release(&test_sem), RT_EOK);
+    uassert_int_equal(rt_sem_release(&test_sem), -RT_EFULL);
+
+    for (i = 0; i < 3; i++)
+        uassert_int_equal(rt_sem_take(&test_sem, RT_WAITING_NO), RT_EOK);
+
+    /* a timed out waiter must not keep the semaphore on the slow path */
+    tick = rt_tick_get();
+    uassert_int_equal(rt_sem_take(&test_sem, 5), -RT_ETIMEOUT);
+    uassert_true(rt_tick_get() - tick >= 5);
+    uassert_int_equal(rt_sem_release(&test_sem), RT_EOK);
+    uassert_int_equal(rt_sem_trytake(&test_sem), RT_EOK);
+
+    rt_sem_control(&test_sem, RT_IPC_CMD_SET_VLIMIT, (void *)RT_SEM_VALUE_MAX);
+}
+
+static void _sem_waiter_entry(void *parameter)
+{
+    if (rt_sem_take(&test_sem, RT_WAITING_FOREVER) == RT_EOK)
+        shared_counter++;
+
+    rt_sem_release(&worker_done);
+}
+
+static void test_sem_wakeup(void)
+{
+    rt_thread_t waiter;
+
+    shared_counter = 0;
+    rt_sem_control(&test_sem, RT_IPC_CMD_RESET, (void *)0);
+
+    waiter = rt_thread_create("fp_sw", _sem_waiter_entry, RT_NULL,
+                              UTEST_THR_STACK_SIZE, PRIO_HIGH, 10);
+    uassert_not_null(waiter);
+    rt_thread_startup(waiter);
+
+    /* the waiter is pended, so the count is handed over to it */
+    uassert_int_equal(rt_sem_release(&test_sem), RT_EOK);
+    uassert_int_equal(rt_sem_take(&worker_done, RT_TICK_PER_SECOND), RT_EOK);
+    uassert_int_equal(shared_counter, 1);
+    uassert_int_equal(rt_sem_trytake(&test_sem), -RT_ETIMEOUT);
+}
+
+static void test_mutex_fastpath(void)
+{
+    rt_thread_t self = rt_thread_self();
+
+    uassert_int_equal(rt_mutex_take(&test_mutex, RT_WAITING_NO), RT_EOK);
+    uassert_true(test_mutex.owner == self);
+    uassert_int_equal(test_mutex.hold, 1);
+
+    /* recursive take falls back to the slow path */
+    uassert_int_equal(rt_mutex_take(&test_mutex, RT_WAITING_NO), RT_EOK);
+    uassert_int_equal(test_mutex.hold, 2);
+    uassert_int_equal(rt_mutex_release(&test_mutex), RT_EOK);
+    uassert_true(test_mutex.owner == self);
+    uassert_int_equal(rt_mutex_release(&test_mutex), RT_EOK);
+    uassert_null(test_mutex.owner);
+
+    uassert_int_equal(rt_mutex_release(&test_mutex), -RT_ERROR);
+
+    /* the fast path is available again after a slow release */
+    uassert_int_equal(rt_mutex_trytake(&test_mutex), RT_EOK);
+    uassert_int_equal(rt_mutex_release(&test_mutex), RT_EOK);
+    uassert_null(test_mutex.owner);
+}
+
+static void _mutex_high_entry(void *parameter)
+{
+    if (rt_mutex_take(&test_mutex, RT_WAITING_FOREVER) == RT_EOK)
+    {
+        shared_counter++;
+        rt_mutex_release(&test_mutex);
+    }
+
+    rt_sem_release(&worker_done);
+}
+
+static void test_mutex_inherit(void)
+{
+    rt_thread_t self = rt_thread_self();
+    rt_thread_t high;
+    rt_uint8_t init_prio = RT_SCHED_PRIV(self).current_priority;
+
+    shared_counter = 0;
+
+    /* the uncontended take does not boost anyone */
+    uassert_int_equal(rt_mutex_take(&test_mutex, RT_WAITING_FOREVER), RT_EOK);
+
+    high = rt_thread_create("fp_mh", _mutex_high_entry, RT_NULL,
+                            UTEST_THR_STACK_SIZE, PRIO_HIGH, 10);
+    uassert_not_null(high);
+    rt_thread_startup(high);
+
+    /* the high priority thread is pended and the owner inherits its priority */
+    uassert_int_equal(RT_SCHED_PRIV(self).current_priority, PRIO_HIGH);
+    uassert_int_equal(shared_counter, 0);
+
+    uassert_int_equal(rt_mutex_release(&test_mutex), RT_EOK);
+    uassert_int_equal(RT_SCHED_PRIV(self).current_priority, init_prio);
+
+    uassert_int_equal(rt_sem_take(&worker_done, RT_TICK_PER_SECOND), RT_EOK);
+    uassert_int_equal(shared_counter, 1);
+    uassert_null(test_mutex.owner);
+}
+
+static void _stress_entry(void *parameter)
+{
+    rt_uint32_t value;
+    int i;
+
+    for (i = 0; i < STRESS_LOOPS; i++)
+    {
+        rt_mutex_take(&test_mutex, RT_WAITING_FOREVER);
+        value = shared_counter;
+        /* let the others contend while the mutex is held */
+        if ((i & 0x7) == 0)
+            rt_thread_yield();
+        shared_counter = value + 1;
+        rt_mutex_release(&test_mutex);
+
+        rt_sem_release(&test_sem);
+        while (rt_sem_take(&test_sem, 1) != RT_EOK);
+    }
+
+    rt_sem_release(&worker_done);
+}
+
+static void test_ipc_stress(void)
+{
+    rt_thread_t tid;
+    int i;
+
+    shared_counter = 0;
+    rt_sem_control(&test_sem, RT_IPC_CMD_RESET, (void *)0);
+
+    for (i = 0; i < STRESS_THREADS; i++)
+    {
+        tid = rt_thread_create("fp_st", _stress_entry, RT_NULL,
+                               UTEST_THR_STACK_SIZE, PRIO_LOW + (i & 1), 2);
+        uassert_not_null(tid);
+        rt_thread_startup(tid);
+    }
+
+    for (i = 0; i < STRESS_THREADS; i++)
+        uassert_int_equal(rt_sem_take(&worker_done, RT_WAITING_FOREVER), RT_EOK);
+
+    uassert_int_equal(shared_counter, STRESS_THREADS * STRESS_LOOPS);
+    uassert_null(test_mutex.owner);
+    uassert_int_equal(rt_sem_trytake(&test_sem), -RT_ETIMEOUT);
+}
+
+static void _pong_entry(void *parameter)
+{
+    while (bench_running)
+    {
+        rt_sem_take(&ping_sem, RT_WAITING_FOREVER);
+        rt_sem_release(&pong_sem);
+    }
+
+    rt_sem_release(&worker_done);
+}
+
+static void _holder_entry(void *parameter)
+{
+    while (bench_running)
+    {
+        rt_sem_take(&ping_sem, RT_WAITING_FOREVER);
+        rt_mutex_take(&test_mutex, RT_WAITING_FOREVER);
+        rt_mutex_release(&test_mutex);
+    }
+
+    rt_sem_release(&worker_done);
+}
+
+static void test_ipc_bench(void)
+{
+    rt_uint64_t start, sem_fast, mtx_fast, sem_cont, mtx_cont;
+    rt_thread_t tid;
+    int i;
+
+    rt_sem_control(&test_sem, RT_IPC_CMD_RESET, (void *)1);
+
+    start = utest_bench_now();
+    for (i = 0; i < BENCH_LOOPS; i++)
+    {
+        rt_sem_take(&test_sem, RT_WAITING_FOREVER);
+        rt_sem_release(&test_sem);
+    }
+    sem_fast = utest_bench_now() - start;
+
+    start = utest_bench_now();
+    for (i = 0; i < BENCH_LOOPS; i++)
+    {
+        rt_mutex_take(&test_mutex, RT_WAITING_FOREVER);
+        rt_mutex_release(&test_mutex);
+    }
+    mtx_fast = utest_bench_now() - start;
+
+    /* contended semaphore: ping-pong with a higher priority thread */
+    bench_running = RT_TRUE;
+    tid = rt_thread_create("fp_pp", _pong_entry, RT_NULL,
+                           UTEST_THR_STACK_SIZE, PRIO_HIGH, 10);
+    uassert_not_null(tid);
+    rt_thread_startup(tid);
+
+    start = utest_bench_now();
+    for (i = 0; i < BENCH_LOOPS; i++)
+    {
+        if (i == BENCH_LOOPS - 1)
+            bench_running = RT_FALSE;
+        rt_sem_release(&ping_sem);
+        rt_sem_take(&pong_sem, RT_WAITING_FOREVER);
+    }
+    sem_cont = utest_bench_now() - start;
+    uassert_int_equal(rt_sem_take(&worker_done, RT_TICK_PER_SECOND), RT_EOK);
+
+    /* contended mutex: a higher priority thread pends on the held mutex */
+    bench_running = RT_TRUE;
+    tid = rt_thread_create("fp_mc", _holder_entry, RT_NULL,
+                           UTEST_THR_STACK_SIZE, PRIO_HIGH, 10);
+    uassert_not_null(tid);
+    rt_thread_startup(tid);
+
+    start = utest_bench_now();
+    for (i = 0; i < BENCH_LOOPS; i++)
+    {
+        if (i == BENCH_LOOPS - 1)
+            bench_running = RT_FALSE;
+        rt_mutex_take(&test_mutex, RT_WAITING_FOREVER);
+        rt_sem_release(&ping_sem);
+        rt_mutex_release(&test_mutex);
+    }
+    mtx_cont = utest_bench_now() - start;
+    uassert_int_equal(rt_sem_take(&worker_done, RT_TICK_PER_SECOND), RT_EOK);
+
+#ifdef RT_USING_CPUTIME
+    LOG_I("%-24s %12s", "take+release", "cycles/op");
+#else
+    LOG_I("%-24s %12s", "take+release", "ns/op");
+    /* convert ticks of the whole round into nanoseconds per operation */
+    sem_fast = sem_fast * (1000000000ULL / RT_TICK_PER_SECOND);
+    mtx_fast = mtx_fast * (1000000000ULL / RT_TICK_PER_SECOND);
+    sem_cont = sem_cont * (1000000000ULL / RT_TICK_PER_SECOND);
+    mtx_cont = mtx_cont * (1000000000ULL / RT_TICK_PER_SECOND);
+#endif /* RT_USING_CPUTIME */
+    LOG_I("%-24s %12u", "sem uncontended", (rt_uint32_t)(sem_fast / BENCH_LOOPS));
+    LOG_I("%-24s %12u", "mutex uncontended", (rt_uint32_t)(mtx_fast / BENCH_LOOPS));
+    LOG_I("%-24s %12u", "sem contended", (rt_uint32_t)(sem_cont / BENCH_LOOPS));
+    LOG_I("%-24s %12u", "mutex contended", (rt_uint32_t)(mtx_cont / BENCH_LOOPS));
+
+    uassert_null(test_mutex.owner);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_sem_init(&test_sem, "fp_sem", 0, RT_IPC_FLAG_PRIO);
+    rt_mutex_init(&test_mutex, "fp_mtx", RT_IPC_FLAG_PRIO);
+    rt_sem_init(&worker_done, "fp_done", 0, RT_IPC_FLAG_PRIO);
+    rt_sem_init(&ping_sem, "fp_ping", 0, RT_IPC_FLAG_PRIO);
+    rt_sem_init(&pong_sem, "fp_pong", 0, RT_IPC_FLAG_PRIO);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&test_sem);
+    rt_mutex_detach(&test_mutex);
+    rt_sem_detach(&worker_done);
+    rt_sem_detach(&ping_sem);
+    rt_sem_detach(&pong_sem);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_sem_fastpath);
+    UTEST_UNIT_RUN(test_sem_wakeup);
+    UTEST_UNIT_RUN(test_mutex_fastpath);
+    UTEST_UNIT_RUN(test_mutex_inherit);
+    UTEST_UNIT_RUN(test_ipc_stress);
+    UTEST_UNIT_RUN(test_ipc_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.ipc_fastpath_tc", utest_tc_init, utest_tc_cleanup, 120);
@@ -0,0 +1,927 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+#define FUZZ_ROUNDS     20000
+#define BUF_SIZE        160
+#define BENCH_CALLS     20000
+
+/*
+ * The rt_vsnprintf of src/klibc/kstdio.c before the digit pair and the fast
+ * path rework, kept as the reference of the differential test. Only the tmp
+ * buffer of print_number has been sized for the binary digits of a 64-bit long.
+ */
+
+#define _ISDIGIT(c)  ((unsigned)((c) - '0') < 10)
+
+#ifdef RT_KPRINTF_USING_LONGLONG
+rt_inline int _ref_divide(unsigned long long *n, int base)
+#else
+rt_inline int _ref_divide(unsigned long *n, int base)
+#endif /* RT_KPRINTF_USING_LONGLONG */
+{
+    int res;
+
+    /* optimized for processor which does not support divide instructions. */
+#ifdef RT_KPRINTF_USING_LONGLONG
+    res = (int)((*n) % base);
+    *n = (long long)((*n) / base);
+#else
+    res = (int)((*n) % base);
+    *n = (long)((*n) / base);
+#endif
+
+    return res;
+}
+
+rt_inline int _ref_skip_atoi(const char **s)
+{
+    int i = 0;
+    while (_ISDIGIT(**s))
+        i = i * 10 + *((*s)++) - '0';
+
+    return i;
+}
+
+#define ZEROPAD     (1 << 0)    /* pad with zero */
+#define SIGN        (1 << 1)    /* unsigned/signed long */
+#define PLUS        (1 << 2)    /* show plus */
+#define SPACE       (1 << 3)    /* space if plus */
+#define LEFT        (1 << 4)    /* left justified */
+#define SPECIAL     (1 << 5)    /* 0x */
+#define LARGE       (1 << 6)    /* use 'ABCDEF' instead of 'abcdef' */
+
+static char *_ref_print_number(char *buf,
+                          char *end,
+#ifdef RT_KPRINTF_USING_LONGLONG
+                          unsigned long long  num,
+#else
+                          unsigned long  num,
+#endif /* RT_KPRINTF_USING_LONGLONG */
+                          int   base,
+                          int   qualifier,
+                          int   s,
+                          int   precision,
+                          int   type)
+{
+    char c = 0, sign = 0;
+#ifdef RT_KPRINTF_USING_LONGLONG
+    char tmp[64] = {0};
+#else
+    char tmp[sizeof(unsigned long) * 8] = {0};  /* 32 overflows with the binary digits of a 64-bit long */
+#endif /* RT_KPRINTF_USING_LONGLONG */
+    int precision_bak = precision;
+    const char *digits = RT_NULL;
+    static const char small_digits[] = "0123456789abcdef";
+    static const char large_digits[] = "0123456789ABCDEF";
+    int i = 0;
+    int size = 0;
+
+    size = s;
+
+    digits = (type & LARGE) ? large_digits : small_digits;
+    if (type & LEFT)
+    {
+        type &= ~ZEROPAD;
+    }
+
+    c = (type & ZEROPAD) ? '0' : ' ';
+
+    /* get sign */
+    sign = 0;
+    if (type & SIGN)
+    {
+        switch (qualifier)
+        {
+        case 'h':
+            if ((rt_int16_t)num < 0)
+            {
+                sign = '-';
+                num = (rt_uint16_t)-num;
+            }
+            break;
+        case 'L':
+        case 'l':
+            if ((long)num < 0)
+            {
+                sign = '-';
+                num = (unsigned long)-num;
+            }
+            break;
+        case 0:
+        default:
+            if ((rt_int32_t)num < 0)
+            {
+                sign = '-';
+                num = (rt_uint32_t)-num;
+            }
+            break;
+        }
+
+        if (sign != '-')
+        {
+            if (type & PLUS)
+            {
+                sign = '+';
+            }
+            else if (type & SPACE)
+            {
+                sign = ' ';
+            }
+        }
+    }
+
+    if (type & SPECIAL)
+    {
+        if (base == 2 || base == 16)
+        {
+            size -= 2;
+        }
+        else if (base == 8)
+        {
+            size--;
+        }
+    }
+
+    i = 0;
+    if (num == 0)
+    {
+        tmp[i++] = '0';
+    }
+    else
+    {
+        while (num != 0)
+            tmp[i++] = digits[_ref_divide(&num, base)];
+    }
+
+    if (i > precision)
+    {
+        precision = i;
+    }
+    size -= precision;
+
+    if (!(type & (ZEROPAD | LEFT)))
+    {
+        if ((sign) && (size > 0))
+        {
+            size--;
+        }
+
+        while (size-- > 0)
+        {
+            if (buf < end)
+            {
+                *buf = ' ';
+            }
+
+            ++ buf;
+        }
+    }
+
+    if (sign)
+    {
+        if (buf < end)
+        {
+            *buf = sign;
+        }
+        -- size;
+        ++ buf;
+    }
+
+    if (type & SPECIAL)
+    {
+        if (base == 2)
+        {
+            if (buf < end)
+                *buf = '0';
+            ++ buf;
+            if (buf < end)
+                *buf = 'b';
+            ++ buf;
+        }
+        else if (base == 8)
+        {
+            if (buf < end)
+                *buf = '0';
+            ++ buf;
+        }
+        else if (base == 16)
+        {
+            if (buf < end)
+            {
+                *buf = '0';
+            }
+
+            ++ buf;
+            if (buf < end)
+            {
+                *buf = type & LARGE ? 'X' : 'x';
+            }
+            ++ buf;
+        }
+    }
+
+    /* no align to the left */
+    if (!(type & LEFT))
+    {
+        while (size-- > 0)
+        {
+            if (buf < end)
+            {
+                *buf = c;
+            }
+
+            ++ buf;
+        }
+    }
+
+    while (i < precision--)
+    {
+        if (buf < end)
+        {
+            *buf = '0';
+        }
+
+        ++ buf;
+    }
+
+    /* put number in the temporary buffer */
+    while (i-- > 0 && (precision_bak != 0))
+    {
+        if (buf < end)
+        {
+            *buf = tmp[i];
+        }
+
+        ++ buf;
+    }
+
+    while (size-- > 0)
+    {
+        if (buf < end)
+        {
+            *buf = ' ';
+        }
+
+        ++ buf;
+    }
+
+    return buf;
+}
+
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION) /* GCC */
+#pragma GCC diagnostic push
+/* ignore warning: this statement may fall through */
+#pragma GCC diagnostic ignored "-Wimplicit-fallthrough"
+#endif /* defined(__GNUC__) && !defined(__ARMCC_VERSION) */
+static int _ref_vsnprintf(char *buf, rt_size_t size, const char *fmt, va_list args)
+{
+#ifdef RT_KPRINTF_USING_LONGLONG
+    unsigned long long num = 0;
+#else
+    unsigned long num = 0;
+#endif /* RT_KPRINTF_USING_LONGLONG */
+    int i = 0, len = 0;
+    char *str = RT_NULL, *end = RT_NULL, c = 0;
+    const char *s = RT_NULL;
+
+    rt_uint8_t base = 0;            /* the base of number */
+    rt_uint8_t flags = 0;           /* flags to print number */
+    rt_uint8_t qualifier = 0;       /* 'h', 'l', or 'L' for integer fields */
+    rt_int32_t field_width = 0;     /* width of output field */
+    int precision = 0;      /* min. # of digits for integers and max for a string */
+
+    str = buf;
+    end = buf + size;
+
+    /* Make sure end is always >= buf */
+    if (end < buf)
+    {
+        end  = ((char *) - 1);
+        size = end - buf;
+    }
+
+    for (; *fmt ; ++fmt)
+    {
+        if (*fmt != '%')
+        {
+            if (str < end)
+            {
+                *str = *fmt;
+            }
+
+            ++ str;
+            continue;
+        }
+
+        /* process flags */
+        flags = 0;
+
+        while (1)
+        {
+            /* skips the first '%' also */
+            ++fmt;
+            if (*fmt == '-') flags |= LEFT;
+            else if (*fmt == '+') flags |= PLUS;
+            else if (*fmt == ' ') flags |= SPACE;
+            else if (*fmt == '#') flags |= SPECIAL;
+            else if (*fmt == '0') flags |= ZEROPAD;
+            else break;
+        }
+
+        /* get field width */
+        field_width = -1;
+        if (_ISDIGIT(*fmt))
+        {
+            field_width = _ref_skip_atoi(&fmt);
+        }
+        else if (*fmt == '*')
+        {
+            ++fmt;
+            /* it's the next argument */
+            field_width = va_arg(args, int);
+            if (field_width < 0)
+            {
+                field_width = -field_width;
+                flags |= LEFT;
+            }
+        }
+
+        /* get the precision */
+        precision = -1;
+        if (*fmt == '.')
+        {
+            ++fmt;
+            if (_ISDIGIT(*fmt))
+            {
+                precision = _ref_skip_atoi(&fmt);
+            }
+            else if (*fmt == '*')
+            {
+                ++fmt;
+                /* it's the next argument */
+                precision = va_arg(args, int);
+            }
+            if (precision < 0)
+            {
+                precision = 0;
+            }
+        }
+
+        qualifier = 0; /* get the conversion qualifier */
+
+        if (*fmt == 'h' || *fmt == 'l' ||
+#ifdef RT_KPRINTF_USING_LONGLONG
+            *fmt == 'L' ||
+#endif /* RT_KPRINTF_USING_LONGLONG */
+            *fmt == 'z')
+        {
+            qualifier = *fmt;
+            ++fmt;
+#ifdef RT_KPRINTF_USING_LONGLONG
+            if (qualifier == 'l' && *fmt == 'l')
+            {
+                qualifier = 'L';
+                ++fmt;
+            }
+#endif /* RT_KPRINTF_USING_LONGLONG */
+            if (qualifier == 'h' && *fmt == 'h')
+            {
+                qualifier = 'H';
+                ++fmt;
+            }
+        }
+
+        /* the default base */
+        base = 10;
+
+        switch (*fmt)
+        {
+        case 'c':
+            if (!(flags & LEFT))
+            {
+                while (--field_width > 0)
+                {
+                    if (str < end) *str = ' ';
+                    ++ str;
+                }
+            }
+
+            /* get character */
+            c = (rt_uint8_t)va_arg(args, int);
+            if (str < end)
+            {
+                *str = c;
+            }
+            ++ str;
+
+            /* put width */
+            while (--field_width > 0)
+            {
+                if (str < end) *str = ' ';
+                ++ str;
+            }
+            continue;
+
+        case 's':
+            s = va_arg(args, char *);
+            if (!s)
+            {
+                s = "(NULL)";
+            }
+
+            for (len = 0; (len != field_width) && (s[len] != '\0'); len++);
+
+            if (precision > 0 && len > precision)
+            {
+                len = precision;
+            }
+
+            if (!(flags & LEFT))
+            {
+                while (len < field_width--)
+                {
+                    if (str < end) *str = ' ';
+                    ++ str;
+                }
+            }
+
+            for (i = 0; i < len; ++i)
+            {
+                if (str < end) *str = *s;
+                ++ str;
+                ++ s;
+            }
+
+            while (len < field_width--)
+            {
+                if (str < end) *str = ' ';
+                ++ str;
+            }
+            continue;
+
+        case 'p':
+            if (field_width == -1)
+            {
+                field_width = sizeof(void *) << 1;
+                field_width += 2; /* `0x` prefix */
+                flags |= SPECIAL;
+                flags |= ZEROPAD;
+            }
+            str = _ref_print_number(str, end, (unsigned long)va_arg(args, void *),
+                               16, qualifier, field_width, precision, flags);
+            continue;
+
+        case '%':
+            if (str < end)
+            {
+                *str = '%';
+            }
+            ++ str;
+            continue;
+
+        /* integer number formats - set up the flags and "break" */
+        case 'b':
+            base = 2;
+            break;
+        case 'o':
+            base = 8;
+            break;
+
+        case 'X':
+            flags |= LARGE;
+        case 'x':
+            base = 16;
+            break;
+
+        case 'd':
+        case 'i':
+            flags |= SIGN;
+        case 'u':
+            break;
+
+        case 'e':
+        case 'E':
+        case 'G':
+        case 'g':
+        case 'f':
+        case 'F':
+            va_arg(args, double);
+        default:
+            if (str < end)
+            {
+                *str = '%';
+            }
+            ++ str;
+
+            if (*fmt)
+            {
+                if (str < end)
+                {
+                    *str = *fmt;
+                }
+                ++ str;
+            }
+            else
+            {
+                -- fmt;
+            }
+            continue;
+        }
+
+        if (qualifier == 'L')
+        {
+            num = va_arg(args, unsigned long long);
+        }
+        else if (qualifier == 'l')
+        {
+            num = va_arg(args, unsigned long);
+        }
+        else if (qualifier == 'H')
+        {
+            num = (rt_int8_t)va_arg(args, rt_int32_t);
+            if (flags & SIGN)
+            {
+                num = (rt_int8_t)num;
+            }
+        }
+        else if (qualifier == 'h')
+        {
+            num = (rt_uint16_t)va_arg(args, rt_int32_t);
+            if (flags & SIGN)
+            {
+                num = (rt_int16_t)num;
+            }
+        }
+        else if (qualifier == 'z')
+        {
+            num = va_arg(args, rt_size_t);
+            if (flags & SIGN)
+            {
+                num = (rt_ssize_t)num;
+            }
+        }
+        else
+        {
+            num = (rt_uint32_t)va_arg(args, unsigned long);
+        }
+        str = _ref_print_number(str, end, num, base, qualifier, field_width, precision, flags);
+    }
+
+    if (size > 0)
+    {
+        if (str < end)
+        {
+            *str = '\0';
+        }
+        else
+        {
+            end[-1] = '\0';
+        }
+    }
+
+    /* the trailing null byte doesn't count towards the total
+    * ++str;
+    */
+    return str - buf;
+}
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION) /* GCC */
+#pragma GCC diagnostic pop /* ignored "-Wimplicit-fallthrough" */
+#endif /* defined(__GNUC__) && !defined(__ARMCC_VERSION) */
+
+static int _ref_snprintf(char *buf, rt_size_t size, const char *fmt, ...)
+{
+    va_list args;
+    int n;
+
+    va_start(args, fmt);
+    n = _ref_vsnprintf(buf, size, fmt, args);
+    va_end(args);
+
+    return n;
+}
+
+#undef ZEROPAD
+#undef SIGN
+#undef PLUS
+#undef SPACE
+#undef LEFT
+#undef SPECIAL
+#undef LARGE
+#undef _ISDIGIT
+
+static char ref_buf[BUF_SIZE], out_buf[BUF_SIZE];
+#ifdef RT_KPRINTF_USING_FORMAT_COMPILE
+static char fmt_buf[BUF_SIZE];
+static struct rt_fmt compiled;
+#endif /* RT_KPRINTF_USING_FORMAT_COMPILE */
+static rt_uint32_t seed, failed;
+
+static rt_uint32_t _rand(void)
+{
+    /* xorshift32, the rounds are reproducible from the seed */
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    return seed;
+}
+
+static void _check(const char *fmt, rt_size_t size, int ref_len, int out_len, const char *out, const char *name)
+{
+    if (out_len != ref_len || rt_memcmp(ref_buf, out, BUF_SIZE) != 0)
+    {
+        if (failed++ < 8)
+            LOG_E("%s: \"%s\", size %u, %d bytes instead of %d", name, fmt, size, out_len, ref_len);
+    }
+}
+
+/* format the arguments with the reference and the kernel, canaries included */
+#ifdef RT_KPRINTF_USING_FORMAT_COMPILE
+#define DIFF(...)                                                                       \
+    do                                                                                  \
+    {                                                                                   \
+        rt_memset(ref_buf, 0x55, BUF_SIZE);                                             \
+        rt_memset(out_buf, 0x55, BUF_SIZE);                                             \
+        ref_len = _ref_snprintf(ref_buf, size, fmt, __VA_ARGS__);                       \
+        _check(fmt, size, ref_len, rt_snprintf(out_buf, size, fmt, __VA_ARGS__),        \
+               out_buf, "rt_snprintf");                                                 \
+        if (rt_fmt_compile(&compiled, fmt) == RT_EOK)                                   \
+        {                                                                               \
+            rt_memset(fmt_buf, 0x55, BUF_SIZE);                                         \
+            _check(fmt, size, ref_len, rt_fmt_snprintf(fmt_buf, size, &compiled,        \
+                   __VA_ARGS__), fmt_buf, "rt_fmt_snprintf");                           \
+        }                                                                               \
+    } while (0)
+#else
+#define DIFF(...)                                                                       \
+    do                                                                                  \
+    {                                                                                   \
+        rt_memset(ref_buf, 0x55, BUF_SIZE);                                             \
+        rt_memset(out_buf, 0x55, BUF_SIZE);                                             \
+        ref_len = _ref_snprintf(ref_buf, size, fmt, __VA_ARGS__);                       \
+        _check(fmt, size, ref_len, rt_snprintf(out_buf, size, fmt, __VA_ARGS__),        \
+               out_buf, "rt_snprintf");                                                 \
+    } while (0)
+#endif /* RT_KPRINTF_USING_FORMAT_COMPILE */
+
+/* the '*' of the width and the precision come before the value */
+#define DIFF_STAR(value)                                                                \
+    do                                                                                  \
+    {                                                                                   \
+        if (stars == 0)                                                                 \
+            DIFF(value);                                                                \
+        else if (stars == 1)                                                            \
+            DIFF(width, value);                                                         \
+        else                                                                            \
+            DIFF(width, precision, value);                                              \
+    } while (0)
+
+/* a random conversion between two literals, returns its qualifier */
+static const char *_rand_format(char *fmt, char *conv, int *stars)
+{
+    static const char *const literals[] = {"", "x=", "val:", "[", "%%"};
+    static const char *const qualifiers[] = {"", "", "", "h", "hh", "l", "ll", "z", "L"};
+    static const char conversions[] = "diuxXobcsp%qdux";
+    const char *qualifier;
+    int count;
+
+    *stars = 0;
+    fmt += rt_sprintf(fmt, "%s%%", literals[_rand() % 5]);
+    for (count = _rand() % 3; count > 0; count--)
+        *fmt++ = "-+ #0"[_rand() % 5];
+
+    switch (_rand() % 4)
+    {
+    case 1:
+        fmt += rt_sprintf(fmt, "%u", _rand() % 25);
+        break;
+    case 2:
+        *fmt++ = '*';
+        (*stars)++;
+        break;
+    }
+    switch (_rand() % 4)
+    {
+    case 1:
+        fmt += rt_sprintf(fmt, ".%u", _rand() % 25);
+        break;
+    case 2:
+        *fmt++ = '.';
+        *fmt++ = '*';
+        (*stars)++;
+        break;
+    case 3:
+        *fmt++ = '.';
+        break;
+    }
+
+    qualifier = qualifiers[_rand() % 9];
+    fmt += rt_sprintf(fmt, "%s", qualifier);
+    *conv = conversions[_rand() % (sizeof(conversions) - 1)];
+    /* now and then a format ending in the middle of the conversion */
+    if (_rand() % 50 == 0)
+        *conv = '\0';
+    *fmt++ = *conv;
+    if (*conv != '\0')
+        fmt += rt_sprintf(fmt, "%s", literals[_rand() % 4]);
+    *fmt = '\0';
+
+    return qualifier;
+}
+
+static void test_kprintf_fuzz(void)
+{
+    static const char *const strings[] = {"", "a", "hello", "a longer string of text", RT_NULL};
+    const char *qualifier;
+    char fmt[48], conv;
+    int round, stars, width, precision, ref_len;
+    rt_uint64_t value;
+    rt_uint32_t pick;
+    rt_size_t size;
+
+    seed = 0x2545f491;
+    failed = 0;
+    for (round = 0; round < FUZZ_ROUNDS; round++)
+    {
+        qualifier = _rand_format(fmt, &conv, &stars);
+        size = (_rand() % 8 == 0) ? _rand() % 16 : BUF_SIZE - 8;
+        width = (int)(_rand() % 41) - 20;
+        precision = (int)(_rand() % 41) - 20;
+        value = ((rt_uint64_t)_rand() << 32) | _rand();
+        if (_rand() % 4 == 0)
+            value >>= _rand() % 64;
+        if (_rand() % 8 == 0)
+            value = (rt_uint64_t)-(rt_int64_t)(_rand() % 1000);
+        /* DIFF evaluates its arguments more than once */
+        pick = _rand();
+
+        switch (conv)
+        {
+        case 's':
+            DIFF_STAR(strings[pick % 5]);
+            break;
+        case 'p':
+            DIFF_STAR((void *)(rt_ubase_t)value);
+            break;
+        case 'c':
+            DIFF_STAR((int)('A' + pick % 26));
+            break;
+        default:
+            if (rt_strcmp(qualifier, "ll") == 0 || rt_strcmp(qualifier, "L") == 0)
+                DIFF_STAR((unsigned long long)value);
+            else if (rt_strcmp(qualifier, "l") == 0 || rt_strcmp(qualifier, "z") == 0)
+                DIFF_STAR((unsigned long)value);
+            else
+                DIFF_STAR((int)value);
+            break;
+        }
+    }
+
+    uassert_int_equal(failed, 0);
+}
+
+static void test_kprintf_boundary(void)
+{
+    static const int values[] = {0, 1, 9, 10, 99, 100, 999, 1000, 9999, 10000, 99999, 100000,
+                                 2147483647, -2147483647 - 1, -1, -10, -100};
+    rt_size_t size = BUF_SIZE - 8;
+    const char *fmt;
+    rt_size_t index;
+    int ref_len;
+
+    failed = 0;
+    for (index = 0; index < sizeof(values) / sizeof(values[0]); index++)
+    {
+        fmt = "%d|%u|%x";
+        DIFF(values[index], values[index], values[index]);
+        fmt = "a%5d%-5ub%08xc";
+        DIFF(values[index], values[index], values[index]);
+        fmt = "%lu %lx %ld";
+        DIFF((unsigned long)values[index], (unsigned long)values[index], (long)values[index]);
+    }
+
+    /* the digits themselves, not only the agreement with the reference */
+    rt_snprintf(out_buf, BUF_SIZE, "%d %u %x %s", -2147483647 - 1, 4294967295u, 0xdeadbeef, "end");
+    uassert_str_equal(out_buf, "-2147483648 4294967295 deadbeef end");
+
+    uassert_int_equal(failed, 0);
+}
+
+#ifdef RT_KPRINTF_USING_FORMAT_COMPILE
+static void test_kprintf_compile(void)
+{
+    char buf[8 * RT_KPRINTF_FORMAT_SPEC_NR];
+    int index;
+
+    uassert_int_equal(rt_fmt_compile(&compiled, "n%d.val=%d"), RT_EOK);
+    uassert_int_equal(rt_fmt_snprintf(out_buf, BUF_SIZE, &compiled, 3, -42), 10);
+    uassert_str_equal(out_buf, "n3.val=-42");
+
+    /* one conversion too many */
+    for (index = 0; index <= RT_KPRINTF_FORMAT_SPEC_NR; index++)
+        rt_memcpy(buf + index * 2, "%d", 2);
+    buf[index * 2] = '\0';
+    uassert_int_equal(rt_fmt_compile(&compiled, buf), -RT_EFULL);
+}
+#endif /* RT_KPRINTF_USING_FORMAT_COMPILE */
+
+enum bench_impl
+{
+    BENCH_REF,
+    BENCH_RT,
+    BENCH_COMPILED
+};
+
+/* cycles of one call, or ticks of all of them, the same arguments fit each of the formats */
+static rt_uint32_t _bench_one(enum bench_impl impl, const char *fmt)
+{
+    rt_uint64_t start;
+    rt_uint32_t call;
+
+#ifdef RT_KPRINTF_USING_FORMAT_COMPILE
+    rt_fmt_compile(&compiled, fmt);
+#endif /* RT_KPRINTF_USING_FORMAT_COMPILE */
+    start = utest_bench_now();
+    for (call = 0; call < BENCH_CALLS; call++)
+    {
+        switch (impl)
+        {
+        case BENCH_REF:
+            _ref_snprintf(out_buf, BUF_SIZE, fmt, call, "main", -(int)call, 0xbeef);
+            break;
+        case BENCH_RT:
+            rt_snprintf(out_buf, BUF_SIZE, fmt, call, "main", -(int)call, 0xbeef);
+            break;
+        default:
+#ifdef RT_KPRINTF_USING_FORMAT_COMPILE
+            rt_fmt_snprintf(out_buf, BUF_SIZE, &compiled, call, "main", -(int)call, 0xbeef);
+#endif /* RT_KPRINTF_USING_FORMAT_COMPILE */
+            break;
+        }
+    }
+
+#ifdef RT_USING_CPUTIME
+    return (rt_uint32_t)((utest_bench_now() - start) / BENCH_CALLS);
+#else
+    return (rt_uint32_t)(utest_bench_now() - start);
+#endif /* RT_USING_CPUTIME */
+}
+
+static void test_kprintf_bench(void)
+{
+    static const char *const fmts[] = {"n0.val=%d", "t%d.txt=\"%s\"", "[%u] %s: %d 0x%x", "%08x %-10s %5d"};
+    rt_uint32_t ref_time, rt_time;
+    rt_size_t index;
+
+    for (index = 0; index < sizeof(fmts) / sizeof(fmts[0]); index++)
+    {
+        ref_time = _bench_one(BENCH_REF, fmts[index]);
+        rt_time = _bench_one(BENCH_RT, fmts[index]);
+#ifdef RT_KPRINTF_USING_FORMAT_COMPILE
+#ifdef RT_USING_CPUTIME
+        LOG_I("%-18s old %6u, new %6u, compiled %6u cyc/call",
+              fmts[index], ref_time, rt_time, _bench_one(BENCH_COMPILED, fmts[index]));
+#else
+        LOG_I("%-18s old %6u, new %6u, compiled %6u ticks/%u calls",
+              fmts[index], ref_time, rt_time, _bench_one(BENCH_COMPILED, fmts[index]), BENCH_CALLS);
+#endif /* RT_USING_CPUTIME */
+#else
+#ifdef RT_USING_CPUTIME
+        LOG_I("%-18s old %6u, new %6u cyc/call", fmts[index], ref_time, rt_time);
+#else
+        LOG_I("%-18s old %6u, new %6u ticks/%u calls", fmts[index], ref_time, rt_time, BENCH_CALLS);
+#endif /* RT_USING_CPUTIME */
+#endif /* RT_KPRINTF_USING_FORMAT_COMPILE */
+    }
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_kprintf_fuzz);
+    UTEST_UNIT_RUN(test_kprintf_boundary);
+#ifdef RT_KPRINTF_USING_FORMAT_COMPILE
+    UTEST_UNIT_RUN(test_kprintf_compile);
+#endif /* RT_KPRINTF_USING_FORMAT_COMPILE */
+    UTEST_UNIT_RUN(test_kprintf_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.kprintf_tc", utest_tc_init, utest_tc_cleanup, 60);
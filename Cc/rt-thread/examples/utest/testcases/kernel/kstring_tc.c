@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include <string.h>
+#include "utest.h"
+
+#define FUZZ_ROUNDS     20000
+#define FUZZ_MAX        4096
+#define GUARD           32              /* bytes checked around every destination */
+#define ALIGN_NR        16
+
+#define BENCH_MAX       (64 * 1024)
+#define BENCH_BYTES     (256 * 1024)    /* bytes moved per measurement */
+
+static rt_uint8_t *buf_a, *buf_b, *buf_c;
+static rt_size_t buf_size;
+static rt_uint32_t seed;
+
+static rt_uint32_t _rand(void)
+{
+    /* xorshift32, the rounds are reproducible from the seed */
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    return seed;
+}
+
+/* mostly short lengths, where the fix-ups and the tails are */
+static rt_size_t _rand_len(void)
+{
+    switch (_rand() % 4)
+    {
+    case 0:
+        return _rand() % 16;
+    case 1:
+        return _rand() % 128;
+    case 2:
+        return _rand() % 1024;
+    default:
+        return _rand() % FUZZ_MAX;
+    }
+}
+
+static void _rand_fill(rt_uint8_t *buf, rt_size_t len)
+{
+    while (len--)
+        *buf++ = (rt_uint8_t)_rand();
+}
+
+static int _sign(int value)
+{
+    return (value > 0) - (value < 0);
+}
+
+static void test_kstring_fuzz(void)
+{
+    rt_size_t len, src_off, dst_off, pos;
+    rt_uint32_t round, failed = 0;
+    int value;
+
+    seed = 0x2545f491;
+    for (round = 0; round < FUZZ_ROUNDS && failed == 0; round++)
+    {
+        len = _rand_len();
+        src_off = GUARD + _rand() % ALIGN_NR;
+        dst_off = GUARD + _rand() % ALIGN_NR;
+
+        /* rt_memcpy, the bytes around the destination stay */
+        _rand_fill(buf_a, len + 2 * GUARD + ALIGN_NR);
+        _rand_fill(buf_b, len + 2 * GUARD + ALIGN_NR);
+        memcpy(buf_c, buf_b, len + 2 * GUARD + ALIGN_NR);
+        rt_memcpy(buf_b + dst_off, buf_a + src_off, len);
+        memcpy(buf_c + dst_off, buf_a + src_off, len);
+        if (memcmp(buf_b, buf_c, len + 2 * GUARD + ALIGN_NR) != 0)
+        {
+            LOG_E("rt_memcpy: round %u, len %u, src +%u, dst +%u", round, len, src_off, dst_off);
+            failed++;
+        }
+
+        /* rt_memset */
+        value = (int)_rand();
+        rt_memset(buf_b + dst_off, value, len);
+        memset(buf_c + dst_off, value, len);
+        if (memcmp(buf_b, buf_c, len + 2 * GUARD + ALIGN_NR) != 0)
+        {
+            LOG_E("rt_memset: round %u, len %u, dst +%u", round, len, dst_off);
+            failed++;
+        }
+
+        /* rt_memcmp, equal or one bit flipped */
+        memcpy(buf_b + dst_off, buf_a + src_off, len);
+        if (len > 0 && (_rand() & 1))
+        {
+            pos = _rand() % len;
+            buf_b[dst_off + pos] ^= 1 << (_rand() % 8);
+        }
+        if (_sign(rt_memcmp(buf_a + src_off, buf_b + dst_off, len)) !=
+            _sign(memcmp(buf_a + src_off, buf_b + dst_off, len)))
+        {
+            LOG_E("rt_memcmp: round %u, len %u, src +%u, dst +%u", round, len, src_off, dst_off);
+            failed++;
+        }
+
+        /* rt_strlen, no zero byte before the terminator */
+        for (pos = 0; pos < len; pos++)
+        {
+            if (buf_b[dst_off + pos] == 0)
+                buf_b[dst_off + pos] = 1;
+        }
+        buf_b[dst_off + len] = 0;
+        if (rt_strlen((const char *)buf_b + dst_off) != strlen((const char *)buf_b + dst_off))
+        {
+            LOG_E("rt_strlen: round %u, len %u, +%u", round, len, dst_off);
+            failed++;
+        }
+    }
+
+    uassert_int_equal(failed, 0);
+}
+
+enum bench_op
+{
+    BENCH_MEMCPY,
+    BENCH_MEMSET,
+    BENCH_MEMCMP,
+    BENCH_STRLEN,
+    BENCH_OP_NR
+};
+
+static const char *const bench_names[BENCH_OP_NR] = {"memcpy", "memset", "memcmp", "strlen"};
+
+/* the time of one call, rt_* if 'kernel' is set, libc otherwise */
+static rt_uint32_t _bench_one(enum bench_op op, rt_bool_t kernel, rt_size_t len,
+                              rt_size_t src_off, rt_size_t dst_off, rt_uint32_t reps)
+{
+    const char *str = (const char *)buf_a + src_off;
+    rt_uint8_t *src = buf_a + src_off, *dst = buf_b + dst_off;
+    volatile rt_size_t sink = 0;
+    rt_uint64_t start;
+    rt_uint32_t rep;
+
+    start = utest_bench_now();
+    for (rep = 0; rep < reps; rep++)
+    {
+        switch (op)
+        {
+        case BENCH_MEMCPY:
+            kernel ? rt_memcpy(dst, src, len) : memcpy(dst, src, len);
+            break;
+        case BENCH_MEMSET:
+            kernel ? rt_memset(dst, rep, len) : memset(dst, rep, len);
+            break;
+        case BENCH_MEMCMP:
+            sink += kernel ? rt_memcmp(dst, src, len) : memcmp(dst, src, len);
+            break;
+        default:
+            sink += kernel ? rt_strlen(str) : strlen(str);
+            break;
+        }
+    }
+    RT_UNUSED(sink);
+
+    return (rt_uint32_t)((utest_bench_now() - start) / reps);
+}
+
+static void _bench_op(enum bench_op op, rt_size_t src_off, rt_size_t dst_off)
+{
+    rt_uint32_t reps, rt_time, libc_time;
+    rt_size_t len;
+
+    for (len = 1; len <= BENCH_MAX && len + ALIGN_NR < buf_size; len <<= 2)
+    {
+        /* equal buffers make memcmp run the whole length, strlen reads a len long string */
+        rt_memset(buf_a, 'a', len + ALIGN_NR);
+        rt_memset(buf_b, 'a', len + ALIGN_NR);
+        buf_a[src_off + len] = 0;
+
+        reps = BENCH_BYTES / len;
+        if (reps > 4096)
+            reps = 4096;
+        rt_time = _bench_one(op, RT_TRUE, len, src_off, dst_off, reps);
+        libc_time = _bench_one(op, RT_FALSE, len, src_off, dst_off, reps);
+
+#ifdef RT_USING_CPUTIME
+        LOG_I("%-7s src +%u dst +%u %6u B: rt %8u cyc/op, libc %8u cyc/op",
+              bench_names[op], src_off, dst_off, len, rt_time, libc_time);
+#else
+        LOG_I("%-7s src +%u dst +%u %6u B: rt %8u ticks/op, libc %8u ticks/op",
+              bench_names[op], src_off, dst_off, len, rt_time, libc_time);
+#endif /* RT_USING_CPUTIME */
+    }
+}
+
+static void test_kstring_bench(void)
+{
+    static const rt_uint8_t aligns[][2] = {{0, 0}, {1, 1}, {1, 3}, {0, 2}};
+    rt_size_t index;
+    int op;
+
+    for (op = 0; op < BENCH_OP_NR; op++)
+    {
+        for (index = 0; index < sizeof(aligns) / sizeof(aligns[0]); index++)
+        {
+            /* the alignment of a single buffer is swept once */
+            if ((op == BENCH_MEMSET || op == BENCH_STRLEN) && index > 1)
+                break;
+            _bench_op((enum bench_op)op, aligns[index][0], aligns[index][1]);
+        }
+    }
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    /* fall back to the fuzz buffers if the largest benchmark does not fit */
+    for (buf_size = BENCH_MAX + ALIGN_NR + 1; buf_size >= FUZZ_MAX + 2 * GUARD + ALIGN_NR; buf_size >>= 1)
+    {
+        buf_a = rt_malloc(buf_size);
+        buf_b = rt_malloc(buf_size);
+        buf_c = rt_malloc(buf_size);
+        if (buf_a != RT_NULL && buf_b != RT_NULL && buf_c != RT_NULL)
+            return RT_EOK;
+
+        rt_free(buf_a);
+        rt_free(buf_b);
+        rt_free(buf_c);
+    }
+
+    return -RT_ENOMEM;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_free(buf_a);
+    rt_free(buf_b);
+    rt_free(buf_c);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_kstring_fuzz);
+    UTEST_UNIT_RUN(test_kstring_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.kstring_tc", utest_tc_init, utest_tc_cleanup, 60);
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+#define POOL_SIZE       4096
+#define BLOCK_SIZE      128
+#define HEAP_NR_MAX     8
+
+rt_align(RT_ALIGN_SIZE)
+static rt_uint8_t fast_pool[POOL_SIZE];
+rt_align(RT_ALIGN_SIZE)
+static rt_uint8_t bulk_pool[POOL_SIZE];
+
+static struct rt_memheap fast_heap;
+static struct rt_memheap bulk_heap;
+
+/* the classes the BSP gave to the other heaps, taken away while testing */
+static struct rt_memheap *saved_heap[HEAP_NR_MAX];
+static rt_uint32_t saved_class[HEAP_NR_MAX];
+
+static rt_bool_t _in_pool(void *ptr, rt_uint8_t *pool)
+{
+    return (rt_uint8_t *)ptr >= pool && (rt_uint8_t *)ptr < pool + POOL_SIZE;
+}
+
+static void test_hint_register(void)
+{
+    uassert_int_equal(rt_memheap_class_register("hintnone", RT_MEM_FAST), -RT_ENOENT);
+    uassert_int_equal(rt_memheap_class_register("hintbulk", 1UL << RT_MEM_CLASS_NR), -RT_EINVAL);
+    uassert_int_equal(rt_memheap_class_register("hintfast", RT_MEM_FAST | RT_MEM_DMA), RT_EOK);
+    uassert_int_equal(fast_heap.mem_class, RT_MEM_FAST | RT_MEM_DMA);
+    uassert_int_equal(rt_memheap_class_register("hintbulk", RT_MEM_BULK), RT_EOK);
+    uassert_int_equal(bulk_heap.mem_class, RT_MEM_BULK);
+}
+
+static void test_hint_placement(void)
+{
+    struct rt_mem_class_stat before, after;
+    void *fast, *dma, *bulk, *ptr;
+
+    rt_mem_class_get_stat(RT_MEM_FAST, &before);
+
+    fast = rt_malloc_hint(BLOCK_SIZE, RT_MEM_FAST);
+    uassert_true(_in_pool(fast, fast_pool));
+    dma = rt_malloc_hint(BLOCK_SIZE, RT_MEM_FAST | RT_MEM_DMA);
+    uassert_true(_in_pool(dma, fast_pool));
+    bulk = rt_malloc_hint(BLOCK_SIZE, RT_MEM_BULK);
+    uassert_true(_in_pool(bulk, bulk_pool));
+
+    /* no heap holds both classes */
+    ptr = rt_malloc_hint(BLOCK_SIZE, RT_MEM_FAST | RT_MEM_BULK | RT_MEM_STRICT);
+    uassert_null(ptr);
+
+    rt_mem_class_get_stat(RT_MEM_FAST, &after);
+    uassert_int_equal(after.allocs - before.allocs, 2);
+    uassert_int_equal(after.failures - before.failures, 1);
+    uassert_int_equal(after.heaps, 1);
+    uassert_int_equal(after.total, fast_heap.pool_size);
+    uassert_true(after.used >= before.used + 2 * BLOCK_SIZE);
+
+    /* the blocks go back with rt_free and resize with rt_realloc */
+    rt_memset(bulk, 0x5a, BLOCK_SIZE);
+    bulk = rt_realloc(bulk, BLOCK_SIZE * 2);
+    uassert_not_null(bulk);
+    uassert_int_equal(((rt_uint8_t *)bulk)[BLOCK_SIZE - 1], 0x5a);
+
+    rt_free(fast);
+    rt_free(dma);
+    rt_free(bulk);
+
+    rt_mem_class_get_stat(RT_MEM_FAST, &after);
+    uassert_int_equal(after.used, before.used);
+    uassert_int_equal(rt_mem_class_get_stat(RT_MEM_FAST | RT_MEM_DMA, &after), -RT_EINVAL);
+}
+
+static void test_hint_fallback(void)
+{
+    struct rt_mem_class_stat before, after;
+    void *ptr;
+
+    rt_mem_class_get_stat(RT_MEM_BULK, &before);
+
+    /* larger than any heap of the class */
+    ptr = rt_malloc_hint(POOL_SIZE, RT_MEM_BULK | RT_MEM_STRICT);
+    uassert_null(ptr);
+
+#ifdef RT_MEMHEAP_HINT_STRICT
+    uassert_null(rt_malloc_hint(POOL_SIZE, RT_MEM_BULK));
+    ptr = rt_malloc_hint(POOL_SIZE, RT_MEM_BULK | RT_MEM_FALLBACK);
+#else
+    ptr = rt_malloc_hint(POOL_SIZE, RT_MEM_BULK);
+#endif /* RT_MEMHEAP_HINT_STRICT */
+    uassert_not_null(ptr);
+    uassert_false(_in_pool(ptr, bulk_pool));
+    rt_free(ptr);
+
+    rt_mem_class_get_stat(RT_MEM_BULK, &after);
+    uassert_int_equal(after.fallbacks - before.fallbacks, 1);
+#ifdef RT_MEMHEAP_HINT_STRICT
+    uassert_int_equal(after.failures - before.failures, 2);
+#else
+    uassert_int_equal(after.failures - before.failures, 1);
+#endif /* RT_MEMHEAP_HINT_STRICT */
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+    struct rt_memheap *heap;
+    int index = 0;
+
+    information = rt_object_get_information(RT_Object_Class_MemHeap);
+    for (node = information->object_list.next; node != &information->object_list; node = node->next)
+    {
+        heap = (struct rt_memheap *)rt_list_entry(node, struct rt_object, list);
+        if (index == HEAP_NR_MAX)
+            return -RT_ERROR;
+        saved_heap[index] = heap;
+        saved_class[index++] = heap->mem_class;
+        heap->mem_class = 0;
+    }
+
+    rt_memheap_init(&fast_heap, "hintfast", fast_pool, sizeof(fast_pool));
+    rt_memheap_init(&bulk_heap, "hintbulk", bulk_pool, sizeof(bulk_pool));
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    int index;
+
+    rt_memheap_detach(&fast_heap);
+    rt_memheap_detach(&bulk_heap);
+
+    for (index = 0; index < HEAP_NR_MAX && saved_heap[index] != RT_NULL; index++)
+    {
+        saved_heap[index]->mem_class = saved_class[index];
+        saved_heap[index] = RT_NULL;
+    }
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_hint_register);
+    UTEST_UNIT_RUN(test_hint_placement);
+    UTEST_UNIT_RUN(test_hint_fallback);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.memheap_hint_tc", utest_tc_init, utest_tc_cleanup, 10);
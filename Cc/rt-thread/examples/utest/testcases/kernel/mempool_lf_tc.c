@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+#define BLOCK_SIZE      32
+#define BLOCK_NR        8
+
+#define BENCH_THREADS   4
+#define BENCH_STACK     1024
+#define BENCH_TICKS     (RT_TICK_PER_SECOND / 2)
+
+rt_align(RT_ALIGN_SIZE)
+static rt_uint8_t lf_pool[BLOCK_NR * BLOCK_SIZE];
+rt_align(RT_ALIGN_SIZE)
+static rt_uint8_t mp_pool[BLOCK_NR * (BLOCK_SIZE + sizeof(rt_uint8_t *))];
+
+static struct rt_mempool_lf lf_mp;
+static struct rt_mempool mp;
+
+static volatile rt_bool_t bench_stop;
+static volatile rt_uint32_t isr_ops;
+static rt_uint32_t thread_ops[BENCH_THREADS];
+static struct rt_semaphore done_sem;
+
+/* allocate every block, check they are distinct, then release them */
+static void _check_blocks(void)
+{
+    void *blocks[BLOCK_NR];
+    int i, j;
+
+    for (i = 0; i < BLOCK_NR; i++)
+    {
+        blocks[i] = rt_mp_lf_alloc(&lf_mp);
+        uassert_not_null(blocks[i]);
+        for (j = 0; j < i; j++)
+            uassert_true(blocks[i] != blocks[j]);
+    }
+    uassert_null(rt_mp_lf_alloc(&lf_mp));
+
+    for (i = 0; i < BLOCK_NR; i++)
+        rt_mp_lf_free(&lf_mp, blocks[i]);
+}
+
+static void test_mp_lf_alloc(void)
+{
+    struct rt_mp_lf_stat stat;
+    void *blocks[BLOCK_NR];
+    int i;
+
+    uassert_int_equal(rt_mp_lf_init(&lf_mp, "lfmp", lf_pool, BLOCK_SIZE - 1, BLOCK_SIZE), -RT_EINVAL);
+    uassert_int_equal(rt_mp_lf_init(&lf_mp, "lfmp", lf_pool, sizeof(lf_pool), BLOCK_SIZE), RT_EOK);
+
+    for (i = 0; i < BLOCK_NR; i++)
+    {
+        blocks[i] = rt_mp_lf_alloc(&lf_mp);
+        uassert_not_null(blocks[i]);
+        uassert_true((rt_uint8_t *)blocks[i] >= lf_pool &&
+                     (rt_uint8_t *)blocks[i] < lf_pool + sizeof(lf_pool));
+        rt_memset(blocks[i], 0xa5, BLOCK_SIZE);
+    }
+    uassert_null(rt_mp_lf_alloc(&lf_mp));
+
+    rt_mp_lf_get_stat(&lf_mp, &stat);
+    uassert_int_equal(stat.total, BLOCK_NR);
+    uassert_int_equal(stat.free, 0);
+    uassert_int_equal(stat.min_free, 0);
+    uassert_int_equal(stat.failed, 1);
+
+    /* last in, first out */
+    rt_mp_lf_free(&lf_mp, blocks[3]);
+    uassert_true(rt_mp_lf_alloc(&lf_mp) == blocks[3]);
+
+    for (i = 0; i < BLOCK_NR; i++)
+        rt_mp_lf_free(&lf_mp, blocks[i]);
+    rt_mp_lf_reset_stat(&lf_mp);
+    rt_mp_lf_get_stat(&lf_mp, &stat);
+    uassert_int_equal(stat.free, BLOCK_NR);
+    uassert_int_equal(stat.min_free, BLOCK_NR);
+    uassert_int_equal(stat.failed, 0);
+
+    _check_blocks();
+    rt_mp_lf_detach(&lf_mp);
+}
+
+static void _free_later(void *parameter)
+{
+    rt_thread_delay(10);
+    rt_mp_lf_free(&lf_mp, parameter);
+}
+
+static void test_mp_lf_wait(void)
+{
+    rt_thread_t tid;
+    void *block;
+
+    rt_mp_lf_init(&lf_mp, "lfmp", lf_pool, BLOCK_SIZE, BLOCK_SIZE);
+    block = rt_mp_lf_alloc_wait(&lf_mp, 0);
+    uassert_not_null(block);
+
+    /* an empty pool times out */
+    uassert_null(rt_mp_lf_alloc_wait(&lf_mp, 5));
+
+    /* a release wakes the waiter up */
+    tid = rt_thread_create("lffree", _free_later, block, BENCH_STACK, UTEST_THR_PRIORITY - 1, 10);
+    uassert_not_null(tid);
+    rt_thread_startup(tid);
+    uassert_true(rt_mp_lf_alloc_wait(&lf_mp, RT_WAITING_FOREVER) == block);
+
+    rt_mp_lf_free(&lf_mp, block);
+    rt_mp_lf_detach(&lf_mp);
+}
+
+/* a hard timer runs in interrupt context */
+static void _isr_lf(void *parameter)
+{
+    void *block = rt_mp_lf_alloc(&lf_mp);
+
+    if (block != RT_NULL)
+    {
+        rt_mp_lf_free(&lf_mp, block);
+        isr_ops++;
+    }
+}
+
+static void _isr_mp(void *parameter)
+{
+    void *block = rt_mp_alloc(&mp, 0);
+
+    if (block != RT_NULL)
+    {
+        rt_mp_free(block);
+        isr_ops++;
+    }
+}
+
+static void _worker_lf(void *parameter)
+{
+    rt_uint32_t *ops = (rt_uint32_t *)parameter;
+    void *a, *b;
+
+    while (!bench_stop)
+    {
+        a = rt_mp_lf_alloc(&lf_mp);
+        b = rt_mp_lf_alloc(&lf_mp);
+        rt_mp_lf_free(&lf_mp, a);
+        rt_mp_lf_free(&lf_mp, b);
+        (*ops)++;
+    }
+    rt_sem_release(&done_sem);
+}
+
+static void _worker_mp(void *parameter)
+{
+    rt_uint32_t *ops = (rt_uint32_t *)parameter;
+    void *a, *b;
+
+    while (!bench_stop)
+    {
+        a = rt_mp_alloc(&mp, 0);
+        b = rt_mp_alloc(&mp, 0);
+        rt_mp_free(a);
+        rt_mp_free(b);
+        (*ops)++;
+    }
+    rt_sem_release(&done_sem);
+}
+
+/* run the workers and the interrupt for BENCH_TICKS, the operations per second */
+static rt_uint32_t _bench(void (*worker)(void *), void (*isr)(void *), rt_uint32_t *isr_rate)
+{
+    struct rt_timer timer;
+    rt_thread_t tid;
+    rt_uint64_t total = 0;
+    int i;
+
+    bench_stop = RT_FALSE;
+    isr_ops = 0;
+    rt_sem_init(&done_sem, "lfdone", 0, RT_IPC_FLAG_PRIO);
+    rt_timer_init(&timer, "lfisr", isr, RT_NULL, 1,
+                  RT_TIMER_FLAG_HARD_TIMER | RT_TIMER_FLAG_PERIODIC);
+
+    /* equal priority workers preempt each other on every time slice */
+    for (i = 0; i < BENCH_THREADS; i++)
+    {
+        thread_ops[i] = 0;
+        tid = rt_thread_create("lfwork", worker, &thread_ops[i], BENCH_STACK, UTEST_THR_PRIORITY + 1, 1);
+        uassert_not_null(tid);
+        rt_thread_startup(tid);
+    }
+    rt_timer_start(&timer);
+
+    rt_thread_delay(BENCH_TICKS);
+    bench_stop = RT_TRUE;
+    rt_timer_stop(&timer);
+    for (i = 0; i < BENCH_THREADS; i++)
+    {
+        rt_sem_take(&done_sem, RT_WAITING_FOREVER);
+        total += thread_ops[i];
+    }
+    rt_timer_detach(&timer);
+    rt_sem_detach(&done_sem);
+
+    *isr_rate = isr_ops * RT_TICK_PER_SECOND / BENCH_TICKS;
+
+    return (rt_uint32_t)(total * RT_TICK_PER_SECOND / BENCH_TICKS);
+}
+
+static void test_mp_lf_bench(void)
+{
+    struct rt_mp_lf_stat stat;
+    rt_uint32_t lf_rate, mp_rate, lf_isr, mp_isr;
+
+    rt_mp_lf_init(&lf_mp, "lfmp", lf_pool, sizeof(lf_pool), BLOCK_SIZE);
+    lf_rate = _bench(_worker_lf, _isr_lf, &lf_isr);
+    rt_mp_lf_get_stat(&lf_mp, &stat);
+    uassert_int_equal(stat.free, BLOCK_NR);
+    _check_blocks();
+    rt_mp_lf_detach(&lf_mp);
+
+    rt_mp_init(&mp, "mp", mp_pool, sizeof(mp_pool), BLOCK_SIZE);
+    mp_rate = _bench(_worker_mp, _isr_mp, &mp_isr);
+    uassert_int_equal(mp.block_free_count, mp.block_total_count);
+    rt_mp_detach(&mp);
+
+    LOG_I("%-24s %12s %12s", "2 x alloc/free", "threads/s", "isr/s");
+    LOG_I("%-24s %12u %12u", "rt_mp_lf", lf_rate, lf_isr);
+    LOG_I("%-24s %12u %12u", "rt_mp", mp_rate, mp_isr);
+    LOG_I("min free %u of %u, %u failed", stat.min_free, stat.total, stat.failed);
+
+    uassert_true(lf_rate > 0 && mp_rate > 0);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_mp_lf_alloc);
+    UTEST_UNIT_RUN(test_mp_lf_wait);
+    UTEST_UNIT_RUN(test_mp_lf_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.mempool_lf_tc", utest_tc_init, utest_tc_cleanup, 10);
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+#define MSG_SIZE        4096
+#define MAX_MSGS        4
+
+/* each benchmark round runs for this many ticks */
+#define BENCH_TICKS     (RT_TICK_PER_SECOND / 5)
+
+static rt_mq_t test_mq;
+static rt_uint8_t *local_buf;
+
+static void test_mq_loan_send_recv(void)
+{
+    void *buf;
+    rt_ssize_t len;
+    rt_err_t ret;
+
+    ret = rt_mq_send_loan(test_mq, &buf, RT_WAITING_NO);
+    uassert_int_equal(ret, RT_EOK);
+    uassert_not_null(buf);
+    rt_memset(buf, 0x5a, 16);
+    ret = rt_mq_send_commit(test_mq, buf, 16);
+    uassert_int_equal(ret, RT_EOK);
+    uassert_int_equal(test_mq->entry, 1);
+
+    /* a loaned message is visible to the copy path */
+    len = rt_mq_recv(test_mq, local_buf, MSG_SIZE, RT_WAITING_NO);
+    uassert_int_equal(len, 16);
+    uassert_int_equal(local_buf[0], 0x5a);
+    uassert_int_equal(local_buf[15], 0x5a);
+
+    /* and a copied message is visible to the loan path */
+    rt_memset(local_buf, 0xa5, 32);
+    ret = rt_mq_send(test_mq, local_buf, 32);
+    uassert_int_equal(ret, RT_EOK);
+    len = rt_mq_recv_loan(test_mq, &buf, RT_WAITING_NO);
+    uassert_int_equal(len, 32);
+    uassert_int_equal(((rt_uint8_t *)buf)[31], 0xa5);
+    uassert_int_equal(test_mq->entry, 0);
+    ret = rt_mq_recv_release(test_mq, buf);
+    uassert_int_equal(ret, RT_EOK);
+
+    len = rt_mq_recv_loan(test_mq, &buf, RT_WAITING_NO);
+    uassert_int_equal(len, -RT_ETIMEOUT);
+    uassert_null(buf);
+
+    /* oversize commit keeps the buffer with the caller */
+    ret = rt_mq_send_loan(test_mq, &buf, RT_WAITING_NO);
+    uassert_int_equal(ret, RT_EOK);
+    ret = rt_mq_send_commit(test_mq, buf, MSG_SIZE + 1);
+    uassert_int_equal(ret, -RT_ERROR);
+    ret = rt_mq_send_abort(test_mq, buf);
+    uassert_int_equal(ret, RT_EOK);
+    uassert_int_equal(test_mq->entry, 0);
+}
+
+static void test_mq_loan_urgent(void)
+{
+    void *buf;
+    rt_ssize_t len;
+    rt_err_t ret;
+
+    ret = rt_mq_send_loan(test_mq, &buf, RT_WAITING_NO);
+    uassert_int_equal(ret, RT_EOK);
+    *(rt_uint8_t *)buf = 1;
+    ret = rt_mq_send_commit(test_mq, buf, 1);
+    uassert_int_equal(ret, RT_EOK);
+
+    ret = rt_mq_send_loan(test_mq, &buf, RT_WAITING_NO);
+    uassert_int_equal(ret, RT_EOK);
+    *(rt_uint8_t *)buf = 2;
+    ret = rt_mq_urgent_commit(test_mq, buf, 1);
+    uassert_int_equal(ret, RT_EOK);
+
+    len = rt_mq_recv_loan(test_mq, &buf, RT_WAITING_NO);
+    uassert_int_equal(len, 1);
+    uassert_int_equal(*(rt_uint8_t *)buf, 2);
+    rt_mq_recv_release(test_mq, buf);
+
+    len = rt_mq_recv_loan(test_mq, &buf, RT_WAITING_NO);
+    uassert_int_equal(len, 1);
+    uassert_int_equal(*(rt_uint8_t *)buf, 1);
+    rt_mq_recv_release(test_mq, buf);
+}
+
+static void test_mq_loan_full(void)
+{
+    void *bufs[MAX_MSGS];
+    void *buf;
+    rt_tick_t tick;
+    rt_err_t ret;
+    int i;
+
+    for (i = 0; i < MAX_MSGS; i++)
+    {
+        ret = rt_mq_send_loan(test_mq, &bufs[i], RT_WAITING_NO);
+        uassert_int_equal(ret, RT_EOK);
+    }
+
+    /* loaned slots are not free, senders must see a full queue */
+    ret = rt_mq_send_loan(test_mq, &buf, RT_WAITING_NO);
+    uassert_int_equal(ret, -RT_EFULL);
+    ret = rt_mq_send(test_mq, local_buf, 1);
+    uassert_int_equal(ret, -RT_EFULL);
+
+    tick = rt_tick_get();
+    ret = rt_mq_send_loan(test_mq, &buf, 10);
+    uassert_int_equal(ret, -RT_ETIMEOUT);
+    uassert_true(rt_tick_get() - tick >= 10);
+
+    for (i = 0; i < MAX_MSGS; i++)
+    {
+        rt_mq_send_abort(test_mq, bufs[i]);
+    }
+    uassert_int_equal(test_mq->entry, 0);
+}
+
+static rt_uint32_t _bench_copy(rt_size_t size)
+{
+    rt_tick_t start, elapsed;
+    rt_uint32_t count = 0;
+
+    start = rt_tick_get();
+    do
+    {
+        rt_memset(local_buf, (int)count, size);
+        rt_mq_send(test_mq, local_buf, size);
+        rt_mq_recv(test_mq, local_buf, size, RT_WAITING_NO);
+        count++;
+        elapsed = rt_tick_get() - start;
+    } while (elapsed < BENCH_TICKS);
+
+    return (rt_uint32_t)((rt_uint64_t)count * size * RT_TICK_PER_SECOND / elapsed);
+}
+
+static rt_uint32_t _bench_loan(rt_size_t size)
+{
+    rt_tick_t start, elapsed;
+    rt_uint32_t count = 0;
+    void *buf;
+
+    start = rt_tick_get();
+    do
+    {
+        rt_mq_send_loan(test_mq, &buf, RT_WAITING_NO);
+        rt_memset(buf, (int)count, size);
+        rt_mq_send_commit(test_mq, buf, size);
+        rt_mq_recv_loan(test_mq, &buf, RT_WAITING_NO);
+        rt_mq_recv_release(test_mq, buf);
+        count++;
+        elapsed = rt_tick_get() - start;
+    } while (elapsed < BENCH_TICKS);
+
+    return (rt_uint32_t)((rt_uint64_t)count * size * RT_TICK_PER_SECOND / elapsed);
+}
+
+static void test_mq_loan_bench(void)
+{
+    rt_size_t size;
+    rt_uint32_t copy_bps, loan_bps;
+
+    LOG_I("%8s %14s %14s", "size", "copy(B/s)", "loan(B/s)");
+    for (size = 16; size <= MSG_SIZE; size <<= 2)
+    {
+        copy_bps = _bench_copy(size);
+        loan_bps = _bench_loan(size);
+        LOG_I("%8d %14u %14u", (int)size, copy_bps, loan_bps);
+    }
+    uassert_int_equal(test_mq->entry, 0);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    test_mq = rt_mq_create("mq_loan", MSG_SIZE, MAX_MSGS, RT_IPC_FLAG_PRIO);
+    if (test_mq == RT_NULL)
+        return -RT_ENOMEM;
+
+    local_buf = rt_malloc(MSG_SIZE);
+    if (local_buf == RT_NULL)
+    {
+        rt_mq_delete(test_mq);
+        return -RT_ENOMEM;
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_mq_delete(test_mq);
+    rt_free(local_buf);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_mq_loan_send_recv);
+    UTEST_UNIT_RUN(test_mq_loan_urgent);
+    UTEST_UNIT_RUN(test_mq_loan_full);
+    UTEST_UNIT_RUN(test_mq_loan_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.mq_loan_tc", utest_tc_init, utest_tc_cleanup, 60);
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+#include "utest.h"
+
+#define DEVICE_NR       256
+#define BENCH_ROUNDS    8
+
+static struct rt_device devices[DEVICE_NR];
+static char names[DEVICE_NR][RT_NAME_MAX];
+
+/* the plain list walk, as rt_object_find does without the index */
+static rt_object_t _list_find(const char *name, rt_uint8_t type)
+{
+    struct rt_object_information *information;
+    struct rt_object *object;
+    struct rt_list_node *node;
+    rt_base_t level;
+
+    information = rt_object_get_information((enum rt_object_class_type)type);
+
+    level = rt_spin_lock_irqsave(&(information->spinlock));
+    rt_list_for_each(node, &(information->object_list))
+    {
+        object = rt_list_entry(node, struct rt_object, list);
+        if (rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
+        {
+            rt_spin_unlock_irqrestore(&(information->spinlock), level);
+            return object;
+        }
+    }
+    rt_spin_unlock_irqrestore(&(information->spinlock), level);
+
+    return RT_NULL;
+}
+
+static void test_object_find(void)
+{
+    struct rt_semaphore sem;
+    rt_device_t dev;
+    int i;
+
+    for (i = 0; i < DEVICE_NR; i++)
+    {
+        dev = rt_device_find(names[i]);
+        uassert_true(dev == &devices[i]);
+    }
+
+    uassert_null(rt_device_find("hd_none"));
+    /* same name in another class is not found */
+    uassert_null(rt_object_find(names[0], RT_Object_Class_Semaphore));
+
+    rt_sem_init(&sem, names[1], 0, RT_IPC_FLAG_PRIO);
+    uassert_true(rt_object_find(names[1], RT_Object_Class_Semaphore) == &sem.parent.parent);
+    uassert_true(rt_device_find(names[1]) == &devices[1]);
+    rt_sem_detach(&sem);
+    uassert_null(rt_object_find(names[1], RT_Object_Class_Semaphore));
+}
+
+static void test_object_unregister(void)
+{
+    int i;
+
+    for (i = 0; i < DEVICE_NR; i += 2)
+        rt_device_unregister(&devices[i]);
+
+    for (i = 0; i < DEVICE_NR; i++)
+    {
+        if (i & 1)
+            uassert_true(rt_device_find(names[i]) == &devices[i]);
+        else
+            uassert_null(rt_device_find(names[i]));
+    }
+
+    for (i = 0; i < DEVICE_NR; i += 2)
+        rt_device_register(&devices[i], names[i], RT_DEVICE_FLAG_RDWR);
+
+    uassert_true(rt_device_find(names[0]) == &devices[0]);
+}
+
+static void test_object_rename(void)
+{
+    uassert_int_equal(rt_object_set_name(&devices[0].parent, "hd_new"), RT_EOK);
+    uassert_null(rt_device_find(names[0]));
+    uassert_true(rt_device_find("hd_new") == &devices[0]);
+
+    uassert_int_equal(rt_object_set_name(&devices[0].parent, names[0]), RT_EOK);
+    uassert_null(rt_device_find("hd_new"));
+    uassert_true(rt_device_find(names[0]) == &devices[0]);
+
+    uassert_int_equal(rt_object_set_name(RT_NULL, names[0]), -RT_EINVAL);
+}
+
+static void test_object_find_bench(void)
+{
+    rt_uint64_t start, elapsed, hash_hit = 0, hash_miss = 0, list_hit = 0, list_miss = 0;
+    rt_uint64_t hash_max = 0, list_max = 0;
+    int round, i;
+
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (i = 0; i < DEVICE_NR; i++)
+        {
+            start = utest_bench_now();
+            rt_device_find(names[i]);
+            elapsed = utest_bench_now() - start;
+            hash_hit += elapsed;
+            if (elapsed > hash_max)
+                hash_max = elapsed;
+
+            start = utest_bench_now();
+            _list_find(names[i], RT_Object_Class_Device);
+            elapsed = utest_bench_now() - start;
+            list_hit += elapsed;
+            if (elapsed > list_max)
+                list_max = elapsed;
+        }
+
+        /* a miss walks the whole list, which is the worst case without the index */
+        for (i = 0; i < DEVICE_NR; i++)
+        {
+            start = utest_bench_now();
+            rt_device_find("hd_none");
+            elapsed = utest_bench_now() - start;
+            hash_miss += elapsed;
+            if (elapsed > hash_max)
+                hash_max = elapsed;
+
+            start = utest_bench_now();
+            _list_find("hd_none", RT_Object_Class_Device);
+            elapsed = utest_bench_now() - start;
+            list_miss += elapsed;
+            if (elapsed > list_max)
+                list_max = elapsed;
+        }
+    }
+
+#ifdef RT_USING_CPUTIME
+    LOG_I("%d devices, %-8s %12s %12s %12s", DEVICE_NR, "find", "hit(cyc)", "miss(cyc)", "max(cyc)");
+#else
+    LOG_I("%d devices, %-8s %12s %12s %12s", DEVICE_NR, "find", "hit(tick)", "miss(tick)", "max(tick)");
+#endif /* RT_USING_CPUTIME */
+    LOG_I("%d devices, %-8s %12u %12u %12u", DEVICE_NR, "hash",
+          (rt_uint32_t)(hash_hit / (BENCH_ROUNDS * DEVICE_NR)),
+          (rt_uint32_t)(hash_miss / (BENCH_ROUNDS * DEVICE_NR)), (rt_uint32_t)hash_max);
+    LOG_I("%d devices, %-8s %12u %12u %12u", DEVICE_NR, "list",
+          (rt_uint32_t)(list_hit / (BENCH_ROUNDS * DEVICE_NR)),
+          (rt_uint32_t)(list_miss / (BENCH_ROUNDS * DEVICE_NR)), (rt_uint32_t)list_max);
+    /* the max of a call bounds the interrupt-off window of the lookup */
+
+#ifdef RT_USING_CPUTIME
+    /* ticks are too coarse to order the two lookups */
+    uassert_true(hash_miss <= list_miss);
+#endif /* RT_USING_CPUTIME */
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    int i;
+
+    for (i = 0; i < DEVICE_NR; i++)
+    {
+        rt_snprintf(names[i], RT_NAME_MAX, "hd%03d", i);
+        rt_memset(&devices[i], 0, sizeof(devices[i]));
+        if (rt_device_register(&devices[i], names[i], RT_DEVICE_FLAG_RDWR) != RT_EOK)
+        {
+            while (i--)
+                rt_device_unregister(&devices[i]);
+            return -RT_ERROR;
+        }
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    int i;
+
+    for (i = 0; i < DEVICE_NR; i++)
+        rt_device_unregister(&devices[i]);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_object_find);
+    UTEST_UNIT_RUN(test_object_unregister);
+    UTEST_UNIT_RUN(test_object_rename);
+    UTEST_UNIT_RUN(test_object_find_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.object_hash_tc", utest_tc_init, utest_tc_cleanup, 60);
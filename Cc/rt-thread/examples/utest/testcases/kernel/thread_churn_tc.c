@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+#define CHURN_STACK_SIZE    1024
+#define CHURN_BURST         16
+
+/* each benchmark round runs for this many ticks */
+#define BENCH_TICKS         (RT_TICK_PER_SECOND / 2)
+
+static volatile rt_uint32_t exited;
+static void *volatile last_stack;
+
+static void _churn_entry(void *parameter)
+{
+    last_stack = rt_thread_self()->stack_addr;
+    exited++;
+}
+
+static rt_err_t _churn_spawn(rt_uint32_t stack_size)
+{
+    rt_thread_t tid;
+
+    /* a higher priority thread runs to its exit in rt_thread_startup */
+    tid = rt_thread_create("churn", _churn_entry, RT_NULL,
+                           stack_size, UTEST_THR_PRIORITY - 1, 10);
+    if (tid == RT_NULL)
+        return -RT_ENOMEM;
+
+    return rt_thread_startup(tid);
+}
+
+static void test_thread_churn_burst(void)
+{
+    int i;
+
+    exited = 0;
+    for (i = 0; i < CHURN_BURST; i++)
+        uassert_int_equal(_churn_spawn(CHURN_STACK_SIZE), RT_EOK);
+    uassert_int_equal(exited, CHURN_BURST);
+
+    /* the idle thread reclaims the whole burst */
+    rt_thread_mdelay(10);
+    uassert_null(rt_thread_defunct_dequeue());
+}
+
+static void test_thread_stack_reuse(void)
+{
+    void *stack;
+
+    uassert_int_equal(_churn_spawn(CHURN_STACK_SIZE), RT_EOK);
+    stack = last_stack;
+    rt_thread_mdelay(10);
+
+    uassert_int_equal(_churn_spawn(CHURN_STACK_SIZE), RT_EOK);
+#ifdef RT_USING_THREAD_STACK_CACHE
+    /* the dead thread's stack is handed to the next thread of the same size */
+    uassert_true(last_stack == stack);
+    rt_thread_mdelay(10);
+    rt_thread_stack_cache_flush();
+    uassert_null(rt_thread_stack_cache_get(CHURN_STACK_SIZE));
+#else
+    RT_UNUSED(stack);
+    rt_thread_mdelay(10);
+#endif /* RT_USING_THREAD_STACK_CACHE */
+}
+
+static rt_uint32_t _bench_churn(rt_bool_t same_size)
+{
+    rt_tick_t start, elapsed;
+    rt_uint32_t count = 0;
+    int i;
+
+    start = rt_tick_get();
+    do
+    {
+        for (i = 0; i < CHURN_BURST; i++)
+        {
+            /* distinct sizes never hit the stack cache */
+            if (_churn_spawn(same_size ? CHURN_STACK_SIZE : CHURN_STACK_SIZE + 8 * (count % 64 + 1)) != RT_EOK)
+                break;
+            count++;
+        }
+        /* let the idle thread reclaim the burst */
+        rt_thread_delay(1);
+        elapsed = rt_tick_get() - start;
+    } while (elapsed < BENCH_TICKS);
+
+    rt_thread_mdelay(10);
+
+    /* threads per second */
+    return (rt_uint32_t)((rt_uint64_t)count * RT_TICK_PER_SECOND / elapsed);
+}
+
+static void test_thread_churn_bench(void)
+{
+    rt_uint32_t same, mixed;
+
+    same = _bench_churn(RT_TRUE);
+    mixed = _bench_churn(RT_FALSE);
+
+    LOG_I("%-24s %12s", "create/exit", "threads/s");
+    LOG_I("%-24s %12u", "same stack size", same);
+    LOG_I("%-24s %12u", "mixed stack size", mixed);
+
+    uassert_true(same > 0);
+    uassert_true(mixed > 0);
+#ifdef RT_USING_THREAD_STACK_CACHE
+    rt_thread_stack_cache_flush();
+#endif /* RT_USING_THREAD_STACK_CACHE */
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_thread_churn_burst);
+    UTEST_UNIT_RUN(test_thread_stack_reuse);
+    UTEST_UNIT_RUN(test_thread_churn_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.thread_churn_tc", utest_tc_init, utest_tc_cleanup, 30);
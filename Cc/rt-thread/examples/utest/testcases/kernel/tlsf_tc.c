@@ -0,0 +1,498 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+#define TEST_MEM_SIZE       (8 * 1024)
+#define RANDOM_OPS          4096
+#define RANDOM_SLOTS        64
+
+/* the trace replayed against each allocator */
+#define BENCH_HEAP_SIZE     (64 * 1024)
+#define TRACE_OPS           8192
+#define TRACE_SLOTS         64
+#define TRACE_SEED          0x5eed
+
+static rt_uint32_t _rand(rt_uint32_t *seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 16;
+}
+
+static void test_tlsf_alloc(void)
+{
+    rt_tlsf_t heap;
+    rt_uint8_t *buf, *ptr;
+    void *blocks[TEST_MEM_SIZE / 64];
+    rt_size_t i, count;
+
+    buf = rt_malloc(TEST_MEM_SIZE);
+    uassert_not_null(buf);
+    heap = rt_tlsf_init("tlsf_tc", buf, TEST_MEM_SIZE);
+    uassert_not_null(heap);
+
+    uassert_null(rt_tlsf_alloc(heap, 0));
+    uassert_null(rt_tlsf_alloc(heap, TEST_MEM_SIZE));
+    uassert_null(rt_tlsf_alloc(heap, ~(rt_size_t)0));
+
+    ptr = rt_tlsf_alloc(heap, 1);
+    uassert_not_null(ptr);
+    uassert_int_equal(RT_ALIGN((rt_ubase_t)ptr, RT_ALIGN_SIZE), (rt_ubase_t)ptr);
+    rt_tlsf_free(heap, ptr);
+    uassert_int_equal(heap->used, 0);
+
+    /* exhaust the heap with small blocks */
+    for (count = 0; count < sizeof(blocks) / sizeof(blocks[0]); count++)
+    {
+        blocks[count] = rt_tlsf_alloc(heap, 40);
+        if (blocks[count] == RT_NULL)
+            break;
+        rt_memset(blocks[count], count, 40);
+    }
+    uassert_true(count > 0);
+    uassert_true(heap->used <= heap->total);
+    uassert_int_equal(rt_tlsf_check(heap), RT_EOK);
+
+    /* free every other block, then the rest, to merge both ways */
+    for (i = 0; i < count; i += 2)
+        rt_tlsf_free(heap, blocks[i]);
+    uassert_int_equal(rt_tlsf_check(heap), RT_EOK);
+    for (i = 1; i < count; i += 2)
+        rt_tlsf_free(heap, blocks[i]);
+    uassert_int_equal(rt_tlsf_check(heap), RT_EOK);
+    uassert_int_equal(heap->used, 0);
+
+    /* the whole heap is one free block again */
+    ptr = rt_tlsf_alloc(heap, heap->total - 64);
+    uassert_not_null(ptr);
+    rt_tlsf_free(heap, ptr);
+
+    rt_tlsf_detach(heap);
+    rt_free(buf);
+}
+
+static void test_tlsf_realloc(void)
+{
+    rt_tlsf_t heap;
+    rt_uint8_t *buf, *ptr, *nptr, *guard;
+    int i;
+
+    buf = rt_malloc(TEST_MEM_SIZE);
+    uassert_not_null(buf);
+    heap = rt_tlsf_init("tlsf_tc", buf, TEST_MEM_SIZE);
+    uassert_not_null(heap);
+
+    ptr = rt_tlsf_realloc(heap, RT_NULL, 64);
+    uassert_not_null(ptr);
+    for (i = 0; i < 64; i++)
+        ptr[i] = (rt_uint8_t)i;
+
+    /* grow in place into the free block behind */
+    nptr = rt_tlsf_realloc(heap, ptr, 256);
+    uassert_true(nptr == ptr);
+    /* shrink in place */
+    nptr = rt_tlsf_realloc(heap, ptr, 32);
+    uassert_true(nptr == ptr);
+    for (i = 0; i < 32; i++)
+        uassert_int_equal(ptr[i], i);
+
+    /* a used block behind forces a move */
+    guard = rt_tlsf_alloc(heap, 16);
+    uassert_not_null(guard);
+    nptr = rt_tlsf_realloc(heap, ptr, 512);
+    uassert_not_null(nptr);
+    uassert_true(nptr != ptr);
+    for (i = 0; i < 32; i++)
+        uassert_int_equal(nptr[i], i);
+    uassert_int_equal(rt_tlsf_check(heap), RT_EOK);
+
+    uassert_null(rt_tlsf_realloc(heap, nptr, 0));
+    rt_tlsf_free(heap, guard);
+    uassert_int_equal(heap->used, 0);
+    uassert_int_equal(rt_tlsf_check(heap), RT_EOK);
+
+    rt_tlsf_detach(heap);
+    rt_free(buf);
+}
+
+static void test_tlsf_region(void)
+{
+    rt_tlsf_t heap;
+    rt_uint8_t *buf, *region, *ptr;
+    rt_size_t total;
+
+    buf = rt_malloc(TEST_MEM_SIZE);
+    region = rt_malloc(TEST_MEM_SIZE * 2);
+    uassert_not_null(buf);
+    uassert_not_null(region);
+    heap = rt_tlsf_init("tlsf_tc", buf, TEST_MEM_SIZE);
+    uassert_not_null(heap);
+    total = heap->total;
+
+    uassert_null(rt_tlsf_alloc(heap, TEST_MEM_SIZE));
+    uassert_int_equal(rt_tlsf_add_region(heap, region, 8), -RT_EINVAL);
+    uassert_int_equal(rt_tlsf_add_region(heap, region, TEST_MEM_SIZE * 2), RT_EOK);
+    uassert_true(heap->total > total + TEST_MEM_SIZE);
+
+    /* only the second region can serve it */
+    ptr = rt_tlsf_alloc(heap, TEST_MEM_SIZE);
+    uassert_not_null(ptr);
+    uassert_true(ptr > region && ptr < region + TEST_MEM_SIZE * 2);
+    uassert_int_equal(rt_tlsf_check(heap), RT_EOK);
+    rt_tlsf_free(heap, ptr);
+    uassert_int_equal(heap->used, 0);
+
+    rt_tlsf_detach(heap);
+    rt_free(region);
+    rt_free(buf);
+}
+
+static void test_tlsf_random(void)
+{
+    rt_tlsf_t heap;
+    rt_uint8_t *buf;
+    rt_uint8_t *slots[RANDOM_SLOTS] = {0};
+    rt_uint16_t sizes[RANDOM_SLOTS];
+    rt_uint32_t seed = TRACE_SEED;
+    rt_uint8_t *ptr;
+    rt_size_t size, k;
+    int i, slot;
+
+    buf = rt_malloc(TEST_MEM_SIZE);
+    uassert_not_null(buf);
+    heap = rt_tlsf_init("tlsf_tc", buf, TEST_MEM_SIZE);
+    uassert_not_null(heap);
+
+    for (i = 0; i < RANDOM_OPS; i++)
+    {
+        slot = _rand(&seed) % RANDOM_SLOTS;
+        if (slots[slot] != RT_NULL)
+        {
+            /* the data survives the neighbours being split and merged */
+            for (k = 0; k < sizes[slot]; k++)
+            {
+                if (slots[slot][k] != (rt_uint8_t)(slot + k))
+                    break;
+            }
+            uassert_int_equal(k, sizes[slot]);
+
+            if (_rand(&seed) % 4 == 0)
+            {
+                size = _rand(&seed) % 512 + 1;
+                ptr = rt_tlsf_realloc(heap, slots[slot], size);
+                if (ptr == RT_NULL)
+                    continue;
+                slots[slot] = ptr;
+                sizes[slot] = size;
+                for (k = 0; k < size; k++)
+                    ptr[k] = (rt_uint8_t)(slot + k);
+            }
+            else
+            {
+                rt_tlsf_free(heap, slots[slot]);
+                slots[slot] = RT_NULL;
+            }
+        }
+        else
+        {
+            size = _rand(&seed) % 256 + 1;
+            ptr = rt_tlsf_alloc(heap, size);
+            if (ptr == RT_NULL)
+                continue;
+            uassert_int_equal(RT_ALIGN((rt_ubase_t)ptr, RT_ALIGN_SIZE), (rt_ubase_t)ptr);
+            slots[slot] = ptr;
+            sizes[slot] = size;
+            for (k = 0; k < size; k++)
+                ptr[k] = (rt_uint8_t)(slot + k);
+        }
+
+        if (i % 64 == 0)
+            uassert_int_equal(rt_tlsf_check(heap), RT_EOK);
+    }
+
+    for (slot = 0; slot < RANDOM_SLOTS; slot++)
+        rt_tlsf_free(heap, slots[slot]);
+    uassert_int_equal(rt_tlsf_check(heap), RT_EOK);
+    uassert_int_equal(heap->used, 0);
+
+    rt_tlsf_detach(heap);
+    rt_free(buf);
+}
+
+struct bench_heap
+{
+    const char *name;
+    void *(*init)(void *buf, rt_size_t size);
+    void (*detach)(void *heap);
+    void *(*alloc)(void *heap, rt_size_t size);
+    void (*free)(void *heap, void *ptr);
+};
+
+struct bench_result
+{
+    rt_uint64_t alloc_sum;
+    rt_uint64_t alloc_max;
+    rt_uint64_t free_sum;
+    rt_uint64_t free_max;
+    rt_uint32_t allocs;
+    rt_uint32_t frees;
+    rt_uint32_t fails;
+};
+
+static void *_tlsf_bench_init(void *buf, rt_size_t size)
+{
+    return rt_tlsf_init("bench", buf, size);
+}
+
+static void _tlsf_bench_detach(void *heap)
+{
+    rt_tlsf_detach(heap);
+}
+
+static void *_tlsf_bench_alloc(void *heap, rt_size_t size)
+{
+    return rt_tlsf_alloc(heap, size);
+}
+
+static void _tlsf_bench_free(void *heap, void *ptr)
+{
+    rt_tlsf_free(heap, ptr);
+}
+
+#ifdef RT_USING_SMALL_MEM
+static void *_smem_bench_init(void *buf, rt_size_t size)
+{
+    return rt_smem_init("bench", buf, size);
+}
+
+static void _smem_bench_detach(void *heap)
+{
+    rt_smem_detach(heap);
+}
+
+static void *_smem_bench_alloc(void *heap, rt_size_t size)
+{
+    return rt_smem_alloc(heap, size);
+}
+
+static void _smem_bench_free(void *heap, void *ptr)
+{
+    rt_smem_free(ptr);
+}
+#endif /* RT_USING_SMALL_MEM */
+
+#ifdef RT_USING_SLAB
+static void *_slab_bench_init(void *buf, rt_size_t size)
+{
+    return rt_slab_init("bench", buf, size);
+}
+
+static void _slab_bench_detach(void *heap)
+{
+    rt_slab_detach(heap);
+}
+
+static void *_slab_bench_alloc(void *heap, rt_size_t size)
+{
+    return rt_slab_alloc(heap, size);
+}
+
+static void _slab_bench_free(void *heap, void *ptr)
+{
+    rt_slab_free(heap, ptr);
+}
+#endif /* RT_USING_SLAB */
+
+#ifdef RT_USING_MEMHEAP
+static struct rt_memheap bench_memheap;
+
+static void *_memheap_bench_init(void *buf, rt_size_t size)
+{
+    if (rt_memheap_init(&bench_memheap, "bench", buf, size) != RT_EOK)
+        return RT_NULL;
+    return &bench_memheap;
+}
+
+static void _memheap_bench_detach(void *heap)
+{
+    rt_memheap_detach(heap);
+}
+
+static void *_memheap_bench_alloc(void *heap, rt_size_t size)
+{
+    return rt_memheap_alloc(heap, size);
+}
+
+static void _memheap_bench_free(void *heap, void *ptr)
+{
+    rt_memheap_free(ptr);
+}
+#endif /* RT_USING_MEMHEAP */
+
+static const struct bench_heap bench_heaps[] =
+{
+    {"tlsf", _tlsf_bench_init, _tlsf_bench_detach, _tlsf_bench_alloc, _tlsf_bench_free},
+#ifdef RT_USING_SMALL_MEM
+    {"small", _smem_bench_init, _smem_bench_detach, _smem_bench_alloc, _smem_bench_free},
+#endif /* RT_USING_SMALL_MEM */
+#ifdef RT_USING_SLAB
+    {"slab", _slab_bench_init, _slab_bench_detach, _slab_bench_alloc, _slab_bench_free},
+#endif /* RT_USING_SLAB */
+#ifdef RT_USING_MEMHEAP
+    {"memheap", _memheap_bench_init, _memheap_bench_detach, _memheap_bench_alloc, _memheap_bench_free},
+#endif /* RT_USING_MEMHEAP */
+};
+
+/*
+ * Replay the same allocation trace: mostly small objects of mixed lifetime
+ * with a few large buffers, as a network stack allocates them. The trace
+ * depends on the seed only, a failed allocation does not change it.
+ */
+static rt_err_t _bench_replay(const struct bench_heap *bench, void *buf, struct bench_result *result)
+{
+    void *slots[TRACE_SLOTS] = {0};
+    rt_bool_t live[TRACE_SLOTS] = {0};
+    rt_uint32_t seed = TRACE_SEED;
+    rt_uint64_t start, elapsed;
+    rt_size_t size;
+    void *heap, *ptr;
+    int i, slot;
+
+    heap = bench->init(buf, BENCH_HEAP_SIZE);
+    if (heap == RT_NULL)
+        return -RT_ERROR;
+
+    rt_memset(result, 0, sizeof(*result));
+    for (i = 0; i < TRACE_OPS; i++)
+    {
+        slot = _rand(&seed) % TRACE_SLOTS;
+        if (live[slot])
+        {
+            live[slot] = RT_FALSE;
+            if (slots[slot] == RT_NULL)
+                continue;
+
+            rt_enter_critical();
+            start = utest_bench_now();
+            bench->free(heap, slots[slot]);
+            elapsed = utest_bench_now() - start;
+            rt_exit_critical();
+
+            result->free_sum += elapsed;
+            if (elapsed > result->free_max)
+                result->free_max = elapsed;
+            result->frees++;
+            slots[slot] = RT_NULL;
+        }
+        else
+        {
+            size = _rand(&seed) % 100;
+            if (size < 70)
+                size = size * 2 + 8;
+            else if (size < 95)
+                size = (size - 69) * 40 + 128;
+            else
+                size = (size - 94) * 700 + 1024;
+            live[slot] = RT_TRUE;
+
+            rt_enter_critical();
+            start = utest_bench_now();
+            ptr = bench->alloc(heap, size);
+            elapsed = utest_bench_now() - start;
+            rt_exit_critical();
+
+            if (ptr == RT_NULL)
+            {
+                result->fails++;
+                continue;
+            }
+            result->alloc_sum += elapsed;
+            if (elapsed > result->alloc_max)
+                result->alloc_max = elapsed;
+            result->allocs++;
+            slots[slot] = ptr;
+        }
+    }
+
+    for (slot = 0; slot < TRACE_SLOTS; slot++)
+    {
+        if (slots[slot] != RT_NULL)
+            bench->free(heap, slots[slot]);
+    }
+    bench->detach(heap);
+
+    return RT_EOK;
+}
+
+static void test_heap_trace_bench(void)
+{
+    struct bench_result result;
+    void *buf;
+    rt_size_t i;
+
+    buf = rt_malloc(BENCH_HEAP_SIZE);
+    if (buf == RT_NULL)
+    {
+        LOG_W("no memory for a %d bytes bench heap, skipped", BENCH_HEAP_SIZE);
+        return;
+    }
+
+#ifdef RT_USING_CPUTIME
+    LOG_I("%-8s %8s %10s %10s %10s %10s %6s", "heap", "ops",
+          "alloc(cyc)", "max(cyc)", "free(cyc)", "max(cyc)", "fails");
+#else
+    LOG_I("%-8s %8s %10s %10s %10s %10s %6s", "heap", "ops",
+          "alloc(tk)", "max(tk)", "free(tk)", "max(tk)", "fails");
+#endif /* RT_USING_CPUTIME */
+    for (i = 0; i < sizeof(bench_heaps) / sizeof(bench_heaps[0]); i++)
+    {
+        if (_bench_replay(&bench_heaps[i], buf, &result) != RT_EOK)
+        {
+            LOG_W("%-8s init failed", bench_heaps[i].name);
+            continue;
+        }
+
+        LOG_I("%-8s %8u %10u %10u %10u %10u %6u", bench_heaps[i].name,
+              result.allocs + result.frees,
+              (rt_uint32_t)(result.alloc_sum / (result.allocs ? result.allocs : 1)),
+              (rt_uint32_t)result.alloc_max,
+              (rt_uint32_t)(result.free_sum / (result.frees ? result.frees : 1)),
+              (rt_uint32_t)result.free_max, result.fails);
+
+        if (i == 0)
+        {
+            /* the trace fits the TLSF heap */
+            uassert_int_equal(result.fails, 0);
+        }
+    }
+
+    rt_free(buf);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_tlsf_alloc);
+    UTEST_UNIT_RUN(test_tlsf_realloc);
+    UTEST_UNIT_RUN(test_tlsf_region);
+    UTEST_UNIT_RUN(test_tlsf_random);
+    UTEST_UNIT_RUN(test_heap_trace_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.tlsf_tc", utest_tc_init, utest_tc_cleanup, 20);
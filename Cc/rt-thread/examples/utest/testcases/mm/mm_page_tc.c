@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include "common.h"
+
+#define SLOT_NR         256
+#define ORDER_MAX       6
+#define CHECK_OPS       20000
+#define BENCH_OPS       200000
+
+struct page_slot
+{
+    rt_uint32_t *addr;
+    rt_uint32_t order;
+};
+
+static struct page_slot slots[SLOT_NR];
+static rt_uint32_t seed;
+
+static rt_uint32_t _rand(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
+
+/* mostly single pages, some small blocks and a few large ones */
+static rt_uint32_t _rand_order(void)
+{
+    rt_uint32_t r = _rand() % 100;
+
+    if (r < 60)
+        return 0;
+    if (r < 90)
+        return 1 + _rand() % 2;
+    return 3 + _rand() % (ORDER_MAX - 2);
+}
+
+/* tag the first word of every page with the slot owning it */
+static void _tag(struct page_slot *slot, rt_uint32_t tag)
+{
+    rt_size_t i;
+
+    for (i = 0; i < (1ul << slot->order); i++)
+        slot->addr[i * ARCH_PAGE_SIZE / sizeof(rt_uint32_t)] = tag;
+}
+
+static rt_bool_t _tag_check(struct page_slot *slot, rt_uint32_t tag)
+{
+    rt_size_t i;
+
+    for (i = 0; i < (1ul << slot->order); i++)
+    {
+        if (slot->addr[i * ARCH_PAGE_SIZE / sizeof(rt_uint32_t)] != tag)
+            return RT_FALSE;
+    }
+    return RT_TRUE;
+}
+
+/* allocate or release one random slot, 0 if an allocation failed */
+static int _step(rt_bool_t check)
+{
+    struct page_slot *slot = &slots[_rand() % SLOT_NR];
+
+    if (slot->addr)
+    {
+        if (check)
+            uassert_true(_tag_check(slot, (rt_uint32_t)(slot - slots)));
+        rt_pages_free(slot->addr, slot->order);
+        slot->addr = RT_NULL;
+        return 1;
+    }
+
+    slot->order = _rand_order();
+    slot->addr = rt_pages_alloc(slot->order);
+    if (slot->addr == RT_NULL)
+        return 0;
+
+    if (check)
+    {
+        uassert_int_equal((rt_ubase_t)slot->addr & ((ARCH_PAGE_SIZE << slot->order) - 1), 0);
+        _tag(slot, (rt_uint32_t)(slot - slots));
+    }
+    return 1;
+}
+
+static void _release_all(void)
+{
+    int i;
+
+    for (i = 0; i < SLOT_NR; i++)
+    {
+        if (slots[i].addr)
+        {
+            rt_pages_free(slots[i].addr, slots[i].order);
+            slots[i].addr = RT_NULL;
+        }
+    }
+}
+
+static void test_page_random(void)
+{
+    rt_size_t total, free_before, free_after;
+    int i, failed = 0;
+
+    rt_page_get_info(&total, &free_before);
+    seed = 0x5eed;
+    for (i = 0; i < CHECK_OPS; i++)
+        failed += !_step(RT_TRUE);
+
+    /* no page was handed out twice */
+    for (i = 0; i < SLOT_NR; i++)
+    {
+        if (slots[i].addr)
+            uassert_true(_tag_check(&slots[i], i));
+    }
+    _release_all();
+
+    rt_page_get_info(&total, &free_after);
+    uassert_int_equal(free_after, free_before);
+    LOG_I("%d random steps, %d allocations failed", CHECK_OPS, failed);
+}
+
+static void test_page_bench(void)
+{
+    rt_size_t total, free_before, free_after;
+    rt_uint64_t start, elapsed;
+    int i, failed = 0;
+
+    rt_page_get_info(&total, &free_before);
+    seed = 0xbe7c;
+
+    /* fragment first, half of the slots stay allocated */
+    for (i = 0; i < SLOT_NR; i += 2)
+        _step(RT_FALSE);
+
+    start = utest_bench_now();
+    for (i = 0; i < BENCH_OPS; i++)
+        failed += !_step(RT_FALSE);
+    elapsed = utest_bench_now() - start;
+    _release_all();
+
+#ifdef RT_USING_CPUTIME
+    LOG_I("%d random order alloc/free: %u cyc/op, %d failed", BENCH_OPS,
+          (rt_uint32_t)(elapsed / BENCH_OPS), failed);
+#else
+    LOG_I("%d random order alloc/free: %u ticks, %d failed", BENCH_OPS,
+          (rt_uint32_t)elapsed, failed);
+#endif /* RT_USING_CPUTIME */
+
+    rt_page_get_info(&total, &free_after);
+    uassert_int_equal(free_after, free_before);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    _release_all();
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_page_random);
+    UTEST_UNIT_RUN(test_page_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.mm.page_tc", utest_tc_init, utest_tc_cleanup, 20);
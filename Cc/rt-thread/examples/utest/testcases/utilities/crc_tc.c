@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include <crc.h>
+#include "utest.h"
+
+#define DATA_LEN        1024
+#define BENCH_ROUNDS    64
+
+static rt_uint8_t *data;
+static rt_uint32_t seed = 1;
+
+static rt_uint32_t _random(void)
+{
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
+
+/* the CRCs of the definitions, one bit at a time */
+static rt_uint32_t _crc_bitwise(enum rt_crc_type type, const rt_uint8_t *p, rt_size_t len)
+{
+    rt_uint32_t crc, poly;
+    int bit;
+
+    switch (type)
+    {
+    case RT_CRC_8:
+        crc = 0;
+        while (len--)
+        {
+            crc ^= *p++;
+            for (bit = 0; bit < 8; bit++)
+            {
+                crc = ((crc << 1) ^ ((crc & 0x80) ? 0x07 : 0)) & 0xff;
+            }
+        }
+        return crc;
+    case RT_CRC_16:
+        crc = 0;
+        while (len--)
+        {
+            crc ^= (rt_uint32_t)*p++ << 8;
+            for (bit = 0; bit < 8; bit++)
+            {
+                crc = ((crc << 1) ^ ((crc & 0x8000) ? 0x1021 : 0)) & 0xffff;
+            }
+        }
+        return crc;
+    default:
+        poly = type == RT_CRC_32 ? 0xEDB88320 : 0x82F63B78;
+        crc = 0xFFFFFFFF;
+        while (len--)
+        {
+            crc ^= *p++;
+            for (bit = 0; bit < 8; bit++)
+            {
+                crc = (crc >> 1) ^ ((crc & 1) ? poly : 0);
+            }
+        }
+        return ~crc;
+    }
+}
+
+static void test_crc_check(void)
+{
+    static const char quick[] = "The quick brown fox jumps over the lazy dog";
+    rt_uint8_t block[32];
+
+    uassert_int_equal(rt_crc8(0, "123456789", 9), 0xF4);
+    uassert_int_equal(rt_crc16(0, "123456789", 9), 0x31C3);
+    uassert_true(rt_crc32(0, "123456789", 9) == 0xCBF43926);
+    uassert_true(rt_crc32c(0, "123456789", 9) == 0xE3069283);
+    uassert_true(rt_crc32(0, quick, sizeof(quick) - 1) == 0x414FA339);
+
+    /* the vectors of iSCSI, RFC 3720 */
+    rt_memset(block, 0x00, sizeof(block));
+    uassert_true(rt_crc32c(0, block, sizeof(block)) == 0x8A9136AA);
+    rt_memset(block, 0xFF, sizeof(block));
+    uassert_true(rt_crc32c(0, block, sizeof(block)) == 0x62A8AB43);
+
+    /* nothing in, nothing changes */
+    uassert_true(rt_crc(RT_CRC_32, 0x12345678, RT_NULL, 0) == 0x12345678);
+    uassert_true(rt_crc(RT_CRC_TYPE_NR, 0, "123456789", 9) == 0);
+}
+
+/* every alignment and every length up to past the longest step */
+static void test_crc_tables(void)
+{
+    int type, offset, len, errors = 0;
+
+    for (type = 0; type < RT_CRC_TYPE_NR; type++)
+    {
+        for (offset = 0; offset < 8; offset++)
+        {
+            for (len = 0; len <= 64; len++)
+            {
+                if (rt_crc((enum rt_crc_type)type, 0, data + offset, len) !=
+                    _crc_bitwise((enum rt_crc_type)type, data + offset, len))
+                {
+                    errors++;
+                }
+            }
+        }
+    }
+    uassert_int_equal(errors, 0);
+}
+
+/* a stream cut in random pieces has the CRC of the whole */
+static void test_crc_stream(void)
+{
+    rt_uint32_t crc, whole;
+    rt_size_t done, piece;
+    int type, round, errors = 0;
+
+    for (type = 0; type < RT_CRC_TYPE_NR; type++)
+    {
+        whole = rt_crc((enum rt_crc_type)type, 0, data, DATA_LEN);
+        for (round = 0; round < 16; round++)
+        {
+            crc = 0;
+            for (done = 0; done < DATA_LEN; done += piece)
+            {
+                piece = _random() % 100;
+                if (piece > DATA_LEN - done)
+                {
+                    piece = DATA_LEN - done;
+                }
+                crc = rt_crc((enum rt_crc_type)type, crc, data + done, piece);
+            }
+            if (crc != whole)
+            {
+                errors++;
+            }
+        }
+    }
+    uassert_int_equal(errors, 0);
+}
+
+static rt_uint64_t _bench_one(enum rt_crc_type type, rt_bool_t bitwise)
+{
+    volatile rt_uint32_t sink = 0;
+    rt_uint64_t start;
+    int round;
+
+    start = utest_bench_now();
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        if (bitwise)
+        {
+            sink ^= _crc_bitwise(type, data, DATA_LEN);
+        }
+        else
+        {
+            sink ^= rt_crc(type, 0, data, DATA_LEN);
+        }
+    }
+    (void)sink;
+
+    return utest_bench_now() - start;
+}
+
+static void test_crc_bench(void)
+{
+    static const char *const names[RT_CRC_TYPE_NR] = {"crc8", "crc16", "crc32", "crc32c"};
+    rt_uint64_t table_time, bit_time;
+    int type;
+
+    for (type = 0; type < RT_CRC_TYPE_NR; type++)
+    {
+        table_time = _bench_one((enum rt_crc_type)type, RT_FALSE);
+        bit_time = _bench_one((enum rt_crc_type)type, RT_TRUE);
+#ifdef RT_USING_CPUTIME
+        table_time = utest_bench_us(table_time);
+        bit_time = utest_bench_us(bit_time);
+        LOG_I("%-6s: %u KB/s, bitwise %u KB/s", names[type],
+              (rt_uint32_t)(BENCH_ROUNDS * DATA_LEN * 1000ULL / (table_time ? table_time : 1)),
+              (rt_uint32_t)(BENCH_ROUNDS * DATA_LEN * 1000ULL / (bit_time ? bit_time : 1)));
+#else
+        LOG_I("%-6s: %u ticks/%d KB, bitwise %u ticks", names[type], (rt_uint32_t)table_time,
+              BENCH_ROUNDS * DATA_LEN / 1024, (rt_uint32_t)bit_time);
+#endif /* RT_USING_CPUTIME */
+    }
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    int index;
+
+    /* 8 more bytes for the unaligned starts */
+    data = rt_malloc(DATA_LEN + 8);
+    if (data == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+    for (index = 0; index < DATA_LEN + 8; index++)
+    {
+        data[index] = (rt_uint8_t)_random();
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_free(data);
+    data = RT_NULL;
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_crc_check);
+    UTEST_UNIT_RUN(test_crc_tables);
+    UTEST_UNIT_RUN(test_crc_stream);
+    UTEST_UNIT_RUN(test_crc_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.utilities.crc_tc", utest_tc_init, utest_tc_cleanup, 20);
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include <heap_prof.h>
+#include "utest.h"
+
+#define TEST_BLOCKS     8
+#define TEST_SIZE       77
+
+#define BENCH_PAIRS     4096
+#define BENCH_SIZE      64
+
+/* the site which allocated 'allocs' blocks of 'size' bytes */
+static int _site_find(rt_uint32_t allocs, rt_size_t size, struct heap_prof_site *site)
+{
+    int index;
+
+    for (index = 0; index < RT_HEAP_PROF_SITE_NR; index++)
+    {
+        if (heap_prof_get_site(index, site) == RT_EOK &&
+            site->allocs == allocs && site->bytes == (rt_uint64_t)allocs * size)
+        {
+            return index;
+        }
+    }
+
+    return -1;
+}
+
+static void test_heap_prof_sites(void)
+{
+    struct heap_prof_site site;
+    void *blocks[TEST_BLOCKS];
+    void *ptr;
+    int index, i;
+
+    heap_prof_start();
+    uassert_true(heap_prof_is_running());
+
+    for (i = 0; i < TEST_BLOCKS; i++)
+    {
+        blocks[i] = rt_malloc(TEST_SIZE);
+        uassert_not_null(blocks[i]);
+    }
+    index = _site_find(TEST_BLOCKS, TEST_SIZE, &site);
+    uassert_true(index >= 0);
+    uassert_int_equal(site.frees, 0);
+    uassert_int_equal(site.live_bytes, TEST_BLOCKS * TEST_SIZE);
+    uassert_int_equal(site.peak_bytes, TEST_BLOCKS * TEST_SIZE);
+
+    for (i = 0; i < TEST_BLOCKS / 2; i++)
+        rt_free(blocks[i]);
+    heap_prof_get_site(index, &site);
+    uassert_int_equal(site.frees, TEST_BLOCKS / 2);
+    uassert_int_equal(site.live_bytes, TEST_BLOCKS / 2 * TEST_SIZE);
+    uassert_int_equal(site.peak_bytes, TEST_BLOCKS * TEST_SIZE);
+
+    /* a resized block moves to the site of the realloc call */
+    ptr = rt_realloc(blocks[TEST_BLOCKS / 2], TEST_SIZE * 3);
+    uassert_not_null(ptr);
+    blocks[TEST_BLOCKS / 2] = ptr;
+    heap_prof_get_site(index, &site);
+    uassert_int_equal(site.frees, TEST_BLOCKS / 2 + 1);
+    uassert_true(_site_find(1, TEST_SIZE * 3, &site) >= 0);
+    uassert_int_equal(site.live_bytes, TEST_SIZE * 3);
+
+    /* nothing is recorded once stopped */
+    heap_prof_stop();
+    for (i = TEST_BLOCKS / 2; i < TEST_BLOCKS; i++)
+        rt_free(blocks[i]);
+    heap_prof_get_site(index, &site);
+    uassert_int_equal(site.frees, TEST_BLOCKS / 2 + 1);
+    uassert_int_equal(heap_prof_get_dropped(), 0);
+
+    uassert_int_equal(heap_prof_get_site(RT_HEAP_PROF_SITE_NR, &site), -RT_EINVAL);
+}
+
+static void test_heap_prof_lifetime(void)
+{
+    struct heap_prof_site site;
+    void *ptr;
+
+    heap_prof_start();
+    ptr = rt_calloc(1, TEST_SIZE);
+    uassert_not_null(ptr);
+    rt_thread_delay(10);
+    rt_free(ptr);
+    heap_prof_stop();
+
+    uassert_true(_site_find(1, TEST_SIZE, &site) >= 0);
+    uassert_int_equal(site.frees, 1);
+    uassert_int_equal(site.live_bytes, 0);
+    uassert_true(site.life_max >= 10);
+    uassert_true(site.life_sum == site.life_max);
+}
+
+static void test_heap_prof_frag(void)
+{
+    struct heap_prof_frag before, after;
+    void *blocks[32];
+    rt_size_t i;
+
+    heap_prof_get_frag(&before);
+    uassert_true(before.max_free <= before.total - before.used);
+    uassert_true(before.index >= -1 && before.index <= 100);
+
+    for (i = 0; i < sizeof(blocks) / sizeof(blocks[0]); i++)
+        blocks[i] = rt_malloc(TEST_SIZE);
+    /* leave holes between the blocks still allocated */
+    for (i = 0; i < sizeof(blocks) / sizeof(blocks[0]); i += 2)
+        rt_free(blocks[i]);
+
+    heap_prof_get_frag(&after);
+    uassert_true(after.max_free <= after.total - after.used);
+    uassert_true(after.index >= -1 && after.index <= 100);
+    LOG_I("fragmentation %d%% -> %d%%, largest free block %u -> %u",
+          before.index, after.index, (rt_uint32_t)before.max_free, (rt_uint32_t)after.max_free);
+
+    for (i = 1; i < sizeof(blocks) / sizeof(blocks[0]); i += 2)
+        rt_free(blocks[i]);
+}
+
+static rt_uint64_t _bench_pairs(void)
+{
+    rt_uint64_t start;
+    void *ptr;
+    int i;
+
+    start = utest_bench_now();
+    for (i = 0; i < BENCH_PAIRS; i++)
+    {
+        ptr = rt_malloc(BENCH_SIZE);
+        rt_free(ptr);
+    }
+
+    return utest_bench_now() - start;
+}
+
+static void test_heap_prof_bench(void)
+{
+    rt_uint64_t stopped, running;
+
+    heap_prof_stop();
+    stopped = _bench_pairs();
+    heap_prof_start();
+    running = _bench_pairs();
+    heap_prof_stop();
+
+#ifdef RT_USING_CPUTIME
+    LOG_I("%d x %d bytes malloc/free pairs: stopped %u cyc/pair, running %u cyc/pair",
+          BENCH_PAIRS, BENCH_SIZE, (rt_uint32_t)(stopped / BENCH_PAIRS), (rt_uint32_t)(running / BENCH_PAIRS));
+#else
+    LOG_I("%d x %d bytes malloc/free pairs: stopped %u ticks, running %u ticks",
+          BENCH_PAIRS, BENCH_SIZE, (rt_uint32_t)stopped, (rt_uint32_t)running);
+#endif /* RT_USING_CPUTIME */
+
+    uassert_int_equal(heap_prof_get_dropped(), 0);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    heap_prof_stop();
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_heap_prof_sites);
+    UTEST_UNIT_RUN(test_heap_prof_lifetime);
+    UTEST_UNIT_RUN(test_heap_prof_frag);
+    UTEST_UNIT_RUN(test_heap_prof_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.utilities.heap_prof_tc", utest_tc_init, utest_tc_cleanup, 10);
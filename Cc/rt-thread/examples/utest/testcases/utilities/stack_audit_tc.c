@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include <stack_audit.h>
+#include "utest.h"
+
+#define TEST_STACK      2048
+#define TEST_DEPTH      512
+#define TEST_NAME       "sa_test"
+
+static struct rt_semaphore go_sem, done_sem;
+static volatile rt_uint32_t depth;
+static volatile rt_bool_t quit;
+static rt_thread_t tid;
+
+static void _use_stack(rt_uint32_t size)
+{
+    volatile rt_uint8_t buf[TEST_STACK / 2];
+    rt_uint32_t i;
+
+    /* touch the end of the buffer next to the caller first */
+    for (i = 0; i < size && i < sizeof(buf); i++)
+    {
+#ifdef ARCH_CPU_STACK_GROWS_UPWARD
+        buf[i] = 0x5a;
+#else
+        buf[sizeof(buf) - 1 - i] = 0x5a;
+#endif /* ARCH_CPU_STACK_GROWS_UPWARD */
+    }
+}
+
+/* use 'depth' bytes of the stack each time it is woken up */
+static void _entry(void *parameter)
+{
+    while (!quit)
+    {
+        rt_sem_take(&go_sem, RT_WAITING_FOREVER);
+        _use_stack(depth);
+        rt_sem_release(&done_sem);
+    }
+}
+
+static void _run(rt_uint32_t size)
+{
+    depth = size;
+    rt_sem_release(&go_sem);
+    rt_sem_take(&done_sem, RT_WAITING_FOREVER);
+}
+
+static void test_stack_audit_peak(void)
+{
+    struct stack_audit_info info, deeper;
+
+    _run(TEST_DEPTH);
+    stack_audit_scan_all();
+    uassert_int_equal(stack_audit_get_thread(tid, &info), RT_EOK);
+    uassert_str_equal(info.name, TEST_NAME);
+    uassert_int_equal(info.stack_size, TEST_STACK);
+    uassert_true(info.alive);
+    uassert_true(info.peak >= TEST_DEPTH && info.peak < TEST_STACK);
+    uassert_int_equal(info.suggested, stack_audit_suggest(info.peak));
+    uassert_true(info.suggested >= info.peak + info.peak * RT_STACK_AUDIT_MARGIN / 100);
+    uassert_int_equal(info.suggested % RT_ALIGN_SIZE, 0);
+
+    /* the same depth again leaves the peak alone */
+    rt_thread_delay(2);
+    _run(TEST_DEPTH);
+    stack_audit_scan_all();
+    stack_audit_get_thread(tid, &deeper);
+    uassert_int_equal(deeper.peak, info.peak);
+    uassert_int_equal(deeper.peak_tick, info.peak_tick);
+
+    /* a deeper use moves it with its tick */
+    rt_thread_delay(2);
+    _run(TEST_DEPTH * 2);
+    stack_audit_scan_all();
+    stack_audit_get_thread(tid, &deeper);
+    uassert_true(deeper.peak >= info.peak + TEST_DEPTH);
+    uassert_true(deeper.peak_tick - info.peak_tick >= 2);
+    LOG_I("%s: peak %u -> %u of %u bytes, suggested %u", TEST_NAME,
+          info.peak, deeper.peak, deeper.stack_size, deeper.suggested);
+}
+
+static void test_stack_audit_idle(void)
+{
+    struct stack_audit_info info;
+    rt_bool_t running = stack_audit_is_running();
+
+    stack_audit_reset();
+    uassert_int_equal(stack_audit_get_thread(tid, &info), -RT_ENOENT);
+    uassert_int_equal(stack_audit_start(), RT_EOK);
+
+    /* the idle hook finds the peak on its own */
+    rt_thread_delay(RT_TICK_PER_SECOND / 2);
+    uassert_int_equal(stack_audit_get_thread(tid, &info), RT_EOK);
+    uassert_true(info.peak >= TEST_DEPTH * 2 && info.peak < TEST_STACK);
+
+    if (!running)
+        stack_audit_stop();
+}
+
+static void test_stack_audit_exit(void)
+{
+    struct stack_audit_info info;
+    int index;
+
+    quit = RT_TRUE;
+    _run(0);
+    rt_thread_delay(10);
+    tid = RT_NULL;
+
+    /* the record of an exited thread is kept */
+    stack_audit_scan_all();
+    for (index = 0; index < RT_STACK_AUDIT_THREAD_NR; index++)
+    {
+        if (stack_audit_get(index, &info) == RT_EOK && rt_strcmp(info.name, TEST_NAME) == 0)
+            break;
+    }
+    uassert_true(index < RT_STACK_AUDIT_THREAD_NR);
+    uassert_false(info.alive);
+    uassert_true(info.peak >= TEST_DEPTH * 2);
+
+    uassert_int_equal(stack_audit_get(RT_STACK_AUDIT_THREAD_NR, &info), -RT_EINVAL);
+}
+
+static void test_stack_audit_bench(void)
+{
+    struct stack_audit_info info;
+    rt_uint32_t bytes = 0;
+    rt_uint64_t start, elapsed;
+    int index;
+
+    stack_audit_reset();
+    start = utest_bench_now();
+    stack_audit_scan_all();
+    elapsed = utest_bench_now() - start;
+
+    for (index = 0; index < RT_STACK_AUDIT_THREAD_NR; index++)
+    {
+        if (stack_audit_get(index, &info) == RT_EOK)
+            bytes += info.stack_size;
+    }
+    uassert_true(bytes > 0);
+
+#ifdef RT_USING_CPUTIME
+    LOG_I("first scan of %u stack bytes: %u cycles, %u cyc/KB",
+          bytes, (rt_uint32_t)elapsed, (rt_uint32_t)(elapsed * 1024 / bytes));
+#else
+    LOG_I("first scan of %u stack bytes: %u ticks", bytes, (rt_uint32_t)elapsed);
+#endif /* RT_USING_CPUTIME */
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    quit = RT_FALSE;
+    rt_sem_init(&go_sem, "sa_go", 0, RT_IPC_FLAG_PRIO);
+    rt_sem_init(&done_sem, "sa_done", 0, RT_IPC_FLAG_PRIO);
+    tid = rt_thread_create(TEST_NAME, _entry, RT_NULL, TEST_STACK, UTEST_THR_PRIORITY - 1, 10);
+    if (tid == RT_NULL)
+        return -RT_ENOMEM;
+    rt_thread_startup(tid);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    if (tid != RT_NULL)
+    {
+        quit = RT_TRUE;
+        _run(0);
+        rt_thread_delay(10);
+    }
+    rt_sem_detach(&go_sem);
+    rt_sem_detach(&done_sem);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_stack_audit_peak);
+    UTEST_UNIT_RUN(test_stack_audit_idle);
+    UTEST_UNIT_RUN(test_stack_audit_exit);
+    UTEST_UNIT_RUN(test_stack_audit_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.utilities.stack_audit_tc", utest_tc_init, utest_tc_cleanup, 10);
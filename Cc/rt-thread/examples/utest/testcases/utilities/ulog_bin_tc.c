@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include <ulog.h>
+#include "utest.h"
+
+#define TEST_TAG        "ulog_bin"
+#define LINE_SIZE       128
+#define BENCH_CALLS     1024
+#define BENCH_BATCH     16              /* records written between two reads, they fit in the ring */
+
+static rt_atomic_t read_buf[ULOG_BINARY_BUF_SIZE / sizeof(rt_atomic_t)];
+static char line[LINE_SIZE], expect[LINE_SIZE];
+static volatile rt_bool_t isr_done;
+#ifdef ULOG_ASYNC_OUTPUT_BY_THREAD
+static volatile rt_bool_t low_stop;
+static volatile rt_uint32_t low_count;
+#endif /* ULOG_ASYNC_OUTPUT_BY_THREAD */
+static rt_uint32_t null_bytes;
+
+/* format the records of this test with 'check', others are given back to ulog */
+static rt_uint32_t _read_records(rt_bool_t (*check)(const struct ulog_bin_head *head, void *arg), void *arg)
+{
+    const struct ulog_bin_head *head;
+    rt_size_t size, pos;
+    rt_uint32_t matched = 0;
+
+    while ((size = ulog_bin_read(read_buf, sizeof(read_buf))) > 0)
+    {
+        for (pos = 0; pos < size; pos += RT_ALIGN(ULOG_BIN_CTRL_LEN(head->ctrl), sizeof(rt_atomic_t)))
+        {
+            head = (const struct ulog_bin_head *)((rt_uint8_t *)read_buf + pos);
+            if (ULOG_BIN_CTRL_MAGIC(head->ctrl) != ULOG_BIN_MAGIC)
+            {
+                return matched;
+            }
+            if (check(head, arg))
+            {
+                matched++;
+            }
+            else if (head->format != 0)
+            {
+                ulog_bin_format(head, line, sizeof(line));
+                ulog_output(ULOG_BIN_CTRL_LEVEL(head->ctrl), (const char *)head->tag, RT_TRUE, "%s", line);
+            }
+        }
+    }
+
+    return matched;
+}
+
+static rt_bool_t _check_format(const struct ulog_bin_head *head, void *arg)
+{
+    if (head->format != (rt_ubase_t)arg || rt_strcmp((const char *)head->tag, TEST_TAG) != 0)
+    {
+        return RT_FALSE;
+    }
+    ulog_bin_format(head, line, sizeof(line));
+    uassert_str_equal(line, expect);
+
+    return RT_TRUE;
+}
+
+static void _check(const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    rt_vsnprintf(expect, sizeof(expect), format, args);
+    va_end(args);
+
+    va_start(args, format);
+    ulog_bin_voutput(LOG_LVL_INFO, TEST_TAG, format, args);
+    va_end(args);
+
+    uassert_int_equal(_read_records(_check_format, (void *)format), 1);
+}
+
+static void test_ulog_bin_format(void)
+{
+    static int value;
+
+    ulog_bin_async_output_enabled(RT_FALSE);
+
+    _check("no arguments");
+    _check("%d %i %u %x %X %o", -12345, 678, 4000000000u, 0xbeef, 0xCAFE, 0755);
+    _check("[%5d] [%-5d] [%05d] [%+d] [% d] [%#x] [%#o]", 42, 42, 42, 42, 42, 255, 8);
+    _check("[%*d] [%-*d] [%.*d] [%*.*u]", 6, -7, 6, 7, 4, 3, 8, 5, 99u);
+    _check("%ld %lu %lx %hd %hu %c%c%%", -2000000000L, 3000000000UL, 0x12345678UL, (short)-3, (unsigned short)65535, 'o', 'k');
+    _check("%p %p", &value, (void *)RT_NULL);
+    _check("[%s] [%10s] [%-10s] [%.3s]", "str", "right", "left", "truncated");
+    _check("%s, %s", "", (char *)RT_NULL);
+#ifdef RT_KPRINTF_USING_LONGLONG
+    _check("%lld %llu %llx", -1234567890123LL, 18446744073709551615ULL, 0x123456789abcULL);
+#endif /* RT_KPRINTF_USING_LONGLONG */
+
+    /* a string longer than the limit keeps its first ULOG_BINARY_STR_MAX characters */
+    rt_memset(expect, 'a', ULOG_BINARY_STR_MAX + 8);
+    expect[ULOG_BINARY_STR_MAX + 8] = '\0';
+    rt_strcpy(line, expect);
+    ulog_bin_output(LOG_LVL_INFO, TEST_TAG, "%s", line);
+    expect[ULOG_BINARY_STR_MAX] = '\0';
+    uassert_int_equal(_read_records(_check_format, "%s"), 1);
+
+    ulog_bin_async_output_enabled(RT_TRUE);
+}
+
+static void _isr(void *parameter)
+{
+    ulog_bin_output(LOG_LVL_WARNING, TEST_TAG, "from isr %u", 7u);
+    isr_done = RT_TRUE;
+}
+
+static void test_ulog_bin_isr(void)
+{
+    struct rt_timer timer;
+
+    ulog_bin_async_output_enabled(RT_FALSE);
+
+    isr_done = RT_FALSE;
+    rt_timer_init(&timer, "ulog_bin", _isr, RT_NULL, 1, RT_TIMER_FLAG_HARD_TIMER | RT_TIMER_FLAG_ONE_SHOT);
+    rt_timer_start(&timer);
+    while (!isr_done)
+    {
+        rt_thread_delay(1);
+    }
+    rt_timer_detach(&timer);
+
+    rt_strcpy(expect, "from isr 7");
+    uassert_int_equal(_read_records(_check_format, "from isr %u"), 1);
+
+    ulog_bin_async_output_enabled(RT_TRUE);
+}
+
+static rt_bool_t _check_drop(const struct ulog_bin_head *head, void *arg)
+{
+    rt_uint32_t dropped = 0;
+    const char *pos;
+
+    if (head->format != 0)
+    {
+        return rt_strcmp((const char *)head->tag, TEST_TAG) == 0;
+    }
+    ulog_bin_format(head, line, sizeof(line));
+    for (pos = line; *pos >= '0' && *pos <= '9'; pos++)
+    {
+        dropped = dropped * 10 + (*pos - '0');
+    }
+    uassert_true(dropped > 0);
+    *(rt_uint32_t *)arg += dropped;
+
+    return RT_FALSE;
+}
+
+static void test_ulog_bin_drop(void)
+{
+    rt_uint32_t index, kept, dropped = 0;
+
+    ulog_bin_async_output_enabled(RT_FALSE);
+
+    /* twice the ring, the records that do not fit are counted */
+    for (index = 0; index < ULOG_BINARY_BUF_SIZE * 2 / sizeof(struct ulog_bin_head); index++)
+    {
+        ulog_bin_output(LOG_LVL_DBG, TEST_TAG, "fill %u", index);
+    }
+    kept = _read_records(_check_drop, &dropped);
+    uassert_true(kept > 0);
+    uassert_true(dropped > 0);
+    uassert_true(kept + dropped >= index);
+
+    ulog_bin_async_output_enabled(RT_TRUE);
+}
+
+static void _null_output(struct ulog_backend *backend, rt_uint32_t level, const char *tag, rt_bool_t is_raw,
+                         const char *log, rt_size_t len)
+{
+    null_bytes += len;
+}
+
+static rt_bool_t _count_bytes(const struct ulog_bin_head *head, void *arg)
+{
+    *(rt_uint32_t *)arg += RT_ALIGN(ULOG_BIN_CTRL_LEN(head->ctrl), sizeof(rt_atomic_t));
+
+    return RT_TRUE;
+}
+
+#ifdef ULOG_ASYNC_OUTPUT_BY_THREAD
+static void _low_entry(void *parameter)
+{
+    while (!low_stop)
+    {
+        low_count++;
+    }
+    low_stop = RT_FALSE;
+}
+
+static void test_ulog_bin_kept(void)
+{
+    rt_uint32_t index, bytes = 0;
+    rt_thread_t tid;
+
+    ulog_bin_async_output_enabled(RT_FALSE);
+
+    /* the records kept for ulog_bin_read() must not keep the output thread busy */
+    for (index = 0; index < 8; index++)
+    {
+        ulog_bin_output(LOG_LVL_INFO, TEST_TAG, "kept %u", index);
+    }
+    low_stop = RT_FALSE;
+    low_count = 0;
+    tid = rt_thread_create("ulog_low", _low_entry, RT_NULL, 512, RT_THREAD_PRIORITY_MAX - 1, 10);
+    uassert_not_null(tid);
+    rt_thread_startup(tid);
+    rt_thread_delay(RT_TICK_PER_SECOND / 10);
+    uassert_true(low_count > 0);
+
+    /* a starved thread does not get to stop either, do not wait for it forever */
+    low_stop = RT_TRUE;
+    for (index = 0; low_stop && index < RT_TICK_PER_SECOND; index++)
+    {
+        rt_thread_delay(1);
+    }
+    uassert_true(_read_records(_count_bytes, &bytes) >= 8);
+
+    ulog_bin_async_output_enabled(RT_TRUE);
+}
+#endif /* ULOG_ASYNC_OUTPUT_BY_THREAD */
+
+static void test_ulog_bin_bench(void)
+{
+    static struct ulog_backend null_backend;
+    ulog_backend_t console;
+    rt_uint64_t start, text_time = 0, bin_time = 0, drain_time = 0;
+    rt_uint32_t index, batch, text_bytes, bin_bytes = 0;
+
+    /* the formatted lines go to a backend that only counts them */
+    console = ulog_backend_find("console");
+    if (console)
+    {
+        ulog_backend_unregister(console);
+    }
+    null_backend.output = _null_output;
+    ulog_backend_register(&null_backend, "bin_null", RT_FALSE);
+    ulog_bin_async_output_enabled(RT_FALSE);
+
+    null_bytes = 0;
+    for (index = 0; index < BENCH_CALLS; index += BENCH_BATCH)
+    {
+        start = utest_bench_now();
+        for (batch = 0; batch < BENCH_BATCH; batch++)
+        {
+            ulog_output(LOG_LVL_INFO, TEST_TAG, RT_TRUE, "sensor %d: value %u, state %s", 3, index + batch, "ok");
+        }
+        ulog_flush();
+        text_time += utest_bench_now() - start;
+    }
+    text_bytes = null_bytes;
+
+    for (index = 0; index < BENCH_CALLS; index += BENCH_BATCH)
+    {
+        start = utest_bench_now();
+        for (batch = 0; batch < BENCH_BATCH; batch++)
+        {
+            ulog_bin_output(LOG_LVL_INFO, TEST_TAG, "sensor %d: value %u, state %s", 3, index + batch, "ok");
+        }
+        bin_time += utest_bench_now() - start;
+        _read_records(_count_bytes, &bin_bytes);
+    }
+
+    /* the same records formatted later, on the device */
+    ulog_bin_async_output_enabled(RT_TRUE);
+    null_bytes = 0;
+    for (index = 0; index < BENCH_CALLS; index += BENCH_BATCH)
+    {
+        for (batch = 0; batch < BENCH_BATCH; batch++)
+        {
+            ulog_bin_output(LOG_LVL_INFO, TEST_TAG, "sensor %d: value %u, state %s", 3, index + batch, "ok");
+        }
+        start = utest_bench_now();
+        ulog_bin_async_output();
+        drain_time += utest_bench_now() - start;
+    }
+    uassert_true(null_bytes > 0);
+
+    ulog_backend_unregister(&null_backend);
+    if (console)
+    {
+        ulog_backend_register(console, "console", console->support_color);
+    }
+
+#ifdef RT_USING_CPUTIME
+    LOG_I("text %u cyc/log, binary %u cyc/log, formatted later %u cyc/log",
+          (rt_uint32_t)(text_time / BENCH_CALLS), (rt_uint32_t)(bin_time / BENCH_CALLS),
+          (rt_uint32_t)(drain_time / BENCH_CALLS));
+#else
+    LOG_I("%u logs: text %u ticks, binary %u ticks, formatted later %u ticks", BENCH_CALLS,
+          (rt_uint32_t)text_time, (rt_uint32_t)bin_time, (rt_uint32_t)drain_time);
+#endif /* RT_USING_CPUTIME */
+    LOG_I("%u logs: text %u bytes, binary %u bytes (%u%%)", BENCH_CALLS,
+          text_bytes, bin_bytes, bin_bytes * 100 / text_bytes);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    ulog_bin_async_output_enabled(RT_TRUE);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_ulog_bin_format);
+    UTEST_UNIT_RUN(test_ulog_bin_isr);
+    UTEST_UNIT_RUN(test_ulog_bin_drop);
+#ifdef ULOG_ASYNC_OUTPUT_BY_THREAD
+    UTEST_UNIT_RUN(test_ulog_bin_kept);
+#endif /* ULOG_ASYNC_OUTPUT_BY_THREAD */
+    UTEST_UNIT_RUN(test_ulog_bin_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.utilities.ulog_bin_tc", utest_tc_init, utest_tc_cleanup, 20);
@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <dfs_fs.h>
+#include <dfs_file.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <ulog.h>
+#include <ulog_be.h>
+#include "utest.h"
+
+#define TEST_TAG        "ulog_file"
+#define DISK_NAME       "ulogdisk"
+#define DISK_SECTORS    256
+#define DISK_SECTOR     512
+#define MOUNT_PATH      "/ulogtc"
+#define LOG_DIR         MOUNT_PATH "/log"
+#define LOG_FILE        LOG_DIR "/tc.log"
+#define FILE_MAX_NUM    3
+#define FILE_MAX_SIZE   (16 * 1024)
+#define BUF_SIZE        1024
+#define LINE_LEN        32              /* "line 00000 ...\n" */
+#define ORDER_LINES     2000
+#define BENCH_BYTES     (32 * 1024)
+
+/* a FAT image in RAM, the writes to it are counted */
+static struct rt_device ram_disk;
+static rt_uint8_t *disk_data;
+static rt_uint32_t disk_writes;
+static struct ulog_file_be file_be;
+static char line[LINE_LEN + 1];
+
+static rt_ssize_t _disk_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    if (pos + size > DISK_SECTORS)
+    {
+        return 0;
+    }
+    rt_memcpy(buffer, disk_data + pos * DISK_SECTOR, size * DISK_SECTOR);
+
+    return size;
+}
+
+static rt_ssize_t _disk_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    if (pos + size > DISK_SECTORS)
+    {
+        return 0;
+    }
+    rt_memcpy(disk_data + pos * DISK_SECTOR, buffer, size * DISK_SECTOR);
+    disk_writes++;
+
+    return size;
+}
+
+static rt_err_t _disk_control(rt_device_t dev, int cmd, void *args)
+{
+    struct rt_device_blk_geometry *geometry;
+
+    if (cmd == RT_DEVICE_CTRL_BLK_GETGEOME)
+    {
+        geometry = (struct rt_device_blk_geometry *)args;
+        geometry->sector_count = DISK_SECTORS;
+        geometry->bytes_per_sector = DISK_SECTOR;
+        geometry->block_size = DISK_SECTOR;
+    }
+
+    return RT_EOK;
+}
+
+#ifdef RT_USING_DEVICE_OPS
+static const struct rt_device_ops ram_disk_ops =
+{
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+    _disk_read,
+    _disk_write,
+    _disk_control
+};
+#endif /* RT_USING_DEVICE_OPS */
+
+static rt_size_t _line_make(rt_uint32_t index)
+{
+    rt_snprintf(line, sizeof(line), "line %05u ........................\n", index);
+
+    return LINE_LEN;
+}
+
+static void _line_output(rt_uint32_t level, rt_uint32_t index)
+{
+    file_be.parent.output(&file_be.parent, level, TEST_TAG, RT_FALSE, line, _line_make(index));
+}
+
+static off_t _file_size(const char *path)
+{
+    struct stat buf;
+
+    return stat(path, &buf) == 0 ? buf.st_size : -1;
+}
+
+/* the line numbers in the files, from the oldest one: the next expected number, or -1 on a gap */
+static int _check_file(const char *path, int next)
+{
+    char buf[LINE_LEN];
+    rt_uint32_t value;
+    int fd, index;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return next;
+    }
+    /* the lines never cross a file, the buffers are whole lines */
+    while (next >= 0 && read(fd, buf, LINE_LEN) == LINE_LEN)
+    {
+        value = 0;
+        for (index = 5; index < 10; index++)
+        {
+            value = value * 10 + (buf[index] - '0');
+        }
+        if (next > 0 && (int)value != next)
+        {
+            next = -1;
+            break;
+        }
+        next = value + 1;
+    }
+    close(fd);
+
+    return next;
+}
+
+static void test_ulog_file_order(void)
+{
+    char path[32];
+    rt_uint32_t index;
+    int next = 0;
+
+    ulog_file_backend_set_flush(&file_be, 0, LOG_LVL_ASSERT);
+    for (index = 0; index < ORDER_LINES; index++)
+    {
+        _line_output(LOG_LVL_INFO, index);
+        /* the buffers are written before they overflow */
+        if (index % (BUF_SIZE / LINE_LEN) == 0)
+        {
+            file_be.parent.flush(&file_be.parent);
+        }
+    }
+    file_be.parent.flush(&file_be.parent);
+    uassert_int_equal(ulog_file_backend_dropped(&file_be), 0);
+
+    /* the oldest file first, the first lines are rotated out */
+    for (index = FILE_MAX_NUM - 1; index > 0; index--)
+    {
+        rt_snprintf(path, sizeof(path), LOG_DIR "/tc_%d.log", index - 1);
+        uassert_true(_file_size(path) <= FILE_MAX_SIZE);
+        next = _check_file(path, next);
+    }
+    next = _check_file(LOG_FILE, next);
+    uassert_int_equal(next, ORDER_LINES);
+}
+
+static void test_ulog_file_level(void)
+{
+    off_t size;
+
+    /* an info log stays in the buffer */
+    ulog_file_backend_set_flush(&file_be, 0, LOG_LVL_ERROR);
+    size = _file_size(LOG_FILE);
+    _line_output(LOG_LVL_INFO, 0);
+    rt_thread_mdelay(100);
+    uassert_int_equal(_file_size(LOG_FILE), size);
+
+    /* an error log takes it to the file */
+    _line_output(LOG_LVL_ERROR, 1);
+    rt_thread_mdelay(100);
+    uassert_int_equal(_file_size(LOG_FILE), size + LINE_LEN * 2);
+
+    /* the period writes an info log */
+    ulog_file_backend_set_flush(&file_be, 50, LOG_LVL_ERROR);
+    file_be.parent.flush(&file_be.parent);
+    size = _file_size(LOG_FILE);
+    _line_output(LOG_LVL_INFO, 2);
+    rt_thread_mdelay(200);
+    uassert_int_equal(_file_size(LOG_FILE), size + LINE_LEN);
+}
+
+static void test_ulog_file_drop(void)
+{
+    rt_size_t dropped;
+    rt_uint32_t index;
+
+    /* the flush thread has a lower priority, the buffers fill up */
+    ulog_file_backend_set_flush(&file_be, 0, LOG_LVL_ASSERT);
+    dropped = ulog_file_backend_dropped(&file_be);
+    for (index = 0; index < ULOG_FILE_BE_BUF_NUM * BUF_SIZE / LINE_LEN * 2; index++)
+    {
+        _line_output(LOG_LVL_INFO, index);
+    }
+    uassert_true(ulog_file_backend_dropped(&file_be) > dropped);
+    file_be.parent.flush(&file_be.parent);
+}
+
+static void test_ulog_file_bench(void)
+{
+    rt_uint64_t start, buf_time, line_time;
+    rt_uint32_t index, buf_writes, line_writes;
+    rt_size_t dropped;
+    int fd;
+
+    /* the producer waits for the flush thread once the buffers it may fill are full */
+    ulog_file_backend_set_flush(&file_be, 0, LOG_LVL_ASSERT);
+    file_be.parent.flush(&file_be.parent);
+    dropped = ulog_file_backend_dropped(&file_be);
+    disk_writes = 0;
+    start = utest_bench_now();
+    for (index = 0; index < BENCH_BYTES / LINE_LEN; index++)
+    {
+        _line_output(LOG_LVL_INFO, index);
+        if ((index + 1) % ((ULOG_FILE_BE_BUF_NUM - 1) * BUF_SIZE / LINE_LEN) == 0)
+        {
+            file_be.parent.flush(&file_be.parent);
+        }
+    }
+    file_be.parent.flush(&file_be.parent);
+    buf_time = utest_bench_now() - start;
+    buf_writes = disk_writes;
+    uassert_int_equal(ulog_file_backend_dropped(&file_be), dropped);
+
+    /* the file written through line by line, as the backend did before */
+    fd = open(MOUNT_PATH "/line.log", O_CREAT | O_RDWR | O_APPEND);
+    uassert_true(fd >= 0);
+    if (fd < 0)
+    {
+        return;
+    }
+    disk_writes = 0;
+    start = utest_bench_now();
+    for (index = 0; index < BENCH_BYTES / LINE_LEN; index++)
+    {
+        write(fd, line, _line_make(index));
+        fsync(fd);
+    }
+    line_time = utest_bench_now() - start;
+    line_writes = disk_writes;
+    close(fd);
+    unlink(MOUNT_PATH "/line.log");
+    uassert_true(buf_writes < line_writes);
+
+#ifdef RT_USING_CPUTIME
+    LOG_I("%u bytes: buffered %u cyc/KB, %u disk writes; line by line %u cyc/KB, %u disk writes", BENCH_BYTES,
+          (rt_uint32_t)(buf_time * 1024 / BENCH_BYTES), buf_writes, (rt_uint32_t)(line_time * 1024 / BENCH_BYTES), line_writes);
+#else
+    LOG_I("%u bytes: buffered %u ticks, %u disk writes; line by line %u ticks, %u disk writes", BENCH_BYTES,
+          (rt_uint32_t)buf_time, buf_writes, (rt_uint32_t)line_time, line_writes);
+#endif /* RT_USING_CPUTIME */
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    disk_data = rt_malloc(DISK_SECTORS * DISK_SECTOR);
+    if (disk_data == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+    rt_memset(disk_data, 0, DISK_SECTORS * DISK_SECTOR);
+
+    ram_disk.type = RT_Device_Class_Block;
+#ifdef RT_USING_DEVICE_OPS
+    ram_disk.ops = &ram_disk_ops;
+#else
+    ram_disk.read = _disk_read;
+    ram_disk.write = _disk_write;
+    ram_disk.control = _disk_control;
+#endif /* RT_USING_DEVICE_OPS */
+    if (rt_device_register(&ram_disk, DISK_NAME, RT_DEVICE_FLAG_RDWR) != RT_EOK)
+    {
+        goto __free;
+    }
+    mkdir(MOUNT_PATH, 0);
+    if (dfs_mkfs("elm", DISK_NAME) != 0 || dfs_mount(DISK_NAME, MOUNT_PATH, "elm", 0, 0) != 0)
+    {
+        goto __unregister;
+    }
+
+    if (ulog_file_backend_init(&file_be, "tc", LOG_DIR, FILE_MAX_NUM, FILE_MAX_SIZE, BUF_SIZE) != RT_EOK)
+    {
+        dfs_unmount(MOUNT_PATH);
+        goto __unregister;
+    }
+    /* the test writes the backend directly, the logs of the system stay out of the image */
+    ulog_backend_unregister(&file_be.parent);
+    ulog_file_backend_enable(&file_be);
+
+    return RT_EOK;
+
+__unregister:
+    rt_device_unregister(&ram_disk);
+__free:
+    rt_free(disk_data);
+    return -RT_ERROR;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    ulog_file_backend_deinit(&file_be);
+    dfs_unmount(MOUNT_PATH);
+    rmdir(MOUNT_PATH);
+    rt_device_unregister(&ram_disk);
+    rt_free(disk_data);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_ulog_file_order);
+    UTEST_UNIT_RUN(test_ulog_file_level);
+    UTEST_UNIT_RUN(test_ulog_file_drop);
+    UTEST_UNIT_RUN(test_ulog_file_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.utilities.ulog_file_tc", utest_tc_init, utest_tc_cleanup, 60);
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include <ulog.h>
+#include "utest.h"
+
+#define TAG_NR          50
+#define TAG_PREFIX      "ulog_tc."
+#define BENCH_CALLS     1000
+
+static char tags[TAG_NR][16];
+static const char *free_tag = TAG_PREFIX "free";
+static struct ulog_backend null_backend;
+static rt_uint32_t null_lines;
+static char null_last[ULOG_LINE_BUF_SIZE + 1];
+
+/* counts the lines of this test */
+static void _null_output(struct ulog_backend *backend, rt_uint32_t level, const char *tag, rt_bool_t is_raw,
+                         const char *log, rt_size_t len)
+{
+    if (rt_strncmp(tag, TAG_PREFIX, sizeof(TAG_PREFIX) - 1) != 0)
+    {
+        return;
+    }
+    null_lines++;
+    if (len > ULOG_LINE_BUF_SIZE)
+    {
+        len = ULOG_LINE_BUF_SIZE;
+    }
+    rt_memcpy(null_last, log, len);
+    null_last[len] = '\0';
+}
+
+/* the level of the configured tag 'index' */
+static rt_uint32_t _tag_level(int index)
+{
+    static const rt_uint32_t levels[] = {LOG_LVL_ERROR, LOG_LVL_WARNING, LOG_LVL_INFO, LOG_FILTER_LVL_SILENT};
+
+    return levels[index % (sizeof(levels) / sizeof(levels[0]))];
+}
+
+static void test_ulog_filter_tags(void)
+{
+    rt_slist_t *node;
+    char copy[16];
+    int index;
+
+    for (index = 0; index < TAG_NR; index++)
+    {
+        /* the first lookup fills the cache, the second one hits it */
+        uassert_int_equal(ulog_tag_lvl_filter_get(tags[index]), _tag_level(index));
+        uassert_int_equal(ulog_tag_lvl_filter_get(tags[index]), _tag_level(index));
+    }
+    uassert_int_equal(ulog_tag_lvl_filter_get(free_tag), LOG_FILTER_LVL_ALL);
+
+    /* another buffer with the same tag finds the same filter */
+    rt_strcpy(copy, tags[1]);
+    uassert_int_equal(ulog_tag_lvl_filter_get(copy), _tag_level(1));
+    /* and once reused for other tags it does not keep that level */
+    rt_strcpy(copy, tags[2]);
+    uassert_int_equal(ulog_tag_lvl_filter_get(copy), _tag_level(2));
+    rt_strcpy(copy, free_tag);
+    uassert_int_equal(ulog_tag_lvl_filter_get(copy), LOG_FILTER_LVL_ALL);
+
+    /* a change is seen through the cache */
+    ulog_tag_lvl_filter_set(tags[0], LOG_LVL_DBG);
+    uassert_int_equal(ulog_tag_lvl_filter_get(tags[0]), LOG_LVL_DBG);
+    ulog_tag_lvl_filter_set(tags[0], LOG_FILTER_LVL_ALL);
+    uassert_int_equal(ulog_tag_lvl_filter_get(tags[0]), LOG_FILTER_LVL_ALL);
+    ulog_tag_lvl_filter_set(tags[0], _tag_level(0));
+    uassert_int_equal(ulog_tag_lvl_filter_get(tags[0]), _tag_level(0));
+    uassert_int_equal(ulog_tag_lvl_filter_get(tags[1]), _tag_level(1));
+
+    /* the list holds every filter once */
+    index = 0;
+    for (node = rt_slist_first(ulog_tag_lvl_list_get()); node; node = rt_slist_next(node))
+    {
+        if (rt_strncmp(rt_slist_entry(node, struct ulog_tag_lvl_filter, list)->tag, TAG_PREFIX, sizeof(TAG_PREFIX) - 1) == 0)
+        {
+            index++;
+        }
+    }
+    uassert_int_equal(index, TAG_NR);
+}
+
+static void test_ulog_filter_output(void)
+{
+#ifdef ULOG_USING_RATE_LIMIT
+    ulog_rate_limit_set(0, 0);
+#endif /* ULOG_USING_RATE_LIMIT */
+
+    null_lines = 0;
+    /* error passes, warning does not */
+    ulog_output(LOG_LVL_ERROR, tags[0], RT_TRUE, "pass");
+    ulog_output(LOG_LVL_WARNING, tags[0], RT_TRUE, "drop");
+    /* silent */
+    ulog_output(LOG_LVL_ERROR, tags[3], RT_TRUE, "drop");
+    ulog_output(LOG_LVL_DBG, free_tag, RT_TRUE, "pass");
+    ulog_flush();
+    uassert_int_equal(null_lines, 2);
+
+#ifdef ULOG_USING_RATE_LIMIT
+    ulog_rate_limit_set(ULOG_RATE_LIMIT_RATE, ULOG_RATE_LIMIT_BURST);
+#endif /* ULOG_USING_RATE_LIMIT */
+}
+
+#ifdef ULOG_USING_RATE_LIMIT
+static void test_ulog_rate_limit(void)
+{
+    char tag[16];
+    int index;
+
+    /* one log per second after a burst of 5 */
+    ulog_rate_limit_set(1, 5);
+    null_lines = 0;
+    rt_strcpy(tag, free_tag);
+    for (index = 0; index < 20; index++)
+    {
+        ulog_output(LOG_LVL_INFO, tag, RT_TRUE, "flood %d", index);
+    }
+    ulog_flush();
+    uassert_int_equal(null_lines, 5);
+    /* the report does not depend on the buffer of the tag */
+    rt_memset(tag, 0, sizeof(tag));
+
+    /* the count comes out once the tag has a token again */
+    rt_thread_delay(RT_TICK_PER_SECOND + 1);
+    ulog_flush();
+    uassert_int_equal(null_lines, 6);
+    uassert_not_null(rt_strstr(null_last, "15 logs suppressed"));
+
+    /* the assert level is never suppressed */
+    ulog_output(LOG_LVL_ASSERT, free_tag, RT_TRUE, "assert");
+    ulog_output(LOG_LVL_ASSERT, free_tag, RT_TRUE, "assert");
+    ulog_flush();
+    uassert_int_equal(null_lines, 8);
+
+    ulog_rate_limit_set(ULOG_RATE_LIMIT_RATE, ULOG_RATE_LIMIT_BURST);
+}
+#endif /* ULOG_USING_RATE_LIMIT */
+
+/* the lookup before the hashed table: a walk of the list with a compare for each tag */
+static rt_uint32_t _list_lookup(const char *tag)
+{
+    rt_slist_t *node;
+    ulog_tag_lvl_filter_t tag_lvl;
+
+    for (node = rt_slist_first(ulog_tag_lvl_list_get()); node; node = rt_slist_next(node))
+    {
+        tag_lvl = rt_slist_entry(node, struct ulog_tag_lvl_filter, list);
+        if (!rt_strncmp(tag_lvl->tag, tag, ULOG_FILTER_TAG_MAX_LEN))
+        {
+            return tag_lvl->level;
+        }
+    }
+
+    return LOG_FILTER_LVL_ALL;
+}
+
+enum bench_case
+{
+    BENCH_LIST,
+    BENCH_HASH,
+    BENCH_SILENT,
+    BENCH_OUTPUT,
+    BENCH_CASE_NR
+};
+
+static const char *const bench_names[BENCH_CASE_NR] =
+{
+    "list walk without lock",
+    "hashed lookup",
+    "filtered log call",
+    "log call to null backend",
+};
+
+static rt_uint64_t _bench_one(enum bench_case which)
+{
+    volatile rt_uint32_t sink = 0;
+    rt_uint64_t start;
+    int call;
+
+    start = utest_bench_now();
+    for (call = 0; call < BENCH_CALLS; call++)
+    {
+        switch (which)
+        {
+        case BENCH_LIST:
+            sink += _list_lookup(tags[call % TAG_NR]);
+            break;
+        case BENCH_HASH:
+            sink += ulog_tag_lvl_filter_get(tags[call % TAG_NR]);
+            break;
+        case BENCH_SILENT:
+            /* tag 3 is silent, the call ends at the filter */
+            ulog_output(LOG_LVL_INFO, tags[3], RT_TRUE, "value %d", call);
+            break;
+        default:
+            ulog_output(LOG_LVL_ERROR, tags[call % 3], RT_TRUE, "value %d", call);
+            break;
+        }
+    }
+    RT_UNUSED(sink);
+
+    return utest_bench_now() - start;
+}
+
+static void test_ulog_filter_bench(void)
+{
+    rt_uint64_t elapsed[BENCH_CASE_NR];
+    ulog_backend_t console;
+    int which;
+
+    /* the lines of the benchmark only go to the null backend */
+    console = ulog_backend_find("console");
+    if (console)
+    {
+        ulog_backend_unregister(console);
+    }
+#ifdef ULOG_USING_RATE_LIMIT
+    ulog_rate_limit_set(0, 0);
+#endif /* ULOG_USING_RATE_LIMIT */
+
+    for (which = 0; which < BENCH_CASE_NR; which++)
+    {
+        elapsed[which] = _bench_one((enum bench_case)which);
+        ulog_flush();
+    }
+
+#ifdef ULOG_USING_RATE_LIMIT
+    ulog_rate_limit_set(ULOG_RATE_LIMIT_RATE, ULOG_RATE_LIMIT_BURST);
+#endif /* ULOG_USING_RATE_LIMIT */
+    if (console)
+    {
+        ulog_backend_register(console, "console", console->support_color);
+    }
+
+    for (which = 0; which < BENCH_CASE_NR; which++)
+    {
+#ifdef RT_USING_CPUTIME
+        LOG_I("%d tags, %-24s: %u cyc/call", TAG_NR, bench_names[which], (rt_uint32_t)(elapsed[which] / BENCH_CALLS));
+#else
+        LOG_I("%d tags, %-24s: %u ticks/%d calls", TAG_NR, bench_names[which], (rt_uint32_t)elapsed[which], BENCH_CALLS);
+#endif /* RT_USING_CPUTIME */
+    }
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    int index;
+
+    for (index = 0; index < TAG_NR; index++)
+    {
+        rt_snprintf(tags[index], sizeof(tags[index]), TAG_PREFIX "%02d", index);
+        if (ulog_tag_lvl_filter_set(tags[index], _tag_level(index)) != RT_EOK)
+        {
+            return -RT_ENOMEM;
+        }
+    }
+
+    null_backend.output = _null_output;
+    ulog_backend_register(&null_backend, "tc_null", RT_FALSE);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    int index;
+
+    ulog_flush();
+    ulog_backend_unregister(&null_backend);
+
+    for (index = 0; index < TAG_NR; index++)
+    {
+        ulog_tag_lvl_filter_set(tags[index], LOG_FILTER_LVL_ALL);
+    }
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_ulog_filter_tags);
+    UTEST_UNIT_RUN(test_ulog_filter_output);
+#ifdef ULOG_USING_RATE_LIMIT
+    UTEST_UNIT_RUN(test_ulog_rate_limit);
+#endif /* ULOG_USING_RATE_LIMIT */
+    UTEST_UNIT_RUN(test_ulog_filter_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.utilities.ulog_filter_tc", utest_tc_init, utest_tc_cleanup, 20);
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <ymodem.h>
+#include <crc.h>
+#include <stdlib.h>
+#include "utest.h"
+
+/* the receiver on sloop0, a minimal sender on sloop1 */
+#define TC_RECV_NAME    "sloop0"
+#define TC_SEND_NAME    "sloop1"
+#define TC_BAUD         BAUD_RATE_921600
+#define TC_BUFSZ        256
+#define FILE_LEN        (32 * 1024 + 77)
+/* about the time to program 1 KB of NOR flash */
+#define WRITE_MS        10
+#define SEND_TIMEOUT    3000
+
+#define FILE_DATA(off)  ((rt_uint8_t)((off) * 7 + ((off) >> 8)))
+
+static struct rt_serial_loop *recv_port, *send_port;
+static rt_sem_t send_done;
+static rt_err_t send_result;
+static rt_uint8_t send_pkt[1 + 2 + 1024 + 2];
+static rt_uint32_t recv_len, recv_errors, recv_cancel_at, recv_flen;
+static rt_bool_t recv_end_cancel;
+
+static int _send_getc(rt_device_t dev)
+{
+    rt_tick_t start = rt_tick_get();
+    rt_uint8_t code;
+
+    while (rt_device_read(dev, 0, &code, 1) != 1)
+    {
+        if (rt_tick_get() - start > rt_tick_from_millisecond(SEND_TIMEOUT))
+        {
+            return -1;
+        }
+        rt_thread_mdelay(1);
+    }
+
+    return code;
+}
+
+static void _send_putc(rt_device_t dev, rt_uint8_t code)
+{
+    rt_device_write(dev, 0, &code, 1);
+}
+
+static void _send_packet(rt_device_t dev, rt_uint8_t code, rt_uint8_t seq, rt_size_t data_sz)
+{
+    rt_uint16_t crc = rt_crc16(0, send_pkt + 3, data_sz);
+
+    send_pkt[0] = code;
+    send_pkt[1] = seq;
+    send_pkt[2] = (rt_uint8_t)~seq;
+    send_pkt[3 + data_sz] = (rt_uint8_t)(crc >> 8);
+    send_pkt[4 + data_sz] = (rt_uint8_t)crc;
+    rt_device_write(dev, 0, send_pkt, data_sz + 5);
+}
+
+/* the sender side of ymodem, waiting for the answer of each packet as sz does */
+static rt_err_t _send_file(rt_device_t dev)
+{
+    rt_uint32_t off, index;
+    rt_uint8_t seq = 1;
+    int code;
+
+    if (_send_getc(dev) != RYM_CODE_C)
+        return -RT_ETIMEOUT;
+    rt_memset(send_pkt, 0, sizeof(send_pkt));
+    index = rt_sprintf((char *)send_pkt + 3, "ymodem_tc.bin");
+    rt_sprintf((char *)send_pkt + 3 + index + 1, "%d", FILE_LEN);
+    _send_packet(dev, RYM_CODE_SOH, 0, 128);
+    if (_send_getc(dev) != RYM_CODE_ACK || _send_getc(dev) != RYM_CODE_C)
+        return -RT_ERROR;
+
+    for (off = 0; off < FILE_LEN; off += 1024, seq++)
+    {
+        for (index = 0; index < 1024; index++)
+        {
+            send_pkt[3 + index] = off + index < FILE_LEN ? FILE_DATA(off + index) : 0x1A;
+        }
+        _send_packet(dev, RYM_CODE_STX, seq, 1024);
+        code = _send_getc(dev);
+        if (code == RYM_CODE_CAN)
+            return -RT_EINTR;
+        if (code != RYM_CODE_ACK)
+            return -RT_ERROR;
+    }
+
+    _send_putc(dev, RYM_CODE_EOT);
+    code = _send_getc(dev);
+    if (code == RYM_CODE_CAN)
+        return -RT_EINTR;
+    if (code != RYM_CODE_NAK)
+        return -RT_ERROR;
+    _send_putc(dev, RYM_CODE_EOT);
+    if (_send_getc(dev) != RYM_CODE_ACK || _send_getc(dev) != RYM_CODE_C)
+        return -RT_ERROR;
+
+    /* no more file */
+    rt_memset(send_pkt, 0, sizeof(send_pkt));
+    _send_packet(dev, RYM_CODE_SOH, 0, 128);
+    if (_send_getc(dev) != RYM_CODE_ACK)
+        return -RT_ERROR;
+
+    return RT_EOK;
+}
+
+static void send_entry(void *parameter)
+{
+    rt_device_t dev = &send_port->serial.parent;
+
+    send_result = rt_device_open(dev, RT_DEVICE_FLAG_RX_NON_BLOCKING | RT_DEVICE_FLAG_TX_BLOCKING);
+    if (send_result == RT_EOK)
+    {
+        send_result = _send_file(dev);
+        rt_device_close(dev);
+    }
+    rt_sem_release(send_done);
+}
+
+static enum rym_code _recv_begin(struct rym_ctx *ctx, rt_uint8_t *buf, rt_size_t len)
+{
+    recv_flen = (rt_uint32_t)atoi(1 + (const char *)buf + rt_strnlen((const char *)buf, len - 1));
+    recv_len = 0;
+
+    return RYM_CODE_ACK;
+}
+
+/* checks the data, then takes as long as a flash write */
+static enum rym_code _recv_data(struct rym_ctx *ctx, rt_uint8_t *buf, rt_size_t len)
+{
+    rt_size_t index;
+
+    if (recv_cancel_at && recv_len >= recv_cancel_at)
+        return RYM_CODE_CAN;
+
+    for (index = 0; index < len && recv_len < recv_flen; index++, recv_len++)
+    {
+        if (buf[index] != FILE_DATA(recv_len))
+        {
+            recv_errors++;
+        }
+    }
+    rt_thread_mdelay(WRITE_MS);
+
+    return RYM_CODE_ACK;
+}
+
+static enum rym_code _recv_end(struct rym_ctx *ctx, rt_uint8_t *buf, rt_size_t len)
+{
+    return recv_end_cancel ? RYM_CODE_CAN : RYM_CODE_ACK;
+}
+
+/* returns the time of the transfer, 0 on an error */
+static rt_uint64_t ymodem_transfer(rt_bool_t pipelined, rt_uint32_t cancel_at, rt_err_t *result)
+{
+    struct serial_configure config = RT_SERIAL_CONFIG_DEFAULT;
+    struct rym_ctx *ctx;
+    rt_thread_t sender;
+    rt_uint64_t start, elapsed;
+
+    config.baud_rate = TC_BAUD;
+    config.rx_bufsz = TC_BUFSZ;
+    config.tx_bufsz = TC_BUFSZ;
+    rt_device_control(&recv_port->serial.parent, RT_DEVICE_CTRL_CONFIG, &config);
+    rt_device_control(&send_port->serial.parent, RT_DEVICE_CTRL_CONFIG, &config);
+
+    ctx = rt_malloc(sizeof(*ctx));
+    sender = rt_thread_create("ym_send", send_entry, RT_NULL, 2048,
+                              RT_SCHED_PRIV(rt_thread_self()).current_priority, 10);
+    if (ctx == RT_NULL || sender == RT_NULL)
+    {
+        rt_free(ctx);
+        if (sender)
+            rt_thread_delete(sender);
+        *result = -RT_ENOMEM;
+        return 0;
+    }
+    recv_errors = 0;
+    recv_cancel_at = cancel_at;
+    rt_thread_startup(sender);
+
+    start = utest_bench_now();
+#ifdef YMODEM_USING_PIPELINE
+    if (pipelined)
+        *result = rym_recv_on_device_pipelined(ctx, &recv_port->serial.parent, RT_DEVICE_OFLAG_RDWR | RT_DEVICE_FLAG_INT_RX,
+                                               _recv_begin, _recv_data, _recv_end, 5);
+    else
+#endif /* YMODEM_USING_PIPELINE */
+        *result = rym_recv_on_device(ctx, &recv_port->serial.parent, RT_DEVICE_OFLAG_RDWR | RT_DEVICE_FLAG_INT_RX,
+                                     _recv_begin, _recv_data, _recv_end, 5);
+    elapsed = utest_bench_now() - start;
+    rt_sem_take(send_done, RT_WAITING_FOREVER);
+    rt_free(ctx);
+
+    return elapsed ? elapsed : 1;
+}
+
+static void test_ymodem_recv(void)
+{
+    rt_uint64_t serial_time, pipe_time = 0;
+    rt_err_t result;
+
+    serial_time = ymodem_transfer(RT_FALSE, 0, &result);
+    uassert_int_equal(result, RT_EOK);
+    uassert_int_equal(send_result, RT_EOK);
+    uassert_int_equal(recv_len, FILE_LEN);
+    uassert_int_equal(recv_errors, 0);
+
+#ifdef YMODEM_USING_PIPELINE
+    pipe_time = ymodem_transfer(RT_TRUE, 0, &result);
+    uassert_int_equal(result, RT_EOK);
+    uassert_int_equal(send_result, RT_EOK);
+    uassert_int_equal(recv_len, FILE_LEN);
+    uassert_int_equal(recv_errors, 0);
+#ifdef RT_USING_CPUTIME
+    /* the writes overlap the transfer */
+    uassert_true(pipe_time < serial_time);
+#endif /* RT_USING_CPUTIME */
+#endif /* YMODEM_USING_PIPELINE */
+
+    LOG_I("%d bytes at %d baud, %d ms per 1K write: serial %u B/s, pipelined %u B/s, link %u B/s",
+          FILE_LEN, TC_BAUD, WRITE_MS,
+          (rt_uint32_t)((rt_uint64_t)FILE_LEN * 1000000 / utest_bench_us(serial_time)),
+          pipe_time ? (rt_uint32_t)((rt_uint64_t)FILE_LEN * 1000000 / utest_bench_us(pipe_time)) : 0,
+          TC_BAUD / 10);
+}
+
+/* the last data not saved by on_end cancels the session */
+static void test_ymodem_recv_end_cancel(void)
+{
+    rt_err_t result;
+
+    recv_end_cancel = RT_TRUE;
+    ymodem_transfer(RT_FALSE, 0, &result);
+    recv_end_cancel = RT_FALSE;
+    uassert_int_equal(result, -RYM_ERR_CAN);
+    uassert_int_equal(send_result, -RT_EINTR);
+    uassert_int_equal(recv_len, FILE_LEN);
+    uassert_int_equal(recv_errors, 0);
+}
+
+#ifdef YMODEM_USING_PIPELINE
+/* a failed write cancels the session, the packet in flight was ACKed already */
+static void test_ymodem_recv_cancel(void)
+{
+    rt_err_t result;
+
+    ymodem_transfer(RT_TRUE, 8 * 1024, &result);
+    uassert_int_equal(result, -RYM_ERR_CAN);
+    uassert_int_equal(send_result, -RT_EINTR);
+    uassert_int_equal(recv_len, 8 * 1024);
+    uassert_int_equal(recv_errors, 0);
+}
+#endif /* YMODEM_USING_PIPELINE */
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_device_t recv_dev, send_dev;
+
+    recv_dev = rt_device_find(TC_RECV_NAME);
+    send_dev = rt_device_find(TC_SEND_NAME);
+    if (recv_dev == RT_NULL || send_dev == RT_NULL)
+    {
+        LOG_E("find %s or %s device failed!", TC_RECV_NAME, TC_SEND_NAME);
+        return -RT_ERROR;
+    }
+    recv_port = rt_container_of(recv_dev, struct rt_serial_loop, serial.parent);
+    send_port = rt_container_of(send_dev, struct rt_serial_loop, serial.parent);
+
+    send_done = rt_sem_create("ym_done", 0, RT_IPC_FLAG_PRIO);
+    if (send_done == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+    rt_serial_loop_connect(recv_port, send_port);
+    rt_serial_loop_connect(send_port, recv_port);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+#ifndef RT_SERIAL_LOOPBACK_PAIRED
+    rt_serial_loop_connect(recv_port, RT_NULL);
+    rt_serial_loop_connect(send_port, RT_NULL);
+#endif /* RT_SERIAL_LOOPBACK_PAIRED */
+    rt_sem_delete(send_done);
+    send_done = RT_NULL;
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_ymodem_recv);
+    UTEST_UNIT_RUN(test_ymodem_recv_end_cancel);
+#ifdef YMODEM_USING_PIPELINE
+    UTEST_UNIT_RUN(test_ymodem_recv_cancel);
+#endif /* YMODEM_USING_PIPELINE */
+}
+UTEST_TC_EXPORT(testcase, "testcases.utilities.ymodem_tc", utest_tc_init, utest_tc_cleanup, 30);
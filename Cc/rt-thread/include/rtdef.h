@@ -110,6 +110,8 @@ extern "C" {
 #define RT_SEM_VALUE_MAX                RT_UINT16_MAX   /**< Maximum number of semaphore .value */
 #define RT_MUTEX_VALUE_MAX              RT_UINT16_MAX   /**< Maximum number of mutex .value */
 #define RT_MUTEX_HOLD_MAX               RT_UINT8_MAX    /**< Maximum number of mutex .hold */
+#define RT_SEM_FAST_WAITERS             (RT_SEM_VALUE_MAX + 1)  /**< Semaphore .value flag of pended threads */
+#define RT_MUTEX_FAST_SLOW              1               /**< Mutex .fast_owner of the slow path */
 #define RT_MB_ENTRY_MAX                 RT_UINT16_MAX   /**< Maximum number of mailbox .entry */
 #define RT_MQ_ENTRY_MAX                 RT_UINT16_MAX   /**< Maximum number of message queue .entry */
 
@@ -201,6 +203,13 @@ typedef int (*init_fn_t)(void);
 
 /* init after mount fs */
 #define INIT_FS_EXPORT(fn)              INIT_EXPORT(fn, "6.0")
+
+/* deferred init routines run after all of the levels above, in a background
+ * thread after main() starts with RT_USING_INIT_DEFERRED, in the same level order */
+#define INIT_DEFERRED_DEVICE_EXPORT(fn)     INIT_EXPORT(fn, "6.x.3")
+#define INIT_DEFERRED_COMPONENT_EXPORT(fn)  INIT_EXPORT(fn, "6.x.4")
+#define INIT_DEFERRED_ENV_EXPORT(fn)        INIT_EXPORT(fn, "6.x.5")
+#define INIT_DEFERRED_APP_EXPORT(fn)        INIT_EXPORT(fn, "6.x.6")
 /* init in secondary_cpu_c_start */
 #define INIT_SECONDARY_CPU_EXPORT(fn)   INIT_EXPORT(fn, "7")
 
@@ -350,6 +359,10 @@ struct rt_object
 #endif /* RT_USING_SMART */
 
     rt_list_t   list;                                    /**< list node of kernel object */
+
+#ifdef RT_USING_OBJECT_HASH
+    struct rt_object *hash_next;                         /**< next object in the same name hash bucket */
+#endif /* RT_USING_OBJECT_HASH */
 };
 typedef struct rt_object *rt_object_t;                   /**< Type for kernel objects. */
 
@@ -876,6 +889,9 @@ struct rt_thread
     /* object for IPC */
     rt_list_t                   taken_object_list;
     rt_object_t                 pending_object;
+#ifdef RT_USING_IPC_FAST_PATH
+    rt_list_t                   fast_taken_list;        /**< mutexes taken by the fast path */
+#endif /* RT_USING_IPC_FAST_PATH */
 #endif /* RT_USING_MUTEX */
 
 #ifdef RT_USING_EVENT
@@ -996,7 +1012,11 @@ struct rt_semaphore
 {
     struct rt_ipc_object parent;                        /**< inherit from ipc_object */
 
+#ifdef RT_USING_IPC_FAST_PATH
+    rt_atomic_t          value;                         /**< value of semaphore, RT_SEM_FAST_WAITERS when pended */
+#else
     rt_uint16_t          value;                         /**< value of semaphore. */
+#endif /* RT_USING_IPC_FAST_PATH */
     rt_uint16_t          max_value;
     struct rt_spinlock   spinlock;
 };
@@ -1019,6 +1039,10 @@ struct rt_mutex
     struct rt_thread    *owner;                         /**< current owner of mutex */
     rt_list_t            taken_list;                    /**< the object list taken by thread */
     struct rt_spinlock   spinlock;
+#ifdef RT_USING_IPC_FAST_PATH
+    rt_atomic_t          fast_owner;                    /**< owner taken by fast path, RT_MUTEX_FAST_SLOW if contended */
+    rt_list_t            fast_list;                     /**< the fast taken list of the owner */
+#endif /* RT_USING_IPC_FAST_PATH */
 };
 typedef struct rt_mutex *rt_mutex_t;
 #endif /* RT_USING_MUTEX */
@@ -1113,6 +1137,47 @@ struct rt_memory
     rt_size_t               max;                    /**< maximum usage */
 };
 typedef struct rt_memory *rt_mem_t;
+
+#ifdef RT_USING_HEAP_CACHE
+/*
+ * statistics of a size class of the heap cache
+ */
+struct rt_heap_cache_stat
+{
+    rt_size_t               size;                   /**< block size of the class */
+    rt_uint32_t             cached;                 /**< blocks held by the cache */
+    rt_uint32_t             hits;                   /**< allocations served by the cache */
+    rt_uint32_t             misses;                 /**< allocations refilling the cache */
+    rt_uint32_t             drains;                 /**< batches given back to the heap */
+};
+#endif /* RT_USING_HEAP_CACHE */
+
+/*
+ * placement hints of rt_malloc_hint()
+ */
+#define RT_MEM_FAST                     0x01        /**< fast memory for hot buffers, e.g. DTCM or AXI SRAM */
+#define RT_MEM_DMA                      0x02        /**< memory the DMA masters can reach */
+#define RT_MEM_BULK                     0x04        /**< large and slow memory, e.g. PSRAM */
+#define RT_MEM_CLASS_NR                 3           /**< number of the class bits above */
+#define RT_MEM_CLASS_MASK               0xff
+#define RT_MEM_STRICT                   0x100       /**< fail instead of falling back to another heap */
+#define RT_MEM_FALLBACK                 0x200       /**< fall back even with RT_MEMHEAP_HINT_STRICT */
+
+#ifdef RT_USING_MEMHEAP_HINT
+/*
+ * statistics of a memory class
+ */
+struct rt_mem_class_stat
+{
+    rt_uint32_t             heaps;                  /**< number of heaps of the class */
+    rt_size_t               total;                  /**< size of these heaps */
+    rt_size_t               used;                   /**< bytes in use in these heaps */
+    rt_size_t               max_used;               /**< maximum usage, summed over these heaps */
+    rt_uint32_t             allocs;                 /**< hinted allocations placed in the class */
+    rt_uint32_t             fallbacks;              /**< hinted allocations placed elsewhere */
+    rt_uint32_t             failures;               /**< hinted allocations which failed */
+};
+#endif /* RT_USING_MEMHEAP_HINT */
 #endif /* RT_USING_HEAP */
 
 /*
@@ -1128,6 +1193,10 @@ typedef rt_mem_t rt_smem_t;
 typedef rt_mem_t rt_slab_t;
 #endif /* RT_USING_SLAB */
 
+#ifdef RT_USING_TLSF
+typedef rt_mem_t rt_tlsf_t;
+#endif /* RT_USING_TLSF */
+
 #ifdef RT_USING_MEMHEAP
 /**
  * memory item on the heap
@@ -1167,6 +1236,9 @@ struct rt_memheap
 
     struct rt_semaphore     lock;                       /**< semaphore lock */
     rt_bool_t               locked;                     /**< External lock mark */
+#ifdef RT_USING_MEMHEAP_HINT
+    rt_uint32_t             mem_class;                  /**< RT_MEM_* classes of the memory */
+#endif /* RT_USING_MEMHEAP_HINT */
 };
 #endif /* RT_USING_MEMHEAP */
 
@@ -1191,6 +1263,40 @@ struct rt_mempool
     struct rt_spinlock  spinlock;
 };
 typedef struct rt_mempool *rt_mp_t;
+
+#ifdef RT_USING_MEMPOOL_LOCKFREE
+/**
+ * lock-free memory pool structure, blocks are allocated and released from any context
+ */
+struct rt_mempool_lf
+{
+    rt_uint8_t          *start_address;                     /**< the first block */
+    rt_size_t           block_size;                        /**< size of memory blocks */
+    rt_size_t           block_total_count;                 /**< numbers of memory block */
+
+    rt_atomic_t         head;                              /**< free block stack, tag and index + 1 of the top */
+    rt_atomic_t         free_count;                        /**< numbers of free memory block */
+    rt_atomic_t         min_free_count;                    /**< lowest numbers of free memory block */
+    rt_atomic_t         failed_count;                      /**< allocations failed on an empty pool */
+
+#ifdef RT_USING_SEMAPHORE
+    rt_atomic_t         waiters;                           /**< threads waiting in rt_mp_lf_alloc_wait */
+    struct rt_semaphore wait_sem;                          /**< signaled on release while threads wait */
+#endif /* RT_USING_SEMAPHORE */
+};
+typedef struct rt_mempool_lf *rt_mp_lf_t;
+
+/**
+ * statistics of a lock-free memory pool
+ */
+struct rt_mp_lf_stat
+{
+    rt_size_t           total;                             /**< numbers of memory block */
+    rt_size_t           free;                              /**< numbers of free memory block */
+    rt_size_t           min_free;                          /**< lowest numbers of free memory block */
+    rt_uint32_t         failed;                            /**< allocations failed on an empty pool */
+};
+#endif /* RT_USING_MEMPOOL_LOCKFREE */
 #endif /* RT_USING_MEMPOOL */
 
 /**@}*/
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2024-03-10     Meco Man     the first version
+ * 2026-10-18     Cc           add compiled formats
  */
 
 #ifndef __RT_KLIBC_H__
@@ -25,6 +26,38 @@ int rt_vsnprintf(char *buf, rt_size_t size, const char *fmt, va_list args);
 int rt_sprintf(char *buf, const char *format, ...);
 int rt_snprintf(char *buf, rt_size_t size, const char *format, ...);
 
+#ifdef RT_KPRINTF_USING_FORMAT_COMPILE
+/**
+ * One conversion of a compiled format, with the literal text before it
+ */
+struct rt_fmt_spec
+{
+    rt_uint16_t literal;                        /**< offset of the literal text in the format */
+    rt_uint16_t literal_len;                    /**< length of the literal text */
+    rt_int16_t  width;                          /**< field width, -1 if none, -2 if taken from the arguments */
+    rt_int16_t  precision;                      /**< precision, -1 if none, -2 if taken from the arguments */
+    rt_uint8_t  flags;
+    rt_uint8_t  qualifier;
+    char        conv;                           /**< conversion character */
+};
+
+/**
+ * A format parsed once by rt_fmt_compile()
+ */
+struct rt_fmt
+{
+    const char  *format;
+    rt_uint16_t nr;                             /**< number of conversions */
+    rt_uint16_t tail;                           /**< offset of the literal text after the last one */
+    rt_uint16_t tail_len;
+    struct rt_fmt_spec specs[RT_KPRINTF_FORMAT_SPEC_NR];
+};
+
+rt_err_t rt_fmt_compile(struct rt_fmt *fmt, const char *format);
+int rt_fmt_vsnprintf(char *buf, rt_size_t size, const struct rt_fmt *fmt, va_list args);
+int rt_fmt_snprintf(char *buf, rt_size_t size, const struct rt_fmt *fmt, ...);
+#endif /* RT_KPRINTF_USING_FORMAT_COMPILE */
+
 /* kstring */
 
 #ifndef RT_KSERVICE_USING_STDLIB_MEMORY
@@ -77,6 +77,7 @@ rt_bool_t rt_object_is_systemobject(rt_object_t object);
 rt_uint8_t rt_object_get_type(rt_object_t object);
 rt_object_t rt_object_find(const char *name, rt_uint8_t type);
 rt_err_t rt_object_get_name(rt_object_t object, char *name, rt_uint8_t name_size);
+rt_err_t rt_object_set_name(rt_object_t object, const char *name);
 
 #ifdef RT_USING_HOOK
 void rt_object_attach_sethook(void (*hook)(struct rt_object *object));
@@ -287,6 +288,22 @@ void rt_mp_alloc_sethook(void (*hook)(struct rt_mempool *mp, void *block));
 void rt_mp_free_sethook(void (*hook)(struct rt_mempool *mp, void *block));
 #endif /* RT_USING_HOOK */
 
+#ifdef RT_USING_MEMPOOL_LOCKFREE
+rt_err_t rt_mp_lf_init(struct rt_mempool_lf *mp,
+                       const char           *name,
+                       void                 *start,
+                       rt_size_t             size,
+                       rt_size_t             block_size);
+rt_err_t rt_mp_lf_detach(struct rt_mempool_lf *mp);
+void *rt_mp_lf_alloc(rt_mp_lf_t mp);
+void rt_mp_lf_free(rt_mp_lf_t mp, void *block);
+#ifdef RT_USING_SEMAPHORE
+void *rt_mp_lf_alloc_wait(rt_mp_lf_t mp, rt_int32_t time);
+#endif /* RT_USING_SEMAPHORE */
+void rt_mp_lf_get_stat(rt_mp_lf_t mp, struct rt_mp_lf_stat *stat);
+void rt_mp_lf_reset_stat(rt_mp_lf_t mp);
+#endif /* RT_USING_MEMPOOL_LOCKFREE */
+
 #endif /* RT_USING_MEMPOOL */
 
 #ifdef RT_USING_HEAP
@@ -294,6 +311,9 @@ void rt_mp_free_sethook(void (*hook)(struct rt_mempool *mp, void *block));
  * heap memory interface
  */
 void rt_system_heap_init(void *begin_addr, void *end_addr);
+#ifdef RT_USING_TLSF_AS_HEAP
+rt_err_t rt_system_heap_add(void *begin_addr, void *end_addr);
+#endif /* RT_USING_TLSF_AS_HEAP */
 
 void *rt_malloc(rt_size_t size);
 void rt_free(void *ptr);
@@ -305,6 +325,28 @@ void rt_free_align(void *ptr);
 void rt_memory_info(rt_size_t *total,
                     rt_size_t *used,
                     rt_size_t *max_used);
+rt_size_t rt_memory_max_free(void);
+
+#ifdef RT_USING_MEMHEAP_HINT
+void *rt_malloc_hint(rt_size_t size, rt_uint32_t hint);
+void *rt_calloc_hint(rt_size_t count, rt_size_t size, rt_uint32_t hint);
+#else
+/* without placement hints any heap will do */
+#define rt_malloc_hint(size, hint)      rt_malloc(size)
+#define rt_calloc_hint(count, size, hint) rt_calloc(count, size)
+#endif /* RT_USING_MEMHEAP_HINT */
+
+#ifdef RT_USING_HEAP_CACHE
+void rt_heap_cache_trim(void);
+void rt_heap_cache_flush(void);
+rt_err_t rt_heap_cache_get_stat(int index, struct rt_heap_cache_stat *stat);
+#endif /* RT_USING_HEAP_CACHE */
+
+#ifdef RT_USING_HEAP_PROF
+void rt_heap_prof_alloc(void *ptr, rt_size_t size, void *caller);
+void rt_heap_prof_realloc(void *ptr, void *nptr, rt_size_t size, void *caller);
+void rt_heap_prof_free(void *ptr);
+#endif /* RT_USING_HEAP_PROF */
 
 #if defined(RT_USING_SLAB) && defined(RT_USING_SLAB_AS_HEAP)
 void *rt_page_alloc(rt_size_t npages);
@@ -331,6 +373,7 @@ rt_err_t rt_smem_detach(rt_smem_t m);
 void *rt_smem_alloc(rt_smem_t m, rt_size_t size);
 void *rt_smem_realloc(rt_smem_t m, void *rmem, rt_size_t newsize);
 void rt_smem_free(void *rmem);
+rt_size_t rt_smem_max_free(rt_smem_t m);
 #endif /* RT_USING_SMALL_MEM */
 
 #ifdef RT_USING_MEMHEAP
@@ -349,6 +392,7 @@ void rt_memheap_info(struct rt_memheap *heap,
                      rt_size_t *total,
                      rt_size_t *used,
                      rt_size_t *max_used);
+rt_size_t rt_memheap_max_free(struct rt_memheap *heap);
 #endif /* RT_USING_MEMHEAP */
 
 #ifdef RT_USING_MEMHEAP_AS_HEAP
@@ -358,6 +402,11 @@ void rt_memheap_info(struct rt_memheap *heap,
 void *_memheap_alloc(struct rt_memheap *heap, rt_size_t size);
 void _memheap_free(void *rmem);
 void *_memheap_realloc(struct rt_memheap *heap, void *rmem, rt_size_t newsize);
+#ifdef RT_USING_MEMHEAP_HINT
+void *_memheap_alloc_hint(struct rt_memheap *heap, rt_size_t size, rt_uint32_t hint);
+rt_err_t rt_memheap_class_register(const char *name, rt_uint32_t mem_class);
+rt_err_t rt_mem_class_get_stat(rt_uint32_t mem_class, struct rt_mem_class_stat *stat);
+#endif /* RT_USING_MEMHEAP_HINT */
 #endif
 
 #ifdef RT_USING_SLAB
@@ -373,6 +422,20 @@ void *rt_slab_realloc(rt_slab_t m, void *ptr, rt_size_t size);
 void rt_slab_free(rt_slab_t m, void *ptr);
 #endif /* RT_USING_SLAB */
 
+#ifdef RT_USING_TLSF
+/**
+ * TLSF memory object interface
+ */
+rt_tlsf_t rt_tlsf_init(const char *name, void *begin_addr, rt_size_t size);
+rt_err_t rt_tlsf_add_region(rt_tlsf_t m, void *begin_addr, rt_size_t size);
+rt_err_t rt_tlsf_detach(rt_tlsf_t m);
+void *rt_tlsf_alloc(rt_tlsf_t m, rt_size_t size);
+void *rt_tlsf_realloc(rt_tlsf_t m, void *ptr, rt_size_t newsize);
+void rt_tlsf_free(rt_tlsf_t m, void *ptr);
+rt_err_t rt_tlsf_check(rt_tlsf_t m);
+rt_size_t rt_tlsf_max_free(rt_tlsf_t m);
+#endif /* RT_USING_TLSF */
+
 /**@}*/
 
 /**
@@ -433,6 +496,9 @@ rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag);
 rt_err_t rt_mutex_delete(rt_mutex_t mutex);
 #endif /* RT_USING_HEAP */
 void rt_mutex_drop_thread(rt_mutex_t mutex, rt_thread_t thread);
+#ifdef RT_USING_IPC_FAST_PATH
+void rt_mutex_fast_detach_thread(rt_thread_t thread);
+#endif /* RT_USING_IPC_FAST_PATH */
 rt_uint8_t rt_mutex_setprioceiling(rt_mutex_t mutex, rt_uint8_t priority);
 rt_uint8_t rt_mutex_getprioceiling(rt_mutex_t mutex);
 
@@ -516,6 +582,8 @@ rt_err_t rt_mb_recv(rt_mailbox_t mb, rt_ubase_t *value, rt_int32_t timeout);
 rt_err_t rt_mb_recv_interruptible(rt_mailbox_t mb, rt_ubase_t *value, rt_int32_t timeout);
 rt_err_t rt_mb_recv_killable(rt_mailbox_t mb, rt_ubase_t *value, rt_int32_t timeout);
 rt_err_t rt_mb_control(rt_mailbox_t mb, int cmd, void *arg);
+rt_ssize_t rt_mb_send_batch(rt_mailbox_t mb, const rt_ubase_t *values, rt_size_t count, rt_int32_t timeout);
+rt_ssize_t rt_mb_recv_batch(rt_mailbox_t mb, rt_ubase_t *values, rt_size_t count, rt_int32_t timeout);
 #endif /* RT_USING_MAILBOX */
 
 #ifdef RT_USING_MESSAGEQUEUE
@@ -580,6 +648,24 @@ rt_ssize_t rt_mq_recv_killable(rt_mq_t    mq,
                     rt_int32_t timeout);
 rt_err_t rt_mq_control(rt_mq_t mq, int cmd, void *arg);
 
+rt_err_t rt_mq_send_loan(rt_mq_t mq, void **buffer, rt_int32_t timeout);
+rt_err_t rt_mq_send_commit(rt_mq_t mq, void *buffer, rt_size_t size);
+rt_err_t rt_mq_urgent_commit(rt_mq_t mq, void *buffer, rt_size_t size);
+rt_err_t rt_mq_send_abort(rt_mq_t mq, void *buffer);
+rt_ssize_t rt_mq_recv_loan(rt_mq_t mq, void **buffer, rt_int32_t timeout);
+rt_err_t rt_mq_recv_release(rt_mq_t mq, void *buffer);
+rt_ssize_t rt_mq_send_batch(rt_mq_t     mq,
+                            const void *buffer,
+                            rt_size_t   size,
+                            rt_size_t   count,
+                            rt_int32_t  timeout);
+rt_ssize_t rt_mq_recv_batch(rt_mq_t    mq,
+                            void      *buffer,
+                            rt_size_t  size,
+                            rt_size_t  count,
+                            rt_size_t *lengths,
+                            rt_int32_t timeout);
+
 #ifdef RT_USING_MESSAGEQUEUE_PRIORITY
 rt_err_t rt_mq_send_wait_prio(rt_mq_t mq,
                               const void *buffer,
@@ -593,6 +679,12 @@ rt_ssize_t rt_mq_recv_prio(rt_mq_t mq,
                            rt_int32_t *prio,
                            rt_int32_t timeout,
                            int suspend_flag);
+rt_err_t rt_mq_send_commit_prio(rt_mq_t mq, void *buffer, rt_size_t size, rt_int32_t prio);
+rt_ssize_t rt_mq_recv_loan_prio(rt_mq_t mq,
+                                void **buffer,
+                                rt_int32_t *prio,
+                                rt_int32_t timeout,
+                                int suspend_flag);
 #endif /* RT_USING_MESSAGEQUEUE_PRIORITY */
 #endif /* RT_USING_MESSAGEQUEUE */
 
@@ -600,6 +692,12 @@ rt_ssize_t rt_mq_recv_prio(rt_mq_t mq,
 void rt_thread_defunct_enqueue(rt_thread_t thread);
 rt_thread_t rt_thread_defunct_dequeue(void);
 
+#ifdef RT_USING_THREAD_STACK_CACHE
+void *rt_thread_stack_cache_get(rt_uint32_t size);
+rt_bool_t rt_thread_stack_cache_put(void *stack, rt_uint32_t size);
+void rt_thread_stack_cache_flush(void);
+#endif /* RT_USING_THREAD_STACK_CACHE */
+
 /*
  * spinlock
  */
@@ -727,6 +825,9 @@ void rt_interrupt_leave_sethook(void (*hook)(void));
 #ifdef RT_USING_COMPONENTS_INIT
 void rt_components_init(void);
 void rt_components_board_init(void);
+#ifdef RT_USING_INIT_DEFERRED
+rt_err_t rt_components_deferred_wait(rt_int32_t timeout);
+#endif /* RT_USING_INIT_DEFERRED */
 #endif /* RT_USING_COMPONENTS_INIT */
 
 /**
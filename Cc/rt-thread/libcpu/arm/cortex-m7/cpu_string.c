@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+/*
+ * rt_memcpy and rt_memset for Cortex-M7, replacing the generic ones of
+ * src/klibc/kstring.c.
+ *
+ * The destination is aligned to a word with byte and halfword stores first.
+ * The bulk then moves 32 bytes per LDM/STM pair, or per four STRD for the
+ * fill. Every access is aligned: a copy whose source and destination can
+ * not be word aligned together goes bytewise, as an unaligned LDR faults on
+ * device memory and with CCR.UNALIGN_TRP set.
+ *
+ * The blocks are GNU inline assembly, other compilers keep the generic
+ * versions.
+ */
+
+#include <rtthread.h>
+
+#if defined(RT_KSERVICE_USING_ARCH_STRING) && defined(__GNUC__)
+
+/* copy 32 bytes between word aligned addresses, advancing both; r7 and r9
+ * are left alone for the frame pointer and the static base */
+#define _COPY_BLOCK(dst, src)                                               \
+    __asm__ volatile ("ldmia %1!, {r3, r4, r5, r6, r8, r10, r11, r12}\n\t"   \
+                      "stmia %0!, {r3, r4, r5, r6, r8, r10, r11, r12}"       \
+                      : "+r" (dst), "+r" (src)                              \
+                      :                                                     \
+                      : "r3", "r4", "r5", "r6", "r8", "r10", "r11", "r12", "memory")
+
+/* fill 32 bytes at a word aligned address with a word, advancing it */
+#define _FILL_BLOCK(dst, word)                                              \
+    __asm__ volatile ("strd %1, %1, [%0], #8\n\t"                           \
+                      "strd %1, %1, [%0], #8\n\t"                           \
+                      "strd %1, %1, [%0], #8\n\t"                           \
+                      "strd %1, %1, [%0], #8"                               \
+                      : "+r" (dst)                                          \
+                      : "r" (word)                                          \
+                      : "memory")
+
+/**
+ * @brief  This function will set the content of memory to specified value.
+ *
+ * @param  s is the address of source memory, point to the memory block to be filled.
+ *
+ * @param  c is the value to be set, in the unsigned character form.
+ *
+ * @param  count number of bytes to be set.
+ *
+ * @return The address of source memory.
+ */
+void *rt_memset(void *s, int c, rt_ubase_t count)
+{
+    rt_uint8_t *m = (rt_uint8_t *)s;
+    rt_uint32_t word = (rt_uint8_t)c * 0x01010101UL;
+    rt_uint32_t *aligned_addr;
+
+    if (count >= 8)
+    {
+        /* the fix-up to the first word boundary */
+        if ((rt_ubase_t)m & 1)
+        {
+            *m++ = (rt_uint8_t)word;
+            count--;
+        }
+        if ((rt_ubase_t)m & 2)
+        {
+            *(rt_uint16_t *)m = (rt_uint16_t)word;
+            m += 2;
+            count -= 2;
+        }
+
+        aligned_addr = (rt_uint32_t *)m;
+        while (count >= 32)
+        {
+            _FILL_BLOCK(aligned_addr, word);
+            count -= 32;
+        }
+        while (count >= 4)
+        {
+            *aligned_addr++ = word;
+            count -= 4;
+        }
+        m = (rt_uint8_t *)aligned_addr;
+    }
+
+    while (count--)
+        *m++ = (rt_uint8_t)word;
+
+    return s;
+}
+RTM_EXPORT(rt_memset);
+
+/**
+ * @brief  This function will copy memory content from source address to destination address.
+ *
+ * @param  dst is the address of destination memory, points to the copied content.
+ *
+ * @param  src  is the address of source memory, pointing to the data source to be copied.
+ *
+ * @param  count is the copied length.
+ *
+ * @return The address of destination memory
+ */
+void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
+{
+    rt_uint8_t *dst_ptr = (rt_uint8_t *)dst;
+    const rt_uint8_t *src_ptr = (const rt_uint8_t *)src;
+    rt_uint32_t *aligned_dst;
+    const rt_uint32_t *aligned_src;
+
+    /* a source and a destination that differ in alignment are copied bytewise */
+    if (count >= 8 && (((rt_ubase_t)dst_ptr ^ (rt_ubase_t)src_ptr) & 3) == 0)
+    {
+        /* the fix-up to the first word boundary of both */
+        if ((rt_ubase_t)dst_ptr & 1)
+        {
+            *dst_ptr++ = *src_ptr++;
+            count--;
+        }
+        if ((rt_ubase_t)dst_ptr & 2)
+        {
+            *(rt_uint16_t *)dst_ptr = *(const rt_uint16_t *)src_ptr;
+            dst_ptr += 2;
+            src_ptr += 2;
+            count -= 2;
+        }
+
+        aligned_dst = (rt_uint32_t *)dst_ptr;
+        aligned_src = (const rt_uint32_t *)src_ptr;
+        while (count >= 32)
+        {
+            _COPY_BLOCK(aligned_dst, aligned_src);
+            count -= 32;
+        }
+        while (count >= 4)
+        {
+            *aligned_dst++ = *aligned_src++;
+            count -= 4;
+        }
+        dst_ptr = (rt_uint8_t *)aligned_dst;
+        src_ptr = (const rt_uint8_t *)aligned_src;
+    }
+
+    while (count--)
+        *dst_ptr++ = *src_ptr++;
+
+    return dst;
+}
+RTM_EXPORT(rt_memcpy);
+
+#endif /* defined(RT_KSERVICE_USING_ARCH_STRING) && defined(__GNUC__) */
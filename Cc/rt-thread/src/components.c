@@ -16,11 +16,16 @@
  * 2015-07-29     Arda.Fu      Add support to use RT_USING_USER_MAIN with IAR
  * 2018-11-22     Jesven       Add secondary cpu boot up
  * 2023-09-15     xqyjlj       perf rt_hw_interrupt_disable/enable
+ * 2026-10-18     Cc           add init profiling and deferred initialization
  */
 
 #include <rthw.h>
 #include <rtthread.h>
 
+#if defined(RT_DEBUGING_INIT_PROFILE) && defined(RT_USING_CPUTIME)
+#include <drivers/cputime.h>
+#endif /* RT_DEBUGING_INIT_PROFILE && RT_USING_CPUTIME */
+
 #ifdef RT_USING_USER_MAIN
 #ifndef RT_MAIN_THREAD_STACK_SIZE
 #define RT_MAIN_THREAD_STACK_SIZE     2048
@@ -46,6 +51,13 @@
  *
  * rti_end           --> 6.end
  *
+ * DEFERRED_DEVICE_EXPORT    --> 6.x.3
+ * DEFERRED_COMPONENT_EXPORT --> 6.x.4
+ * DEFERRED_ENV_EXPORT       --> 6.x.5
+ * DEFERRED_APP_EXPORT       --> 6.x.6
+ *
+ * rti_deferred_end  --> 6.x.end
+ *
  * These automatically initialization, the driver or component initial function must
  * be defined with:
  * INIT_BOARD_EXPORT(fn);
@@ -78,57 +90,237 @@ static int rti_end(void)
 }
 INIT_EXPORT(rti_end, "6.end");
 
-/**
- * @brief  Onboard components initialization. In this function, the board-level
- *         initialization function will be called to complete the initialization
- *         of the on-board peripherals.
- */
-void rt_components_board_init(void)
+static int rti_deferred_end(void)
 {
+    return 0;
+}
+INIT_EXPORT(rti_deferred_end, "6.x.end");
+
+#ifdef RT_DEBUGING_INIT_PROFILE
+#ifndef RT_INIT_PROFILE_MAX
+#define RT_INIT_PROFILE_MAX     128
+#endif /* RT_INIT_PROFILE_MAX */
+
+struct rt_init_profile
+{
+    const char *fn_name;
+    rt_uint32_t time;       /* the time of the call in microseconds */
+    rt_bool_t deferred;     /* at a deferred level */
+};
+
+static struct rt_init_profile _init_profile[RT_INIT_PROFILE_MAX];
+static rt_uint16_t _init_profile_nr;
+static rt_uint64_t _init_main_time;
+static rt_uint32_t _init_sync_us, _init_deferred_us;
+
+static rt_uint64_t _init_profile_now(void)
+{
+#ifdef RT_USING_CPUTIME
+    return clock_cpu_gettime();
+#else
+    return rt_tick_get();
+#endif /* RT_USING_CPUTIME */
+}
+
+static rt_uint32_t _init_profile_us(rt_uint64_t time)
+{
+#ifdef RT_USING_CPUTIME
+    return (rt_uint32_t)clock_cpu_microsecond(time);
+#else
+    return (rt_uint32_t)(time * (1000000 / RT_TICK_PER_SECOND));
+#endif /* RT_USING_CPUTIME */
+}
+#endif /* RT_DEBUGING_INIT_PROFILE */
+
 #ifdef RT_DEBUGING_AUTO_INIT
+static void _components_init_range(const struct rt_init_desc *begin,
+                                   const struct rt_init_desc *end, rt_bool_t deferred)
+{
     int result;
     const struct rt_init_desc *desc;
-    for (desc = &__rt_init_desc_rti_board_start; desc < &__rt_init_desc_rti_board_end; desc ++)
+#ifdef RT_DEBUGING_INIT_PROFILE
+    rt_uint64_t start;
+    rt_uint32_t time;
+#endif /* RT_DEBUGING_INIT_PROFILE */
+
+    RT_UNUSED(deferred);
+
+    for (desc = begin; desc < end; desc ++)
     {
         rt_kprintf("initialize %s", desc->fn_name);
+#ifdef RT_DEBUGING_INIT_PROFILE
+        start = _init_profile_now();
+        result = desc->fn();
+        time = _init_profile_us(_init_profile_now() - start);
+        if (_init_profile_nr < RT_INIT_PROFILE_MAX)
+        {
+            _init_profile[_init_profile_nr].fn_name = desc->fn_name;
+            _init_profile[_init_profile_nr].time = time;
+            _init_profile[_init_profile_nr].deferred = deferred;
+            _init_profile_nr ++;
+        }
+        if (deferred)
+            _init_deferred_us += time;
+        else
+            _init_sync_us += time;
+        rt_kprintf(":%d done, %u us\n", result, time);
+#else
         result = desc->fn();
         rt_kprintf(":%d done\n", result);
+#endif /* RT_DEBUGING_INIT_PROFILE */
     }
+}
+#define _COMPONENTS_INIT_RANGE(begin, end, deferred) \
+    _components_init_range(&__rt_init_desc_##begin, &__rt_init_desc_##end, deferred)
 #else
+static void _components_init_range(volatile const init_fn_t *begin,
+                                   volatile const init_fn_t *end)
+{
     volatile const init_fn_t *fn_ptr;
 
-    for (fn_ptr = &__rt_init_rti_board_start; fn_ptr < &__rt_init_rti_board_end; fn_ptr++)
+    for (fn_ptr = begin; fn_ptr < end; fn_ptr ++)
     {
         (*fn_ptr)();
     }
+}
+#define _COMPONENTS_INIT_RANGE(begin, end, deferred) \
+    _components_init_range(&__rt_init_##begin, &__rt_init_##end)
 #endif /* RT_DEBUGING_AUTO_INIT */
+
+/**
+ * @brief  Onboard components initialization. In this function, the board-level
+ *         initialization function will be called to complete the initialization
+ *         of the on-board peripherals.
+ */
+void rt_components_board_init(void)
+{
+    _COMPONENTS_INIT_RANGE(rti_board_start, rti_board_end, RT_FALSE);
+}
+
+#ifdef RT_USING_INIT_DEFERRED
+static struct rt_semaphore _init_deferred_sem;
+
+static void _init_deferred_entry(void *parameter)
+{
+    RT_UNUSED(parameter);
+
+    _COMPONENTS_INIT_RANGE(rti_end, rti_deferred_end, RT_TRUE);
+
+    /* wake up all of the waiters, and the later ones */
+    rt_sem_release(&_init_deferred_sem);
+}
+
+static void _init_deferred_start(void)
+{
+    rt_thread_t tid;
+
+    rt_sem_init(&_init_deferred_sem, "rti_def", 0, RT_IPC_FLAG_PRIO);
+    tid = rt_thread_create("rti_def", _init_deferred_entry, RT_NULL,
+                           RT_INIT_DEFERRED_THREAD_STACK_SIZE,
+                           RT_INIT_DEFERRED_THREAD_PRIORITY, 20);
+    if (tid != RT_NULL)
+    {
+        rt_thread_startup(tid);
+    }
+    else
+    {
+        /* no background thread, initialize them here as usual */
+        _init_deferred_entry(RT_NULL);
+    }
+}
+
+/**
+ * @brief  Wait for the deferred initialization to be finished.
+ *
+ * @note   This function shall be called after rt_components_init().
+ *
+ * @param  timeout is the waiting time in ticks, RT_WAITING_FOREVER to wait
+ *         until it is finished.
+ *
+ * @return RT_EOK if the deferred initialization is finished, -RT_ETIMEOUT
+ *         if it is still running.
+ */
+rt_err_t rt_components_deferred_wait(rt_int32_t timeout)
+{
+    rt_err_t result;
+
+    result = rt_sem_take(&_init_deferred_sem, timeout);
+    if (result == RT_EOK)
+    {
+        /* pass it on to the next waiter */
+        rt_sem_release(&_init_deferred_sem);
+    }
+
+    return result;
 }
+#endif /* RT_USING_INIT_DEFERRED */
 
 /**
  * @brief  RT-Thread Components Initialization.
+ *
+ * @note   With RT_USING_INIT_DEFERRED, the INIT_DEFERRED_*_EXPORT functions
+ *         run in a background thread after this function returns. Otherwise
+ *         they run here after all of the other levels.
  */
 void rt_components_init(void)
 {
 #ifdef RT_DEBUGING_AUTO_INIT
-    int result;
-    const struct rt_init_desc *desc;
-
     rt_kprintf("do components initialization.\n");
-    for (desc = &__rt_init_desc_rti_board_end; desc < &__rt_init_desc_rti_end; desc ++)
+#endif /* RT_DEBUGING_AUTO_INIT */
+
+    _COMPONENTS_INIT_RANGE(rti_board_end, rti_end, RT_FALSE);
+
+#ifdef RT_USING_INIT_DEFERRED
+#ifdef RT_DEBUGING_INIT_PROFILE
+    _init_main_time = _init_profile_now();
+#endif /* RT_DEBUGING_INIT_PROFILE */
+    _init_deferred_start();
+#else
+    _COMPONENTS_INIT_RANGE(rti_end, rti_deferred_end, RT_TRUE);
+#ifdef RT_DEBUGING_INIT_PROFILE
+    _init_main_time = _init_profile_now();
+#endif /* RT_DEBUGING_INIT_PROFILE */
+#endif /* RT_USING_INIT_DEFERRED */
+}
+
+#if defined(RT_DEBUGING_INIT_PROFILE) && defined(RT_USING_FINSH)
+static int list_init(void)
+{
+    rt_uint16_t order[RT_INIT_PROFILE_MAX];
+    rt_uint32_t main_us;
+    int i, j, nr;
+
+    nr = _init_profile_nr;
+    for (i = 0; i < nr; i ++)
     {
-        rt_kprintf("initialize %s", desc->fn_name);
-        result = desc->fn();
-        rt_kprintf(":%d done\n", result);
+        /* insertion sort by time, the slowest first */
+        for (j = i; j > 0 && _init_profile[order[j - 1]].time < _init_profile[i].time; j --)
+            order[j] = order[j - 1];
+        order[j] = i;
     }
-#else
-    volatile const init_fn_t *fn_ptr;
 
-    for (fn_ptr = &__rt_init_rti_board_end; fn_ptr < &__rt_init_rti_end; fn_ptr ++)
+    rt_kprintf("%-32s %10s %s\n", "function", "time(us)", "level");
+    for (i = 0; i < nr; i ++)
     {
-        (*fn_ptr)();
+        rt_kprintf("%-32s %10u %s\n", _init_profile[order[i]].fn_name,
+                   _init_profile[order[i]].time,
+                   _init_profile[order[i]].deferred ? "deferred" : "");
     }
-#endif /* RT_DEBUGING_AUTO_INIT */
+
+    main_us = _init_profile_us(_init_main_time);
+    rt_kprintf("boot init functions : %u us\n", _init_sync_us);
+    rt_kprintf("deferred functions  : %u us\n", _init_deferred_us);
+    rt_kprintf("main() reached at   : %u us\n", main_us);
+#ifdef RT_USING_INIT_DEFERRED
+    rt_kprintf("without deferral    : %u us\n", main_us + _init_deferred_us);
+#else
+    rt_kprintf("with deferral       : %u us\n", main_us - _init_deferred_us);
+#endif /* RT_USING_INIT_DEFERRED */
+
+    return 0;
 }
+MSH_CMD_EXPORT(list_init, list the time of initialization functions);
+#endif /* RT_DEBUGING_INIT_PROFILE && RT_USING_FINSH */
 #endif /* RT_USING_COMPONENTS_INIT */
 
 #ifdef RT_USING_USER_MAIN
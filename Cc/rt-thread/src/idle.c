@@ -19,6 +19,7 @@
  * 2023-09-15     xqyjlj       perf rt_hw_interrupt_disable/enable
  * 2023-11-07     xqyjlj       fix thread exit
  * 2023-12-10     xqyjlj       add _hook_spinlock
+ * 2026-10-18     Cc           drain the defunct list in one batch
  */
 
 #include <rthw.h>
@@ -185,75 +186,111 @@ rt_thread_t rt_thread_defunct_dequeue(void)
 /**
  * @brief This function will perform system background job when system idle.
  */
-static void rt_defunct_execute(void)
+/* move all of the dead threads to the batch list, under one lock */
+static rt_bool_t _defunct_drain(rt_list_t *batch)
 {
-    /* Loop until there is no dead thread. So one call to rt_defunct_execute
-     * will do all the cleanups. */
-    while (1)
+    rt_base_t level;
+    rt_list_t *l = &_rt_thread_defunct;
+    rt_bool_t drained = RT_FALSE;
+
+    rt_list_init(batch);
+
+    level = rt_spin_lock_irqsave(&_defunct_spinlock);
+    if (!rt_list_isempty(l))
     {
-        rt_thread_t thread;
-        rt_bool_t object_is_systemobject;
-        void (*cleanup)(struct rt_thread *tid);
+        batch->next = l->next;
+        batch->prev = l->prev;
+        l->next->prev = batch;
+        l->prev->next = batch;
+        rt_list_init(l);
+        drained = RT_TRUE;
+    }
+    rt_spin_unlock_irqrestore(&_defunct_spinlock, level);
 
-#ifdef RT_USING_MODULE
-        struct rt_dlmodule *module = RT_NULL;
-#endif
-        /* get defunct thread */
-        thread = rt_thread_defunct_dequeue();
-        if (thread == RT_NULL)
-        {
-            break;
-        }
+    return drained;
+}
+
+static void _defunct_reclaim(rt_thread_t thread)
+{
+    rt_bool_t object_is_systemobject;
+    void (*cleanup)(struct rt_thread *tid);
 
 #ifdef RT_USING_MODULE
-        module = (struct rt_dlmodule*)thread->parent.module_id;
-        if (module)
-        {
-            dlmodule_destroy(module);
-        }
+    struct rt_dlmodule *module = RT_NULL;
+
+    module = (struct rt_dlmodule*)thread->parent.module_id;
+    if (module)
+    {
+        dlmodule_destroy(module);
+    }
 #endif
 
 #ifdef RT_USING_SIGNALS
-        rt_thread_free_sig(thread);
+    rt_thread_free_sig(thread);
 #endif
 
-        /* store the point of "thread->cleanup" avoid to lose */
-        cleanup = thread->cleanup;
+    /* store the point of "thread->cleanup" avoid to lose */
+    cleanup = thread->cleanup;
 
-        /* if it's a system object, not delete it */
-        object_is_systemobject = rt_object_is_systemobject((rt_object_t)thread);
-        if (object_is_systemobject == RT_TRUE)
-        {
-            /* detach this object */
-            rt_object_detach((rt_object_t)thread);
-        }
+    /* if it's a system object, not delete it */
+    object_is_systemobject = rt_object_is_systemobject((rt_object_t)thread);
+    if (object_is_systemobject == RT_TRUE)
+    {
+        /* detach this object */
+        rt_object_detach((rt_object_t)thread);
+    }
 
-        /* invoke thread cleanup */
-        if (cleanup != RT_NULL)
-        {
-            cleanup(thread);
-        }
+    /* invoke thread cleanup */
+    if (cleanup != RT_NULL)
+    {
+        cleanup(thread);
+    }
 
 #ifdef RT_USING_HEAP
 #ifdef RT_USING_MEM_PROTECTION
-        if (thread->mem_regions != RT_NULL)
-        {
-            RT_KERNEL_FREE(thread->mem_regions);
-        }
+    if (thread->mem_regions != RT_NULL)
+    {
+        RT_KERNEL_FREE(thread->mem_regions);
+    }
 #endif
-        /* if need free, delete it */
-        if (object_is_systemobject == RT_FALSE)
-        {
-            /* release thread's stack */
+    /* if need free, delete it */
+    if (object_is_systemobject == RT_FALSE)
+    {
+        /* release thread's stack */
 #ifdef RT_USING_HW_STACK_GUARD
-            RT_KERNEL_FREE(thread->stack_buf);
+        RT_KERNEL_FREE(thread->stack_buf);
 #else
+#ifdef RT_USING_THREAD_STACK_CACHE
+        /* keep it for the next rt_thread_create of the same stack size */
+        if (rt_thread_stack_cache_put(thread->stack_addr, thread->stack_size) == RT_FALSE)
+#endif /* RT_USING_THREAD_STACK_CACHE */
+        {
             RT_KERNEL_FREE(thread->stack_addr);
-#endif
-            /* delete thread object */
-            rt_object_delete((rt_object_t)thread);
         }
 #endif
+        /* delete thread object */
+        rt_object_delete((rt_object_t)thread);
+    }
+#endif
+}
+
+static void rt_defunct_execute(void)
+{
+    rt_list_t batch;
+    rt_thread_t thread;
+
+    /* Loop until there is no dead thread. So one call to rt_defunct_execute
+     * will do all the cleanups. The dead threads are taken in batches, so the
+     * defunct lock is not taken once per thread. */
+    while (_defunct_drain(&batch))
+    {
+        while (!rt_list_isempty(&batch))
+        {
+            thread = RT_THREAD_LIST_NODE_ENTRY(batch.next);
+            rt_list_remove(&RT_THREAD_LIST_NODE(thread));
+
+            _defunct_reclaim(thread);
+        }
     }
 }
 
@@ -46,6 +46,9 @@
  * 2022-10-16     Bernard      add prioceiling feature in mutex
  * 2023-04-16     Xin-zheqi    redesigen queue recv and send function return real message size
  * 2023-09-15     xqyjlj       perf rt_hw_interrupt_disable/enable
+ * 2026-10-18     Cc           add zero-copy loan/commit api for message queue
+ *                             add batched send/recv for mailbox and message queue
+ *                             add atomic fast path for semaphore and mutex
  */
 
 #include <rtthread.h>
@@ -228,6 +231,31 @@ rt_err_t rt_susp_list_resume_all_irq(rt_list_t *susp_list,
     return RT_EOK;
 }
 
+/**
+ * @brief   Resume at most count threads in the suspended list. The caller
+ *          holds the lock of the IPC object and schedules once after
+ *          releasing it.
+ *
+ * @param   susp_list is a pointer to a suspended thread list of the IPC object.
+ * @param   count is the maximum number of threads to resume.
+ *
+ * @return  Return RT_TRUE if any thread was resumed, otherwise RT_FALSE.
+ */
+#if defined(RT_USING_MAILBOX) || defined(RT_USING_MESSAGEQUEUE)
+static rt_bool_t _ipc_list_resume_n(rt_list_t *susp_list, rt_size_t count)
+{
+    rt_bool_t resumed = RT_FALSE;
+
+    while (count-- > 0 && !rt_list_isempty(susp_list))
+    {
+        if (rt_susp_list_dequeue(susp_list, RT_EOK) != RT_NULL)
+            resumed = RT_TRUE;
+    }
+
+    return resumed;
+}
+#endif /* defined(RT_USING_MAILBOX) || defined(RT_USING_MESSAGEQUEUE) */
+
 /**
  * @brief   Add a thread to the suspend list
  *
@@ -328,13 +356,143 @@ static void _sem_object_init(rt_sem_t       sem,
 
     sem->max_value = max_value;
     /* set initial value */
+#ifdef RT_USING_IPC_FAST_PATH
+    rt_atomic_store(&(sem->value), value);
+#else
     sem->value = value;
+#endif /* RT_USING_IPC_FAST_PATH */
 
     /* set parent */
     sem->parent.parent.flag = flag;
     rt_spin_lock_init(&(sem->spinlock));
 }
 
+#ifdef RT_USING_IPC_FAST_PATH
+/*
+ * The value word of semaphore holds the count, or RT_SEM_FAST_WAITERS while
+ * threads are pended on it. The flag is only set when the count is 0 and only
+ * changed with sem->spinlock held, so an uncontended take or release is a
+ * single compare-and-swap which fails over to the spinlock once it is set.
+ */
+rt_inline rt_bool_t _sem_fast_take(rt_sem_t sem)
+{
+    rt_atomic_t value = rt_atomic_load(&(sem->value));
+
+    while (value > 0 && value != RT_SEM_FAST_WAITERS)
+    {
+        if (rt_atomic_compare_exchange_strong(&(sem->value), &value, value - 1))
+            return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+rt_inline rt_bool_t _sem_fast_release(rt_sem_t sem)
+{
+    rt_atomic_t value = rt_atomic_load(&(sem->value));
+
+    while (value < sem->max_value)
+    {
+        if (rt_atomic_compare_exchange_strong(&(sem->value), &value, value + 1))
+            return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+/* clear the waiters flag once no thread is pended, must hold sem->spinlock */
+rt_inline void _sem_sync_waiters(rt_sem_t sem)
+{
+    if (rt_list_isempty(&(sem->parent.suspend_thread)) &&
+        rt_atomic_load(&(sem->value)) == RT_SEM_FAST_WAITERS)
+    {
+        rt_atomic_store(&(sem->value), 0);
+    }
+}
+
+/* take one count, or set the waiters flag if pend is true, must hold sem->spinlock */
+static rt_bool_t _sem_take_value(rt_sem_t sem, rt_bool_t pend)
+{
+    rt_atomic_t value;
+
+    _sem_sync_waiters(sem);
+
+    value = rt_atomic_load(&(sem->value));
+    while (value != RT_SEM_FAST_WAITERS)
+    {
+        if (value > 0)
+        {
+            if (rt_atomic_compare_exchange_strong(&(sem->value), &value, value - 1))
+                return RT_TRUE;
+        }
+        else if (pend == RT_FALSE ||
+                 rt_atomic_compare_exchange_strong(&(sem->value), &value, RT_SEM_FAST_WAITERS))
+        {
+            break;
+        }
+    }
+
+    return RT_FALSE;
+}
+
+/* add one count if no thread is pended, must hold sem->spinlock */
+rt_inline rt_bool_t _sem_release_value(rt_sem_t sem)
+{
+    _sem_sync_waiters(sem);
+
+    return _sem_fast_release(sem);
+}
+
+rt_inline rt_uint16_t _sem_get_value(rt_sem_t sem)
+{
+    return (rt_uint16_t)(rt_atomic_load(&(sem->value)) & RT_SEM_VALUE_MAX);
+}
+
+rt_inline void _sem_set_value(rt_sem_t sem, rt_uint16_t value)
+{
+    rt_atomic_store(&(sem->value), value);
+}
+#else
+rt_inline void _sem_sync_waiters(rt_sem_t sem)
+{
+    RT_UNUSED(sem);
+}
+
+rt_inline rt_bool_t _sem_take_value(rt_sem_t sem, rt_bool_t pend)
+{
+    RT_UNUSED(pend);
+
+    if (sem->value > 0)
+    {
+        sem->value --;
+        return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+rt_inline rt_bool_t _sem_release_value(rt_sem_t sem)
+{
+    if (sem->value < sem->max_value)
+    {
+        sem->value ++;
+        return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+rt_inline rt_uint16_t _sem_get_value(rt_sem_t sem)
+{
+    return sem->value;
+}
+
+rt_inline void _sem_set_value(rt_sem_t sem, rt_uint16_t value)
+{
+    sem->value = value;
+}
+#endif /* RT_USING_IPC_FAST_PATH */
+
 /**
  * @brief    This function will initialize a static semaphore object.
  *
@@ -570,17 +728,25 @@ static rt_err_t _rt_sem_take(rt_sem_t sem, rt_int32_t timeout, int suspend_flag)
     /* current context checking */
     RT_DEBUG_SCHEDULER_AVAILABLE(1);
 
+#ifdef RT_USING_IPC_FAST_PATH
+    if (_sem_fast_take(sem))
+    {
+        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(sem->parent.parent)));
+
+        return RT_EOK;
+    }
+#endif /* RT_USING_IPC_FAST_PATH */
+
     level = rt_spin_lock_irqsave(&(sem->spinlock));
 
     LOG_D("thread %s take sem:%s, which value is: %d",
           rt_thread_self()->parent.name,
           sem->parent.parent.name,
-          sem->value);
+          _sem_get_value(sem));
 
-    if (sem->value > 0)
+    if (_sem_take_value(sem, timeout != 0))
     {
         /* semaphore is available */
-        sem->value --;
         rt_spin_unlock_irqrestore(&(sem->spinlock), level);
     }
     else
@@ -703,6 +869,13 @@ rt_err_t rt_sem_release(rt_sem_t sem)
 
     RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(sem->parent.parent)));
 
+#ifdef RT_USING_IPC_FAST_PATH
+    if (_sem_fast_release(sem))
+    {
+        return RT_EOK;
+    }
+#endif /* RT_USING_IPC_FAST_PATH */
+
     need_schedule = RT_FALSE;
 
     level = rt_spin_lock_irqsave(&(sem->spinlock));
@@ -710,21 +883,19 @@ rt_err_t rt_sem_release(rt_sem_t sem)
     LOG_D("thread %s releases sem:%s, which value is: %d",
           rt_thread_self()->parent.name,
           sem->parent.parent.name,
-          sem->value);
+          _sem_get_value(sem));
 
     if (!rt_list_isempty(&sem->parent.suspend_thread))
     {
         /* resume the suspended thread */
         rt_susp_list_dequeue(&(sem->parent.suspend_thread), RT_EOK);
+        _sem_sync_waiters(sem);
         need_schedule = RT_TRUE;
     }
     else
     {
-        if(sem->value < sem->max_value)
-        {
-            sem->value ++; /* increase value */
-        }
-        else
+        /* increase value */
+        if (_sem_release_value(sem) == RT_FALSE)
         {
             rt_spin_unlock_irqrestore(&(sem->spinlock), level);
             return -RT_EFULL; /* value overflowed */
@@ -776,7 +947,7 @@ rt_err_t rt_sem_control(rt_sem_t sem, int cmd, void *arg)
         rt_susp_list_resume_all(&sem->parent.suspend_thread, RT_ERROR);
 
         /* set new value */
-        sem->value = (rt_uint16_t)value;
+        _sem_set_value(sem, (rt_uint16_t)value);
         rt_spin_unlock_irqrestore(&(sem->spinlock), level);
         rt_schedule();
 
@@ -794,7 +965,7 @@ rt_err_t rt_sem_control(rt_sem_t sem, int cmd, void *arg)
         }
 
         level = rt_spin_lock_irqsave(&(sem->spinlock));
-        if (max_value < sem->value)
+        if (max_value < _sem_get_value(sem))
         {
             if (!rt_list_isempty(&sem->parent.suspend_thread))
             {
@@ -942,16 +1113,142 @@ static rt_bool_t _check_and_update_prio(rt_thread_t thread, rt_mutex_t mutex)
     return do_sched;
 }
 
+#ifdef RT_USING_IPC_FAST_PATH
+/*
+ * mutex->fast_owner is 0 when the mutex is free, the owner thread when it is
+ * taken by the fast path, or RT_MUTEX_FAST_SLOW when owner, hold and
+ * taken_list under mutex->spinlock describe the mutex. A fast owner has hold
+ * of 1 and is not linked to its taken list until the mutex gets contended.
+ * Until the owner releases it, mutex->fast_list links the mutex to
+ * thread->fast_taken_list, which only the owner changes, so the thread exit
+ * finds them without a walk of all mutexes.
+ */
+rt_inline rt_bool_t _mutex_fast_take(rt_mutex_t mutex, struct rt_thread *thread)
+{
+    rt_atomic_t fast_owner = 0;
+
+    /* priority ceiling has to boost the owner in the slow path */
+    if (mutex->ceiling_priority != 0xFF)
+        return RT_FALSE;
+
+    if (rt_atomic_compare_exchange_strong(&(mutex->fast_owner), &fast_owner, (rt_atomic_t)thread))
+    {
+        mutex->owner = thread;
+        mutex->hold  = 1;
+        rt_list_insert_after(&(thread->fast_taken_list), &(mutex->fast_list));
+        return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+rt_inline rt_bool_t _mutex_fast_release(rt_mutex_t mutex, struct rt_thread *thread)
+{
+    rt_atomic_t fast_owner = (rt_atomic_t)thread;
+
+    if (rt_atomic_load(&(mutex->fast_owner)) != fast_owner)
+        return RT_FALSE;
+
+    /* unlink it before the next owner can take it */
+    rt_list_remove(&(mutex->fast_list));
+    if (rt_atomic_compare_exchange_strong(&(mutex->fast_owner), &fast_owner, 0))
+    {
+        /* the next owner may have already taken it */
+        fast_owner = (rt_atomic_t)thread;
+        rt_atomic_compare_exchange_strong((volatile rt_atomic_t *)&(mutex->owner), &fast_owner, 0);
+        return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+/* hand the mutex over to the slow path, must hold mutex->spinlock */
+static void _mutex_fast_exit(rt_mutex_t mutex)
+{
+    rt_sched_lock_level_t slvl;
+    struct rt_thread *owner;
+    rt_atomic_t fast_owner;
+
+    fast_owner = rt_atomic_load(&(mutex->fast_owner));
+    while (fast_owner != RT_MUTEX_FAST_SLOW &&
+           !rt_atomic_compare_exchange_strong(&(mutex->fast_owner), &fast_owner, RT_MUTEX_FAST_SLOW));
+
+    if (fast_owner == 0)
+    {
+        /* the last fast owner may not have cleared it yet */
+        mutex->owner = RT_NULL;
+    }
+    else if (fast_owner != RT_MUTEX_FAST_SLOW)
+    {
+        owner = (struct rt_thread *)fast_owner;
+
+        mutex->owner = owner;
+        mutex->hold  = 1;
+
+        /* priority inheritance looks for the mutex in the taken list of owner */
+        rt_sched_lock(&slvl);
+        rt_list_insert_after(&owner->taken_object_list, &mutex->taken_list);
+        rt_sched_unlock(slvl);
+    }
+}
+
+/* open the fast path again if the mutex is free, must hold mutex->spinlock */
+rt_inline void _mutex_fast_enter(rt_mutex_t mutex)
+{
+    if (mutex->owner == RT_NULL)
+    {
+        rt_atomic_store(&(mutex->fast_owner), 0);
+    }
+}
+
+/* unlink the mutex from the fast taken list of its owner */
+#define _mutex_fast_unlink(mutex)   rt_list_remove(&((mutex)->fast_list))
+#else
+#define _mutex_fast_exit(mutex)
+#define _mutex_fast_enter(mutex)
+#define _mutex_fast_unlink(mutex)
+#endif /* RT_USING_IPC_FAST_PATH */
+
+#ifdef RT_USING_IPC_FAST_PATH
+/**
+ * @brief This function will hand the mutexes a thread took by the fast path
+ *        over to the slow path, so they are linked to its taken list.
+ *
+ * @note  It is called on the exit of the thread, before the mutexes in its
+ *        taken list are released. Without it the mutex keeps the exited
+ *        thread as its owner. It only visits the mutexes the thread holds.
+ *
+ * @param thread is the thread which is exiting.
+ */
+void rt_mutex_fast_detach_thread(rt_thread_t thread)
+{
+    struct rt_list_node *node, *tmp_list;
+    struct rt_mutex *mutex;
+
+    rt_list_for_each_safe(node, tmp_list, &(thread->fast_taken_list))
+    {
+        mutex = rt_list_entry(node, struct rt_mutex, fast_list);
+
+        rt_spin_lock(&(mutex->spinlock));
+        _mutex_fast_exit(mutex);
+        _mutex_fast_unlink(mutex);
+        rt_spin_unlock(&(mutex->spinlock));
+    }
+}
+#endif /* RT_USING_IPC_FAST_PATH */
+
 static void _mutex_before_delete_detach(rt_mutex_t mutex)
 {
     rt_sched_lock_level_t slvl;
     rt_bool_t need_schedule;
 
     rt_spin_lock(&(mutex->spinlock));
+    _mutex_fast_exit(mutex);
     /* wakeup all suspended threads */
     rt_susp_list_resume_all(&(mutex->parent.suspend_thread), RT_ERROR);
     /* remove mutex from thread's taken list */
     rt_list_remove(&mutex->taken_list);
+    _mutex_fast_unlink(mutex);
 
     /* whether change the thread priority */
     if (mutex->owner)
@@ -1021,6 +1318,10 @@ rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag)
     mutex->hold     = 0;
     mutex->ceiling_priority = 0xFF;
     rt_list_init(&(mutex->taken_list));
+#ifdef RT_USING_IPC_FAST_PATH
+    rt_atomic_store(&(mutex->fast_owner), 0);
+    rt_list_init(&(mutex->fast_list));
+#endif /* RT_USING_IPC_FAST_PATH */
 
     /* flag can only be RT_IPC_FLAG_PRIO. RT_IPC_FLAG_FIFO cannot solve the unbounded priority inversion problem */
     mutex->parent.parent.flag = RT_IPC_FLAG_PRIO;
@@ -1158,6 +1459,7 @@ rt_uint8_t rt_mutex_setprioceiling(rt_mutex_t mutex, rt_uint8_t priority)
     {
         /* critical section here if multiple updates to one mutex happen */
         rt_spin_lock(&(mutex->spinlock));
+        _mutex_fast_exit(mutex);
         ret_priority = mutex->ceiling_priority;
         mutex->ceiling_priority = priority;
         if (mutex->owner)
@@ -1170,6 +1472,7 @@ rt_uint8_t rt_mutex_setprioceiling(rt_mutex_t mutex, rt_uint8_t priority)
             }
             rt_sched_unlock(slvl);
         }
+        _mutex_fast_enter(mutex);
         rt_spin_unlock(&(mutex->spinlock));
     }
     else
@@ -1250,6 +1553,10 @@ rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag)
     mutex->hold     = 0;
     mutex->ceiling_priority = 0xFF;
     rt_list_init(&(mutex->taken_list));
+#ifdef RT_USING_IPC_FAST_PATH
+    rt_atomic_store(&(mutex->fast_owner), 0);
+    rt_list_init(&(mutex->fast_list));
+#endif /* RT_USING_IPC_FAST_PATH */
 
     /* flag can only be RT_IPC_FLAG_PRIO. RT_IPC_FLAG_FIFO cannot solve the unbounded priority inversion problem */
     mutex->parent.parent.flag = RT_IPC_FLAG_PRIO;
@@ -1337,7 +1644,22 @@ static rt_err_t _rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout, int suspend
     /* get current thread */
     thread = rt_thread_self();
 
+#ifdef RT_USING_IPC_FAST_PATH
+    if (_mutex_fast_take(mutex, thread))
+    {
+        RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mutex->parent.parent)));
+
+        /* reset thread error */
+        thread->error = RT_EOK;
+
+        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mutex->parent.parent)));
+
+        return RT_EOK;
+    }
+#endif /* RT_USING_IPC_FAST_PATH */
+
     rt_spin_lock(&(mutex->spinlock));
+    _mutex_fast_exit(mutex);
 
     RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mutex->parent.parent)));
 
@@ -1596,7 +1918,17 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
     /* get current thread */
     thread = rt_thread_self();
 
+#ifdef RT_USING_IPC_FAST_PATH
+    if (_mutex_fast_release(mutex, thread))
+    {
+        RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mutex->parent.parent)));
+
+        return RT_EOK;
+    }
+#endif /* RT_USING_IPC_FAST_PATH */
+
     rt_spin_lock(&(mutex->spinlock));
+    _mutex_fast_exit(mutex);
 
     LOG_D("mutex_release:current thread %s, hold: %d",
           thread->parent.name, mutex->hold);
@@ -1607,6 +1939,7 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
     if (thread != mutex->owner)
     {
         thread->error = -RT_ERROR;
+        _mutex_fast_enter(mutex);
         rt_spin_unlock(&(mutex->spinlock));
 
         return -RT_ERROR;
@@ -1619,6 +1952,7 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
     {
         /* remove mutex from thread's taken list */
         rt_list_remove(&mutex->taken_list);
+        _mutex_fast_unlink(mutex);
 
         rt_sched_lock(&slvl);
 
@@ -1697,6 +2031,7 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
         }
     }
 
+    _mutex_fast_enter(mutex);
     rt_spin_unlock(&(mutex->spinlock));
 
     /* perform a schedule */
@@ -2530,41 +2865,41 @@ RTM_EXPORT(rt_mb_delete);
 
 
 /**
- * @brief    This function will send an mail to the mailbox object. If there is a thread suspended on the mailbox,
- *           the thread will be resumed.
- *
- * @note     When using this function to send a mail, if the mailbox if fully used, the current thread will
- *           wait for a timeout. If the set timeout time is reached and there is still no space available,
- *           the sending thread will be resumed and an error code will be returned.
- *           By contrast, the rt_mb_send() function will return an error code immediately without waiting time
- *           when the mailbox if fully used.
+ * @brief    This function will send up to count mails to the mailbox object under one lock acquisition.
+ *           The suspended receivers are resumed together and the scheduler runs at most once.
  *
- * @see      rt_mb_send()
+ * @note     When the mailbox is fully used, the current thread will wait for a timeout until there is
+ *           space for at least one mail. The mails which do not fit are not sent.
  *
  * @param    mb is a pointer to the mailbox object to be sent.
  *
- * @param    value is a value to the content of the mail you want to send.
+ * @param    values is the array of mails you want to send.
+ *
+ * @param    count is the number of mails in the values array.
  *
  * @param    timeout is a timeout period (unit: an OS tick).
  *
- * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
- *           If the return value is any other values, it means that the mailbox detach failed.
+ * @param    suspend_flag status flag of the thread to be suspended.
  *
- * @warning  This function can be called in interrupt context and thread context.
+ * @return   Return the number of mails sent. If the return value is negative, no mail was sent.
  */
-static rt_err_t _rt_mb_send_wait(rt_mailbox_t mb,
-                         rt_ubase_t   value,
-                         rt_int32_t   timeout,
-                         int suspend_flag)
+static rt_ssize_t _rt_mb_send_batch(rt_mailbox_t mb,
+                                    const rt_ubase_t *values,
+                                    rt_size_t count,
+                                    rt_int32_t timeout,
+                                    int suspend_flag)
 {
     struct rt_thread *thread;
     rt_base_t level;
     rt_uint32_t tick_delta;
     rt_err_t ret;
+    rt_size_t sent;
 
     /* parameter check */
     RT_ASSERT(mb != RT_NULL);
     RT_ASSERT(rt_object_get_type(&mb->parent.parent) == RT_Object_Class_MailBox);
+    RT_ASSERT(values != RT_NULL);
+    RT_ASSERT(count != 0);
 
     /* current context checking */
     RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
@@ -2649,38 +2984,75 @@ static rt_err_t _rt_mb_send_wait(rt_mailbox_t mb,
         }
     }
 
-    /* set ptr */
-    mb->msg_pool[mb->in_offset] = value;
-    /* increase input offset */
-    ++ mb->in_offset;
-    if (mb->in_offset >= mb->size)
-        mb->in_offset = 0;
-
-    if(mb->entry < RT_MB_ENTRY_MAX)
+    for (sent = 0; sent < count && mb->entry < mb->size; sent ++)
     {
+        if (mb->entry >= RT_MB_ENTRY_MAX)
+            break; /* value overflowed */
+
+        /* set ptr */
+        mb->msg_pool[mb->in_offset] = values[sent];
+        /* increase input offset */
+        ++ mb->in_offset;
+        if (mb->in_offset >= mb->size)
+            mb->in_offset = 0;
+
         /* increase message entry */
         mb->entry ++;
     }
-    else
+
+    if (sent == 0)
     {
         rt_spin_unlock_irqrestore(&(mb->spinlock), level);
         return -RT_EFULL; /* value overflowed */
     }
 
     /* resume suspended thread */
-    if (!rt_list_isempty(&mb->parent.suspend_thread))
+    if (_ipc_list_resume_n(&(mb->parent.suspend_thread), sent))
     {
-        rt_susp_list_dequeue(&(mb->parent.suspend_thread), RT_EOK);
-
         rt_spin_unlock_irqrestore(&(mb->spinlock), level);
 
         rt_schedule();
 
-        return RT_EOK;
+        return sent;
     }
     rt_spin_unlock_irqrestore(&(mb->spinlock), level);
 
-    return RT_EOK;
+    return sent;
+}
+
+/**
+ * @brief    This function will send an mail to the mailbox object. If there is a thread suspended on the mailbox,
+ *           the thread will be resumed.
+ *
+ * @note     When using this function to send a mail, if the mailbox if fully used, the current thread will
+ *           wait for a timeout. If the set timeout time is reached and there is still no space available,
+ *           the sending thread will be resumed and an error code will be returned.
+ *           By contrast, the rt_mb_send() function will return an error code immediately without waiting time
+ *           when the mailbox if fully used.
+ *
+ * @see      rt_mb_send()
+ *
+ * @param    mb is a pointer to the mailbox object to be sent.
+ *
+ * @param    value is a value to the content of the mail you want to send.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is any other values, it means that the mailbox detach failed.
+ *
+ * @warning  This function can be called in interrupt context and thread context.
+ */
+static rt_err_t _rt_mb_send_wait(rt_mailbox_t mb,
+                         rt_ubase_t   value,
+                         rt_int32_t   timeout,
+                         int suspend_flag)
+{
+    rt_ssize_t ret;
+
+    ret = _rt_mb_send_batch(mb, &value, 1, timeout, suspend_flag);
+
+    return ret < 0 ? (rt_err_t)ret : RT_EOK;
 }
 
 rt_err_t rt_mb_send_wait(rt_mailbox_t mb,
@@ -2810,17 +3182,18 @@ RTM_EXPORT(rt_mb_urgent);
 
 
 /**
- * @brief    This function will receive a mail from mailbox object, if there is no mail in mailbox object,
+ * @brief    This function will receive up to count mails from mailbox object, if there is no mail in mailbox object,
  *           the thread shall wait for a specified time.
  *
- * @note     Only when there is mail in the mailbox, the receiving thread can get the mail immediately and
- *           return RT_EOK, otherwise the receiving thread will be suspended until the set timeout. If the mail
+ * @note     Only when there is mail in the mailbox, the receiving thread can get the mails immediately,
+ *           otherwise the receiving thread will be suspended until the set timeout. If the mail
  *           is still not received within the specified time, it will return-RT_ETIMEOUT.
  *
  * @param    mb is a pointer to the mailbox object to be received.
  *
- * @param    value is a flag that you will set for this mailbox's flag.
- *           You can set an mailbox flag, or you can set multiple flags through OR logic operations.
+ * @param    values is the array to store the received mails.
+ *
+ * @param    count is the capacity of the values array.
  *
  * @param    timeout is a timeout period (unit: an OS tick). If the mailbox object is not avaliable in the queue,
  *           the thread will wait for the object in the queue up to the amount of time specified by this parameter.
@@ -2831,19 +3204,27 @@ RTM_EXPORT(rt_mb_urgent);
  *           If use macro RT_WAITING_NO to set this parameter, which means that this
  *           function is non-blocking and will return immediately.
  *
- * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
- *           If the return value is any other values, it means that the mailbox release failed.
+ * @param    suspend_flag status flag of the thread to be suspended.
+ *
+ * @return   Return the number of mails received. If the return value is negative, no mail was received.
  */
-static rt_err_t _rt_mb_recv(rt_mailbox_t mb, rt_ubase_t *value, rt_int32_t timeout, int suspend_flag)
+static rt_ssize_t _rt_mb_recv_batch(rt_mailbox_t mb,
+                                    rt_ubase_t *values,
+                                    rt_size_t count,
+                                    rt_int32_t timeout,
+                                    int suspend_flag)
 {
     struct rt_thread *thread;
     rt_base_t level;
     rt_uint32_t tick_delta;
     rt_err_t ret;
+    rt_size_t recved;
 
     /* parameter check */
     RT_ASSERT(mb != RT_NULL);
     RT_ASSERT(rt_object_get_type(&mb->parent.parent) == RT_Object_Class_MailBox);
+    RT_ASSERT(values != RT_NULL);
+    RT_ASSERT(count != 0);
 
     /* current context checking */
     RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
@@ -2929,38 +3310,45 @@ static rt_err_t _rt_mb_recv(rt_mailbox_t mb, rt_ubase_t *value, rt_int32_t timeo
         }
     }
 
-    /* fill ptr */
-    *value = mb->msg_pool[mb->out_offset];
+    for (recved = 0; recved < count && mb->entry > 0; recved ++)
+    {
+        /* fill ptr */
+        values[recved] = mb->msg_pool[mb->out_offset];
 
-    /* increase output offset */
-    ++ mb->out_offset;
-    if (mb->out_offset >= mb->size)
-        mb->out_offset = 0;
+        /* increase output offset */
+        ++ mb->out_offset;
+        if (mb->out_offset >= mb->size)
+            mb->out_offset = 0;
 
-    /* decrease message entry */
-    if(mb->entry > 0)
-    {
+        /* decrease message entry */
         mb->entry --;
     }
 
     /* resume suspended thread */
-    if (!rt_list_isempty(&(mb->suspend_sender_thread)))
+    if (_ipc_list_resume_n(&(mb->suspend_sender_thread), recved))
     {
-        rt_susp_list_dequeue(&(mb->suspend_sender_thread), RT_EOK);
-
         rt_spin_unlock_irqrestore(&(mb->spinlock), level);
 
         RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mb->parent.parent)));
 
         rt_schedule();
 
-        return RT_EOK;
+        return recved;
     }
     rt_spin_unlock_irqrestore(&(mb->spinlock), level);
 
     RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mb->parent.parent)));
 
-    return RT_EOK;
+    return recved;
+}
+
+static rt_err_t _rt_mb_recv(rt_mailbox_t mb, rt_ubase_t *value, rt_int32_t timeout, int suspend_flag)
+{
+    rt_ssize_t ret;
+
+    ret = _rt_mb_recv_batch(mb, value, 1, timeout, suspend_flag);
+
+    return ret < 0 ? (rt_err_t)ret : RT_EOK;
 }
 
 rt_err_t rt_mb_recv(rt_mailbox_t mb, rt_ubase_t *value, rt_int32_t timeout)
@@ -2982,20 +3370,73 @@ rt_err_t rt_mb_recv_killable(rt_mailbox_t mb, rt_ubase_t *value, rt_int32_t time
 RTM_EXPORT(rt_mb_recv_killable);
 
 /**
- * @brief    This function will set some extra attributions of a mailbox object.
+ * @brief    This function will send up to count mails to the mailbox object under one lock acquisition.
  *
- * @note     Currently this function only supports the RT_IPC_CMD_RESET command to reset the mailbox.
+ * @note     If the mailbox is fully used, the current thread will wait for a timeout until there is space
+ *           for at least one mail. The suspended receivers are resumed together, so that the cost of
+ *           locking and scheduling is paid once per batch instead of once per mail.
  *
- * @param    mb is a pointer to a mailbox object.
+ * @see      rt_mb_send_wait()
  *
- * @param    cmd is a command used to configure some attributions of the mailbox.
+ * @param    mb is a pointer to the mailbox object to be sent.
  *
- * @param    arg is the argument of the function to execute the command.
+ * @param    values is the array of mails you want to send.
  *
- * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
- *           If the return value is any other values, it means that this function failed to execute.
+ * @param    count is the number of mails in the values array.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @return   Return the number of mails sent, which may be less than count.
+ *           If the return value is negative, no mail was sent.
+ *
+ * @warning  This function can be called in interrupt context only when timeout is RT_WAITING_NO.
  */
-rt_err_t rt_mb_control(rt_mailbox_t mb, int cmd, void *arg)
+rt_ssize_t rt_mb_send_batch(rt_mailbox_t mb, const rt_ubase_t *values, rt_size_t count, rt_int32_t timeout)
+{
+    return _rt_mb_send_batch(mb, values, count, timeout, RT_UNINTERRUPTIBLE);
+}
+RTM_EXPORT(rt_mb_send_batch);
+
+/**
+ * @brief    This function will receive up to count mails from the mailbox object under one lock acquisition.
+ *
+ * @note     If there is no mail in the mailbox, the current thread will wait for a timeout until at least
+ *           one mail arrives. The suspended senders are resumed together once the mails are taken.
+ *
+ * @see      rt_mb_recv()
+ *
+ * @param    mb is a pointer to the mailbox object to be received.
+ *
+ * @param    values is the array to store the received mails.
+ *
+ * @param    count is the capacity of the values array.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @return   Return the number of mails received, which may be less than count.
+ *           If the return value is negative, no mail was received.
+ */
+rt_ssize_t rt_mb_recv_batch(rt_mailbox_t mb, rt_ubase_t *values, rt_size_t count, rt_int32_t timeout)
+{
+    return _rt_mb_recv_batch(mb, values, count, timeout, RT_UNINTERRUPTIBLE);
+}
+RTM_EXPORT(rt_mb_recv_batch);
+
+/**
+ * @brief    This function will set some extra attributions of a mailbox object.
+ *
+ * @note     Currently this function only supports the RT_IPC_CMD_RESET command to reset the mailbox.
+ *
+ * @param    mb is a pointer to a mailbox object.
+ *
+ * @param    cmd is a command used to configure some attributions of the mailbox.
+ *
+ * @param    arg is the argument of the function to execute the command.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is any other values, it means that this function failed to execute.
+ */
+rt_err_t rt_mb_control(rt_mailbox_t mb, int cmd, void *arg)
 {
     rt_base_t level;
 
@@ -3333,73 +3774,44 @@ RTM_EXPORT(rt_mq_delete);
 #endif /* RT_USING_HEAP */
 
 /**
- * @brief    This function will send a message to the messagequeue object. If
- *           there is a thread suspended on the messagequeue, the thread will be
- *           resumed.
- *
- * @note     When using this function to send a message, if the messagequeue is
- *           fully used, the current thread will wait for a timeout. If reaching
- *           the timeout and there is still no space available, the sending
- *           thread will be resumed and an error code will be returned. By
- *           contrast, the _rt_mq_send_wait() function will return an error code
- *           immediately without waiting when the messagequeue if fully used.
- *
- * @see      _rt_mq_send_wait()
+ * @brief    This function will take up to count free message slots from the messagequeue object.
+ *           If the messagequeue is fully used, the current thread will wait for a timeout.
  *
- * @param    mq is a pointer to the messagequeue object to be sent.
+ * @note     The slots are unlinked from the free list as a chain terminated by RT_NULL and owned
+ *           by the caller until they are handed to _rt_mq_put_msg() or given back through
+ *           _rt_mq_free_msg().
  *
- * @param    buffer is the content of the message.
+ * @param    mq is a pointer to the messagequeue object.
  *
- * @param    size is the length of the message(Unit: Byte).
+ * @param    msg_out is a pointer to store the first free message slot of the chain.
  *
- * @param    prio is message priority, A larger value indicates a higher priority
+ * @param    count is the maximum number of message slots to take.
  *
  * @param    timeout is a timeout period (unit: an OS tick).
  *
  * @param    suspend_flag status flag of the thread to be suspended.
  *
- * @return   Return the operation status. When the return value is RT_EOK, the
- *           operation is successful. If the return value is any other values,
- *           it means that the messagequeue detach failed.
- *
- * @warning  This function can be called in interrupt context and thread
- * context.
+ * @return   Return the number of message slots taken. If the return value is -RT_EFULL,
+ *           the messagequeue is still fully used.
  */
-static rt_err_t _rt_mq_send_wait(rt_mq_t mq,
-                                 const void *buffer,
-                                 rt_size_t size,
-                                 rt_int32_t prio,
-                                 rt_int32_t timeout,
-                                 int suspend_flag)
+static rt_ssize_t _rt_mq_alloc_msg(rt_mq_t mq,
+                                   struct rt_mq_message **msg_out,
+                                   rt_size_t count,
+                                   rt_int32_t timeout,
+                                   int suspend_flag)
 {
     rt_base_t level;
-    struct rt_mq_message *msg;
+    struct rt_mq_message *msg, *last;
     rt_uint32_t tick_delta;
     struct rt_thread *thread;
     rt_err_t ret;
-
-    RT_UNUSED(prio);
-
-    /* parameter check */
-    RT_ASSERT(mq != RT_NULL);
-    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
-    RT_ASSERT(buffer != RT_NULL);
-    RT_ASSERT(size != 0);
-
-    /* current context checking */
-    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
-
-    /* greater than one message size */
-    if (size > mq->msg_size)
-        return -RT_ERROR;
+    rt_size_t taken;
 
     /* initialize delta tick */
     tick_delta = 0;
     /* get current thread */
     thread = rt_thread_self();
 
-    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
-
     level = rt_spin_lock_irqsave(&(mq->spinlock));
 
     /* get a free list, there must be an empty item */
@@ -3474,66 +3886,121 @@ static rt_err_t _rt_mq_send_wait(rt_mq_t mq,
         }
     }
 
+    /* take the slots from the head of free list */
+    last = msg;
+    for (taken = 1; taken < count && last->next != RT_NULL; taken ++)
+        last = last->next;
+
     /* move free list pointer */
-    mq->msg_queue_free = msg->next;
+    mq->msg_queue_free = last->next;
 
     rt_spin_unlock_irqrestore(&(mq->spinlock), level);
 
-    /* the msg is the new tailer of list, the next shall be NULL */
-    msg->next = RT_NULL;
+    /* the last msg is the new tailer of list, the next shall be NULL */
+    last->next = RT_NULL;
+    *msg_out = msg;
 
-    /* add the length */
-    ((struct rt_mq_message *)msg)->length = size;
-    /* copy buffer */
-    rt_memcpy(GET_MESSAGEBYTE_ADDR(msg), buffer, size);
+    return taken;
+}
+
+/**
+ * @brief    This function will link a chain of filled message slots into the messagequeue object.
+ *           The suspended receivers are resumed together and the scheduler runs at most once.
+ *
+ * @note     The length of each message shall be set by the caller.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    msg is the first message slot of the chain taken by _rt_mq_alloc_msg().
+ *
+ * @param    count is the number of message slots in the chain.
+ *
+ * @param    prio is message priority, A larger value indicates a higher priority
+ *
+ * @param    urgent is RT_TRUE to place the messages at the head of the messagequeue.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ */
+static rt_err_t _rt_mq_put_msg(rt_mq_t mq,
+                               struct rt_mq_message *msg,
+                               rt_size_t count,
+                               rt_int32_t prio,
+                               rt_bool_t urgent)
+{
+    rt_base_t level;
+    struct rt_mq_message *last;
+
+    RT_UNUSED(prio);
+
+    /* find the tail of the chain before taking the lock */
+    for (last = msg; last->next != RT_NULL; last = last->next);
 
-    /* disable interrupt */
     level = rt_spin_lock_irqsave(&(mq->spinlock));
-#ifdef RT_USING_MESSAGEQUEUE_PRIORITY
-    msg->prio = prio;
-    if (mq->msg_queue_head == RT_NULL)
+    if (urgent)
+    {
+        /* link msg to the beginning of message queue */
+        last->next = (struct rt_mq_message *)mq->msg_queue_head;
         mq->msg_queue_head = msg;
 
-    struct rt_mq_message *node, *prev_node = RT_NULL;
-    for (node = mq->msg_queue_head; node != RT_NULL; node = node->next)
+        /* if there is no tail */
+        if (mq->msg_queue_tail == RT_NULL)
+            mq->msg_queue_tail = last;
+    }
+    else
     {
-        if (node->prio < msg->prio)
+#ifdef RT_USING_MESSAGEQUEUE_PRIORITY
+        struct rt_mq_message *node, *prev_node, *next_msg;
+
+        for (; msg != RT_NULL; msg = next_msg)
         {
-            if (prev_node == RT_NULL)
+            next_msg = msg->next;
+            msg->next = RT_NULL;
+            msg->prio = prio;
+            if (mq->msg_queue_head == RT_NULL)
                 mq->msg_queue_head = msg;
-            else
-                prev_node->next = msg;
-            msg->next = node;
-            break;
+
+            prev_node = RT_NULL;
+            for (node = mq->msg_queue_head; node != RT_NULL; node = node->next)
+            {
+                if (node->prio < msg->prio)
+                {
+                    if (prev_node == RT_NULL)
+                        mq->msg_queue_head = msg;
+                    else
+                        prev_node->next = msg;
+                    msg->next = node;
+                    break;
+                }
+                if (node->next == RT_NULL)
+                {
+                    if (node != msg)
+                        node->next = msg;
+                    mq->msg_queue_tail = msg;
+                    break;
+                }
+                prev_node = node;
+            }
         }
-        if (node->next == RT_NULL)
+#else
+        /* link msg to message queue */
+        if (mq->msg_queue_tail != RT_NULL)
         {
-            if (node != msg)
-                node->next = msg;
-            mq->msg_queue_tail = msg;
-            break;
+            /* if the tail exists, */
+            ((struct rt_mq_message *)mq->msg_queue_tail)->next = msg;
         }
-        prev_node = node;
-    }
-#else
-    /* link msg to message queue */
-    if (mq->msg_queue_tail != RT_NULL)
-    {
-        /* if the tail exists, */
-        ((struct rt_mq_message *)mq->msg_queue_tail)->next = msg;
-    }
 
-    /* set new tail */
-    mq->msg_queue_tail = msg;
-    /* if the head is empty, set head */
-    if (mq->msg_queue_head == RT_NULL)
-        mq->msg_queue_head = msg;
+        /* set new tail */
+        mq->msg_queue_tail = last;
+        /* if the head is empty, set head */
+        if (mq->msg_queue_head == RT_NULL)
+            mq->msg_queue_head = msg;
 #endif
+    }
 
-    if(mq->entry < RT_MQ_ENTRY_MAX)
+    if(mq->entry + count <= RT_MQ_ENTRY_MAX)
     {
         /* increase message entry */
-        mq->entry ++;
+        mq->entry += count;
     }
     else
     {
@@ -3542,10 +4009,8 @@ static rt_err_t _rt_mq_send_wait(rt_mq_t mq,
     }
 
     /* resume suspended thread */
-    if (!rt_list_isempty(&mq->parent.suspend_thread))
+    if (_ipc_list_resume_n(&(mq->parent.suspend_thread), count))
     {
-        rt_susp_list_dequeue(&(mq->parent.suspend_thread), RT_EOK);
-
         rt_spin_unlock_irqrestore(&(mq->spinlock), level);
 
         rt_schedule();
@@ -3557,253 +4022,70 @@ static rt_err_t _rt_mq_send_wait(rt_mq_t mq,
     return RT_EOK;
 }
 
-rt_err_t rt_mq_send_wait(rt_mq_t     mq,
-                         const void *buffer,
-                         rt_size_t   size,
-                         rt_int32_t  timeout)
-{
-    return _rt_mq_send_wait(mq, buffer, size, 0, timeout, RT_UNINTERRUPTIBLE);
-}
-RTM_EXPORT(rt_mq_send_wait);
-
-rt_err_t rt_mq_send_wait_interruptible(rt_mq_t     mq,
-                         const void *buffer,
-                         rt_size_t   size,
-                         rt_int32_t  timeout)
-{
-    return _rt_mq_send_wait(mq, buffer, size, 0, timeout, RT_INTERRUPTIBLE);
-}
-RTM_EXPORT(rt_mq_send_wait_interruptible);
-
-rt_err_t rt_mq_send_wait_killable(rt_mq_t     mq,
-                         const void *buffer,
-                         rt_size_t   size,
-                         rt_int32_t  timeout)
-{
-    return _rt_mq_send_wait(mq, buffer, size, 0, timeout, RT_KILLABLE);
-}
-RTM_EXPORT(rt_mq_send_wait_killable);
 /**
- * @brief    This function will send a message to the messagequeue object.
- *           If there is a thread suspended on the messagequeue, the thread will be resumed.
- *
- * @note     When using this function to send a message, if the messagequeue is fully used,
- *           the current thread will wait for a timeout.
- *           By contrast, when the messagequeue is fully used, the rt_mq_send_wait() function will
- *           return an error code immediately without waiting.
- *
- * @see      rt_mq_send_wait()
- *
- * @param    mq is a pointer to the messagequeue object to be sent.
- *
- * @param    buffer is the content of the message.
- *
- * @param    size is the length of the message(Unit: Byte).
- *
- * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
- *           If the return value is any other values, it means that the messagequeue detach failed.
+ * @brief    This function will unlink up to count messages from the head of the messagequeue object.
+ *           If there is no message in the messagequeue, the thread shall wait for a specified time.
  *
- * @warning  This function can be called in interrupt context and thread context.
- */
-rt_err_t rt_mq_send(rt_mq_t mq, const void *buffer, rt_size_t size)
-{
-    return rt_mq_send_wait(mq, buffer, size, 0);
-}
-RTM_EXPORT(rt_mq_send);
-
-rt_err_t rt_mq_send_interruptible(rt_mq_t mq, const void *buffer, rt_size_t size)
-{
-    return rt_mq_send_wait_interruptible(mq, buffer, size, 0);
-}
-RTM_EXPORT(rt_mq_send_interruptible);
-
-rt_err_t rt_mq_send_killable(rt_mq_t mq, const void *buffer, rt_size_t size)
-{
-    return rt_mq_send_wait_killable(mq, buffer, size, 0);
-}
-RTM_EXPORT(rt_mq_send_killable);
-/**
- * @brief    This function will send an urgent message to the messagequeue object.
+ * @note     The messages are returned as a chain terminated by RT_NULL and owned by the caller
+ *           until they are given back through _rt_mq_free_msg().
  *
- * @note     This function is almost the same as the rt_mq_send() function. The only difference is that
- *           when sending an urgent message, the message is placed at the head of the messagequeue so that
- *           the recipient can receive the urgent message first.
+ * @param    mq is a pointer to the messagequeue object.
  *
- * @see      rt_mq_send()
+ * @param    msg_out is a pointer to store the first received message slot of the chain.
  *
- * @param    mq is a pointer to the messagequeue object to be sent.
+ * @param    count is the maximum number of messages to take.
  *
- * @param    buffer is the content of the message.
+ * @param    timeout is a timeout period (unit: an OS tick).
  *
- * @param    size is the length of the message(Unit: Byte).
+ * @param    suspend_flag status flag of the thread to be suspended.
  *
- * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
- *           If the return value is any other values, it means that the mailbox detach failed.
+ * @return   Return the number of messages taken. If the return value is -RT_ETIMEOUT,
+ *           there is still no message in the messagequeue.
  */
-rt_err_t rt_mq_urgent(rt_mq_t mq, const void *buffer, rt_size_t size)
+static rt_ssize_t _rt_mq_get_msg(rt_mq_t mq,
+                                 struct rt_mq_message **msg_out,
+                                 rt_size_t count,
+                                 rt_int32_t timeout,
+                                 int suspend_flag)
 {
+    struct rt_thread *thread;
     rt_base_t level;
-    struct rt_mq_message *msg;
-
-    /* parameter check */
-    RT_ASSERT(mq != RT_NULL);
-    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
-    RT_ASSERT(buffer != RT_NULL);
-    RT_ASSERT(size != 0);
-
-    /* greater than one message size */
-    if (size > mq->msg_size)
-        return -RT_ERROR;
+    struct rt_mq_message *msg, *last;
+    rt_uint32_t tick_delta;
+    rt_err_t ret;
+    rt_size_t taken;
 
-    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
+    /* initialize delta tick */
+    tick_delta = 0;
+    /* get current thread */
+    thread = rt_thread_self();
 
     level = rt_spin_lock_irqsave(&(mq->spinlock));
 
-    /* get a free list, there must be an empty item */
-    msg = (struct rt_mq_message *)mq->msg_queue_free;
-    /* message queue is full */
-    if (msg == RT_NULL)
+    /* for non-blocking call */
+    if (mq->entry == 0 && timeout == 0)
     {
         rt_spin_unlock_irqrestore(&(mq->spinlock), level);
 
-        return -RT_EFULL;
+        return -RT_ETIMEOUT;
     }
-    /* move free list pointer */
-    mq->msg_queue_free = msg->next;
-
-    rt_spin_unlock_irqrestore(&(mq->spinlock), level);
 
-    /* add the length */
-    ((struct rt_mq_message *)msg)->length = size;
-    /* copy buffer */
-    rt_memcpy(GET_MESSAGEBYTE_ADDR(msg), buffer, size);
+    /* message queue is empty */
+    while (mq->entry == 0)
+    {
+        /* reset error number in thread */
+        thread->error = -RT_EINTR;
 
-    level = rt_spin_lock_irqsave(&(mq->spinlock));
+        /* no waiting, return timeout */
+        if (timeout == 0)
+        {
+            /* enable interrupt */
+            rt_spin_unlock_irqrestore(&(mq->spinlock), level);
 
-    /* link msg to the beginning of message queue */
-    msg->next = (struct rt_mq_message *)mq->msg_queue_head;
-    mq->msg_queue_head = msg;
+            thread->error = -RT_ETIMEOUT;
 
-    /* if there is no tail */
-    if (mq->msg_queue_tail == RT_NULL)
-        mq->msg_queue_tail = msg;
-
-    if(mq->entry < RT_MQ_ENTRY_MAX)
-    {
-        /* increase message entry */
-        mq->entry ++;
-    }
-    else
-    {
-        rt_spin_unlock_irqrestore(&(mq->spinlock), level);
-        return -RT_EFULL; /* value overflowed */
-    }
-
-    /* resume suspended thread */
-    if (!rt_list_isempty(&mq->parent.suspend_thread))
-    {
-        rt_susp_list_dequeue(&(mq->parent.suspend_thread), RT_EOK);
-
-        rt_spin_unlock_irqrestore(&(mq->spinlock), level);
-
-        rt_schedule();
-
-        return RT_EOK;
-    }
-
-    rt_spin_unlock_irqrestore(&(mq->spinlock), level);
-
-    return RT_EOK;
-}
-RTM_EXPORT(rt_mq_urgent);
-
-/**
- * @brief    This function will receive a message from message queue object,
- *           if there is no message in messagequeue object, the thread shall wait for a specified time.
- *
- * @note     Only when there is mail in the mailbox, the receiving thread can get the mail immediately and return RT_EOK,
- *           otherwise the receiving thread will be suspended until timeout.
- *           If the mail is not received within the specified time, it will return -RT_ETIMEOUT.
- *
- * @param    mq is a pointer to the messagequeue object to be received.
- *
- * @param    buffer is the content of the message.
- *
- * @param    prio is message priority, A larger value indicates a higher priority
- *
- * @param    size is the length of the message(Unit: Byte).
- *
- * @param    timeout is a timeout period (unit: an OS tick). If the message is unavailable, the thread will wait for
- *           the message in the queue up to the amount of time specified by this parameter.
- *
- * @param    suspend_flag status flag of the thread to be suspended.
- *
- *           NOTE:
- *           If use Macro RT_WAITING_FOREVER to set this parameter, which means that when the
- *           message is unavailable in the queue, the thread will be waiting forever.
- *           If use macro RT_WAITING_NO to set this parameter, which means that this
- *           function is non-blocking and will return immediately.
- *
- * @return   Return the real length of the message. When the return value is larger than zero, the operation is successful.
- *           If the return value is any other values, it means that the mailbox release failed.
- */
-static rt_ssize_t _rt_mq_recv(rt_mq_t mq,
-                              void *buffer,
-                              rt_size_t size,
-                              rt_int32_t *prio,
-                              rt_int32_t timeout,
-                              int suspend_flag)
-{
-    struct rt_thread *thread;
-    rt_base_t level;
-    struct rt_mq_message *msg;
-    rt_uint32_t tick_delta;
-    rt_err_t ret;
-    rt_size_t len;
-
-    RT_UNUSED(prio);
-
-    /* parameter check */
-    RT_ASSERT(mq != RT_NULL);
-    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
-    RT_ASSERT(buffer != RT_NULL);
-    RT_ASSERT(size != 0);
-
-    /* current context checking */
-    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
-
-    /* initialize delta tick */
-    tick_delta = 0;
-    /* get current thread */
-    thread = rt_thread_self();
-    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
-
-    level = rt_spin_lock_irqsave(&(mq->spinlock));
-
-    /* for non-blocking call */
-    if (mq->entry == 0 && timeout == 0)
-    {
-        rt_spin_unlock_irqrestore(&(mq->spinlock), level);
-
-        return -RT_ETIMEOUT;
-    }
-
-    /* message queue is empty */
-    while (mq->entry == 0)
-    {
-        /* reset error number in thread */
-        thread->error = -RT_EINTR;
-
-        /* no waiting, return timeout */
-        if (timeout == 0)
-        {
-            /* enable interrupt */
-            rt_spin_unlock_irqrestore(&(mq->spinlock), level);
-
-            thread->error = -RT_ETIMEOUT;
-
-            return -RT_ETIMEOUT;
-        }
+            return -RT_ETIMEOUT;
+        }
 
         /* suspend current thread */
         ret = rt_thread_suspend_to_list(thread, &(mq->parent.suspend_thread),
@@ -3856,98 +4138,390 @@ static rt_ssize_t _rt_mq_recv(rt_mq_t mq,
 
     /* get message from queue */
     msg = (struct rt_mq_message *)mq->msg_queue_head;
+    last = msg;
+    for (taken = 1; taken < count && taken < mq->entry; taken ++)
+        last = last->next;
 
     /* move message queue head */
-    mq->msg_queue_head = msg->next;
+    mq->msg_queue_head = last->next;
     /* reach queue tail, set to NULL */
-    if (mq->msg_queue_tail == msg)
+    if (mq->msg_queue_tail == last)
         mq->msg_queue_tail = RT_NULL;
 
     /* decrease message entry */
-    if(mq->entry > 0)
-    {
-        mq->entry --;
-    }
+    mq->entry -= taken;
 
     rt_spin_unlock_irqrestore(&(mq->spinlock), level);
 
-    /* get real message length */
-    len = ((struct rt_mq_message *)msg)->length;
+    last->next = RT_NULL;
+    *msg_out = msg;
 
-    if (len > size)
-        len = size;
-    /* copy message */
-    rt_memcpy(buffer, GET_MESSAGEBYTE_ADDR(msg), len);
+    return taken;
+}
+
+/**
+ * @brief    This function will give a chain of message slots back to the free list of the messagequeue object.
+ *           The suspended senders are resumed together and the scheduler runs at most once.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    msg is the first message slot of the chain to be released.
+ *
+ * @param    count is the number of message slots in the chain.
+ */
+static void _rt_mq_free_msg(rt_mq_t mq, struct rt_mq_message *msg, rt_size_t count)
+{
+    rt_base_t level;
+    struct rt_mq_message *last;
+
+    /* find the tail of the chain before taking the lock */
+    for (last = msg; last->next != RT_NULL; last = last->next);
 
-#ifdef RT_USING_MESSAGEQUEUE_PRIORITY
-    if (prio != RT_NULL)
-        *prio = msg->prio;
-#endif
     level = rt_spin_lock_irqsave(&(mq->spinlock));
     /* put message to free list */
-    msg->next = (struct rt_mq_message *)mq->msg_queue_free;
+    last->next = (struct rt_mq_message *)mq->msg_queue_free;
     mq->msg_queue_free = msg;
 
     /* resume suspended thread */
-    if (!rt_list_isempty(&(mq->suspend_sender_thread)))
+    if (_ipc_list_resume_n(&(mq->suspend_sender_thread), count))
     {
-        rt_susp_list_dequeue(&(mq->suspend_sender_thread), RT_EOK);
-
         rt_spin_unlock_irqrestore(&(mq->spinlock), level);
 
-        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
-
         rt_schedule();
 
-        return len;
+        return;
     }
 
     rt_spin_unlock_irqrestore(&(mq->spinlock), level);
+}
 
-    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
+/**
+ * @brief    This function will convert a loaned message buffer back to its message slot.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    buffer is the message buffer returned by rt_mq_send_loan() or rt_mq_recv_loan().
+ *
+ * @return   Return the message slot which holds the buffer.
+ */
+rt_inline struct rt_mq_message *_rt_mq_buffer_to_msg(rt_mq_t mq, void *buffer)
+{
+    struct rt_mq_message *msg;
 
-    return len;
+    RT_ASSERT(buffer != RT_NULL);
+
+    msg = (struct rt_mq_message *)buffer - 1;
+
+    /* the buffer must be a slot in the message pool */
+    RT_ASSERT((rt_uint8_t *)msg >= (rt_uint8_t *)mq->msg_pool);
+    RT_ASSERT((rt_uint8_t *)msg < (rt_uint8_t *)mq->msg_pool +
+              mq->max_msgs * (RT_ALIGN(mq->msg_size, RT_ALIGN_SIZE) + sizeof(struct rt_mq_message)));
+    RT_ASSERT(((rt_uint8_t *)msg - (rt_uint8_t *)mq->msg_pool) %
+              (RT_ALIGN(mq->msg_size, RT_ALIGN_SIZE) + sizeof(struct rt_mq_message)) == 0);
+
+    return msg;
 }
 
-rt_ssize_t rt_mq_recv(rt_mq_t    mq,
-                    void      *buffer,
-                    rt_size_t  size,
-                    rt_int32_t timeout)
+/**
+ * @brief    This function will send a message to the messagequeue object. If
+ *           there is a thread suspended on the messagequeue, the thread will be
+ *           resumed.
+ *
+ * @note     When using this function to send a message, if the messagequeue is
+ *           fully used, the current thread will wait for a timeout. If reaching
+ *           the timeout and there is still no space available, the sending
+ *           thread will be resumed and an error code will be returned. By
+ *           contrast, the _rt_mq_send_wait() function will return an error code
+ *           immediately without waiting when the messagequeue if fully used.
+ *
+ * @see      _rt_mq_send_wait()
+ *
+ * @param    mq is a pointer to the messagequeue object to be sent.
+ *
+ * @param    buffer is the content of the message.
+ *
+ * @param    size is the length of the message(Unit: Byte).
+ *
+ * @param    prio is message priority, A larger value indicates a higher priority
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @param    suspend_flag status flag of the thread to be suspended.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the
+ *           operation is successful. If the return value is any other values,
+ *           it means that the messagequeue detach failed.
+ *
+ * @warning  This function can be called in interrupt context and thread
+ * context.
+ */
+static rt_err_t _rt_mq_send_wait(rt_mq_t mq,
+                                 const void *buffer,
+                                 rt_size_t size,
+                                 rt_int32_t prio,
+                                 rt_int32_t timeout,
+                                 int suspend_flag)
 {
-    return _rt_mq_recv(mq, buffer, size, 0, timeout, RT_UNINTERRUPTIBLE);
+    struct rt_mq_message *msg;
+    rt_ssize_t ret;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+    RT_ASSERT(size != 0);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    /* greater than one message size */
+    if (size > mq->msg_size)
+        return -RT_ERROR;
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
+
+    ret = _rt_mq_alloc_msg(mq, &msg, 1, timeout, suspend_flag);
+    if (ret < 0)
+        return (rt_err_t)ret;
+
+    /* add the length */
+    msg->length = size;
+    /* copy buffer */
+    rt_memcpy(GET_MESSAGEBYTE_ADDR(msg), buffer, size);
+
+    return _rt_mq_put_msg(mq, msg, 1, prio, RT_FALSE);
 }
-RTM_EXPORT(rt_mq_recv);
 
-rt_ssize_t rt_mq_recv_interruptible(rt_mq_t    mq,
-                    void      *buffer,
-                    rt_size_t  size,
-                    rt_int32_t timeout)
+rt_err_t rt_mq_send_wait(rt_mq_t     mq,
+                         const void *buffer,
+                         rt_size_t   size,
+                         rt_int32_t  timeout)
 {
-    return _rt_mq_recv(mq, buffer, size, 0, timeout, RT_INTERRUPTIBLE);
+    return _rt_mq_send_wait(mq, buffer, size, 0, timeout, RT_UNINTERRUPTIBLE);
 }
-RTM_EXPORT(rt_mq_recv_interruptible);
+RTM_EXPORT(rt_mq_send_wait);
 
-rt_ssize_t rt_mq_recv_killable(rt_mq_t    mq,
-                    void      *buffer,
-                    rt_size_t  size,
-                    rt_int32_t timeout)
+rt_err_t rt_mq_send_wait_interruptible(rt_mq_t     mq,
+                         const void *buffer,
+                         rt_size_t   size,
+                         rt_int32_t  timeout)
 {
-    return _rt_mq_recv(mq, buffer, size, 0, timeout, RT_KILLABLE);
+    return _rt_mq_send_wait(mq, buffer, size, 0, timeout, RT_INTERRUPTIBLE);
 }
-#ifdef RT_USING_MESSAGEQUEUE_PRIORITY
-rt_err_t rt_mq_send_wait_prio(rt_mq_t mq,
-                              const void *buffer,
-                              rt_size_t size,
-                              rt_int32_t prio,
-                              rt_int32_t timeout,
-                              int suspend_flag)
+RTM_EXPORT(rt_mq_send_wait_interruptible);
+
+rt_err_t rt_mq_send_wait_killable(rt_mq_t     mq,
+                         const void *buffer,
+                         rt_size_t   size,
+                         rt_int32_t  timeout)
 {
-    return _rt_mq_send_wait(mq, buffer, size, prio, timeout, suspend_flag);
+    return _rt_mq_send_wait(mq, buffer, size, 0, timeout, RT_KILLABLE);
 }
-rt_ssize_t rt_mq_recv_prio(rt_mq_t mq,
-                           void *buffer,
-                           rt_size_t size,
-                           rt_int32_t *prio,
+RTM_EXPORT(rt_mq_send_wait_killable);
+/**
+ * @brief    This function will send a message to the messagequeue object.
+ *           If there is a thread suspended on the messagequeue, the thread will be resumed.
+ *
+ * @note     When using this function to send a message, if the messagequeue is fully used,
+ *           the current thread will wait for a timeout.
+ *           By contrast, when the messagequeue is fully used, the rt_mq_send_wait() function will
+ *           return an error code immediately without waiting.
+ *
+ * @see      rt_mq_send_wait()
+ *
+ * @param    mq is a pointer to the messagequeue object to be sent.
+ *
+ * @param    buffer is the content of the message.
+ *
+ * @param    size is the length of the message(Unit: Byte).
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is any other values, it means that the messagequeue detach failed.
+ *
+ * @warning  This function can be called in interrupt context and thread context.
+ */
+rt_err_t rt_mq_send(rt_mq_t mq, const void *buffer, rt_size_t size)
+{
+    return rt_mq_send_wait(mq, buffer, size, 0);
+}
+RTM_EXPORT(rt_mq_send);
+
+rt_err_t rt_mq_send_interruptible(rt_mq_t mq, const void *buffer, rt_size_t size)
+{
+    return rt_mq_send_wait_interruptible(mq, buffer, size, 0);
+}
+RTM_EXPORT(rt_mq_send_interruptible);
+
+rt_err_t rt_mq_send_killable(rt_mq_t mq, const void *buffer, rt_size_t size)
+{
+    return rt_mq_send_wait_killable(mq, buffer, size, 0);
+}
+RTM_EXPORT(rt_mq_send_killable);
+/**
+ * @brief    This function will send an urgent message to the messagequeue object.
+ *
+ * @note     This function is almost the same as the rt_mq_send() function. The only difference is that
+ *           when sending an urgent message, the message is placed at the head of the messagequeue so that
+ *           the recipient can receive the urgent message first.
+ *
+ * @see      rt_mq_send()
+ *
+ * @param    mq is a pointer to the messagequeue object to be sent.
+ *
+ * @param    buffer is the content of the message.
+ *
+ * @param    size is the length of the message(Unit: Byte).
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is any other values, it means that the mailbox detach failed.
+ */
+rt_err_t rt_mq_urgent(rt_mq_t mq, const void *buffer, rt_size_t size)
+{
+    struct rt_mq_message *msg;
+    rt_ssize_t ret;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+    RT_ASSERT(size != 0);
+
+    /* greater than one message size */
+    if (size > mq->msg_size)
+        return -RT_ERROR;
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
+
+    /* urgent message never waits for a free slot */
+    ret = _rt_mq_alloc_msg(mq, &msg, 1, RT_WAITING_NO, RT_UNINTERRUPTIBLE);
+    if (ret < 0)
+        return (rt_err_t)ret;
+
+    /* add the length */
+    msg->length = size;
+    /* copy buffer */
+    rt_memcpy(GET_MESSAGEBYTE_ADDR(msg), buffer, size);
+
+    return _rt_mq_put_msg(mq, msg, 1, 0, RT_TRUE);
+}
+RTM_EXPORT(rt_mq_urgent);
+
+/**
+ * @brief    This function will receive a message from message queue object,
+ *           if there is no message in messagequeue object, the thread shall wait for a specified time.
+ *
+ * @note     Only when there is mail in the mailbox, the receiving thread can get the mail immediately and return RT_EOK,
+ *           otherwise the receiving thread will be suspended until timeout.
+ *           If the mail is not received within the specified time, it will return -RT_ETIMEOUT.
+ *
+ * @param    mq is a pointer to the messagequeue object to be received.
+ *
+ * @param    buffer is the content of the message.
+ *
+ * @param    prio is message priority, A larger value indicates a higher priority
+ *
+ * @param    size is the length of the message(Unit: Byte).
+ *
+ * @param    timeout is a timeout period (unit: an OS tick). If the message is unavailable, the thread will wait for
+ *           the message in the queue up to the amount of time specified by this parameter.
+ *
+ * @param    suspend_flag status flag of the thread to be suspended.
+ *
+ *           NOTE:
+ *           If use Macro RT_WAITING_FOREVER to set this parameter, which means that when the
+ *           message is unavailable in the queue, the thread will be waiting forever.
+ *           If use macro RT_WAITING_NO to set this parameter, which means that this
+ *           function is non-blocking and will return immediately.
+ *
+ * @return   Return the real length of the message. When the return value is larger than zero, the operation is successful.
+ *           If the return value is any other values, it means that the mailbox release failed.
+ */
+static rt_ssize_t _rt_mq_recv(rt_mq_t mq,
+                              void *buffer,
+                              rt_size_t size,
+                              rt_int32_t *prio,
+                              rt_int32_t timeout,
+                              int suspend_flag)
+{
+    struct rt_mq_message *msg;
+    rt_ssize_t ret;
+    rt_size_t len;
+
+    RT_UNUSED(prio);
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+    RT_ASSERT(size != 0);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
+
+    ret = _rt_mq_get_msg(mq, &msg, 1, timeout, suspend_flag);
+    if (ret < 0)
+        return ret;
+
+    /* get real message length */
+    len = ((struct rt_mq_message *)msg)->length;
+
+    if (len > size)
+        len = size;
+    /* copy message */
+    rt_memcpy(buffer, GET_MESSAGEBYTE_ADDR(msg), len);
+
+#ifdef RT_USING_MESSAGEQUEUE_PRIORITY
+    if (prio != RT_NULL)
+        *prio = msg->prio;
+#endif
+    _rt_mq_free_msg(mq, msg, 1);
+
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
+
+    return len;
+}
+
+rt_ssize_t rt_mq_recv(rt_mq_t    mq,
+                    void      *buffer,
+                    rt_size_t  size,
+                    rt_int32_t timeout)
+{
+    return _rt_mq_recv(mq, buffer, size, 0, timeout, RT_UNINTERRUPTIBLE);
+}
+RTM_EXPORT(rt_mq_recv);
+
+rt_ssize_t rt_mq_recv_interruptible(rt_mq_t    mq,
+                    void      *buffer,
+                    rt_size_t  size,
+                    rt_int32_t timeout)
+{
+    return _rt_mq_recv(mq, buffer, size, 0, timeout, RT_INTERRUPTIBLE);
+}
+RTM_EXPORT(rt_mq_recv_interruptible);
+
+rt_ssize_t rt_mq_recv_killable(rt_mq_t    mq,
+                    void      *buffer,
+                    rt_size_t  size,
+                    rt_int32_t timeout)
+{
+    return _rt_mq_recv(mq, buffer, size, 0, timeout, RT_KILLABLE);
+}
+#ifdef RT_USING_MESSAGEQUEUE_PRIORITY
+rt_err_t rt_mq_send_wait_prio(rt_mq_t mq,
+                              const void *buffer,
+                              rt_size_t size,
+                              rt_int32_t prio,
+                              rt_int32_t timeout,
+                              int suspend_flag)
+{
+    return _rt_mq_send_wait(mq, buffer, size, prio, timeout, suspend_flag);
+}
+rt_ssize_t rt_mq_recv_prio(rt_mq_t mq,
+                           void *buffer,
+                           rt_size_t size,
+                           rt_int32_t *prio,
                            rt_int32_t timeout,
                            int suspend_flag)
 {
@@ -3955,6 +4529,431 @@ rt_ssize_t rt_mq_recv_prio(rt_mq_t mq,
 }
 #endif
 RTM_EXPORT(rt_mq_recv_killable);
+
+/**
+ * @brief    This function will loan a free message buffer from the messagequeue object,
+ *           so that the sender can fill the message in place without an extra copy.
+ *
+ * @note     The loaned buffer MUST be handed back with exactly one of rt_mq_send_commit(),
+ *           rt_mq_urgent_commit(), rt_mq_send_commit_prio() or rt_mq_send_abort().
+ *           The buffer can hold up to msg_size bytes given in rt_mq_init() or rt_mq_create().
+ *           If the messagequeue is fully used, the current thread will wait for a timeout.
+ *
+ * @see      rt_mq_send_wait()
+ *
+ * @param    mq is a pointer to the messagequeue object to be sent.
+ *
+ * @param    buffer is a pointer to store the address of the loaned message buffer.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is -RT_EFULL, there is no free message buffer in the messagequeue.
+ *
+ * @warning  This function can be called in interrupt context only when timeout is RT_WAITING_NO.
+ */
+rt_err_t rt_mq_send_loan(rt_mq_t mq, void **buffer, rt_int32_t timeout)
+{
+    struct rt_mq_message *msg;
+    rt_ssize_t ret;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
+
+    ret = _rt_mq_alloc_msg(mq, &msg, 1, timeout, RT_UNINTERRUPTIBLE);
+    if (ret < 0)
+    {
+        *buffer = RT_NULL;
+        return (rt_err_t)ret;
+    }
+
+    *buffer = GET_MESSAGEBYTE_ADDR(msg);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_send_loan);
+
+/**
+ * @brief    This function will commit a loaned message buffer to the tail of the messagequeue object.
+ *           If there is a thread suspended on the messagequeue, the thread will be resumed.
+ *
+ * @see      rt_mq_send_loan()
+ *
+ * @param    mq is a pointer to the messagequeue object to be sent.
+ *
+ * @param    buffer is the message buffer returned by rt_mq_send_loan().
+ *
+ * @param    size is the length of the message(Unit: Byte).
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is any other values, the buffer is still owned by the caller.
+ *
+ * @warning  This function can be called in interrupt context and thread context.
+ */
+rt_err_t rt_mq_send_commit(rt_mq_t mq, void *buffer, rt_size_t size)
+{
+    struct rt_mq_message *msg;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(size != 0);
+
+    /* greater than one message size */
+    if (size > mq->msg_size)
+        return -RT_ERROR;
+
+    msg = _rt_mq_buffer_to_msg(mq, buffer);
+    msg->length = size;
+
+    return _rt_mq_put_msg(mq, msg, 1, 0, RT_FALSE);
+}
+RTM_EXPORT(rt_mq_send_commit);
+
+/**
+ * @brief    This function will commit a loaned message buffer as an urgent message,
+ *           which is placed at the head of the messagequeue.
+ *
+ * @see      rt_mq_send_loan(), rt_mq_urgent()
+ *
+ * @param    mq is a pointer to the messagequeue object to be sent.
+ *
+ * @param    buffer is the message buffer returned by rt_mq_send_loan().
+ *
+ * @param    size is the length of the message(Unit: Byte).
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is any other values, the buffer is still owned by the caller.
+ *
+ * @warning  This function can be called in interrupt context and thread context.
+ */
+rt_err_t rt_mq_urgent_commit(rt_mq_t mq, void *buffer, rt_size_t size)
+{
+    struct rt_mq_message *msg;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(size != 0);
+
+    /* greater than one message size */
+    if (size > mq->msg_size)
+        return -RT_ERROR;
+
+    msg = _rt_mq_buffer_to_msg(mq, buffer);
+    msg->length = size;
+
+    return _rt_mq_put_msg(mq, msg, 1, 0, RT_TRUE);
+}
+RTM_EXPORT(rt_mq_urgent_commit);
+
+/**
+ * @brief    This function will give a loaned message buffer back to the messagequeue object
+ *           without sending it.
+ *
+ * @see      rt_mq_send_loan()
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    buffer is the message buffer returned by rt_mq_send_loan().
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ */
+rt_err_t rt_mq_send_abort(rt_mq_t mq, void *buffer)
+{
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+
+    _rt_mq_free_msg(mq, _rt_mq_buffer_to_msg(mq, buffer), 1);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_send_abort);
+
+/**
+ * @brief    This function will loan the first message buffer of the messagequeue object to the receiver,
+ *           so that the message can be consumed in place without an extra copy.
+ *
+ * @note     The loaned buffer MUST be given back with rt_mq_recv_release() once the message has
+ *           been consumed. Until then, the slot is not available to the senders.
+ *
+ * @see      rt_mq_recv()
+ *
+ * @param    mq is a pointer to the messagequeue object to be received.
+ *
+ * @param    buffer is a pointer to store the address of the message buffer.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @return   Return the real length of the message. When the return value is larger than zero, the operation is successful.
+ *           If the return value is any other values, it means that no message was received.
+ */
+rt_ssize_t rt_mq_recv_loan(rt_mq_t mq, void **buffer, rt_int32_t timeout)
+{
+    struct rt_mq_message *msg;
+    rt_ssize_t ret;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
+
+    ret = _rt_mq_get_msg(mq, &msg, 1, timeout, RT_UNINTERRUPTIBLE);
+    if (ret < 0)
+    {
+        *buffer = RT_NULL;
+        return ret;
+    }
+
+    *buffer = GET_MESSAGEBYTE_ADDR(msg);
+
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
+
+    return msg->length;
+}
+RTM_EXPORT(rt_mq_recv_loan);
+
+/**
+ * @brief    This function will give a received message buffer back to the messagequeue object.
+ *           If there is a sender suspended on the messagequeue, the sender will be resumed.
+ *
+ * @see      rt_mq_recv_loan()
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    buffer is the message buffer returned by rt_mq_recv_loan().
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ */
+rt_err_t rt_mq_recv_release(rt_mq_t mq, void *buffer)
+{
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+
+    _rt_mq_free_msg(mq, _rt_mq_buffer_to_msg(mq, buffer), 1);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_recv_release);
+
+/**
+ * @brief    This function will send up to count messages to the messagequeue object under one lock acquisition.
+ *
+ * @note     The messages are laid out back to back in the buffer, each of them is size bytes long.
+ *           If the messagequeue is fully used, the current thread will wait for a timeout until there is
+ *           space for at least one message. The suspended receivers are resumed together, so that the cost
+ *           of locking and scheduling is paid once per batch instead of once per message.
+ *
+ * @see      rt_mq_send_wait()
+ *
+ * @param    mq is a pointer to the messagequeue object to be sent.
+ *
+ * @param    buffer is the content of the messages.
+ *
+ * @param    size is the length of each message(Unit: Byte).
+ *
+ * @param    count is the number of messages in the buffer.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @return   Return the number of messages sent, which may be less than count.
+ *           If the return value is negative, no message was sent.
+ *
+ * @warning  This function can be called in interrupt context only when timeout is RT_WAITING_NO.
+ */
+rt_ssize_t rt_mq_send_batch(rt_mq_t     mq,
+                            const void *buffer,
+                            rt_size_t   size,
+                            rt_size_t   count,
+                            rt_int32_t  timeout)
+{
+    struct rt_mq_message *msg, *node;
+    const rt_uint8_t *ptr;
+    rt_ssize_t sent;
+    rt_err_t ret;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+    RT_ASSERT(size != 0);
+    RT_ASSERT(count != 0);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    /* greater than one message size */
+    if (size > mq->msg_size)
+        return -RT_ERROR;
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
+
+    sent = _rt_mq_alloc_msg(mq, &msg, count, timeout, RT_UNINTERRUPTIBLE);
+    if (sent < 0)
+        return sent;
+
+    /* copy buffer */
+    ptr = (const rt_uint8_t *)buffer;
+    for (node = msg; node != RT_NULL; node = node->next)
+    {
+        node->length = size;
+        rt_memcpy(GET_MESSAGEBYTE_ADDR(node), ptr, size);
+        ptr += size;
+    }
+
+    ret = _rt_mq_put_msg(mq, msg, sent, 0, RT_FALSE);
+    if (ret != RT_EOK)
+        return ret;
+
+    return sent;
+}
+RTM_EXPORT(rt_mq_send_batch);
+
+/**
+ * @brief    This function will receive up to count messages from the messagequeue object under one lock acquisition.
+ *
+ * @note     The messages are copied back to back into the buffer, each of them takes size bytes.
+ *           If there is no message in the messagequeue, the current thread will wait for a timeout until
+ *           at least one message arrives. The suspended senders are resumed together once the slots are freed.
+ *
+ * @see      rt_mq_recv()
+ *
+ * @param    mq is a pointer to the messagequeue object to be received.
+ *
+ * @param    buffer is the buffer to store the messages, which is at least size * count bytes.
+ *
+ * @param    size is the room for each message in the buffer(Unit: Byte).
+ *
+ * @param    count is the maximum number of messages to receive.
+ *
+ * @param    lengths is an optional array of count entries to store the real length of each message.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @return   Return the number of messages received, which may be less than count.
+ *           If the return value is negative, no message was received.
+ */
+rt_ssize_t rt_mq_recv_batch(rt_mq_t    mq,
+                            void      *buffer,
+                            rt_size_t  size,
+                            rt_size_t  count,
+                            rt_size_t *lengths,
+                            rt_int32_t timeout)
+{
+    struct rt_mq_message *msg, *node;
+    rt_uint8_t *ptr;
+    rt_ssize_t recved;
+    rt_size_t len;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+    RT_ASSERT(size != 0);
+    RT_ASSERT(count != 0);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
+
+    recved = _rt_mq_get_msg(mq, &msg, count, timeout, RT_UNINTERRUPTIBLE);
+    if (recved < 0)
+        return recved;
+
+    /* copy message */
+    ptr = (rt_uint8_t *)buffer;
+    for (node = msg; node != RT_NULL; node = node->next)
+    {
+        len = node->length;
+        if (len > size)
+            len = size;
+        rt_memcpy(ptr, GET_MESSAGEBYTE_ADDR(node), len);
+        ptr += size;
+
+        if (lengths != RT_NULL)
+            *lengths ++ = len;
+    }
+
+    _rt_mq_free_msg(mq, msg, recved);
+
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
+
+    return recved;
+}
+RTM_EXPORT(rt_mq_recv_batch);
+
+#ifdef RT_USING_MESSAGEQUEUE_PRIORITY
+rt_err_t rt_mq_send_commit_prio(rt_mq_t mq, void *buffer, rt_size_t size, rt_int32_t prio)
+{
+    struct rt_mq_message *msg;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(size != 0);
+
+    /* greater than one message size */
+    if (size > mq->msg_size)
+        return -RT_ERROR;
+
+    msg = _rt_mq_buffer_to_msg(mq, buffer);
+    msg->length = size;
+
+    return _rt_mq_put_msg(mq, msg, 1, prio, RT_FALSE);
+}
+RTM_EXPORT(rt_mq_send_commit_prio);
+
+rt_ssize_t rt_mq_recv_loan_prio(rt_mq_t mq,
+                                void **buffer,
+                                rt_int32_t *prio,
+                                rt_int32_t timeout,
+                                int suspend_flag)
+{
+    struct rt_mq_message *msg;
+    rt_ssize_t ret;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
+
+    ret = _rt_mq_get_msg(mq, &msg, 1, timeout, suspend_flag);
+    if (ret < 0)
+    {
+        *buffer = RT_NULL;
+        return ret;
+    }
+
+    *buffer = GET_MESSAGEBYTE_ADDR(msg);
+    if (prio != RT_NULL)
+        *prio = msg->prio;
+
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
+
+    return msg->length;
+}
+RTM_EXPORT(rt_mq_recv_loan_prio);
+#endif /* RT_USING_MESSAGEQUEUE_PRIORITY */
 /**
  * @brief    This function will set some extra attributions of a messagequeue object.
  *
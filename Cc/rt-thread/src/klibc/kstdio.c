@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2024-03-10     Meco Man     the first version
+ * 2026-10-18     Cc           digit pairs and reciprocals for integers, fast path of %d %u %x %s
  */
 
 #include <rtdef.h>
@@ -24,33 +25,118 @@
 /* private function */
 #define _ISDIGIT(c)  ((unsigned)((c) - '0') < 10)
 
+/* n / 100 of a 32-bit n by multiplying with the reciprocal */
+#define _DIV100(n)   ((rt_uint32_t)(((rt_uint64_t)(n) * 0x51eb851fu) >> 37))
+
+static const char _digit_pairs[200] =
+{
+    '0','0','0','1','0','2','0','3','0','4','0','5','0','6','0','7','0','8','0','9',
+    '1','0','1','1','1','2','1','3','1','4','1','5','1','6','1','7','1','8','1','9',
+    '2','0','2','1','2','2','2','3','2','4','2','5','2','6','2','7','2','8','2','9',
+    '3','0','3','1','3','2','3','3','3','4','3','5','3','6','3','7','3','8','3','9',
+    '4','0','4','1','4','2','4','3','4','4','4','5','4','6','4','7','4','8','4','9',
+    '5','0','5','1','5','2','5','3','5','4','5','5','5','6','5','7','5','8','5','9',
+    '6','0','6','1','6','2','6','3','6','4','6','5','6','6','6','7','6','8','6','9',
+    '7','0','7','1','7','2','7','3','7','4','7','5','7','6','7','7','7','8','7','9',
+    '8','0','8','1','8','2','8','3','8','4','8','5','8','6','8','7','8','8','8','9',
+    '9','0','9','1','9','2','9','3','9','4','9','5','9','6','9','7','9','8','9','9',
+};
+
+static const char _small_digits[] = "0123456789abcdef";
+static const char _large_digits[] = "0123456789ABCDEF";
+
 /**
- * @brief  This function will duplicate a string.
+ * @brief  This function will put the decimal digits of a 32-bit number in front
+ *         of a buffer, two digits per division.
  *
- * @param  n is the string to be duplicated.
+ * @param  p is the end of the digits.
  *
- * @param  base is support divide instructions value.
+ * @param  n is the number.
  *
- * @return the duplicated string pointer.
+ * @return the first digit.
+ */
+static char *_utoa10(char *p, rt_uint32_t n)
+{
+    rt_uint32_t q;
+
+    while (n >= 100)
+    {
+        q = _DIV100(n);
+        p -= 2;
+        p[0] = _digit_pairs[(n - q * 100) * 2];
+        p[1] = _digit_pairs[(n - q * 100) * 2 + 1];
+        n = q;
+    }
+
+    if (n >= 10)
+    {
+        p -= 2;
+        p[0] = _digit_pairs[n * 2];
+        p[1] = _digit_pairs[n * 2 + 1];
+    }
+    else
+    {
+        *--p = '0' + n;
+    }
+
+    return p;
+}
+
+/**
+ * @brief  This function will put the digits of a number in front of a buffer.
+ *
+ * @param  p is the end of the digits.
+ *
+ * @param  num is the number.
+ *
+ * @param  base is 2, 8, 10 or 16.
+ *
+ * @param  digits are the digit characters of base 16.
+ *
+ * @return the first digit.
  */
 #ifdef RT_KPRINTF_USING_LONGLONG
-rt_inline int divide(unsigned long long *n, int base)
+static char *_utoa(char *p, unsigned long long num, int base, const char *digits)
 #else
-rt_inline int divide(unsigned long *n, int base)
+static char *_utoa(char *p, unsigned long num, int base, const char *digits)
 #endif /* RT_KPRINTF_USING_LONGLONG */
 {
-    int res;
+    int shift, mask;
+#if defined(RT_KPRINTF_USING_LONGLONG)
+    unsigned long long q;
+    char *low;
+#elif defined(ARCH_CPU_64BIT)
+    unsigned long q;
+    char *low;
+#endif /* defined(RT_KPRINTF_USING_LONGLONG) */
+
+    if (base == 10)
+    {
+#if defined(RT_KPRINTF_USING_LONGLONG) || defined(ARCH_CPU_64BIT)
+        /* one wide division per 9 digits, the rest in 32 bits */
+        while (num > 0xffffffffu)
+        {
+            q = num / 1000000000u;
+            low = p - 9;
+            p = _utoa10(p, (rt_uint32_t)(num - q * 1000000000u));
+            while (p > low)
+                *--p = '0';
+            num = q;
+        }
+#endif /* defined(RT_KPRINTF_USING_LONGLONG) || defined(ARCH_CPU_64BIT) */
 
-    /* optimized for processor which does not support divide instructions. */
-#ifdef RT_KPRINTF_USING_LONGLONG
-    res = (int)((*n) % base);
-    *n = (long long)((*n) / base);
-#else
-    res = (int)((*n) % base);
-    *n = (long)((*n) / base);
-#endif
+        return _utoa10(p, (rt_uint32_t)num);
+    }
 
-    return res;
+    shift = base == 16 ? 4 : base == 8 ? 3 : 1;
+    mask = base - 1;
+    do
+    {
+        *--p = digits[num & mask];
+        num >>= shift;
+    } while (num != 0);
+
+    return p;
 }
 
 rt_inline int skip_atoi(const char **s)
@@ -69,6 +155,19 @@ rt_inline int skip_atoi(const char **s)
 #define LEFT        (1 << 4)    /* left justified */
 #define SPECIAL     (1 << 5)    /* 0x */
 #define LARGE       (1 << 6)    /* use 'ABCDEF' instead of 'abcdef' */
+#define FAST        (1 << 7)    /* a compiled %d, %u, %x or %s taking the fast path */
+
+#define FMT_ARG     (-2)        /* width or precision taken from the arguments */
+
+/* one parsed conversion */
+struct fmt_spec
+{
+    int         field_width;    /* width of output field */
+    int         precision;      /* min. # of digits for integers and max for a string */
+    rt_uint8_t  flags;          /* flags to print number */
+    rt_uint8_t  qualifier;      /* 'h', 'l', or 'L' for integer fields */
+    char        conv;           /* the conversion, '\0' if the format ends */
+};
 
 static char *print_number(char *buf,
                           char *end,
@@ -85,20 +184,17 @@ static char *print_number(char *buf,
 {
     char c = 0, sign = 0;
 #ifdef RT_KPRINTF_USING_LONGLONG
-    char tmp[64] = {0};
+    char tmp[64];
 #else
-    char tmp[32] = {0};
+    char tmp[sizeof(unsigned long) * 8];    /* the binary digits of a long */
 #endif /* RT_KPRINTF_USING_LONGLONG */
+    char *digit = RT_NULL;
     int precision_bak = precision;
-    const char *digits = RT_NULL;
-    static const char small_digits[] = "0123456789abcdef";
-    static const char large_digits[] = "0123456789ABCDEF";
     int i = 0;
     int size = 0;
 
     size = s;
 
-    digits = (type & LARGE) ? large_digits : small_digits;
     if (type & LEFT)
     {
         type &= ~ZEROPAD;
@@ -162,16 +258,8 @@ static char *print_number(char *buf,
         }
     }
 
-    i = 0;
-    if (num == 0)
-    {
-        tmp[i++] = '0';
-    }
-    else
-    {
-        while (num != 0)
-            tmp[i++] = digits[divide(&num, base)];
-    }
+    digit = _utoa(tmp + sizeof(tmp), num, base, (type & LARGE) ? _large_digits : _small_digits);
+    i = tmp + sizeof(tmp) - digit;
 
     if (i > precision)
     {
@@ -265,14 +353,18 @@ static char *print_number(char *buf,
     }
 
     /* put number in the temporary buffer */
-    while (i-- > 0 && (precision_bak != 0))
+    if (precision_bak != 0)
     {
-        if (buf < end)
+        while (i-- > 0)
         {
-            *buf = tmp[i];
-        }
+            if (buf < end)
+            {
+                *buf = *digit;
+            }
 
-        ++ buf;
+            ++ buf;
+            ++ digit;
+        }
     }
 
     while (size-- > 0)
@@ -288,318 +380,389 @@ static char *print_number(char *buf,
     return buf;
 }
 
-#if defined(__GNUC__) && !defined(__ARMCC_VERSION) /* GCC */
-#pragma GCC diagnostic push
-/* ignore warning: this statement may fall through */
-#pragma GCC diagnostic ignored "-Wimplicit-fallthrough"
-#endif /* defined(__GNUC__) && !defined(__ARMCC_VERSION) */
 /**
- * @brief  This function will fill a formatted string to buffer.
+ * @brief  This function will parse one conversion of a format.
  *
- * @param  buf is the buffer to save formatted string.
+ * @param  fmt points behind the '%'.
  *
- * @param  size is the size of buffer.
- *
- * @param  fmt is the format parameters.
+ * @param  spec is the conversion parsed, a width or precision of '*' is
+ *         left as FMT_ARG.
  *
- * @param  args is a list of variable parameters.
- *
- * @return The number of characters actually written to buffer.
+ * @return the conversion character, or the terminator if the format ends.
  */
-rt_weak int rt_vsnprintf(char *buf, rt_size_t size, const char *fmt, va_list args)
+static const char *_fmt_parse(const char *fmt, struct fmt_spec *spec)
 {
-#ifdef RT_KPRINTF_USING_LONGLONG
-    unsigned long long num = 0;
-#else
-    unsigned long num = 0;
-#endif /* RT_KPRINTF_USING_LONGLONG */
-    int i = 0, len = 0;
-    char *str = RT_NULL, *end = RT_NULL, c = 0;
-    const char *s = RT_NULL;
-
-    rt_uint8_t base = 0;            /* the base of number */
-    rt_uint8_t flags = 0;           /* flags to print number */
-    rt_uint8_t qualifier = 0;       /* 'h', 'l', or 'L' for integer fields */
-    rt_int32_t field_width = 0;     /* width of output field */
-    int precision = 0;      /* min. # of digits for integers and max for a string */
+    /* process flags */
+    spec->flags = 0;
 
-    str = buf;
-    end = buf + size;
-
-    /* Make sure end is always >= buf */
-    if (end < buf)
+    while (1)
     {
-        end  = ((char *) - 1);
-        size = end - buf;
+        if (*fmt == '-') spec->flags |= LEFT;
+        else if (*fmt == '+') spec->flags |= PLUS;
+        else if (*fmt == ' ') spec->flags |= SPACE;
+        else if (*fmt == '#') spec->flags |= SPECIAL;
+        else if (*fmt == '0') spec->flags |= ZEROPAD;
+        else break;
+        ++fmt;
     }
 
-    for (; *fmt ; ++fmt)
+    /* get field width */
+    spec->field_width = -1;
+    if (_ISDIGIT(*fmt))
     {
-        if (*fmt != '%')
-        {
-            if (str < end)
-            {
-                *str = *fmt;
-            }
-
-            ++ str;
-            continue;
-        }
-
-        /* process flags */
-        flags = 0;
-
-        while (1)
-        {
-            /* skips the first '%' also */
-            ++fmt;
-            if (*fmt == '-') flags |= LEFT;
-            else if (*fmt == '+') flags |= PLUS;
-            else if (*fmt == ' ') flags |= SPACE;
-            else if (*fmt == '#') flags |= SPECIAL;
-            else if (*fmt == '0') flags |= ZEROPAD;
-            else break;
-        }
+        spec->field_width = skip_atoi(&fmt);
+    }
+    else if (*fmt == '*')
+    {
+        ++fmt;
+        /* it's the next argument */
+        spec->field_width = FMT_ARG;
+    }
 
-        /* get field width */
-        field_width = -1;
+    /* get the precision */
+    spec->precision = -1;
+    if (*fmt == '.')
+    {
+        ++fmt;
+        spec->precision = 0;
         if (_ISDIGIT(*fmt))
         {
-            field_width = skip_atoi(&fmt);
+            spec->precision = skip_atoi(&fmt);
         }
         else if (*fmt == '*')
         {
             ++fmt;
             /* it's the next argument */
-            field_width = va_arg(args, int);
-            if (field_width < 0)
-            {
-                field_width = -field_width;
-                flags |= LEFT;
-            }
+            spec->precision = FMT_ARG;
         }
+    }
 
-        /* get the precision */
-        precision = -1;
-        if (*fmt == '.')
+    spec->qualifier = 0; /* get the conversion qualifier */
+
+    if (*fmt == 'h' || *fmt == 'l' ||
+#ifdef RT_KPRINTF_USING_LONGLONG
+        *fmt == 'L' ||
+#endif /* RT_KPRINTF_USING_LONGLONG */
+        *fmt == 'z')
+    {
+        spec->qualifier = *fmt;
+        ++fmt;
+#ifdef RT_KPRINTF_USING_LONGLONG
+        if (spec->qualifier == 'l' && *fmt == 'l')
         {
+            spec->qualifier = 'L';
             ++fmt;
-            if (_ISDIGIT(*fmt))
-            {
-                precision = skip_atoi(&fmt);
-            }
-            else if (*fmt == '*')
-            {
-                ++fmt;
-                /* it's the next argument */
-                precision = va_arg(args, int);
-            }
-            if (precision < 0)
-            {
-                precision = 0;
-            }
         }
-
-        qualifier = 0; /* get the conversion qualifier */
-
-        if (*fmt == 'h' || *fmt == 'l' ||
-#ifdef RT_KPRINTF_USING_LONGLONG
-            *fmt == 'L' ||
 #endif /* RT_KPRINTF_USING_LONGLONG */
-            *fmt == 'z')
+        if (spec->qualifier == 'h' && *fmt == 'h')
         {
-            qualifier = *fmt;
+            spec->qualifier = 'H';
             ++fmt;
+        }
+    }
+
+    spec->conv = *fmt;
+
+    return fmt;
+}
+
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION) /* GCC */
+#pragma GCC diagnostic push
+/* ignore warning: this statement may fall through */
+#pragma GCC diagnostic ignored "-Wimplicit-fallthrough"
+#endif /* defined(__GNUC__) && !defined(__ARMCC_VERSION) */
+/**
+ * @brief  This function will format one conversion.
+ *
+ * @param  str is where the output goes, nothing is written from end on.
+ *
+ * @param  spec is the conversion.
+ *
+ * @param  args are the arguments, the ones taken are consumed.
+ *
+ * @return the end of the output.
+ */
+static char *_fmt_emit(char *str, char *end, const struct fmt_spec *spec, va_list *args)
+{
 #ifdef RT_KPRINTF_USING_LONGLONG
-            if (qualifier == 'l' && *fmt == 'l')
-            {
-                qualifier = 'L';
-                ++fmt;
-            }
+    unsigned long long num = 0;
+#else
+    unsigned long num = 0;
 #endif /* RT_KPRINTF_USING_LONGLONG */
-            if (qualifier == 'h' && *fmt == 'h')
-            {
-                qualifier = 'H';
-                ++fmt;
-            }
-        }
+    int i = 0, len = 0;
+    char c = 0;
+    const char *s = RT_NULL;
 
-        /* the default base */
-        base = 10;
+    rt_uint8_t base = 0;                        /* the base of number */
+    rt_uint8_t flags = spec->flags;             /* flags to print number */
+    rt_uint8_t qualifier = spec->qualifier;     /* 'h', 'l', or 'L' for integer fields */
+    rt_int32_t field_width = spec->field_width; /* width of output field */
+    int precision = spec->precision;            /* min. # of digits for integers and max for a string */
 
-        switch (*fmt)
+    if (field_width == FMT_ARG)
+    {
+        field_width = va_arg(*args, int);
+        if (field_width < 0)
         {
-        case 'c':
-            if (!(flags & LEFT))
-            {
-                while (--field_width > 0)
-                {
-                    if (str < end) *str = ' ';
-                    ++ str;
-                }
-            }
+            field_width = -field_width;
+            flags |= LEFT;
+        }
+    }
 
-            /* get character */
-            c = (rt_uint8_t)va_arg(args, int);
-            if (str < end)
-            {
-                *str = c;
-            }
-            ++ str;
+    if (precision == FMT_ARG)
+    {
+        precision = va_arg(*args, int);
+        if (precision < 0)
+        {
+            precision = 0;
+        }
+    }
 
-            /* put width */
+    /* the default base */
+    base = 10;
+
+    switch (spec->conv)
+    {
+    case 'c':
+        if (!(flags & LEFT))
+        {
             while (--field_width > 0)
             {
                 if (str < end) *str = ' ';
                 ++ str;
             }
-            continue;
+        }
 
-        case 's':
-            s = va_arg(args, char *);
-            if (!s)
-            {
-                s = "(NULL)";
-            }
+        /* get character */
+        c = (rt_uint8_t)va_arg(*args, int);
+        if (str < end)
+        {
+            *str = c;
+        }
+        ++ str;
 
-            for (len = 0; (len != field_width) && (s[len] != '\0'); len++);
+        /* put width */
+        while (--field_width > 0)
+        {
+            if (str < end) *str = ' ';
+            ++ str;
+        }
+        return str;
 
-            if (precision > 0 && len > precision)
-            {
-                len = precision;
-            }
+    case 's':
+        s = va_arg(*args, char *);
+        if (!s)
+        {
+            s = "(NULL)";
+        }
 
-            if (!(flags & LEFT))
-            {
-                while (len < field_width--)
-                {
-                    if (str < end) *str = ' ';
-                    ++ str;
-                }
-            }
+        for (len = 0; (len != field_width) && (s[len] != '\0'); len++);
 
-            for (i = 0; i < len; ++i)
-            {
-                if (str < end) *str = *s;
-                ++ str;
-                ++ s;
-            }
+        if (precision > 0 && len > precision)
+        {
+            len = precision;
+        }
 
+        if (!(flags & LEFT))
+        {
             while (len < field_width--)
             {
                 if (str < end) *str = ' ';
                 ++ str;
             }
-            continue;
-
-        case 'p':
-            if (field_width == -1)
-            {
-                field_width = sizeof(void *) << 1;
-                field_width += 2; /* `0x` prefix */
-                flags |= SPECIAL;
-                flags |= ZEROPAD;
-            }
-            str = print_number(str, end, (unsigned long)va_arg(args, void *),
-                               16, qualifier, field_width, precision, flags);
-            continue;
+        }
 
-        case '%':
-            if (str < end)
-            {
-                *str = '%';
-            }
+        for (i = 0; i < len; ++i)
+        {
+            if (str < end) *str = *s;
             ++ str;
-            continue;
+            ++ s;
+        }
 
-        /* integer number formats - set up the flags and "break" */
-        case 'b':
-            base = 2;
-            break;
-        case 'o':
-            base = 8;
-            break;
+        while (len < field_width--)
+        {
+            if (str < end) *str = ' ';
+            ++ str;
+        }
+        return str;
 
-        case 'X':
-            flags |= LARGE;
-        case 'x':
-            base = 16;
-            break;
+    case 'p':
+        if (field_width == -1)
+        {
+            field_width = sizeof(void *) << 1;
+            field_width += 2; /* `0x` prefix */
+            flags |= SPECIAL;
+            flags |= ZEROPAD;
+        }
+        return print_number(str, end, (unsigned long)va_arg(*args, void *),
+                            16, qualifier, field_width, precision, flags);
 
-        case 'd':
-        case 'i':
-            flags |= SIGN;
-        case 'u':
-            break;
+    case '%':
+        if (str < end)
+        {
+            *str = '%';
+        }
+        ++ str;
+        return str;
+
+    /* integer number formats - set up the flags and "break" */
+    case 'b':
+        base = 2;
+        break;
+    case 'o':
+        base = 8;
+        break;
+
+    case 'X':
+        flags |= LARGE;
+    case 'x':
+        base = 16;
+        break;
+
+    case 'd':
+    case 'i':
+        flags |= SIGN;
+    case 'u':
+        break;
+
+    case 'e':
+    case 'E':
+    case 'G':
+    case 'g':
+    case 'f':
+    case 'F':
+        va_arg(*args, double);
+    default:
+        if (str < end)
+        {
+            *str = '%';
+        }
+        ++ str;
 
-        case 'e':
-        case 'E':
-        case 'G':
-        case 'g':
-        case 'f':
-        case 'F':
-            va_arg(args, double);
-        default:
+        if (spec->conv)
+        {
             if (str < end)
             {
-                *str = '%';
+                *str = spec->conv;
             }
             ++ str;
-
-            if (*fmt)
-            {
-                if (str < end)
-                {
-                    *str = *fmt;
-                }
-                ++ str;
-            }
-            else
-            {
-                -- fmt;
-            }
-            continue;
         }
+        return str;
+    }
 
-        if (qualifier == 'L')
+    if (qualifier == 'L')
+    {
+        num = va_arg(*args, unsigned long long);
+    }
+    else if (qualifier == 'l')
+    {
+        num = va_arg(*args, unsigned long);
+    }
+    else if (qualifier == 'H')
+    {
+        num = (rt_int8_t)va_arg(*args, rt_int32_t);
+        if (flags & SIGN)
         {
-            num = va_arg(args, unsigned long long);
+            num = (rt_int8_t)num;
         }
-        else if (qualifier == 'l')
+    }
+    else if (qualifier == 'h')
+    {
+        num = (rt_uint16_t)va_arg(*args, rt_int32_t);
+        if (flags & SIGN)
         {
-            num = va_arg(args, unsigned long);
+            num = (rt_int16_t)num;
         }
-        else if (qualifier == 'H')
+    }
+    else if (qualifier == 'z')
+    {
+        num = va_arg(*args, rt_size_t);
+        if (flags & SIGN)
         {
-            num = (rt_int8_t)va_arg(args, rt_int32_t);
-            if (flags & SIGN)
-            {
-                num = (rt_int8_t)num;
-            }
+            num = (rt_ssize_t)num;
         }
-        else if (qualifier == 'h')
+    }
+    else
+    {
+        num = (rt_uint32_t)va_arg(*args, unsigned long);
+    }
+
+    return print_number(str, end, num, base, qualifier, field_width, precision, flags);
+}
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION) /* GCC */
+#pragma GCC diagnostic pop /* ignored "-Wimplicit-fallthrough" */
+#endif /* defined(__GNUC__) && !defined(__ARMCC_VERSION) */
+
+/* copy len bytes of literal text */
+rt_inline char *_fmt_literal(char *str, char *end, const char *s, rt_size_t len)
+{
+    rt_size_t room;
+
+    if (str < end)
+    {
+        room = end - str;
+        rt_memcpy(str, s, len < room ? len : room);
+    }
+
+    return str + len;
+}
+
+/**
+ * @brief  This function will format %d, %u, %x or %s without flags, width,
+ *         precision or qualifier, giving the same output as _fmt_emit().
+ *
+ * @param  str is where the output goes, nothing is written from end on.
+ *
+ * @param  conv is 'd', 'u', 'x' or 's'.
+ *
+ * @param  args are the arguments, the one taken is consumed.
+ *
+ * @return the end of the output.
+ */
+static char *_fmt_fast(char *str, char *end, char conv, va_list *args)
+{
+    char tmp[12];
+    char *digit = RT_NULL;
+    const char *s = RT_NULL;
+    rt_uint32_t num = 0;
+
+    if (conv == 's')
+    {
+        s = va_arg(*args, char *);
+        if (!s)
         {
-            num = (rt_uint16_t)va_arg(args, rt_int32_t);
-            if (flags & SIGN)
-            {
-                num = (rt_int16_t)num;
-            }
+            s = "(NULL)";
         }
-        else if (qualifier == 'z')
+        for (; *s != '\0'; ++s)
         {
-            num = va_arg(args, rt_size_t);
-            if (flags & SIGN)
-            {
-                num = (rt_ssize_t)num;
-            }
+            if (str < end) *str = *s;
+            ++ str;
         }
-        else
+        return str;
+    }
+
+    num = (rt_uint32_t)va_arg(*args, unsigned long);
+    if (conv == 'd' && (rt_int32_t)num < 0)
+    {
+        if (str < end)
         {
-            num = (rt_uint32_t)va_arg(args, unsigned long);
+            *str = '-';
         }
-        str = print_number(str, end, num, base, qualifier, field_width, precision, flags);
+        ++ str;
+        num = (rt_uint32_t)-num;
     }
 
+    if (conv == 'x')
+        digit = _utoa(tmp + sizeof(tmp), num, 16, _small_digits);
+    else
+        digit = _utoa10(tmp + sizeof(tmp), num);
+
+    return _fmt_literal(str, end, digit, tmp + sizeof(tmp) - digit);
+}
+
+/* terminate the output, the length without the terminator */
+rt_inline int _fmt_end(char *buf, char *str, char *end, rt_size_t size)
+{
     if (size > 0)
     {
         if (str < end)
@@ -617,10 +780,231 @@ rt_weak int rt_vsnprintf(char *buf, rt_size_t size, const char *fmt, va_list arg
     */
     return str - buf;
 }
+
+/**
+ * @brief  This function will fill a formatted string to buffer.
+ *
+ * @param  buf is the buffer to save formatted string.
+ *
+ * @param  size is the size of buffer.
+ *
+ * @param  fmt is the format parameters.
+ *
+ * @param  args is a list of variable parameters.
+ *
+ * @return The number of characters actually written to buffer.
+ */
+rt_weak int rt_vsnprintf(char *buf, rt_size_t size, const char *fmt, va_list args)
+{
+    char *str = RT_NULL, *end = RT_NULL;
+    const char *s = RT_NULL;
+    struct fmt_spec spec;
+    va_list ap;
+
+    str = buf;
+    end = buf + size;
+
+    /* Make sure end is always >= buf */
+    if (end < buf)
+    {
+        end  = ((char *) - 1);
+        size = end - buf;
+    }
+
+    va_copy(ap, args);
+    while (*fmt)
+    {
+        if (*fmt != '%')
+        {
+            /* the literal text up to the next conversion at once */
+            for (s = fmt; *fmt != '\0' && *fmt != '%'; ++fmt);
+            str = _fmt_literal(str, end, s, fmt - s);
+            continue;
+        }
+
+        /* %d, %u, %x and %s without flags, width, precision or qualifier */
+        ++fmt;
+        if (*fmt == 'd' || *fmt == 'u' || *fmt == 'x' || *fmt == 's')
+        {
+            str = _fmt_fast(str, end, *fmt, &ap);
+            ++fmt;
+            continue;
+        }
+
+        fmt = _fmt_parse(fmt, &spec);
+        str = _fmt_emit(str, end, &spec, &ap);
+        if (*fmt)
+        {
+            ++fmt;
+        }
+    }
+    va_end(ap);
+
+    return _fmt_end(buf, str, end, size);
+}
 RTM_EXPORT(rt_vsnprintf);
-#if defined(__GNUC__) && !defined(__ARMCC_VERSION) /* GCC */
-#pragma GCC diagnostic pop /* ignored "-Wimplicit-fallthrough" */
-#endif /* defined(__GNUC__) && !defined(__ARMCC_VERSION) */
+
+#ifdef RT_KPRINTF_USING_FORMAT_COMPILE
+/**
+ * @brief  This function will compile a format once, so that formatting with it
+ *         skips the parsing.
+ *
+ * @param  fmt is the compiled format.
+ *
+ * @param  format is the format, it is referenced and must outlive fmt.
+ *
+ * @return RT_EOK on success, -RT_EFULL if the format has more than
+ *         RT_KPRINTF_FORMAT_SPEC_NR conversions, -RT_EINVAL if it is longer
+ *         than 65535 characters or a width or precision exceeds 32767.
+ */
+rt_err_t rt_fmt_compile(struct rt_fmt *fmt, const char *format)
+{
+    struct rt_fmt_spec *compiled = RT_NULL;
+    struct fmt_spec spec;
+    const char *p = format, *s = RT_NULL;
+
+    RT_ASSERT(fmt != RT_NULL);
+    RT_ASSERT(format != RT_NULL);
+
+    fmt->format = format;
+    fmt->nr = 0;
+
+    while (1)
+    {
+        for (s = p; *p != '\0' && *p != '%'; ++p);
+        if (p - format > 0xffff)
+        {
+            return -RT_EINVAL;
+        }
+        if (*p == '\0')
+        {
+            break;
+        }
+        if (fmt->nr >= RT_KPRINTF_FORMAT_SPEC_NR)
+        {
+            return -RT_EFULL;
+        }
+
+        compiled = &fmt->specs[fmt->nr];
+        compiled->literal = s - format;
+        compiled->literal_len = p - s;
+
+        p = _fmt_parse(p + 1, &spec);
+        if (spec.field_width > 0x7fff || spec.precision > 0x7fff)
+        {
+            return -RT_EINVAL;
+        }
+
+        fmt->nr++;
+        compiled->width = spec.field_width;
+        compiled->precision = spec.precision;
+        compiled->flags = spec.flags;
+        compiled->qualifier = spec.qualifier;
+        compiled->conv = spec.conv;
+
+        if (spec.flags == 0 && spec.field_width == -1 && spec.precision == -1 && spec.qualifier == 0 &&
+            (spec.conv == 'd' || spec.conv == 'u' || spec.conv == 'x' || spec.conv == 's'))
+        {
+            compiled->flags = FAST;
+        }
+
+        if (*p)
+        {
+            ++p;
+        }
+    }
+
+    fmt->tail = s - format;
+    fmt->tail_len = p - s;
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_fmt_compile);
+
+/**
+ * @brief  This function will fill a string formatted by a compiled format to
+ *         buffer, the output is the same as rt_vsnprintf() with its format.
+ *
+ * @param  buf is the buffer to save formatted string.
+ *
+ * @param  size is the size of buffer.
+ *
+ * @param  fmt is the compiled format.
+ *
+ * @param  args is a list of variable parameters.
+ *
+ * @return The number of characters actually written to buffer.
+ */
+int rt_fmt_vsnprintf(char *buf, rt_size_t size, const struct rt_fmt *fmt, va_list args)
+{
+    const struct rt_fmt_spec *compiled = RT_NULL;
+    char *str = RT_NULL, *end = RT_NULL;
+    struct fmt_spec spec;
+    va_list ap;
+    int index;
+
+    RT_ASSERT(fmt != RT_NULL);
+
+    str = buf;
+    end = buf + size;
+
+    /* Make sure end is always >= buf */
+    if (end < buf)
+    {
+        end  = ((char *) - 1);
+        size = end - buf;
+    }
+
+    va_copy(ap, args);
+    for (index = 0; index < fmt->nr; index++)
+    {
+        compiled = &fmt->specs[index];
+        str = _fmt_literal(str, end, fmt->format + compiled->literal, compiled->literal_len);
+        if (compiled->flags == FAST)
+        {
+            str = _fmt_fast(str, end, compiled->conv, &ap);
+            continue;
+        }
+
+        spec.field_width = compiled->width;
+        spec.precision = compiled->precision;
+        spec.flags = compiled->flags;
+        spec.qualifier = compiled->qualifier;
+        spec.conv = compiled->conv;
+        str = _fmt_emit(str, end, &spec, &ap);
+    }
+    str = _fmt_literal(str, end, fmt->format + fmt->tail, fmt->tail_len);
+    va_end(ap);
+
+    return _fmt_end(buf, str, end, size);
+}
+RTM_EXPORT(rt_fmt_vsnprintf);
+
+/**
+ * @brief  This function will fill a string formatted by a compiled format to
+ *         buffer.
+ *
+ * @param  buf is the buffer to save formatted string.
+ *
+ * @param  size is the size of buffer.
+ *
+ * @param  fmt is the compiled format.
+ *
+ * @return The number of characters actually written to buffer.
+ */
+int rt_fmt_snprintf(char *buf, rt_size_t size, const struct rt_fmt *fmt, ...)
+{
+    rt_int32_t n = 0;
+    va_list args;
+
+    va_start(args, fmt);
+    n = rt_fmt_vsnprintf(buf, size, fmt, args);
+    va_end(args);
+
+    return n;
+}
+RTM_EXPORT(rt_fmt_snprintf);
+#endif /* RT_KPRINTF_USING_FORMAT_COMPILE */
 
 /**
  * @brief  This function will fill a formatted string to buffer.
@@ -6,6 +6,7 @@
  * Change Logs:
  * Date           Author       Notes
  * 2024-03-10     Meco Man     the first version
+ * 2026-10-18     Cc           align before the word loops, word-at-a-time rt_memcmp and rt_strlen
  */
 
 #include <rtdef.h>
@@ -57,10 +58,17 @@ rt_weak void *rt_memset(void *s, int c, rt_ubase_t count)
 
     RT_ASSERT(LBLOCKSIZE == 2 || LBLOCKSIZE == 4 || LBLOCKSIZE == 8);
 
-    if (!TOO_SMALL(count) && !UNALIGNED(s))
+    if (!TOO_SMALL(count))
     {
-        /* If we get this far, we know that count is large and s is word-aligned. */
-        aligned_addr = (unsigned long *)s;
+        /* Set the bytes up to the first word boundary. */
+        while (UNALIGNED(m))
+        {
+            *m++ = (char)d;
+            count--;
+        }
+
+        /* If we get this far, we know that m is word-aligned. */
+        aligned_addr = (unsigned long *)m;
 
         /* Store d into each char sized location in buffer so that
          * we can set large blocks quickly.
@@ -136,6 +144,8 @@ rt_weak void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
 
 #define UNALIGNED(X, Y) \
     (((long)X & (sizeof (long) - 1)) | ((long)Y & (sizeof (long) - 1)))
+#define MISALIGNED(X, Y) \
+    (((long)X ^ (long)Y) & (sizeof (long) - 1))
 #define BIGBLOCKSIZE    (sizeof (long) << 2)
 #define LITTLEBLOCKSIZE (sizeof (long))
 #define TOO_SMALL(LEN)  ((LEN) < BIGBLOCKSIZE)
@@ -146,10 +156,17 @@ rt_weak void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
     long *aligned_src = RT_NULL;
     rt_ubase_t len = count;
 
-    /* If the size is small, or either SRC or DST is unaligned,
+    /* If the size is small, or SRC and DST can not be aligned together,
     then punt into the byte copy loop.  This should be rare. */
-    if (!TOO_SMALL(len) && !UNALIGNED(src_ptr, dst_ptr))
+    if (!TOO_SMALL(len) && !MISALIGNED(src_ptr, dst_ptr))
     {
+        /* Copy the bytes up to the first word boundary of both. */
+        while (UNALIGNED(src_ptr, dst_ptr))
+        {
+            *dst_ptr++ = *src_ptr++;
+            len--;
+        }
+
         aligned_dst = (long *)dst_ptr;
         aligned_src = (long *)src_ptr;
 
@@ -180,6 +197,7 @@ rt_weak void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
 
     return dst;
 #undef UNALIGNED
+#undef MISALIGNED
 #undef BIGBLOCKSIZE
 #undef LITTLEBLOCKSIZE
 #undef TOO_SMALL
@@ -236,12 +254,47 @@ RTM_EXPORT(rt_memmove);
  *         If the result > 0, cs is greater than ct.
  *         If the result = 0, cs is equal to ct.
  */
-rt_int32_t rt_memcmp(const void *cs, const void *ct, rt_size_t count)
+rt_weak rt_int32_t rt_memcmp(const void *cs, const void *ct, rt_size_t count)
 {
-    const unsigned char *su1 = RT_NULL, *su2 = RT_NULL;
+    const unsigned char *su1 = (const unsigned char *)cs, *su2 = (const unsigned char *)ct;
     int res = 0;
 
-    for (su1 = (const unsigned char *)cs, su2 = (const unsigned char *)ct; 0 < count; ++su1, ++su2, count--)
+#ifndef RT_KSERVICE_USING_TINY_SIZE
+#define LBLOCKSIZE      (sizeof(rt_ubase_t))
+#define UNALIGNED(X)    ((rt_ubase_t)X & (LBLOCKSIZE - 1))
+
+    if (count >= LBLOCKSIZE && UNALIGNED(su1) == UNALIGNED(su2))
+    {
+        const rt_ubase_t *aligned_su1, *aligned_su2;
+
+        /* Compare the bytes up to the first word boundary of both. */
+        while (UNALIGNED(su1))
+        {
+            if ((res = *su1 - *su2) != 0)
+                return res;
+            su1++;
+            su2++;
+            count--;
+        }
+
+        /* Skip the equal words, the first different one is compared bytewise below. */
+        aligned_su1 = (const rt_ubase_t *)su1;
+        aligned_su2 = (const rt_ubase_t *)su2;
+        while (count >= LBLOCKSIZE && *aligned_su1 == *aligned_su2)
+        {
+            aligned_su1++;
+            aligned_su2++;
+            count -= LBLOCKSIZE;
+        }
+        su1 = (const unsigned char *)aligned_su1;
+        su2 = (const unsigned char *)aligned_su2;
+    }
+
+#undef LBLOCKSIZE
+#undef UNALIGNED
+#endif /* RT_KSERVICE_USING_TINY_SIZE */
+
+    for (; 0 < count; ++su1, ++su2, count--)
         if ((res = *su1 - *su2) != 0)
             break;
 
@@ -444,11 +497,36 @@ RTM_EXPORT(rt_strcmp);
  *
  * @return The length of string.
  */
-rt_size_t rt_strlen(const char *s)
+rt_weak rt_size_t rt_strlen(const char *s)
 {
-    const char *sc = RT_NULL;
+    const char *sc = s;
+
+#ifndef RT_KSERVICE_USING_TINY_SIZE
+#define LBLOCKSIZE      (sizeof(rt_ubase_t))
+#define ONES            ((rt_ubase_t)~0 / 0xff)
+/* nonzero if any byte of X is zero */
+#define DETECT_NULL(X)  (((X) - ONES) & ~(X) & (ONES << 7))
+
+    const rt_ubase_t *aligned_addr;
+
+    while ((rt_ubase_t)sc & (LBLOCKSIZE - 1))
+    {
+        if (*sc == '\0')
+            return sc - s;
+        sc++;
+    }
+
+    /* An aligned word never crosses a page, reading past the terminator is safe. */
+    for (aligned_addr = (const rt_ubase_t *)sc; !DETECT_NULL(*aligned_addr); aligned_addr++) /* nothing */
+        ;
+    sc = (const char *)aligned_addr;
+
+#undef LBLOCKSIZE
+#undef ONES
+#undef DETECT_NULL
+#endif /* RT_KSERVICE_USING_TINY_SIZE */
 
-    for (sc = s; *sc != '\0'; ++sc) /* nothing */
+    for (; *sc != '\0'; ++sc) /* nothing */
         ;
 
     return sc - s;
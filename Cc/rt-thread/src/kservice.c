@@ -27,6 +27,10 @@
  * 2023-10-16     Shell        Add hook point for rt_malloc services
  * 2023-12-10     xqyjlj       perf rt_hw_interrupt_disable/enable, fix memheap lock
  * 2024-03-10     Meco Man     move std libc related functions to rtklibc
+ * 2026-10-18     Cc           add TLSF as system heap and rt_system_heap_add
+ * 2026-10-18     Cc           add size class cache in front of the system heap
+ * 2026-10-18     Cc           add heap profiler hooks and rt_memory_max_free
+ * 2026-10-18     Cc           add rt_malloc_hint
  */
 
 #include <rtthread.h>
@@ -726,6 +730,8 @@ rt_inline void _smem_info(rt_size_t *total,
     rt_smem_free(_ptr)
 #define _MEM_INFO(_total, _used, _max)  \
     _smem_info(_total, _used, _max)
+#define _MEM_MAX_FREE() \
+    rt_smem_max_free(system_heap)
 #elif defined(RT_USING_MEMHEAP_AS_HEAP)
 static struct rt_memheap system_heap;
 void *_memheap_alloc(struct rt_memheap *heap, rt_size_t size);
@@ -744,6 +750,8 @@ void *_memheap_realloc(struct rt_memheap *heap, void *rmem, rt_size_t newsize);
     _memheap_free(_ptr)
 #define _MEM_INFO(_total, _used, _max)   \
     rt_memheap_info(&system_heap, _total, _used, _max)
+#define _MEM_MAX_FREE() \
+    rt_memheap_max_free(&system_heap)
 #elif defined(RT_USING_SLAB_AS_HEAP)
 static rt_slab_t system_heap;
 rt_inline void _slab_info(rt_size_t *total,
@@ -765,14 +773,530 @@ rt_inline void _slab_info(rt_size_t *total,
 #define _MEM_FREE(_ptr) \
     rt_slab_free(system_heap, _ptr)
 #define _MEM_INFO       _slab_info
+/* the free pages and zones of slab are not tracked as blocks */
+#define _MEM_MAX_FREE() 0
+#elif defined(RT_USING_TLSF_AS_HEAP)
+static rt_tlsf_t system_heap;
+rt_inline void _tlsf_info(rt_size_t *total,
+    rt_size_t *used, rt_size_t *max_used)
+{
+    if (total)
+        *total = system_heap->total;
+    if (used)
+        *used = system_heap->used;
+    if (max_used)
+        *max_used = system_heap->max;
+}
+#define _MEM_INIT(_name, _start, _size) \
+    system_heap = rt_tlsf_init(_name, _start, _size)
+#define _MEM_MALLOC(_size)  \
+    rt_tlsf_alloc(system_heap, _size)
+#define _MEM_REALLOC(_ptr, _newsize)    \
+    rt_tlsf_realloc(system_heap, _ptr, _newsize)
+#define _MEM_FREE(_ptr) \
+    rt_tlsf_free(system_heap, _ptr)
+#define _MEM_INFO       _tlsf_info
+#define _MEM_MAX_FREE() \
+    rt_tlsf_max_free(system_heap)
 #else
 #define _MEM_INIT(...)
 #define _MEM_MALLOC(...)     RT_NULL
 #define _MEM_REALLOC(...)    RT_NULL
 #define _MEM_FREE(...)
 #define _MEM_INFO(...)
+#define _MEM_MAX_FREE()      0
 #endif
 
+#if defined(RT_USING_HEAP_PROF) && defined(__GNUC__)
+/* the call site charged by the heap profiler */
+#define _HEAP_CALLER()      __builtin_return_address(0)
+#else
+#define _HEAP_CALLER()      RT_NULL
+#endif /* defined(RT_USING_HEAP_PROF) && defined(__GNUC__) */
+
+#ifdef RT_USING_HEAP_CACHE
+/*
+ * Size class cache in front of the heap backend.
+ *
+ * Every block of the system heap handed out by rt_malloc carries one header
+ * word naming its size class, blocks of other heaps have none, so a block is
+ * told apart by its address. A released block of a cached class is pushed
+ * onto the free list of its class under a spinlock only; the heap lock is
+ * taken once per batch when a class is refilled or drained. Blocks above the
+ * largest class go straight to the backend.
+ *
+ * The classes are four per power of two, so a block wastes a quarter of its
+ * size at most, and the common buffer sizes of 512, 1024 and 2048 bytes fit
+ * a class exactly. A full size Ethernet frame of lwIP goes to 1792 bytes.
+ */
+#define HEAP_CACHE_CLASS_NR     ((int)(sizeof(_heap_cache_size) / sizeof(_heap_cache_size[0])))
+#define HEAP_CACHE_MAX_SIZE     (_heap_cache_size[HEAP_CACHE_CLASS_NR - 1])
+#define HEAP_CACHE_HDR_SIZE     RT_ALIGN(sizeof(rt_ubase_t), RT_ALIGN_SIZE)
+#define HEAP_CACHE_MAGIC        ((rt_ubase_t)0x1ea5ca00)
+#define HEAP_CACHE_MAGIC_MASK   (~(rt_ubase_t)0xff)
+#define HEAP_CACHE_UNCACHED     0xff
+#define HEAP_CACHE_TAG_INDEX(_tag)  ((int)((_tag) & 0xff))
+
+#define HEAP_CACHE_HDR(_ptr)    ((rt_ubase_t *)((rt_uint8_t *)(_ptr) - HEAP_CACHE_HDR_SIZE))
+#define HEAP_CACHE_PTR(_hdr)    ((void *)((rt_uint8_t *)(_hdr) + HEAP_CACHE_HDR_SIZE))
+#define HEAP_CACHE_NEXT(_ptr)   (*(void **)(_ptr))
+
+struct _heap_cache_class
+{
+    struct rt_spinlock  lock;
+    void               *free_list;      /**< cached blocks, linked through the user data */
+    rt_uint16_t         count;          /**< number of cached blocks */
+    rt_uint16_t         low;            /**< lowest count since the last trim */
+    rt_uint32_t         hits;
+    rt_uint32_t         misses;
+    rt_uint32_t         drains;
+};
+
+static const rt_uint16_t _heap_cache_size[] =
+{
+    16, 32, 48, 64, 80, 96, 112, 128,
+    160, 192, 224, 256, 320, 384, 448, 512,
+    640, 768, 896, 1024, 1280, 1536, 1792, 2048,
+};
+
+static struct _heap_cache_class _heap_cache[HEAP_CACHE_CLASS_NR];
+/* the range of the system heap */
+static rt_ubase_t _heap_cache_begin, _heap_cache_end;
+
+/* the smallest class holding size, which is not above the largest class */
+rt_inline int _heap_cache_index(rt_size_t size)
+{
+    int low = 0, high = HEAP_CACHE_CLASS_NR - 1, mid;
+
+    while (low < high)
+    {
+        mid = (low + high) / 2;
+        if (size > _heap_cache_size[mid])
+            low = mid + 1;
+        else
+            high = mid;
+    }
+
+    return low;
+}
+
+/* the bytes held by the cache, which the backend counts as used */
+static rt_size_t _heap_cache_bytes(void)
+{
+    rt_size_t bytes = 0;
+    int index;
+
+    for (index = 0; index < HEAP_CACHE_CLASS_NR; index++)
+        bytes += _heap_cache[index].count * (_heap_cache_size[index] + HEAP_CACHE_HDR_SIZE);
+
+    return bytes;
+}
+
+/*
+ * a block outside the system heap has no header, e.g. one of another memheap
+ * from rt_memheap_alloc() or from the auto binding of the backend
+ */
+rt_inline rt_bool_t _heap_cache_owns(void *ptr)
+{
+    return (rt_ubase_t)ptr >= _heap_cache_begin && (rt_ubase_t)ptr < _heap_cache_end;
+}
+
+static void _heap_cache_init(rt_ubase_t begin, rt_ubase_t end)
+{
+    int index;
+
+    _heap_cache_begin = begin;
+    _heap_cache_end   = end;
+
+    for (index = 0; index < HEAP_CACHE_CLASS_NR; index++)
+    {
+        rt_memset(&_heap_cache[index], 0, sizeof(_heap_cache[index]));
+        rt_spin_lock_init(&_heap_cache[index].lock);
+    }
+}
+
+/* give a chain of cached blocks back to the backend */
+static void _heap_cache_release(void *chain)
+{
+    rt_base_t level;
+    void *next;
+
+    if (chain == RT_NULL)
+        return;
+
+    level = _heap_lock();
+    while (chain != RT_NULL)
+    {
+        next = HEAP_CACHE_NEXT(chain);
+        _MEM_FREE(HEAP_CACHE_HDR(chain));
+        chain = next;
+    }
+    _heap_unlock(level);
+}
+
+/* detach up to count blocks from the head of a class, with its lock held */
+static void *_heap_cache_take(struct _heap_cache_class *cache, rt_uint16_t count)
+{
+    void *chain, *tail;
+
+    if (count == 0 || cache->free_list == RT_NULL)
+        return RT_NULL;
+
+    chain = tail = cache->free_list;
+    cache->count--;
+    while (--count && HEAP_CACHE_NEXT(tail) != RT_NULL)
+    {
+        tail = HEAP_CACHE_NEXT(tail);
+        cache->count--;
+    }
+    cache->free_list = HEAP_CACHE_NEXT(tail);
+    HEAP_CACHE_NEXT(tail) = RT_NULL;
+    if (cache->low > cache->count)
+        cache->low = cache->count;
+
+    return chain;
+}
+
+static void *_heap_cache_backend_alloc(rt_size_t size)
+{
+    rt_base_t level;
+    rt_ubase_t *hdr;
+
+    level = _heap_lock();
+    hdr = (rt_ubase_t *)_MEM_MALLOC(size + HEAP_CACHE_HDR_SIZE);
+    _heap_unlock(level);
+
+    return hdr;
+}
+
+/* allocate from a class, refilling it with one batch on a miss */
+static void *_heap_cache_alloc(rt_size_t size)
+{
+    struct _heap_cache_class *cache;
+    rt_base_t level;
+    rt_ubase_t *hdr;
+    void *ptr, *chain = RT_NULL;
+    rt_uint16_t count = 0;
+    int index;
+
+    if (size > HEAP_CACHE_MAX_SIZE)
+    {
+        hdr = _heap_cache_backend_alloc(size);
+        if (hdr == RT_NULL)
+        {
+            /* the cached blocks may be what the backend is missing */
+            rt_heap_cache_flush();
+            hdr = _heap_cache_backend_alloc(size);
+            if (hdr == RT_NULL)
+                return RT_NULL;
+        }
+        if (!_heap_cache_owns(hdr))
+            return hdr;
+        *hdr = HEAP_CACHE_MAGIC | HEAP_CACHE_UNCACHED;
+
+        return HEAP_CACHE_PTR(hdr);
+    }
+
+    index = _heap_cache_index(size);
+    cache = &_heap_cache[index];
+    size = _heap_cache_size[index];
+
+    level = rt_spin_lock_irqsave(&cache->lock);
+    ptr = cache->free_list;
+    if (ptr != RT_NULL)
+    {
+        cache->free_list = HEAP_CACHE_NEXT(ptr);
+        cache->count--;
+        if (cache->low > cache->count)
+            cache->low = cache->count;
+        cache->hits++;
+        rt_spin_unlock_irqrestore(&cache->lock, level);
+
+        return ptr;
+    }
+    cache->misses++;
+    rt_spin_unlock_irqrestore(&cache->lock, level);
+
+    /* refill a batch under one heap lock */
+    level = _heap_lock();
+    for (ptr = RT_NULL; count < RT_HEAP_CACHE_BATCH; count++)
+    {
+        hdr = (rt_ubase_t *)_MEM_MALLOC(size + HEAP_CACHE_HDR_SIZE);
+        if (hdr == RT_NULL)
+            break;
+        if (!_heap_cache_owns(hdr))
+        {
+            /* the system heap is full, do not cache the other heaps */
+            _MEM_FREE(hdr);
+            break;
+        }
+        *hdr = HEAP_CACHE_MAGIC | index;
+        if (ptr == RT_NULL)
+        {
+            ptr = HEAP_CACHE_PTR(hdr);
+        }
+        else
+        {
+            HEAP_CACHE_NEXT(HEAP_CACHE_PTR(hdr)) = chain;
+            chain = HEAP_CACHE_PTR(hdr);
+        }
+    }
+    _heap_unlock(level);
+
+    if (ptr == RT_NULL)
+    {
+        rt_heap_cache_flush();
+        hdr = _heap_cache_backend_alloc(size);
+        if (hdr == RT_NULL)
+            return RT_NULL;
+        if (!_heap_cache_owns(hdr))
+            return hdr;
+        *hdr = HEAP_CACHE_MAGIC | index;
+
+        return HEAP_CACHE_PTR(hdr);
+    }
+
+    if (chain != RT_NULL)
+    {
+        void *tail = chain;
+
+        while (HEAP_CACHE_NEXT(tail) != RT_NULL)
+            tail = HEAP_CACHE_NEXT(tail);
+
+        level = rt_spin_lock_irqsave(&cache->lock);
+        HEAP_CACHE_NEXT(tail) = cache->free_list;
+        cache->free_list = chain;
+        cache->count += count - 1;
+        rt_spin_unlock_irqrestore(&cache->lock, level);
+    }
+
+    return ptr;
+}
+
+static void _heap_cache_free(void *ptr)
+{
+    struct _heap_cache_class *cache;
+    rt_base_t level;
+    rt_ubase_t tag;
+    void *chain = RT_NULL;
+
+    if (!_heap_cache_owns(ptr))
+    {
+        level = _heap_lock();
+        _MEM_FREE(ptr);
+        _heap_unlock(level);
+        return;
+    }
+
+    tag = *HEAP_CACHE_HDR(ptr);
+    RT_ASSERT((tag & HEAP_CACHE_MAGIC_MASK) == HEAP_CACHE_MAGIC);
+    if (HEAP_CACHE_TAG_INDEX(tag) == HEAP_CACHE_UNCACHED)
+    {
+        level = _heap_lock();
+        _MEM_FREE(HEAP_CACHE_HDR(ptr));
+        _heap_unlock(level);
+        return;
+    }
+
+    RT_ASSERT(HEAP_CACHE_TAG_INDEX(tag) < HEAP_CACHE_CLASS_NR);
+    cache = &_heap_cache[HEAP_CACHE_TAG_INDEX(tag)];
+
+    level = rt_spin_lock_irqsave(&cache->lock);
+    HEAP_CACHE_NEXT(ptr) = cache->free_list;
+    cache->free_list = ptr;
+    cache->count++;
+    if (cache->count > RT_HEAP_CACHE_DEPTH)
+    {
+        /* drain a batch back to the backend */
+        chain = _heap_cache_take(cache, RT_HEAP_CACHE_BATCH);
+        cache->drains++;
+    }
+    rt_spin_unlock_irqrestore(&cache->lock, level);
+
+    _heap_cache_release(chain);
+}
+
+static void *_heap_cache_realloc(void *ptr, rt_size_t newsize)
+{
+    rt_base_t level;
+    rt_ubase_t tag, *hdr;
+    rt_size_t size;
+    void *nptr;
+
+    if (!_heap_cache_owns(ptr))
+    {
+        /* stays with the backend, with room for a header */
+        level = _heap_lock();
+        hdr = (rt_ubase_t *)_MEM_REALLOC(ptr, newsize + HEAP_CACHE_HDR_SIZE);
+        _heap_unlock(level);
+
+        if (hdr == RT_NULL || !_heap_cache_owns(hdr))
+            return hdr;
+
+        /* moved into the system heap, where a block needs a header */
+        rt_memmove(HEAP_CACHE_PTR(hdr), hdr, newsize);
+        *hdr = HEAP_CACHE_MAGIC | HEAP_CACHE_UNCACHED;
+
+        return HEAP_CACHE_PTR(hdr);
+    }
+
+    tag = *HEAP_CACHE_HDR(ptr);
+    RT_ASSERT((tag & HEAP_CACHE_MAGIC_MASK) == HEAP_CACHE_MAGIC);
+    if (HEAP_CACHE_TAG_INDEX(tag) == HEAP_CACHE_UNCACHED)
+    {
+        /* stays with the backend */
+        level = _heap_lock();
+        hdr = (rt_ubase_t *)_MEM_REALLOC(HEAP_CACHE_HDR(ptr), newsize + HEAP_CACHE_HDR_SIZE);
+        _heap_unlock(level);
+
+        if (hdr == RT_NULL)
+            return RT_NULL;
+        if (!_heap_cache_owns(hdr))
+        {
+            /* moved to another heap, drop the header */
+            rt_memmove(hdr, HEAP_CACHE_PTR(hdr), newsize);
+            return hdr;
+        }
+
+        return HEAP_CACHE_PTR(hdr);
+    }
+
+    if (newsize <= HEAP_CACHE_MAX_SIZE && _heap_cache_index(newsize) == HEAP_CACHE_TAG_INDEX(tag))
+        return ptr;
+    size = _heap_cache_size[HEAP_CACHE_TAG_INDEX(tag)];
+
+    nptr = _heap_cache_alloc(newsize);
+    if (nptr != RT_NULL)
+    {
+        rt_memcpy(nptr, ptr, size < newsize ? size : newsize);
+        _heap_cache_free(ptr);
+    }
+
+    return nptr;
+}
+
+#ifdef RT_USING_IDLE_HOOK
+static void _heap_cache_idle_hook(void)
+{
+    static rt_tick_t trim_tick;
+
+    if (rt_tick_get() - trim_tick >= rt_tick_from_millisecond(RT_HEAP_CACHE_TRIM_PERIOD))
+    {
+        trim_tick = rt_tick_get();
+        rt_heap_cache_trim();
+    }
+}
+#endif /* RT_USING_IDLE_HOOK */
+
+/**
+ * @brief This function will trim the size class cache of the system heap.
+ *
+ * @note  The blocks of a class that stayed cached since the last trim, i.e.
+ *        the lowest count seen in between, are given back to the heap. It is
+ *        called periodically from the idle thread when the idle hook is enabled.
+ */
+void rt_heap_cache_trim(void)
+{
+    struct _heap_cache_class *cache;
+    rt_base_t level;
+    void *chain;
+    int index;
+
+    for (index = 0; index < HEAP_CACHE_CLASS_NR; index++)
+    {
+        cache = &_heap_cache[index];
+
+        level = rt_spin_lock_irqsave(&cache->lock);
+        chain = _heap_cache_take(cache, cache->low);
+        cache->low = cache->count;
+        rt_spin_unlock_irqrestore(&cache->lock, level);
+
+        _heap_cache_release(chain);
+    }
+}
+RTM_EXPORT(rt_heap_cache_trim);
+
+/**
+ * @brief This function will give every block of the size class cache back to
+ *        the system heap.
+ */
+void rt_heap_cache_flush(void)
+{
+    struct _heap_cache_class *cache;
+    rt_base_t level;
+    void *chain;
+    int index;
+
+    for (index = 0; index < HEAP_CACHE_CLASS_NR; index++)
+    {
+        cache = &_heap_cache[index];
+
+        level = rt_spin_lock_irqsave(&cache->lock);
+        chain = _heap_cache_take(cache, cache->count);
+        cache->low = 0;
+        rt_spin_unlock_irqrestore(&cache->lock, level);
+
+        _heap_cache_release(chain);
+    }
+}
+RTM_EXPORT(rt_heap_cache_flush);
+
+/**
+ * @brief This function will get the statistics of a size class.
+ *
+ * @param index is the index of the size class, from 0 for the smallest one.
+ *
+ * @param stat is a pointer to get the statistics.
+ *
+ * @return RT_EOK on success, -RT_EINVAL if there is no such class.
+ */
+rt_err_t rt_heap_cache_get_stat(int index, struct rt_heap_cache_stat *stat)
+{
+    struct _heap_cache_class *cache;
+    rt_base_t level;
+
+    if (index < 0 || index >= HEAP_CACHE_CLASS_NR || stat == RT_NULL)
+        return -RT_EINVAL;
+
+    cache = &_heap_cache[index];
+    level = rt_spin_lock_irqsave(&cache->lock);
+    stat->size = _heap_cache_size[index];
+    stat->cached = cache->count;
+    stat->hits = cache->hits;
+    stat->misses = cache->misses;
+    stat->drains = cache->drains;
+    rt_spin_unlock_irqrestore(&cache->lock, level);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_heap_cache_get_stat);
+
+#ifdef RT_USING_FINSH
+static int heapcache(int argc, char **argv)
+{
+    struct rt_heap_cache_stat stat;
+    int index;
+
+    if (argc > 1 && rt_strcmp(argv[1], "-t") == 0)
+        rt_heap_cache_trim();
+    else if (argc > 1 && rt_strcmp(argv[1], "-f") == 0)
+        rt_heap_cache_flush();
+
+    rt_kprintf("size   cached   hits       misses     drains\n");
+    rt_kprintf("------ -------- ---------- ---------- ----------\n");
+    for (index = 0; rt_heap_cache_get_stat(index, &stat) == RT_EOK; index++)
+    {
+        rt_kprintf("%-6d %-8d %-10u %-10u %-10u\n", stat.size, stat.cached,
+                   stat.hits, stat.misses, stat.drains);
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(heapcache, show heap size class cache; -t trim; -f flush);
+#endif /* RT_USING_FINSH */
+
+#endif /* RT_USING_HEAP_CACHE */
+
 static void _rt_system_heap_init(void *begin_addr, void *end_addr)
 {
     rt_ubase_t begin_align = RT_ALIGN((rt_ubase_t)begin_addr, RT_ALIGN_SIZE);
@@ -784,6 +1308,12 @@ static void _rt_system_heap_init(void *begin_addr, void *end_addr)
     _MEM_INIT("heap", (void *)begin_align, end_align - begin_align);
     /* Initialize multi thread contention lock */
     _heap_lock_init();
+#ifdef RT_USING_HEAP_CACHE
+    _heap_cache_init(begin_align, end_align);
+#ifdef RT_USING_IDLE_HOOK
+    rt_thread_idle_sethook(_heap_cache_idle_hook);
+#endif /* RT_USING_IDLE_HOOK */
+#endif /* RT_USING_HEAP_CACHE */
 }
 
 /**
@@ -798,17 +1328,14 @@ rt_weak void rt_system_heap_init(void *begin_addr, void *end_addr)
     _rt_system_heap_init(begin_addr, end_addr);
 }
 
-/**
- * @brief Allocate a block of memory with a minimum of 'size' bytes.
- *
- * @param size is the minimum size of the requested block in bytes.
- *
- * @return the pointer to allocated memory or NULL if no free memory was found.
- */
-rt_weak void *rt_malloc(rt_size_t size)
+/* rt_malloc, charging the block to the call site 'caller' */
+rt_inline void *_heap_malloc(rt_size_t size, void *caller)
 {
-    rt_base_t level;
     void *ptr;
+#ifdef RT_USING_HEAP_CACHE
+    ptr = size ? _heap_cache_alloc(size) : RT_NULL;
+#else
+    rt_base_t level;
 
     /* Enter critical zone */
     level = _heap_lock();
@@ -816,10 +1343,28 @@ rt_weak void *rt_malloc(rt_size_t size)
     ptr = _MEM_MALLOC(size);
     /* Exit critical zone */
     _heap_unlock(level);
+#endif /* RT_USING_HEAP_CACHE */
     /* call 'rt_malloc' hook */
     RT_OBJECT_HOOK_CALL(rt_malloc_hook, (&ptr, size));
+#ifdef RT_USING_HEAP_PROF
+    rt_heap_prof_alloc(ptr, size, caller);
+#else
+    RT_UNUSED(caller);
+#endif /* RT_USING_HEAP_PROF */
     return ptr;
 }
+
+/**
+ * @brief Allocate a block of memory with a minimum of 'size' bytes.
+ *
+ * @param size is the minimum size of the requested block in bytes.
+ *
+ * @return the pointer to allocated memory or NULL if no free memory was found.
+ */
+rt_weak void *rt_malloc(rt_size_t size)
+{
+    return _heap_malloc(size, _HEAP_CALLER());
+}
 RTM_EXPORT(rt_malloc);
 
 /**
@@ -833,19 +1378,40 @@ RTM_EXPORT(rt_malloc);
  */
 rt_weak void *rt_realloc(void *ptr, rt_size_t newsize)
 {
-    rt_base_t level;
     void *nptr;
+#ifndef RT_USING_HEAP_CACHE
+    rt_base_t level;
+#endif /* RT_USING_HEAP_CACHE */
 
     /* Entry hook */
     RT_OBJECT_HOOK_CALL(rt_realloc_entry_hook, (&ptr, newsize));
+#ifdef RT_USING_HEAP_CACHE
+    if (ptr == RT_NULL)
+    {
+        nptr = newsize ? _heap_cache_alloc(newsize) : RT_NULL;
+    }
+    else if (newsize == 0)
+    {
+        _heap_cache_free(ptr);
+        nptr = RT_NULL;
+    }
+    else
+    {
+        nptr = _heap_cache_realloc(ptr, newsize);
+    }
+#else
     /* Enter critical zone */
     level = _heap_lock();
     /* Change the size of previously allocated memory block */
     nptr = _MEM_REALLOC(ptr, newsize);
     /* Exit critical zone */
     _heap_unlock(level);
+#endif /* RT_USING_HEAP_CACHE */
     /* Exit hook */
     RT_OBJECT_HOOK_CALL(rt_realloc_exit_hook, (&nptr, newsize));
+#ifdef RT_USING_HEAP_PROF
+    rt_heap_prof_realloc(ptr, nptr, newsize, _HEAP_CALLER());
+#endif /* RT_USING_HEAP_PROF */
     return nptr;
 }
 RTM_EXPORT(rt_realloc);
@@ -868,7 +1434,11 @@ rt_weak void *rt_calloc(rt_size_t count, rt_size_t size)
     void *p;
 
     /* allocate 'count' objects of size 'size' */
+#ifdef RT_USING_HEAP_PROF
+    p = _heap_malloc(count * size, _HEAP_CALLER());
+#else
     p = rt_malloc(count * size);
+#endif /* RT_USING_HEAP_PROF */
     /* zero the memory */
     if (p)
     {
@@ -886,17 +1456,26 @@ RTM_EXPORT(rt_calloc);
  */
 rt_weak void rt_free(void *ptr)
 {
+#ifndef RT_USING_HEAP_CACHE
     rt_base_t level;
+#endif /* RT_USING_HEAP_CACHE */
 
     /* call 'rt_free' hook */
     RT_OBJECT_HOOK_CALL(rt_free_hook, (&ptr));
     /* NULL check */
     if (ptr == RT_NULL) return;
+#ifdef RT_USING_HEAP_PROF
+    rt_heap_prof_free(ptr);
+#endif /* RT_USING_HEAP_PROF */
+#ifdef RT_USING_HEAP_CACHE
+    _heap_cache_free(ptr);
+#else
     /* Enter critical zone */
     level = _heap_lock();
     _MEM_FREE(ptr);
     /* Exit critical zone */
     _heap_unlock(level);
+#endif /* RT_USING_HEAP_CACHE */
 }
 RTM_EXPORT(rt_free);
 
@@ -921,9 +1500,152 @@ rt_weak void rt_memory_info(rt_size_t *total,
     _MEM_INFO(total, used, max_used);
     /* Exit critical zone */
     _heap_unlock(level);
+#ifdef RT_USING_HEAP_CACHE
+    /* the cached blocks are free to any rt_malloc of their class */
+    if (used)
+        *used -= _heap_cache_bytes();
+#endif /* RT_USING_HEAP_CACHE */
 }
 RTM_EXPORT(rt_memory_info);
 
+/**
+ * @brief This function will return the size of the largest free block of the
+ *        system heap, which is the largest request it could serve.
+ *
+ * @note  Blocks held by the size class cache count as used.
+ *
+ * @return the size of the largest free block, 0 if the heap does not tell.
+ */
+rt_weak rt_size_t rt_memory_max_free(void)
+{
+    rt_base_t level;
+    rt_size_t max_free;
+
+    /* Enter critical zone */
+    level = _heap_lock();
+    max_free = _MEM_MAX_FREE();
+    /* Exit critical zone */
+    _heap_unlock(level);
+
+    return max_free;
+}
+RTM_EXPORT(rt_memory_max_free);
+
+#ifdef RT_USING_MEMHEAP_HINT
+/* rt_malloc_hint, charging the block to the call site 'caller' */
+static void *_heap_malloc_hint(rt_size_t size, rt_uint32_t hint, void *caller)
+{
+    rt_base_t level;
+    void *ptr = RT_NULL;
+
+    if (size != 0)
+    {
+        /* Enter critical zone */
+        level = _heap_lock();
+#ifdef RT_USING_HEAP_CACHE
+        /* bypass the size class cache, which does not keep the placement */
+        ptr = _memheap_alloc_hint(&system_heap, size + HEAP_CACHE_HDR_SIZE, hint);
+        /* only a block of the system heap carries a header */
+        if (ptr != RT_NULL && _heap_cache_owns(ptr))
+        {
+            *(rt_ubase_t *)ptr = HEAP_CACHE_MAGIC | HEAP_CACHE_UNCACHED;
+            ptr = HEAP_CACHE_PTR(ptr);
+        }
+#else
+        ptr = _memheap_alloc_hint(&system_heap, size, hint);
+#endif /* RT_USING_HEAP_CACHE */
+        /* Exit critical zone */
+        _heap_unlock(level);
+    }
+    /* call 'rt_malloc' hook */
+    RT_OBJECT_HOOK_CALL(rt_malloc_hook, (&ptr, size));
+#ifdef RT_USING_HEAP_PROF
+    rt_heap_prof_alloc(ptr, size, caller);
+#else
+    RT_UNUSED(caller);
+#endif /* RT_USING_HEAP_PROF */
+    return ptr;
+}
+
+/**
+ * @brief Allocate a block of memory with a minimum of 'size' bytes from the
+ *        memory classes named by 'hint'.
+ *
+ * @note  The block is placed in a memheap registered with every class bit of
+ *        the hint. When these are full it comes from any heap, unless
+ *        RT_MEM_STRICT is given or RT_MEMHEAP_HINT_STRICT is enabled and
+ *        RT_MEM_FALLBACK is not given. The block is released with rt_free();
+ *        rt_realloc() may move it out of its class.
+ *
+ * @param size is the minimum size of the requested block in bytes.
+ *
+ * @param hint is the RT_MEM_* classes and the fallback flags.
+ *
+ * @return the pointer to allocated memory or NULL if no free memory was found.
+ */
+rt_weak void *rt_malloc_hint(rt_size_t size, rt_uint32_t hint)
+{
+    return _heap_malloc_hint(size, hint, _HEAP_CALLER());
+}
+RTM_EXPORT(rt_malloc_hint);
+
+/**
+ * @brief Allocate a zeroed array of 'count' objects of 'size' bytes each from
+ *        the memory classes named by 'hint', like rt_malloc_hint().
+ *
+ * @param count is the number of objects to allocate.
+ *
+ * @param size is the size of one object to allocate.
+ *
+ * @param hint is the RT_MEM_* classes and the fallback flags.
+ *
+ * @return pointer to allocated memory / NULL pointer if there is an error.
+ */
+rt_weak void *rt_calloc_hint(rt_size_t count, rt_size_t size, rt_uint32_t hint)
+{
+    void *p;
+
+    p = _heap_malloc_hint(count * size, hint, _HEAP_CALLER());
+    /* zero the memory */
+    if (p)
+    {
+        rt_memset(p, 0, count * size);
+    }
+    return p;
+}
+RTM_EXPORT(rt_calloc_hint);
+#endif /* RT_USING_MEMHEAP_HINT */
+
+#ifdef RT_USING_TLSF_AS_HEAP
+/**
+ * @brief This function will add a memory region, e.g. external PSRAM, to the
+ *        system heap.
+ *
+ * @param begin_addr the beginning address of the region.
+ *
+ * @param end_addr the end address of the region.
+ *
+ * @return RT_EOK on success, -RT_EINVAL if the region is too small.
+ */
+rt_err_t rt_system_heap_add(void *begin_addr, void *end_addr)
+{
+    rt_base_t level;
+    rt_err_t result;
+
+    RT_ASSERT((rt_ubase_t)end_addr > (rt_ubase_t)begin_addr);
+
+    /* Enter critical zone */
+    level = _heap_lock();
+    result = rt_tlsf_add_region(system_heap, begin_addr,
+                                (rt_ubase_t)end_addr - (rt_ubase_t)begin_addr);
+    /* Exit critical zone */
+    _heap_unlock(level);
+
+    return result;
+}
+RTM_EXPORT(rt_system_heap_add);
+#endif /* RT_USING_TLSF_AS_HEAP */
+
 #if defined(RT_USING_SLAB) && defined(RT_USING_SLAB_AS_HEAP)
 void *rt_page_alloc(rt_size_t npages)
 {
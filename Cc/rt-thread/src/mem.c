@@ -12,6 +12,8 @@
  * 2010-10-14     Bernard      fix rt_realloc issue when realloc a NULL pointer.
  * 2017-07-14     armink       fix rt_realloc issue when new size is 0
  * 2018-10-02     Bernard      Add 64bit support
+ * 2026-10-18     Cc           skip the memory objects of other algorithms in memcheck/memtrace
+ * 2026-10-18     Cc           add rt_smem_max_free
  */
 
 /*
@@ -548,6 +550,42 @@ void rt_smem_free(void *rmem)
 }
 RTM_EXPORT(rt_smem_free);
 
+/**
+ * @brief This function returns the size of the largest free block of a small
+ *        memory object, which is the largest request it could serve.
+ *
+ * @note  The caller serializes it against allocations, as rt_smem_alloc.
+ *
+ * @param m the small memory management object.
+ *
+ * @return the usable size of the largest free block.
+ */
+rt_size_t rt_smem_max_free(rt_smem_t m)
+{
+    struct rt_small_mem_item *mem;
+    struct rt_small_mem *small_mem;
+    rt_size_t size, max_free = 0;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+    RT_ASSERT(rt_object_is_systemobject(&m->parent));
+
+    small_mem = (struct rt_small_mem *)m;
+    /* no free block lives below lfree */
+    for (mem = small_mem->lfree; mem != small_mem->heap_end;
+         mem = (struct rt_small_mem_item *)&small_mem->heap_ptr[mem->next])
+    {
+        if (MEM_ISUSED(mem))
+            continue;
+        size = MEM_SIZE(small_mem, mem);
+        if (size > max_free)
+            max_free = size;
+    }
+
+    return max_free;
+}
+RTM_EXPORT(rt_smem_max_free);
+
 #ifdef RT_USING_FINSH
 #include <finsh.h>
 
@@ -577,6 +615,8 @@ static int memcheck(int argc, char *argv[])
             continue;
         /* mem object */
         m = (struct rt_small_mem *)object;
+        if (rt_strcmp(m->parent.algorithm, "small") != 0)
+            continue;
         /* check mem */
         for (mem = (struct rt_small_mem_item *)m->heap_ptr; mem != m->heap_end; mem = (struct rt_small_mem_item *)&m->heap_ptr[mem->next])
         {
@@ -623,6 +663,8 @@ static int memtrace(int argc, char **argv)
             continue;
         /* mem object */
         m = (struct rt_small_mem *)object;
+        if (rt_strcmp(m->parent.algorithm, "small") != 0)
+            continue;
         /* show memory information */
         rt_kprintf("\nmemory heap address:\n");
         rt_kprintf("name    : %s\n", m->parent.parent.name);
@@ -19,6 +19,8 @@
  * 2013-07-15     Grissiom     optimize rt_memheap_realloc
  * 2021-06-03     Flybreak     Fix the crash problem after opening Oz optimization on ac6.
  * 2023-03-01     Bernard      Fix the alignment issue for minimal size
+ * 2026-10-18     Cc           add rt_memheap_max_free
+ * 2026-10-18     Cc           add memory classes and placement hints
  */
 
 #include <rthw.h>
@@ -92,6 +94,9 @@ rt_err_t rt_memheap_init(struct rt_memheap *memheap,
     memheap->pool_size      = RT_ALIGN_DOWN(size, RT_ALIGN_SIZE);
     memheap->available_size = memheap->pool_size - (2 * RT_MEMHEAP_SIZE);
     memheap->max_used_size  = memheap->pool_size - memheap->available_size;
+#ifdef RT_USING_MEMHEAP_HINT
+    memheap->mem_class      = 0;
+#endif /* RT_USING_MEMHEAP_HINT */
 
     /* initialize the free list header */
     item            = &(memheap->free_header);
@@ -766,6 +771,52 @@ void rt_memheap_info(struct rt_memheap *heap,
     }
 }
 
+/**
+ * @brief This function will return the size of the largest free block in the
+ *        memheap, which is the largest request it could serve.
+ *
+ * @param heap is a pointer to the memheap object.
+ *
+ * @return the usable size of the largest free block.
+ */
+rt_size_t rt_memheap_max_free(struct rt_memheap *heap)
+{
+    rt_err_t result;
+    struct rt_memheap_item *item;
+    rt_size_t max_free = 0;
+
+    RT_ASSERT(heap);
+    RT_ASSERT(rt_object_get_type(&heap->parent) == RT_Object_Class_MemHeap);
+
+    if (heap->locked == RT_FALSE)
+    {
+        /* lock memheap */
+        result = rt_sem_take(&(heap->lock), RT_WAITING_FOREVER);
+        if (result != RT_EOK)
+        {
+            rt_set_errno(result);
+            return 0;
+        }
+    }
+
+    for (item = heap->free_list->next_free;
+         item != heap->free_list;
+         item = item->next_free)
+    {
+        if (MEMITEM_SIZE(item) > max_free)
+            max_free = MEMITEM_SIZE(item);
+    }
+
+    if (heap->locked == RT_FALSE)
+    {
+        /* release lock */
+        rt_sem_release(&(heap->lock));
+    }
+
+    return max_free;
+}
+RTM_EXPORT(rt_memheap_max_free);
+
 #ifdef RT_USING_MEMHEAP_AS_HEAP
 /*
  * rt_malloc port function
@@ -858,6 +909,195 @@ void *_memheap_realloc(struct rt_memheap *heap, void *rmem, rt_size_t newsize)
 
     return new_ptr;
 }
+
+#ifdef RT_USING_MEMHEAP_HINT
+/* the hinted requests of each class bit, counted under the system heap lock */
+static struct
+{
+    rt_uint32_t allocs;
+    rt_uint32_t fallbacks;
+    rt_uint32_t failures;
+} _mem_class_count[RT_MEM_CLASS_NR];
+
+static void _mem_class_account(rt_uint32_t mem_class, void *ptr, rt_bool_t fallback)
+{
+    int index;
+
+    for (index = 0; index < RT_MEM_CLASS_NR; index++)
+    {
+        if (!(mem_class & (1UL << index)))
+            continue;
+
+        if (ptr == RT_NULL)
+            _mem_class_count[index].failures++;
+        else if (fallback)
+            _mem_class_count[index].fallbacks++;
+        else
+            _mem_class_count[index].allocs++;
+    }
+}
+
+/**
+ * @brief This function will assign memory classes to a memheap, so that the
+ *        hinted allocations of these classes are placed in it.
+ *
+ * @note  It is called by the BSP once the heap is initialized, e.g.
+ *        rt_memheap_class_register("psram", RT_MEM_BULK). The system heap is
+ *        named "heap". A class of 0 takes the heap out of every class.
+ *
+ * @param name is the name of the memheap.
+ *
+ * @param mem_class is the RT_MEM_* classes of its memory.
+ *
+ * @return RT_EOK on success, -RT_EINVAL on a bad class, -RT_ENOENT if there
+ *         is no such memheap.
+ */
+rt_err_t rt_memheap_class_register(const char *name, rt_uint32_t mem_class)
+{
+    struct rt_memheap *heap;
+
+    RT_ASSERT(name != RT_NULL);
+
+    if (mem_class & ~((1UL << RT_MEM_CLASS_NR) - 1))
+        return -RT_EINVAL;
+
+    heap = (struct rt_memheap *)rt_object_find(name, RT_Object_Class_MemHeap);
+    if (heap == RT_NULL)
+        return -RT_ENOENT;
+
+    heap->mem_class = mem_class;
+    LOG_D("memheap %.*s class 0x%x", RT_NAME_MAX, name, mem_class);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_memheap_class_register);
+
+/*
+ * rt_malloc_hint port function
+ *
+ * The heaps holding every class bit of the hint are tried in the order they
+ * were created. When all of them are full the request falls back to the
+ * ordinary heap order, unless the fallback policy forbids it.
+*/
+void *_memheap_alloc_hint(struct rt_memheap *heap, rt_size_t size, rt_uint32_t hint)
+{
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+    struct rt_memheap *_heap;
+    rt_uint32_t mem_class;
+    rt_bool_t strict;
+    void *ptr;
+
+    mem_class = hint & RT_MEM_CLASS_MASK;
+    if (mem_class == 0)
+        return _memheap_alloc(heap, size);
+
+#ifdef RT_MEMHEAP_HINT_STRICT
+    strict = (hint & RT_MEM_FALLBACK) ? RT_FALSE : RT_TRUE;
+#else
+    strict = (hint & RT_MEM_STRICT) ? RT_TRUE : RT_FALSE;
+#endif /* RT_MEMHEAP_HINT_STRICT */
+
+    information = rt_object_get_information(RT_Object_Class_MemHeap);
+    RT_ASSERT(information != RT_NULL);
+    for (node  = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        _heap = (struct rt_memheap *)rt_list_entry(node, struct rt_object, list);
+        if ((_heap->mem_class & mem_class) != mem_class)
+            continue;
+
+        ptr = rt_memheap_alloc(_heap, size);
+        if (ptr != RT_NULL)
+        {
+            _mem_class_account(mem_class, ptr, RT_FALSE);
+            return ptr;
+        }
+    }
+
+    ptr = strict ? RT_NULL : _memheap_alloc(heap, size);
+    _mem_class_account(mem_class, ptr, RT_TRUE);
+
+    return ptr;
+}
+
+/**
+ * @brief This function will get the usage and the hinted allocations of a
+ *        memory class.
+ *
+ * @param mem_class is one RT_MEM_* class bit.
+ *
+ * @param stat is a pointer to the statistics of the class.
+ *
+ * @return RT_EOK on success, -RT_EINVAL if mem_class is not one class bit.
+ */
+rt_err_t rt_mem_class_get_stat(rt_uint32_t mem_class, struct rt_mem_class_stat *stat)
+{
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+    struct rt_memheap *heap;
+    rt_size_t total, used, max_used;
+    int index;
+
+    RT_ASSERT(stat != RT_NULL);
+
+    for (index = 0; index < RT_MEM_CLASS_NR; index++)
+    {
+        if (mem_class == (1UL << index))
+            break;
+    }
+    if (index == RT_MEM_CLASS_NR)
+        return -RT_EINVAL;
+
+    rt_memset(stat, 0, sizeof(*stat));
+    stat->allocs    = _mem_class_count[index].allocs;
+    stat->fallbacks = _mem_class_count[index].fallbacks;
+    stat->failures  = _mem_class_count[index].failures;
+
+    information = rt_object_get_information(RT_Object_Class_MemHeap);
+    RT_ASSERT(information != RT_NULL);
+    for (node  = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        heap = (struct rt_memheap *)rt_list_entry(node, struct rt_object, list);
+        if (!(heap->mem_class & mem_class))
+            continue;
+
+        rt_memheap_info(heap, &total, &used, &max_used);
+        stat->heaps++;
+        stat->total    += total;
+        stat->used     += used;
+        stat->max_used += max_used;
+    }
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mem_class_get_stat);
+
+#ifdef RT_USING_FINSH
+static int memclass(void)
+{
+    static const char *const names[RT_MEM_CLASS_NR] = {"fast", "dma", "bulk"};
+    struct rt_mem_class_stat stat;
+    int index;
+
+    rt_kprintf("class heaps total      used       max used   allocs     fallbacks  failures\n");
+    rt_kprintf("----- ----- ---------- ---------- ---------- ---------- ---------- ----------\n");
+    for (index = 0; index < RT_MEM_CLASS_NR; index++)
+    {
+        rt_mem_class_get_stat(1UL << index, &stat);
+        rt_kprintf("%-5s %-5d %-10d %-10d %-10d %-10u %-10u %-10u\n", names[index],
+                   stat.heaps, stat.total, stat.used, stat.max_used,
+                   stat.allocs, stat.fallbacks, stat.failures);
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(memclass, show memory class usage and hinted allocations);
+#endif /* RT_USING_FINSH */
+#endif /* RT_USING_MEMHEAP_HINT */
 #endif
 
 #ifdef RT_USING_MEMTRACE
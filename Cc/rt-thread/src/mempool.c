@@ -17,6 +17,7 @@
  * 2022-01-07     Gabriel      Moving __on_rt_xxxxx_hook to mempool.c
  * 2023-09-15     xqyjlj       perf rt_hw_interrupt_disable/enable
  * 2023-12-10     xqyjlj       fix spinlock assert
+ * 2026-10-18     Cc           add lock-free memory pool
  */
 
 #include <rthw.h>
@@ -406,6 +407,289 @@ void rt_mp_free(void *block)
 }
 RTM_EXPORT(rt_mp_free);
 
+#ifdef RT_USING_MEMPOOL_LOCKFREE
+/*
+ * The free blocks of a lock-free pool form a stack linked by block index. The
+ * head word holds the index + 1 of the top block in its low half, 0 for an
+ * empty stack, and a tag in its high half. Every successful push or pop bumps
+ * the tag, so a compare-and-swap fails whenever the head changed in between,
+ * even if the same block is back on top (the ABA problem). A free block keeps
+ * the index + 1 of the next one in its first word; a stale read of it by a
+ * loser of the race is harmless since its compare-and-swap fails.
+ *
+ * The head is a single rt_atomic_t, as there is no double-word
+ * compare-and-swap on the 32-bit cores, so the tag has 16 bits there. It
+ * wraps after 65536 pushes and pops: a thread stalled between its read of the
+ * head and its compare-and-swap for exactly a multiple of that many changes,
+ * with the same block on top again, still succeeds on a stale next link.
+ */
+#define MP_LF_INDEX_BITS    (sizeof(rt_atomic_t) * 4)
+#define MP_LF_INDEX_MASK    (((rt_atomic_t)1 << MP_LF_INDEX_BITS) - 1)
+#define MP_LF_TAG_ONE       ((rt_atomic_t)1 << MP_LF_INDEX_BITS)
+
+#define MP_LF_BLOCK(_mp, _link) \
+    ((_mp)->start_address + ((_link) - 1) * (_mp)->block_size)
+#define MP_LF_NEXT(_block)  (*(volatile rt_atomic_t *)(_block))
+
+/**
+ * @brief  This function will initialize a lock-free memory pool.
+ *
+ * @note   The blocks are carved from the memory area without any header, a
+ *         block holds at least a rt_atomic_t and is aligned to RT_ALIGN_SIZE.
+ *
+ * @param  mp is the lock-free memory pool.
+ *
+ * @param  name is the name of the memory pool.
+ *
+ * @param  start is the start address of the memory pool.
+ *
+ * @param  size is the total size of the memory pool.
+ *
+ * @param  block_size is the size for each block.
+ *
+ * @return RT_EOK on success, -RT_EINVAL if the area holds no block or more
+ *         blocks than the index of the free stack can address.
+ */
+rt_err_t rt_mp_lf_init(struct rt_mempool_lf *mp,
+                       const char           *name,
+                       void                 *start,
+                       rt_size_t             size,
+                       rt_size_t             block_size)
+{
+    rt_uint8_t *block_ptr;
+    rt_size_t index;
+
+    /* parameter check */
+    RT_ASSERT(mp != RT_NULL);
+    RT_ASSERT(name != RT_NULL);
+    RT_ASSERT(start != RT_NULL);
+    RT_ASSERT(((rt_ubase_t)start & (RT_ALIGN_SIZE - 1)) == 0);
+    RT_ASSERT(size > 0 && block_size > 0);
+
+    if (block_size < sizeof(rt_atomic_t))
+        block_size = sizeof(rt_atomic_t);
+    block_size = RT_ALIGN(block_size, RT_ALIGN_SIZE);
+    if (size / block_size == 0 || size / block_size >= MP_LF_INDEX_MASK)
+        return -RT_EINVAL;
+
+    mp->start_address     = (rt_uint8_t *)start;
+    mp->block_size        = block_size;
+    mp->block_total_count = size / block_size;
+
+    /* link every block to the next one, the last one ends the stack */
+    block_ptr = mp->start_address;
+    for (index = 0; index < mp->block_total_count; index++)
+    {
+        MP_LF_NEXT(block_ptr) = index + 1 < mp->block_total_count ? index + 2 : 0;
+        block_ptr += block_size;
+    }
+
+    rt_atomic_store(&(mp->head), 1);
+    rt_atomic_store(&(mp->free_count), mp->block_total_count);
+    rt_atomic_store(&(mp->min_free_count), mp->block_total_count);
+    rt_atomic_store(&(mp->failed_count), 0);
+
+#ifdef RT_USING_SEMAPHORE
+    rt_atomic_store(&(mp->waiters), 0);
+    rt_sem_init(&(mp->wait_sem), name, 0, RT_IPC_FLAG_PRIO);
+#endif /* RT_USING_SEMAPHORE */
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mp_lf_init);
+
+/**
+ * @brief  This function will detach a lock-free memory pool, the threads
+ *         waiting for a block are woken up with an error.
+ *
+ * @param  mp is the lock-free memory pool.
+ *
+ * @return RT_EOK
+ */
+rt_err_t rt_mp_lf_detach(struct rt_mempool_lf *mp)
+{
+    RT_ASSERT(mp != RT_NULL);
+
+#ifdef RT_USING_SEMAPHORE
+    rt_sem_detach(&(mp->wait_sem));
+#endif /* RT_USING_SEMAPHORE */
+    rt_atomic_store(&(mp->head), 0);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mp_lf_detach);
+
+/**
+ * @brief  This function will allocate a block from a lock-free memory pool
+ *         without waiting. It may be called from any context, interrupt
+ *         service routines included.
+ *
+ * @param  mp is the lock-free memory pool.
+ *
+ * @return the allocated block, or RT_NULL if the pool is empty.
+ */
+void *rt_mp_lf_alloc(rt_mp_lf_t mp)
+{
+    rt_atomic_t head, next, free_count, min_free;
+    rt_uint8_t *block_ptr;
+
+    RT_ASSERT(mp != RT_NULL);
+
+    head = rt_atomic_load(&(mp->head));
+    do
+    {
+        if ((head & MP_LF_INDEX_MASK) == 0)
+        {
+            rt_atomic_add(&(mp->failed_count), 1);
+            return RT_NULL;
+        }
+
+        block_ptr = MP_LF_BLOCK(mp, head & MP_LF_INDEX_MASK);
+        next = MP_LF_NEXT(block_ptr) & MP_LF_INDEX_MASK;
+    } while (!rt_atomic_compare_exchange_strong(&(mp->head), &head,
+                                                ((head & ~MP_LF_INDEX_MASK) + MP_LF_TAG_ONE) | next));
+
+    /* track the low water mark of the free blocks */
+    free_count = rt_atomic_sub(&(mp->free_count), 1) - 1;
+    min_free = rt_atomic_load(&(mp->min_free_count));
+    while (free_count < min_free &&
+           !rt_atomic_compare_exchange_strong(&(mp->min_free_count), &min_free, free_count));
+
+    return block_ptr;
+}
+RTM_EXPORT(rt_mp_lf_alloc);
+
+/**
+ * @brief  This function will release a block to its lock-free memory pool.
+ *         It may be called from any context, interrupt service routines
+ *         included.
+ *
+ * @param  mp is the lock-free memory pool the block was allocated from.
+ *
+ * @param  block is the block to be released.
+ */
+void rt_mp_lf_free(rt_mp_lf_t mp, void *block)
+{
+    rt_atomic_t head, link;
+
+    RT_ASSERT(mp != RT_NULL);
+    if (block == RT_NULL) return;
+
+    RT_ASSERT((rt_uint8_t *)block >= mp->start_address);
+    RT_ASSERT(((rt_uint8_t *)block - mp->start_address) % mp->block_size == 0);
+    link = ((rt_uint8_t *)block - mp->start_address) / mp->block_size + 1;
+    RT_ASSERT(link <= mp->block_total_count);
+
+    /* counted before the push, so that the count never drops below zero */
+    rt_atomic_add(&(mp->free_count), 1);
+    head = rt_atomic_load(&(mp->head));
+    do
+    {
+        MP_LF_NEXT(block) = head & MP_LF_INDEX_MASK;
+    } while (!rt_atomic_compare_exchange_strong(&(mp->head), &head,
+                                                ((head & ~MP_LF_INDEX_MASK) + MP_LF_TAG_ONE) | link));
+
+#ifdef RT_USING_SEMAPHORE
+    /* the waiters recheck the pool after announcing themselves */
+    if (rt_atomic_load(&(mp->waiters)) != 0)
+        rt_sem_release(&(mp->wait_sem));
+#endif /* RT_USING_SEMAPHORE */
+}
+RTM_EXPORT(rt_mp_lf_free);
+
+#ifdef RT_USING_SEMAPHORE
+/**
+ * @brief  This function will allocate a block from a lock-free memory pool,
+ *         waiting for a release while the pool is empty.
+ *
+ * @param  mp is the lock-free memory pool.
+ *
+ * @param  time is the maximum waiting time for allocating memory.
+ *              - 0 for not waiting, allocating memory immediately.
+ *
+ * @return the allocated block, or RT_NULL if none was released in time.
+ */
+void *rt_mp_lf_alloc_wait(rt_mp_lf_t mp, rt_int32_t time)
+{
+    void *block;
+    rt_tick_t before_sleep;
+    rt_err_t result;
+
+    RT_ASSERT(mp != RT_NULL);
+
+    while ((block = rt_mp_lf_alloc(mp)) == RT_NULL && time != 0)
+    {
+        RT_DEBUG_NOT_IN_INTERRUPT;
+
+        /* a release after this point signals the semaphore */
+        rt_atomic_add(&(mp->waiters), 1);
+        block = rt_mp_lf_alloc(mp);
+        if (block != RT_NULL)
+        {
+            rt_atomic_sub(&(mp->waiters), 1);
+            break;
+        }
+
+        before_sleep = rt_tick_get();
+        result = rt_sem_take(&(mp->wait_sem), time);
+        rt_atomic_sub(&(mp->waiters), 1);
+        if (result != RT_EOK)
+        {
+            rt_set_errno(result);
+            return RT_NULL;
+        }
+
+        if (time > 0)
+        {
+            time -= rt_tick_get() - before_sleep;
+            if (time < 0)
+                time = 0;
+        }
+    }
+
+    if (block == RT_NULL)
+        rt_set_errno(-RT_ETIMEOUT);
+
+    return block;
+}
+RTM_EXPORT(rt_mp_lf_alloc_wait);
+#endif /* RT_USING_SEMAPHORE */
+
+/**
+ * @brief  This function will get the statistics of a lock-free memory pool.
+ *
+ * @param  mp is the lock-free memory pool.
+ *
+ * @param  stat is the buffer receiving the statistics.
+ */
+void rt_mp_lf_get_stat(rt_mp_lf_t mp, struct rt_mp_lf_stat *stat)
+{
+    RT_ASSERT(mp != RT_NULL);
+    RT_ASSERT(stat != RT_NULL);
+
+    stat->total    = mp->block_total_count;
+    stat->free     = rt_atomic_load(&(mp->free_count));
+    stat->min_free = rt_atomic_load(&(mp->min_free_count));
+    stat->failed   = rt_atomic_load(&(mp->failed_count));
+}
+RTM_EXPORT(rt_mp_lf_get_stat);
+
+/**
+ * @brief  This function will restart the statistics of a lock-free memory
+ *         pool from its current state.
+ *
+ * @param  mp is the lock-free memory pool.
+ */
+void rt_mp_lf_reset_stat(rt_mp_lf_t mp)
+{
+    RT_ASSERT(mp != RT_NULL);
+
+    rt_atomic_store(&(mp->min_free_count), rt_atomic_load(&(mp->free_count)));
+    rt_atomic_store(&(mp->failed_count), 0);
+}
+RTM_EXPORT(rt_mp_lf_reset_stat);
+#endif /* RT_USING_MEMPOOL_LOCKFREE */
+
 /**@}*/
 
 #endif /* RT_USING_MEMPOOL */
@@ -16,6 +16,7 @@
  * 2022-01-07     Gabriel      Moving __on_rt_xxxxx_hook to object.c
  * 2023-09-15     xqyjlj       perf rt_hw_interrupt_disable/enable
  * 2023-11-17     xqyjlj       add process group and session support
+ * 2026-10-18     Cc           add hashed name index for rt_object_find
  */
 
 #include <rtthread.h>
@@ -230,6 +231,82 @@ void rt_object_put_sethook(void (*hook)(struct rt_object *object))
 /**@}*/
 #endif /* RT_USING_HOOK */
 
+#ifdef RT_USING_OBJECT_HASH
+#if (RT_OBJECT_HASH_SIZE & (RT_OBJECT_HASH_SIZE - 1)) != 0
+#error "RT_OBJECT_HASH_SIZE must be a power of 2"
+#endif
+
+static struct rt_object *_object_hash[RT_Object_Info_Unknown][RT_OBJECT_HASH_SIZE];
+
+/* FNV-1a over the significant characters of the name */
+static rt_uint32_t _object_name_hash(const char *name)
+{
+    rt_uint32_t hash = 2166136261u;
+    int i;
+
+    for (i = 0; i < RT_NAME_MAX && name[i] != '\0'; i++)
+    {
+        hash ^= (rt_uint8_t)name[i];
+        hash *= 16777619u;
+    }
+
+    return hash & (RT_OBJECT_HASH_SIZE - 1);
+}
+
+static struct rt_object **_object_hash_bucket(struct rt_object_information *information,
+                                              const char *name)
+{
+    return &_object_hash[information - _object_container][_object_name_hash(name)];
+}
+
+/* must be called with the information spinlock held */
+static void _object_hash_insert(struct rt_object_information *information,
+                                struct rt_object *object)
+{
+    struct rt_object **bucket = _object_hash_bucket(information, object->name);
+
+    object->hash_next = *bucket;
+    *bucket = object;
+}
+
+/* must be called with the information spinlock held */
+static rt_bool_t _object_hash_remove(struct rt_object_information *information,
+                                     struct rt_object *object)
+{
+    struct rt_object **bucket = _object_hash_bucket(information, object->name);
+    struct rt_object **pprev;
+    int index;
+
+    for (pprev = bucket; *pprev != RT_NULL; pprev = &(*pprev)->hash_next)
+    {
+        if (*pprev == object)
+        {
+            *pprev = object->hash_next;
+            object->hash_next = RT_NULL;
+            return RT_TRUE;
+        }
+    }
+
+    /* the name was written behind our back, never leave a dangling entry */
+    for (index = 0; index < RT_OBJECT_HASH_SIZE; index++)
+    {
+        for (pprev = &_object_hash[information - _object_container][index];
+             *pprev != RT_NULL; pprev = &(*pprev)->hash_next)
+        {
+            if (*pprev == object)
+            {
+                *pprev = object->hash_next;
+                object->hash_next = RT_NULL;
+                return RT_TRUE;
+            }
+        }
+    }
+
+    /* module objects are not in the index */
+    return RT_FALSE;
+}
+#endif /* RT_USING_OBJECT_HASH */
+
 /**
  * @addtogroup KernelObject
  */
@@ -401,6 +478,9 @@ void rt_object_init(struct rt_object         *object,
     {
         /* insert object into information object list */
         rt_list_insert_after(&(information->object_list), &(object->list));
+#ifdef RT_USING_OBJECT_HASH
+        _object_hash_insert(information, object);
+#endif /* RT_USING_OBJECT_HASH */
     }
     rt_spin_unlock_irqrestore(&(information->spinlock), level);
 }
@@ -427,6 +507,9 @@ void rt_object_detach(rt_object_t object)
     level = rt_spin_lock_irqsave(&(information->spinlock));
     /* remove from old list */
     rt_list_remove(&(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    _object_hash_remove(information, object);
+#endif /* RT_USING_OBJECT_HASH */
     rt_spin_unlock_irqrestore(&(information->spinlock), level);
 
     object->type = 0;
@@ -496,6 +579,9 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
     {
         /* insert object into information object list */
         rt_list_insert_after(&(information->object_list), &(object->list));
+#ifdef RT_USING_OBJECT_HASH
+        _object_hash_insert(information, object);
+#endif /* RT_USING_OBJECT_HASH */
     }
     rt_spin_unlock_irqrestore(&(information->spinlock), level);
 
@@ -526,6 +612,9 @@ void rt_object_delete(rt_object_t object)
 
     /* remove from old list */
     rt_list_remove(&(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    _object_hash_remove(information, object);
+#endif /* RT_USING_OBJECT_HASH */
 
     rt_spin_unlock_irqrestore(&(information->spinlock), level);
 
@@ -590,9 +679,13 @@ rt_uint8_t rt_object_get_type(rt_object_t object)
 rt_object_t rt_object_find(const char *name, rt_uint8_t type)
 {
     struct rt_object *object = RT_NULL;
-    struct rt_list_node *node = RT_NULL;
     struct rt_object_information *information = RT_NULL;
     rt_base_t level;
+#ifdef RT_USING_OBJECT_HASH
+    struct rt_object **bucket;
+#else
+    struct rt_list_node *node = RT_NULL;
+#endif /* RT_USING_OBJECT_HASH */
 
     information = rt_object_get_information((enum rt_object_class_type)type);
 
@@ -602,6 +695,20 @@ rt_object_t rt_object_find(const char *name, rt_uint8_t type)
     /* which is invoke in interrupt status */
     RT_DEBUG_NOT_IN_INTERRUPT;
 
+#ifdef RT_USING_OBJECT_HASH
+    /* hash outside of the critical section, only the bucket is walked inside */
+    bucket = _object_hash_bucket(information, name);
+
+    level = rt_spin_lock_irqsave(&(information->spinlock));
+    for (object = *bucket; object != RT_NULL; object = object->hash_next)
+    {
+        if (rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
+            break;
+    }
+    rt_spin_unlock_irqrestore(&(information->spinlock), level);
+
+    return object;
+#else
     /* enter critical */
     level = rt_spin_lock_irqsave(&(information->spinlock));
 
@@ -620,6 +727,7 @@ rt_object_t rt_object_find(const char *name, rt_uint8_t type)
     rt_spin_unlock_irqrestore(&(information->spinlock), level);
 
     return RT_NULL;
+#endif /* RT_USING_OBJECT_HASH */
 }
 
 /**
@@ -646,6 +754,62 @@ rt_err_t rt_object_get_name(rt_object_t object, char *name, rt_uint8_t name_size
     return result;
 }
 
+rt_inline void _object_name_copy(rt_object_t object, const char *name)
+{
+#if RT_NAME_MAX > 0
+    rt_strncpy(object->name, name, RT_NAME_MAX - 1);
+    object->name[RT_NAME_MAX - 1] = '\0';
+#else
+    object->name = name;
+#endif /* RT_NAME_MAX > 0 */
+}
+
+/**
+ * @brief This function will change the name of an object in the object
+ *        container.
+ *
+ * @note  With RT_USING_OBJECT_HASH, the name of an object in the container
+ *        must be changed by this function to keep it findable. An object
+ *        which is not in the container yet just gets the new name.
+ *
+ * @param object    the specified object to be renamed
+ * @param name      the new name of the object
+ *
+ * @return -RT_EINVAL if any parameter is invalid or RT_EOK if the operation is successfully executed
+ */
+rt_err_t rt_object_set_name(rt_object_t object, const char *name)
+{
+    struct rt_object_information *information;
+    rt_base_t level;
+#ifdef RT_USING_OBJECT_HASH
+    rt_bool_t hashed;
+#endif /* RT_USING_OBJECT_HASH */
+
+    if ((object == RT_NULL) || (name == RT_NULL))
+        return -RT_EINVAL;
+
+    information = rt_object_get_information((enum rt_object_class_type)object->type);
+    if (information == RT_NULL)
+    {
+        _object_name_copy(object, name);
+        return RT_EOK;
+    }
+
+    level = rt_spin_lock_irqsave(&(information->spinlock));
+#ifdef RT_USING_OBJECT_HASH
+    hashed = _object_hash_remove(information, object);
+#endif /* RT_USING_OBJECT_HASH */
+    _object_name_copy(object, name);
+#ifdef RT_USING_OBJECT_HASH
+    if (hashed)
+        _object_hash_insert(information, object);
+#endif /* RT_USING_OBJECT_HASH */
+    rt_spin_unlock_irqrestore(&(information->spinlock), level);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_object_set_name);
+
 #ifdef RT_USING_HEAP
 /**
  * This function will create a custom object
@@ -35,6 +35,7 @@
  * 2023-09-15     xqyjlj       perf rt_hw_interrupt_disable/enable
  * 2023-12-10     xqyjlj       fix thread_exit/detach/delete
  *                             fix rt_thread_delay
+ * 2026-10-18     Cc           add recycled thread stack cache
  */
 
 #include <rthw.h>
@@ -164,6 +165,11 @@ static void _thread_detach_from_mutex(rt_thread_t thread)
         thread->pending_object = RT_NULL;
     }
 
+#ifdef RT_USING_IPC_FAST_PATH
+    /* the mutexes taken by the fast path are not in the taken list yet */
+    rt_mutex_fast_detach_thread(thread);
+#endif /* RT_USING_IPC_FAST_PATH */
+
     /* free taken mutex after detaching from waiting, so we don't lost mutex just got */
     rt_list_for_each_safe(node, tmp_list, &(thread->taken_object_list))
     {
@@ -225,6 +231,9 @@ static rt_err_t _thread_init(struct rt_thread *thread,
 #ifdef RT_USING_MUTEX
     rt_list_init(&thread->taken_object_list);
     thread->pending_object = RT_NULL;
+#ifdef RT_USING_IPC_FAST_PATH
+    rt_list_init(&thread->fast_taken_list);
+#endif /* RT_USING_IPC_FAST_PATH */
 #endif
 
 #ifdef RT_USING_EVENT
@@ -486,6 +495,102 @@ static rt_err_t _thread_detach(rt_thread_t thread)
 }
 
 #ifdef RT_USING_HEAP
+#ifdef RT_USING_THREAD_STACK_CACHE
+struct rt_thread_stack_cache
+{
+    void *stack;
+    rt_uint32_t size;
+};
+
+static struct rt_thread_stack_cache _stack_cache[RT_THREAD_STACK_CACHE_NR];
+static struct rt_spinlock _stack_cache_lock = RT_SPINLOCK_INIT;
+
+/**
+ * @brief   This function will take a recycled stack of the exact size from the
+ *          thread stack cache.
+ *
+ * @param   size is the size of the stack.
+ *
+ * @return  the stack, or RT_NULL if there is no stack of this size in the cache.
+ */
+void *rt_thread_stack_cache_get(rt_uint32_t size)
+{
+    void *stack = RT_NULL;
+    rt_base_t level;
+    int i;
+
+    level = rt_spin_lock_irqsave(&_stack_cache_lock);
+    for (i = 0; i < RT_THREAD_STACK_CACHE_NR; i++)
+    {
+        if (_stack_cache[i].stack != RT_NULL && _stack_cache[i].size == size)
+        {
+            stack = _stack_cache[i].stack;
+            _stack_cache[i].stack = RT_NULL;
+            break;
+        }
+    }
+    rt_spin_unlock_irqrestore(&_stack_cache_lock, level);
+
+    return stack;
+}
+
+/**
+ * @brief   This function will keep the stack of a dead thread in the thread
+ *          stack cache for reuse.
+ *
+ * @param   stack is the stack allocated from the kernel heap.
+ *
+ * @param   size is the size of the stack.
+ *
+ * @return  RT_TRUE if the stack is kept, RT_FALSE if the cache is full and
+ *          the caller shall free the stack.
+ */
+rt_bool_t rt_thread_stack_cache_put(void *stack, rt_uint32_t size)
+{
+    rt_bool_t kept = RT_FALSE;
+    rt_base_t level;
+    int i;
+
+    level = rt_spin_lock_irqsave(&_stack_cache_lock);
+    for (i = 0; i < RT_THREAD_STACK_CACHE_NR; i++)
+    {
+        if (_stack_cache[i].stack == RT_NULL)
+        {
+            _stack_cache[i].stack = stack;
+            _stack_cache[i].size = size;
+            kept = RT_TRUE;
+            break;
+        }
+    }
+    rt_spin_unlock_irqrestore(&_stack_cache_lock, level);
+
+    return kept;
+}
+
+/**
+ * @brief   This function will return all of the cached stacks to the kernel heap.
+ */
+void rt_thread_stack_cache_flush(void)
+{
+    void *stack;
+    rt_base_t level;
+    int i;
+
+    for (i = 0; i < RT_THREAD_STACK_CACHE_NR; i++)
+    {
+        level = rt_spin_lock_irqsave(&_stack_cache_lock);
+        stack = _stack_cache[i].stack;
+        _stack_cache[i].stack = RT_NULL;
+        rt_spin_unlock_irqrestore(&_stack_cache_lock, level);
+
+        if (stack != RT_NULL)
+        {
+            RT_KERNEL_FREE(stack);
+        }
+    }
+}
+#endif /* RT_USING_THREAD_STACK_CACHE */
+
 /**
  * @brief   This function will create a thread object and allocate thread object memory.
  *          and stack.
@@ -520,7 +625,21 @@ rt_thread_t rt_thread_create(const char *name,
     if (thread == RT_NULL)
         return RT_NULL;
 
+#ifdef RT_USING_THREAD_STACK_CACHE
+    stack_start = rt_thread_stack_cache_get(stack_size);
+    if (stack_start == RT_NULL)
+    {
+        stack_start = (void *)RT_KERNEL_MALLOC(stack_size);
+        if (stack_start == RT_NULL)
+        {
+            /* the cached stacks of other sizes may make room for it */
+            rt_thread_stack_cache_flush();
+            stack_start = (void *)RT_KERNEL_MALLOC(stack_size);
+        }
+    }
+#else
     stack_start = (void *)RT_KERNEL_MALLOC(stack_size);
+#endif /* RT_USING_THREAD_STACK_CACHE */
     if (stack_start == RT_NULL)
     {
         /* allocate stack failure */
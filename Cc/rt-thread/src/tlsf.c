@@ -0,0 +1,870 @@
+/*
+ * Copyright (c) 2006-2026, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-18     Cc           the first version
+ */
+
+/*
+ * Two-Level Segregated Fit memory allocator.
+ *
+ * Free blocks are kept in segregated lists. The first level splits sizes by
+ * power of two, the second level splits each power of two range linearly into
+ * 2^RT_TLSF_SL_SHIFT lists. A bitmap per level records which lists are not
+ * empty, so that a fitting list is found with two find-first-set operations
+ * and allocation and release run in bounded time, whatever the fragmentation
+ * of the heap.
+ *
+ * Reference: M. Masmano, I. Ripoll, A. Crespo, J. Real. "TLSF: a New Dynamic
+ * Memory Allocator for Real-Time Systems", ECRTS 2004.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#if defined (RT_USING_TLSF)
+
+#define DBG_TAG           "kernel.tlsf"
+#define DBG_LVL           DBG_INFO
+#include <rtdbg.h>
+
+/* the block sizes are multiples of TLSF_ALIGN, the low bits hold the flags */
+#define TLSF_ALIGN          (RT_ALIGN_SIZE > 8 ? RT_ALIGN_SIZE : 8)
+#define TLSF_BLOCK_FREE     0x1
+
+/* sizes below TLSF_SMALL_BLOCK are split linearly into 8 bytes wide lists */
+#define TLSF_SL_SHIFT       RT_TLSF_SL_SHIFT
+#define TLSF_SL_COUNT       (1 << TLSF_SL_SHIFT)
+#define TLSF_FL_SHIFT       (TLSF_SL_SHIFT + 3)
+#define TLSF_SMALL_BLOCK    ((rt_size_t)1 << TLSF_FL_SHIFT)
+
+#ifdef ARCH_CPU_64BIT
+#define TLSF_FL_COUNT       32
+#else
+#define TLSF_FL_COUNT       (32 - TLSF_FL_SHIFT + 1)
+#endif /* ARCH_CPU_64BIT */
+/* the largest block still maps below TLSF_FL_COUNT after rounding up */
+#define TLSF_BLOCK_MAX      ((rt_size_t)1 << (TLSF_FL_COUNT + TLSF_FL_SHIFT - 2))
+
+struct rt_tlsf_block
+{
+    struct rt_tlsf_block   *prev_phys;          /**< physically previous block */
+    rt_size_t               size;               /**< block size with header, and flags */
+#ifdef RT_USING_MEMTRACE
+#ifdef ARCH_CPU_64BIT
+    rt_uint8_t              thread[8];          /**< thread name */
+#else
+    rt_uint8_t              thread[4];          /**< thread name */
+#endif /* ARCH_CPU_64BIT */
+#endif /* RT_USING_MEMTRACE */
+
+    /* the links are only valid in a free block, they overlay the user data */
+    struct rt_tlsf_block   *next_free;          /**< next block in the free list */
+    struct rt_tlsf_block   *prev_free;          /**< previous block in the free list */
+};
+
+/**
+ * Memory region, a heap is made of one or more of them
+ */
+struct rt_tlsf_region
+{
+    struct rt_tlsf_region  *next;               /**< next region of the heap */
+    struct rt_tlsf_block   *first;              /**< the first block */
+    struct rt_tlsf_block   *end;                /**< the used sentinel block at the end */
+};
+
+/**
+ * Base structure of TLSF memory object
+ */
+struct rt_tlsf
+{
+    struct rt_memory        parent;                             /**< inherit from rt_memory */
+    struct rt_tlsf_region  *regions;                            /**< memory regions */
+    rt_uint32_t             fl_bitmap;                          /**< non-empty first levels */
+    rt_uint32_t             sl_bitmap[TLSF_FL_COUNT];           /**< non-empty second levels */
+    struct rt_tlsf_block   *blocks[TLSF_FL_COUNT][TLSF_SL_COUNT]; /**< free list heads */
+};
+
+#define TLSF_HDR_SIZE       RT_ALIGN((rt_size_t)&((struct rt_tlsf_block *)0)->next_free, TLSF_ALIGN)
+#define TLSF_BLOCK_MIN      RT_ALIGN(sizeof(struct rt_tlsf_block), TLSF_ALIGN)
+
+#define TLSF_BLOCK_SIZE(_block)     ((_block)->size & ~(rt_size_t)TLSF_BLOCK_FREE)
+#define TLSF_BLOCK_ISFREE(_block)   ((_block)->size & TLSF_BLOCK_FREE)
+#define TLSF_BLOCK_NEXT(_block)     \
+    ((struct rt_tlsf_block *)((rt_uint8_t *)(_block) + TLSF_BLOCK_SIZE(_block)))
+#define TLSF_BLOCK_MEM(_block)      ((void *)((rt_uint8_t *)(_block) + TLSF_HDR_SIZE))
+#define TLSF_MEM_BLOCK(_mem)        ((struct rt_tlsf_block *)((rt_uint8_t *)(_mem) - TLSF_HDR_SIZE))
+
+static const char _tlsf_algorithm[] = "tlsf";
+
+#ifdef RT_USING_MEMTRACE
+rt_inline void rt_tlsf_setname(struct rt_tlsf_block *block, const char *name)
+{
+    int index;
+    for (index = 0; index < sizeof(block->thread); index ++)
+    {
+        if (name[index] == '\0') break;
+        block->thread[index] = name[index];
+    }
+
+    for (; index < sizeof(block->thread); index ++)
+    {
+        block->thread[index] = ' ';
+    }
+}
+#endif /* RT_USING_MEMTRACE */
+
+/* index of the most significant bit set, word must not be zero */
+rt_inline int _tlsf_fls(rt_size_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (int)(sizeof(unsigned long) * 8) - 1 - __builtin_clzl((unsigned long)word);
+#else
+    int bit = 0;
+
+#ifdef ARCH_CPU_64BIT
+    if (word >> 32) { word >>= 32; bit += 32; }
+#endif /* ARCH_CPU_64BIT */
+    if (word >> 16) { word >>= 16; bit += 16; }
+    if (word >> 8)  { word >>= 8;  bit += 8; }
+    if (word >> 4)  { word >>= 4;  bit += 4; }
+    if (word >> 2)  { word >>= 2;  bit += 2; }
+    if (word >> 1)  { bit += 1; }
+
+    return bit;
+#endif /* __GNUC__ || __clang__ */
+}
+
+/* the free list holding blocks of this size */
+rt_inline void _tlsf_mapping(rt_size_t size, int *fl, int *sl)
+{
+    int bit;
+
+    if (size < TLSF_SMALL_BLOCK)
+    {
+        *fl = 0;
+        *sl = (int)(size >> (TLSF_FL_SHIFT - TLSF_SL_SHIFT));
+    }
+    else
+    {
+        bit = _tlsf_fls(size);
+        *fl = bit - TLSF_FL_SHIFT + 1;
+        *sl = (int)(size >> (bit - TLSF_SL_SHIFT)) ^ TLSF_SL_COUNT;
+    }
+}
+
+/* the first free list whose every block fits this size */
+rt_inline void _tlsf_mapping_search(rt_size_t size, int *fl, int *sl)
+{
+    if (size >= TLSF_SMALL_BLOCK)
+    {
+        size += ((rt_size_t)1 << (_tlsf_fls(size) - TLSF_SL_SHIFT)) - 1;
+    }
+    _tlsf_mapping(size, fl, sl);
+}
+
+static struct rt_tlsf_block *_tlsf_find_suitable(struct rt_tlsf *tlsf, int *fl, int *sl)
+{
+    rt_uint32_t sl_map, fl_map;
+
+    sl_map = tlsf->sl_bitmap[*fl] & (~(rt_uint32_t)0 << *sl);
+    if (sl_map == 0)
+    {
+        /* no block in this first level, take the next larger one */
+        fl_map = *fl + 1 < 32 ? tlsf->fl_bitmap & (~(rt_uint32_t)0 << (*fl + 1)) : 0;
+        if (fl_map == 0)
+            return RT_NULL;
+
+        *fl = __rt_ffs((int)fl_map) - 1;
+        sl_map = tlsf->sl_bitmap[*fl];
+    }
+    *sl = __rt_ffs((int)sl_map) - 1;
+
+    return tlsf->blocks[*fl][*sl];
+}
+
+static void _tlsf_insert(struct rt_tlsf *tlsf, struct rt_tlsf_block *block)
+{
+    struct rt_tlsf_block *head;
+    int fl, sl;
+
+    _tlsf_mapping(TLSF_BLOCK_SIZE(block), &fl, &sl);
+    head = tlsf->blocks[fl][sl];
+    block->next_free = head;
+    block->prev_free = RT_NULL;
+    if (head != RT_NULL)
+        head->prev_free = block;
+    tlsf->blocks[fl][sl] = block;
+
+    tlsf->fl_bitmap |= (rt_uint32_t)1 << fl;
+    tlsf->sl_bitmap[fl] |= (rt_uint32_t)1 << sl;
+}
+
+static void _tlsf_remove(struct rt_tlsf *tlsf, struct rt_tlsf_block *block)
+{
+    int fl, sl;
+
+    _tlsf_mapping(TLSF_BLOCK_SIZE(block), &fl, &sl);
+    if (block->next_free != RT_NULL)
+        block->next_free->prev_free = block->prev_free;
+    if (block->prev_free != RT_NULL)
+    {
+        block->prev_free->next_free = block->next_free;
+    }
+    else
+    {
+        tlsf->blocks[fl][sl] = block->next_free;
+        if (block->next_free == RT_NULL)
+        {
+            /* the list is empty now */
+            tlsf->sl_bitmap[fl] &= ~((rt_uint32_t)1 << sl);
+            if (tlsf->sl_bitmap[fl] == 0)
+                tlsf->fl_bitmap &= ~((rt_uint32_t)1 << fl);
+        }
+    }
+}
+
+/* size of the block serving a request, 0 if it can never be served */
+rt_inline rt_size_t _tlsf_adjust(rt_size_t size)
+{
+    if (size > TLSF_BLOCK_MAX - TLSF_HDR_SIZE - TLSF_ALIGN)
+        return 0;
+
+    size = RT_ALIGN(size + TLSF_HDR_SIZE, TLSF_ALIGN);
+    if (size < TLSF_BLOCK_MIN)
+        size = TLSF_BLOCK_MIN;
+
+    return size;
+}
+
+/* give the tail of a used block beyond size back to the free lists */
+static void _tlsf_trim(struct rt_tlsf *tlsf, struct rt_tlsf_block *block, rt_size_t size)
+{
+    struct rt_tlsf_block *rest, *next;
+    rt_size_t rest_size;
+
+    rest_size = TLSF_BLOCK_SIZE(block) - size;
+    if (rest_size < TLSF_BLOCK_MIN)
+        return;
+
+    block->size = size;
+    rest = TLSF_BLOCK_NEXT(block);
+    rest->prev_phys = block;
+    tlsf->parent.used -= rest_size;
+
+    /* merge with the next block if it is free */
+    next = (struct rt_tlsf_block *)((rt_uint8_t *)rest + rest_size);
+    if (TLSF_BLOCK_ISFREE(next))
+    {
+        _tlsf_remove(tlsf, next);
+        rest_size += TLSF_BLOCK_SIZE(next);
+        next = (struct rt_tlsf_block *)((rt_uint8_t *)rest + rest_size);
+    }
+    rest->size = rest_size | TLSF_BLOCK_FREE;
+    next->prev_phys = rest;
+#ifdef RT_USING_MEMTRACE
+    rt_tlsf_setname(rest, "    ");
+#endif /* RT_USING_MEMTRACE */
+
+    _tlsf_insert(tlsf, rest);
+}
+
+static rt_err_t _tlsf_add_region(struct rt_tlsf *tlsf, void *begin_addr, rt_size_t size)
+{
+    struct rt_tlsf_region *region;
+    struct rt_tlsf_block *block;
+    rt_ubase_t begin_align, end_align, block_size;
+
+    begin_align = RT_ALIGN((rt_ubase_t)begin_addr, TLSF_ALIGN);
+    end_align   = RT_ALIGN_DOWN((rt_ubase_t)begin_addr + size, TLSF_ALIGN);
+    block       = (struct rt_tlsf_block *)RT_ALIGN(begin_align + sizeof(struct rt_tlsf_region), TLSF_ALIGN);
+
+    /* room for the first block and the end sentinel */
+    if ((rt_ubase_t)begin_addr + size < (rt_ubase_t)begin_addr ||
+        end_align < (rt_ubase_t)block + TLSF_BLOCK_MIN + TLSF_HDR_SIZE)
+    {
+        return -RT_EINVAL;
+    }
+
+    block_size = end_align - TLSF_HDR_SIZE - (rt_ubase_t)block;
+    if (block_size >= TLSF_BLOCK_MAX)
+        block_size = TLSF_BLOCK_MAX - TLSF_ALIGN;
+
+    region = (struct rt_tlsf_region *)begin_align;
+    region->first = block;
+    region->end = (struct rt_tlsf_block *)((rt_ubase_t)block + block_size);
+
+    /* one free block spanning the region */
+    block->prev_phys = RT_NULL;
+    block->size = block_size | TLSF_BLOCK_FREE;
+#ifdef RT_USING_MEMTRACE
+    rt_tlsf_setname(block, "    ");
+#endif /* RT_USING_MEMTRACE */
+
+    /* the sentinel is never free, so no block is ever merged across it */
+    region->end->prev_phys = block;
+    region->end->size = TLSF_HDR_SIZE;
+#ifdef RT_USING_MEMTRACE
+    rt_tlsf_setname(region->end, "INIT");
+#endif /* RT_USING_MEMTRACE */
+
+    region->next = tlsf->regions;
+    tlsf->regions = region;
+    tlsf->parent.total += block_size;
+    _tlsf_insert(tlsf, block);
+
+    LOG_D("tlsf region at 0x%x, size %d", begin_align, block_size);
+
+    return RT_EOK;
+}
+
+/**
+ * @brief This function will initialize TLSF memory management algorithm.
+ *
+ * @param name is the name of the TLSF memory management object.
+ *
+ * @param begin_addr the beginning address of memory.
+ *
+ * @param size is the size of the memory.
+ *
+ * @return Return a pointer to the memory object. When the return value is RT_NULL, it means the init failed.
+ */
+rt_tlsf_t rt_tlsf_init(const char *name, void *begin_addr, rt_size_t size)
+{
+    struct rt_tlsf *tlsf;
+    rt_ubase_t start_addr;
+
+    tlsf = (struct rt_tlsf *)RT_ALIGN((rt_ubase_t)begin_addr, TLSF_ALIGN);
+    start_addr = (rt_ubase_t)tlsf + sizeof(*tlsf);
+
+    if (start_addr >= (rt_ubase_t)begin_addr + size)
+    {
+        rt_kprintf("tlsf init, error begin address 0x%x, and end address 0x%x\n",
+                   (rt_ubase_t)begin_addr, (rt_ubase_t)begin_addr + size);
+
+        return RT_NULL;
+    }
+
+    rt_memset(tlsf, 0, sizeof(*tlsf));
+    if (_tlsf_add_region(tlsf, (void *)start_addr, (rt_ubase_t)begin_addr + size - start_addr) != RT_EOK)
+    {
+        rt_kprintf("tlsf init, error begin address 0x%x, and end address 0x%x\n",
+                   (rt_ubase_t)begin_addr, (rt_ubase_t)begin_addr + size);
+
+        return RT_NULL;
+    }
+
+    /* initialize TLSF memory object */
+    rt_object_init(&(tlsf->parent.parent), RT_Object_Class_Memory, name);
+    tlsf->parent.algorithm = _tlsf_algorithm;
+    tlsf->parent.address = (rt_ubase_t)tlsf;
+
+    return &tlsf->parent;
+}
+RTM_EXPORT(rt_tlsf_init);
+
+/**
+ * @brief This function will add a memory region to a TLSF memory object.
+ *
+ * @note  The region need not be adjacent to the others, so that one heap can
+ *        span e.g. internal SRAM and external PSRAM. Blocks are never merged
+ *        across regions.
+ *
+ * @param m the TLSF memory management object.
+ *
+ * @param begin_addr the beginning address of the region.
+ *
+ * @param size is the size of the region.
+ *
+ * @return RT_EOK on success, -RT_EINVAL if the region is too small.
+ */
+rt_err_t rt_tlsf_add_region(rt_tlsf_t m, void *begin_addr, rt_size_t size)
+{
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+    RT_ASSERT(rt_object_is_systemobject(&m->parent));
+
+    return _tlsf_add_region((struct rt_tlsf *)m, begin_addr, size);
+}
+RTM_EXPORT(rt_tlsf_add_region);
+
+/**
+ * @brief This function will remove a TLSF memory object from the system.
+ *
+ * @param m the TLSF memory management object.
+ *
+ * @return RT_EOK
+ */
+rt_err_t rt_tlsf_detach(rt_tlsf_t m)
+{
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+    RT_ASSERT(rt_object_is_systemobject(&m->parent));
+
+    rt_object_detach(&(m->parent));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_tlsf_detach);
+
+/**
+ * @addtogroup MM
+ */
+
+/**@{*/
+
+/**
+ * @brief Allocate a block of memory with a minimum of 'size' bytes.
+ *
+ * @param m the TLSF memory management object.
+ *
+ * @param size is the minimum size of the requested block in bytes.
+ *
+ * @return the pointer to allocated memory or NULL if no free memory was found.
+ */
+void *rt_tlsf_alloc(rt_tlsf_t m, rt_size_t size)
+{
+    struct rt_tlsf *tlsf;
+    struct rt_tlsf_block *block;
+    int fl, sl;
+
+    if (size == 0)
+        return RT_NULL;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+    RT_ASSERT(rt_object_is_systemobject(&m->parent));
+
+    tlsf = (struct rt_tlsf *)m;
+    size = _tlsf_adjust(size);
+    if (size == 0)
+    {
+        LOG_D("no memory");
+
+        return RT_NULL;
+    }
+
+    _tlsf_mapping_search(size, &fl, &sl);
+    block = _tlsf_find_suitable(tlsf, &fl, &sl);
+    if (block == RT_NULL)
+    {
+        /* the head of the list holding this size may still be large enough */
+        _tlsf_mapping(size, &fl, &sl);
+        block = tlsf->blocks[fl][sl];
+        if (block != RT_NULL && TLSF_BLOCK_SIZE(block) < size)
+            block = RT_NULL;
+    }
+    if (block == RT_NULL)
+    {
+        LOG_D("no memory");
+
+        return RT_NULL;
+    }
+
+    RT_ASSERT(TLSF_BLOCK_ISFREE(block));
+    RT_ASSERT(TLSF_BLOCK_SIZE(block) >= size);
+    _tlsf_remove(tlsf, block);
+
+    block->size = TLSF_BLOCK_SIZE(block);
+    tlsf->parent.used += block->size;
+    _tlsf_trim(tlsf, block, size);
+    if (tlsf->parent.max < tlsf->parent.used)
+        tlsf->parent.max = tlsf->parent.used;
+
+#ifdef RT_USING_MEMTRACE
+    if (rt_thread_self())
+        rt_tlsf_setname(block, rt_thread_self()->parent.name);
+    else
+        rt_tlsf_setname(block, "NONE");
+#endif /* RT_USING_MEMTRACE */
+
+    RT_ASSERT((((rt_ubase_t)TLSF_BLOCK_MEM(block)) & (RT_ALIGN_SIZE - 1)) == 0);
+
+    LOG_D("allocate memory at 0x%x, size: %d",
+            (rt_ubase_t)TLSF_BLOCK_MEM(block), (rt_ubase_t)block->size);
+
+    return TLSF_BLOCK_MEM(block);
+}
+RTM_EXPORT(rt_tlsf_alloc);
+
+/**
+ * @brief This function will release the previously allocated memory block by
+ *        rt_tlsf_alloc. The released memory block is taken back to the TLSF object.
+ *
+ * @param m the TLSF memory management object.
+ *
+ * @param ptr the address of memory which will be released.
+ */
+void rt_tlsf_free(rt_tlsf_t m, void *ptr)
+{
+    struct rt_tlsf *tlsf;
+    struct rt_tlsf_block *block, *prev, *next;
+    rt_size_t size;
+
+    if (ptr == RT_NULL)
+        return;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+    RT_ASSERT(rt_object_is_systemobject(&m->parent));
+    RT_ASSERT((((rt_ubase_t)ptr) & (RT_ALIGN_SIZE - 1)) == 0);
+
+    tlsf = (struct rt_tlsf *)m;
+    block = TLSF_MEM_BLOCK(ptr);
+    /* which has to be in a used state, and linked with its neighbour */
+    RT_ASSERT(!TLSF_BLOCK_ISFREE(block));
+    RT_ASSERT(TLSF_BLOCK_NEXT(block)->prev_phys == block);
+
+    size = TLSF_BLOCK_SIZE(block);
+    tlsf->parent.used -= size;
+
+    LOG_D("release memory 0x%x, size: %d", (rt_ubase_t)ptr, size);
+
+    /* merge with the previous block */
+    prev = block->prev_phys;
+    if (prev != RT_NULL && TLSF_BLOCK_ISFREE(prev))
+    {
+        _tlsf_remove(tlsf, prev);
+        size += TLSF_BLOCK_SIZE(prev);
+        block = prev;
+    }
+
+    /* merge with the next block */
+    next = (struct rt_tlsf_block *)((rt_uint8_t *)block + size);
+    if (TLSF_BLOCK_ISFREE(next))
+    {
+        _tlsf_remove(tlsf, next);
+        size += TLSF_BLOCK_SIZE(next);
+        next = (struct rt_tlsf_block *)((rt_uint8_t *)block + size);
+    }
+
+    block->size = size | TLSF_BLOCK_FREE;
+    next->prev_phys = block;
+#ifdef RT_USING_MEMTRACE
+    rt_tlsf_setname(block, "    ");
+#endif /* RT_USING_MEMTRACE */
+
+    _tlsf_insert(tlsf, block);
+}
+RTM_EXPORT(rt_tlsf_free);
+
+/**
+ * @brief This function will change the size of previously allocated memory block.
+ *
+ * @param m the TLSF memory management object.
+ *
+ * @param ptr is the pointer to memory allocated by rt_tlsf_alloc.
+ *
+ * @param newsize is the required new size.
+ *
+ * @return the changed memory block address.
+ */
+void *rt_tlsf_realloc(rt_tlsf_t m, void *ptr, rt_size_t newsize)
+{
+    struct rt_tlsf *tlsf;
+    struct rt_tlsf_block *block, *next;
+    rt_size_t size;
+    void *nptr;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+    RT_ASSERT(rt_object_is_systemobject(&m->parent));
+
+    if (newsize == 0)
+    {
+        rt_tlsf_free(m, ptr);
+        return RT_NULL;
+    }
+
+    /* allocate a new memory block */
+    if (ptr == RT_NULL)
+        return rt_tlsf_alloc(m, newsize);
+
+    tlsf = (struct rt_tlsf *)m;
+    newsize = _tlsf_adjust(newsize);
+    if (newsize == 0)
+    {
+        LOG_D("realloc: out of memory");
+
+        return RT_NULL;
+    }
+
+    block = TLSF_MEM_BLOCK(ptr);
+    RT_ASSERT(!TLSF_BLOCK_ISFREE(block));
+    size = TLSF_BLOCK_SIZE(block);
+
+    if (newsize > size)
+    {
+        next = TLSF_BLOCK_NEXT(block);
+        if (!TLSF_BLOCK_ISFREE(next) || size + TLSF_BLOCK_SIZE(next) < newsize)
+        {
+            /* expand memory */
+            nptr = rt_tlsf_alloc(m, newsize - TLSF_HDR_SIZE);
+            if (nptr != RT_NULL)
+            {
+                rt_memcpy(nptr, ptr, size - TLSF_HDR_SIZE);
+                rt_tlsf_free(m, ptr);
+            }
+
+            return nptr;
+        }
+
+        /* grow in place into the free block behind */
+        _tlsf_remove(tlsf, next);
+        block->size = size + TLSF_BLOCK_SIZE(next);
+        TLSF_BLOCK_NEXT(block)->prev_phys = block;
+        tlsf->parent.used += TLSF_BLOCK_SIZE(next);
+        if (tlsf->parent.max < tlsf->parent.used)
+            tlsf->parent.max = tlsf->parent.used;
+    }
+
+    /* split memory block */
+    _tlsf_trim(tlsf, block, newsize);
+
+    return ptr;
+}
+RTM_EXPORT(rt_tlsf_realloc);
+
+/**
+ * @brief This function will check the consistency of a TLSF memory object.
+ *
+ * @note  Every region is walked block by block, and every free list is walked
+ *        against its bitmap bits. The caller shall hold the lock of the object.
+ *
+ * @param m the TLSF memory management object.
+ *
+ * @return RT_EOK if the object is consistent, -RT_ERROR if a block is broken.
+ */
+rt_err_t rt_tlsf_check(rt_tlsf_t m)
+{
+    struct rt_tlsf *tlsf;
+    struct rt_tlsf_region *region;
+    struct rt_tlsf_block *block, *next;
+    rt_size_t free_nr = 0, used = 0;
+    int fl, sl, bfl, bsl;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+
+    tlsf = (struct rt_tlsf *)m;
+    for (region = tlsf->regions; region != RT_NULL; region = region->next)
+    {
+        for (block = region->first; block != region->end; block = next)
+        {
+            next = TLSF_BLOCK_NEXT(block);
+            if (TLSF_BLOCK_SIZE(block) < TLSF_BLOCK_MIN ||
+                TLSF_BLOCK_SIZE(block) % TLSF_ALIGN != 0 ||
+                next > region->end || next->prev_phys != block ||
+                (TLSF_BLOCK_ISFREE(block) && TLSF_BLOCK_ISFREE(next)))
+            {
+                goto __exit;
+            }
+
+            if (TLSF_BLOCK_ISFREE(block))
+                free_nr++;
+            else
+                used += TLSF_BLOCK_SIZE(block);
+        }
+    }
+    if (used != tlsf->parent.used)
+    {
+        rt_kprintf("Memory usage wrong: %d, counted %d\n", tlsf->parent.used, used);
+        return -RT_ERROR;
+    }
+
+    for (fl = 0; fl < TLSF_FL_COUNT; fl++)
+    {
+        for (sl = 0; sl < TLSF_SL_COUNT; sl++)
+        {
+            block = tlsf->blocks[fl][sl];
+            if ((block != RT_NULL) != !!(tlsf->sl_bitmap[fl] & ((rt_uint32_t)1 << sl)) ||
+                (tlsf->sl_bitmap[fl] != 0) != !!(tlsf->fl_bitmap & ((rt_uint32_t)1 << fl)))
+            {
+                rt_kprintf("Free list bitmap wrong: %d-%d\n", fl, sl);
+                return -RT_ERROR;
+            }
+
+            for (; block != RT_NULL; block = block->next_free)
+            {
+                _tlsf_mapping(TLSF_BLOCK_SIZE(block), &bfl, &bsl);
+                if (!TLSF_BLOCK_ISFREE(block) || bfl != fl || bsl != sl ||
+                    (block->next_free != RT_NULL && block->next_free->prev_free != block))
+                {
+                    goto __exit;
+                }
+                free_nr--;
+            }
+        }
+    }
+    if (free_nr != 0)
+    {
+        rt_kprintf("Free list count wrong: %d blocks lost\n", free_nr);
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+
+__exit:
+    rt_kprintf("Memory block wrong:\n");
+    rt_kprintf("   name: %s\n", tlsf->parent.parent.name);
+    rt_kprintf("address: 0x%08x\n", block);
+    rt_kprintf("   size: 0x%08x\n", block->size);
+    rt_kprintf("   prev: 0x%08x\n", block->prev_phys);
+
+    return -RT_ERROR;
+}
+RTM_EXPORT(rt_tlsf_check);
+
+/**
+ * @brief This function returns the size of the largest free block of a TLSF
+ *        memory object, which is the largest request it could serve.
+ *
+ * @note  Only the highest non-empty free list is walked. The caller shall hold
+ *        the lock of the object.
+ *
+ * @param m the TLSF memory management object.
+ *
+ * @return the usable size of the largest free block.
+ */
+rt_size_t rt_tlsf_max_free(rt_tlsf_t m)
+{
+    struct rt_tlsf *tlsf;
+    struct rt_tlsf_block *block;
+    rt_size_t size, max_free = 0;
+    int fl, sl;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+
+    tlsf = (struct rt_tlsf *)m;
+    if (tlsf->fl_bitmap == 0)
+        return 0;
+
+    fl = _tlsf_fls(tlsf->fl_bitmap);
+    sl = _tlsf_fls(tlsf->sl_bitmap[fl]);
+    for (block = tlsf->blocks[fl][sl]; block != RT_NULL; block = block->next_free)
+    {
+        size = TLSF_BLOCK_SIZE(block) - TLSF_HDR_SIZE;
+        if (size > max_free)
+            max_free = size;
+    }
+
+    return max_free;
+}
+RTM_EXPORT(rt_tlsf_max_free);
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+#ifdef RT_USING_MEMTRACE
+static int tlsfcheck(int argc, char *argv[])
+{
+    rt_base_t level;
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+    struct rt_object *object;
+    rt_mem_t m;
+    char *name;
+
+    name = argc > 1 ? argv[1] : RT_NULL;
+    level = rt_hw_interrupt_disable();
+    /* get mem object */
+    information = rt_object_get_information(RT_Object_Class_Memory);
+    for (node = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        object = rt_list_entry(node, struct rt_object, list);
+        /* find the specified object */
+        if (name != RT_NULL && rt_strncmp(name, object->name, RT_NAME_MAX) != 0)
+            continue;
+        m = (rt_mem_t)object;
+        if (m->algorithm != _tlsf_algorithm)
+            continue;
+        /* check mem */
+        if (rt_tlsf_check(m) != RT_EOK)
+            break;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return 0;
+}
+
+static int tlsftrace(int argc, char **argv)
+{
+    struct rt_tlsf *m;
+    struct rt_tlsf_region *region;
+    struct rt_tlsf_block *block;
+    struct rt_object_information *information;
+    struct rt_list_node *node;
+    struct rt_object *object;
+    char *name;
+
+    name = argc > 1 ? argv[1] : RT_NULL;
+    /* get mem object */
+    information = rt_object_get_information(RT_Object_Class_Memory);
+    for (node = information->object_list.next;
+         node != &(information->object_list);
+         node  = node->next)
+    {
+        object = rt_list_entry(node, struct rt_object, list);
+        /* find the specified object */
+        if (name != RT_NULL && rt_strncmp(name, object->name, RT_NAME_MAX) != 0)
+            continue;
+        /* tlsf object */
+        m = (struct rt_tlsf *)object;
+        if (m->parent.algorithm != _tlsf_algorithm)
+            continue;
+        /* show memory information */
+        rt_kprintf("\nmemory heap address:\n");
+        rt_kprintf("name    : %s\n", m->parent.parent.name);
+        rt_kprintf("total   : %d\n", m->parent.total);
+        rt_kprintf("used    : %d\n", m->parent.used);
+        rt_kprintf("max_used: %d\n", m->parent.max);
+        for (region = m->regions; region != RT_NULL; region = region->next)
+        {
+            rt_kprintf("region  : 0x%08x - 0x%08x\n", region->first, region->end);
+        }
+        rt_kprintf("\n--memory item information --\n");
+        for (region = m->regions; region != RT_NULL; region = region->next)
+        {
+            for (block = region->first; block != region->end; block = TLSF_BLOCK_NEXT(block))
+            {
+                int size = TLSF_BLOCK_SIZE(block) - TLSF_HDR_SIZE;
+
+                rt_kprintf("[0x%08x - ", block);
+                if (size < 1024)
+                    rt_kprintf("%5d", size);
+                else if (size < 1024 * 1024)
+                    rt_kprintf("%4dK", size / 1024);
+                else
+                    rt_kprintf("%4dM", size / (1024 * 1024));
+
+                rt_kprintf("] %c%c%c%c", block->thread[0], block->thread[1], block->thread[2], block->thread[3]);
+                if (TLSF_BLOCK_NEXT(block)->prev_phys != block)
+                    rt_kprintf(": ***\n");
+                else
+                    rt_kprintf("\n");
+            }
+        }
+    }
+    return 0;
+}
+
+#ifdef RT_USING_SMALL_MEM
+MSH_CMD_EXPORT(tlsfcheck, check tlsf memory data);
+MSH_CMD_EXPORT(tlsftrace, dump tlsf memory trace information);
+#else
+/* the TLSF heap stands in for the small memory one */
+MSH_CMD_EXPORT_ALIAS(tlsfcheck, memcheck, check memory data);
+MSH_CMD_EXPORT_ALIAS(tlsftrace, memtrace, dump memory trace information);
+#endif /* RT_USING_SMALL_MEM */
+#endif /* RT_USING_MEMTRACE */
+#endif /* RT_USING_FINSH */
+
+/**@}*/
+
+#endif /* defined (RT_USING_TLSF) */
@@ -0,0 +1,149 @@
+#!/usr/bin/env python
+#
+# Copyright (c) 2006-2026, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-18     Cc           the first version
+#
+
+"""
+Decode the export of the heap allocation profiler (components/utilities/heap_prof).
+
+The input is either the file written by 'heapprof export <file>', or a console
+log holding the 'hprf:' lines printed by 'heapprof export'. The call sites are
+symbolised with addr2line when the ELF image is given:
+
+    python heapprof.py heap.prof -e rtthread.elf --addr2line arm-none-eabi-addr2line
+"""
+
+import argparse
+import struct
+import subprocess
+import sys
+
+HEAP_PROF_MAGIC = 0x46525048
+HEAP_PROF_FLAG_RUNNING = 0x0001
+
+HEADER_FORMAT = 'IHHIIII4Q'
+RECORD_FORMAT = '5Q4I'
+
+HEADER_FIELDS = ('magic', 'version', 'flags', 'site_nr', 'tick_per_second',
+                 'tick', 'dropped', 'total', 'used', 'max_used', 'max_free')
+RECORD_FIELDS = ('caller', 'bytes', 'live_bytes', 'peak_bytes', 'life_sum',
+                 'allocs', 'frees', 'life_max', 'reserved')
+
+SORT_KEYS = {
+    'bytes': lambda site: site['bytes'],
+    'live': lambda site: site['live_bytes'],
+    'peak': lambda site: site['peak_bytes'],
+    'allocs': lambda site: site['allocs'],
+    'life': lambda site: site['life_max'],
+}
+
+
+def load(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    for order in '<>':
+        if len(data) >= 4 and struct.unpack(order + 'I', data[:4])[0] == HEAP_PROF_MAGIC:
+            return data
+
+    # a console log, the export is split over the 'hprf:' lines
+    chunks = []
+    for line in data.decode('ascii', 'replace').splitlines():
+        pos = line.find('hprf:')
+        if pos >= 0:
+            chunks.append(line[pos + 5:].strip())
+    if not chunks:
+        raise ValueError('%s holds no heap profiler export' % path)
+
+    return bytes(bytearray.fromhex(''.join(chunks)))
+
+
+def parse(data):
+    for order in '<>':
+        if struct.unpack(order + 'I', data[:4])[0] == HEAP_PROF_MAGIC:
+            break
+    else:
+        raise ValueError('bad magic')
+
+    header_size = struct.calcsize(order + HEADER_FORMAT)
+    record_size = struct.calcsize(order + RECORD_FORMAT)
+    header = dict(zip(HEADER_FIELDS, struct.unpack_from(order + HEADER_FORMAT, data)))
+    if header['version'] != 1:
+        raise ValueError('unsupported version %d' % header['version'])
+    if len(data) < header_size + header['site_nr'] * record_size:
+        raise ValueError('truncated export, %d of %d sites' %
+                         ((len(data) - header_size) // record_size, header['site_nr']))
+
+    sites = []
+    for index in range(header['site_nr']):
+        offset = header_size + index * record_size
+        sites.append(dict(zip(RECORD_FIELDS, struct.unpack_from(order + RECORD_FORMAT, data, offset))))
+
+    return header, sites
+
+
+def symbolise(sites, elf, addr2line):
+    callers = [site['caller'] for site in sites if site['caller'] != 0]
+    names = {0: '(other)'}
+    if not elf or not callers:
+        for caller in callers:
+            names[caller] = '0x%08x' % caller
+        return names
+
+    # a return address follows the call, step back into it; bit 0 is the Thumb bit
+    args = [addr2line, '-f', '-C', '-e', elf] + ['0x%x' % ((caller & ~1) - 1) for caller in callers]
+    output = subprocess.check_output(args).decode('utf-8', 'replace').splitlines()
+    for index, caller in enumerate(callers):
+        function, location = output[2 * index], output[2 * index + 1]
+        names[caller] = '%s %s' % (function, location.split('/')[-1])
+
+    return names
+
+
+def main():
+    parser = argparse.ArgumentParser(description='decode a heap allocation profiler export')
+    parser.add_argument('input', help='the exported file or the console log')
+    parser.add_argument('-e', '--elf', help='the ELF image to symbolise the call sites')
+    parser.add_argument('--addr2line', default='addr2line', help='the addr2line of the toolchain')
+    parser.add_argument('-s', '--sort', default='bytes', choices=sorted(SORT_KEYS), help='the sort key')
+    parser.add_argument('-n', '--top', type=int, default=0, help='only show the top N call sites')
+    args = parser.parse_args()
+
+    header, sites = parse(load(args.input))
+    names = symbolise(sites, args.elf, args.addr2line)
+    sites.sort(key=SORT_KEYS[args.sort], reverse=True)
+    if args.top > 0:
+        sites = sites[:args.top]
+
+    free = header['total'] - header['used']
+    print('heap: total %d, used %d, max used %d, free %d, largest free %d' %
+          (header['total'], header['used'], header['max_used'], free, header['max_free']))
+    if header['max_free'] and free:
+        print('fragmentation: %d%%' % max(0, 100 - header['max_free'] * 100 // free))
+    print('profiler %s at tick %d, %d allocations dropped' %
+          ('running' if header['flags'] & HEAP_PROF_FLAG_RUNNING else 'stopped',
+           header['tick'], header['dropped']))
+    print('')
+
+    ms = 1000.0 / header['tick_per_second']
+    print('%10s %10s %12s %10s %10s %10s %10s  %s' %
+          ('allocs', 'frees', 'bytes', 'live', 'peak', 'avg ms', 'max ms', 'call site'))
+    for site in sites:
+        avg = site['life_sum'] * ms / site['frees'] if site['frees'] else 0
+        print('%10d %10d %12d %10d %10d %10.1f %10.1f  %s' %
+              (site['allocs'], site['frees'], site['bytes'], site['live_bytes'],
+               site['peak_bytes'], avg, site['life_max'] * ms, names[site['caller']]))
+
+
+if __name__ == '__main__':
+    try:
+        main()
+    except (IOError, ValueError, subprocess.CalledProcessError) as e:
+        sys.stderr.write('heapprof: %s\n' % e)
+        sys.exit(1)
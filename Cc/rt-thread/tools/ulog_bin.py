@@ -0,0 +1,468 @@
+#!/usr/bin/env python
+#
+# Copyright (c) 2006-2026, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-18     Cc           the first version
+#
+
+"""
+Decode the records of the ulog binary log mode (ULOG_USING_BINARY).
+
+A record only holds the addresses of its format and tag strings, so they are
+looked up in the image the target runs. Extract the string table once per
+build, e.g. as a post build step:
+
+    python ulog_bin.py dict rtthread.elf -o rtthread.ulog.json
+
+and decode a file of records, or a console log holding the 'ulgb:' lines
+printed by 'ulog_bin dump':
+
+    python ulog_bin.py decode console.log -d rtthread.ulog.json --stat
+
+The text is formatted by the rules of rt_vsnprintf(), so it matches the text
+mode line by line except for the thread name, which is not recorded.
+"""
+
+import argparse
+import bisect
+import json
+import struct
+import sys
+
+ULOG_BIN_MAGIC = 0xB1
+ULOG_BIN_MAGIC_PAD = 0xB0
+
+SHT_PROGBITS = 1
+SHF_ALLOC = 0x2
+SHF_EXECINSTR = 0x4
+
+LEVEL_NAMES = {0: 'A', 3: 'E', 4: 'W', 6: 'I', 7: 'D'}
+
+# the flags of rt_vsnprintf()
+ZEROPAD = 1 << 0
+SIGN = 1 << 1
+PLUS = 1 << 2
+SPACE = 1 << 3
+LEFT = 1 << 4
+SPECIAL = 1 << 5
+LARGE = 1 << 6
+
+
+class Target(object):
+    """The C types of the target, --bits and --longlong of the command line."""
+
+    def __init__(self, bits, longlong):
+        self.word = bits // 8
+        self.longlong = longlong
+        self.head_size = self.align(self.word * 3 + 4)
+        # unsigned long long with RT_KPRINTF_USING_LONGLONG, unsigned long otherwise
+        self.num_bits = 64 if longlong else bits
+
+    def align(self, size):
+        return (size + self.word - 1) & ~(self.word - 1)
+
+
+def elf_strings(path, code):
+    """The NUL terminated strings of the loaded sections of an ELF image, by address."""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:4] != b'\x7fELF':
+        raise ValueError('%s is not an ELF image' % path)
+
+    order = '<' if data[5] == 1 or data[5] == b'\x01' else '>'
+    if data[4] in (2, b'\x02'):
+        shoff, = struct.unpack_from(order + 'Q', data, 0x28)
+        shentsize, shnum = struct.unpack_from(order + 'HH', data, 0x3a)
+        section = order + 'IIQQQQIIQQ'
+    else:
+        shoff, = struct.unpack_from(order + 'I', data, 0x20)
+        shentsize, shnum = struct.unpack_from(order + 'HH', data, 0x2e)
+        section = order + 'IIIIIIIIII'
+
+    strings = {}
+    for index in range(shnum):
+        _, sh_type, flags, addr, offset, size = struct.unpack_from(section, data, shoff + index * shentsize)[:6]
+        if sh_type != SHT_PROGBITS or not flags & SHF_ALLOC or addr == 0:
+            continue
+        if flags & SHF_EXECINSTR and not code:
+            continue
+        start = 0
+        for end, byte in enumerate(bytearray(data[offset:offset + size])):
+            if byte == 0:
+                if end > start:
+                    text = data[offset + start:offset + end].decode('latin-1')
+                    if all(c >= ' ' or c in '\t\r\n\x1b' for c in text):
+                        strings[addr + start] = text
+                start = end + 1
+
+    return strings
+
+
+class StringTable(object):
+    """Finds the string at an address, also inside a string merged with a longer one."""
+
+    def __init__(self, strings):
+        self.addrs = sorted(strings)
+        self.strings = strings
+
+    def get(self, addr):
+        index = bisect.bisect_right(self.addrs, addr) - 1
+        if index >= 0:
+            start = self.addrs[index]
+            text = self.strings[start]
+            if addr - start <= len(text):
+                return text[addr - start:]
+        return None
+
+
+def load(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    if len(data) and bytearray(data[:1])[0] in (ULOG_BIN_MAGIC, ULOG_BIN_MAGIC_PAD):
+        return data
+
+    # a console log, the records are split over the 'ulgb:' lines
+    chunks = []
+    for line in data.decode('ascii', 'replace').splitlines():
+        pos = line.find('ulgb:')
+        if pos >= 0:
+            chunks.append(line[pos + 5:].strip())
+    if not chunks:
+        raise ValueError('%s holds no binary log records' % path)
+
+    return bytes(bytearray.fromhex(''.join(chunks)))
+
+
+class Args(object):
+    """The raw arguments of one record."""
+
+    def __init__(self, data, target):
+        self.data = data
+        self.pos = 0
+        self.target = target
+
+    def take(self, size, fmt):
+        if self.pos + size > len(self.data):
+            raise IndexError('out of arguments')
+        value, = struct.unpack_from('<' + fmt, self.data, self.pos)
+        self.pos += size
+        return value
+
+    def int32(self):
+        return self.take(4, 'i')
+
+    def word(self):
+        return self.take(self.target.word, 'Q' if self.target.word == 8 else 'I')
+
+    def u64(self):
+        return self.take(8, 'Q')
+
+    def double(self):
+        return self.take(8, 'd')
+
+    def string(self):
+        size = self.take(1, 'B')
+        if self.pos + size > len(self.data):
+            raise IndexError('out of arguments')
+        text = self.data[self.pos:self.pos + size].decode('latin-1')
+        self.pos += size
+        return text
+
+
+def signed(value, bits):
+    value &= (1 << bits) - 1
+    return value - (1 << bits) if value >> (bits - 1) else value
+
+
+def print_number(num, base, qualifier, size, precision, flags, target):
+    """print_number() of kstdio.c"""
+    mask = (1 << target.num_bits) - 1
+    out = []
+    precision_bak = precision
+
+    if flags & LEFT:
+        flags &= ~ZEROPAD
+    pad = '0' if flags & ZEROPAD else ' '
+
+    sign = ''
+    if flags & SIGN:
+        if qualifier == 'h':
+            if signed(num, 16) < 0:
+                sign = '-'
+                num = -num & 0xffff
+        elif qualifier in 'Ll' and qualifier:
+            if signed(num, target.word * 8) < 0:
+                sign = '-'
+                num = -num & ((1 << (target.word * 8)) - 1)
+        elif signed(num, 32) < 0:
+            sign = '-'
+            num = -num & 0xffffffff
+        if not sign:
+            if flags & PLUS:
+                sign = '+'
+            elif flags & SPACE:
+                sign = ' '
+
+    if flags & SPECIAL:
+        if base in (2, 16):
+            size -= 2
+        elif base == 8:
+            size -= 1
+
+    num &= mask
+    digits = {2: '{0:b}', 8: '{0:o}', 10: '{0:d}', 16: '{0:X}' if flags & LARGE else '{0:x}'}[base].format(num)
+    i = len(digits)
+    if i > precision:
+        precision = i
+    size -= precision
+
+    if not flags & (ZEROPAD | LEFT):
+        if sign and size > 0:
+            size -= 1
+        while size > 0:
+            out.append(' ')
+            size -= 1
+        size -= 1
+
+    if sign:
+        out.append(sign)
+        size -= 1
+
+    if flags & SPECIAL:
+        if base == 2:
+            out.append('0b')
+        elif base == 8:
+            out.append('0')
+        elif base == 16:
+            out.append('0X' if flags & LARGE else '0x')
+
+    if not flags & LEFT:
+        while size > 0:
+            out.append(pad)
+            size -= 1
+        size -= 1
+
+    out.append('0' * (precision - i))
+    if precision_bak != 0:
+        out.append(digits)
+
+    while size > 0:
+        out.append(' ')
+        size -= 1
+
+    return ''.join(out)
+
+
+def vsnprintf(fmt, args, target):
+    """rt_vsnprintf() over the raw arguments, stops where they have run out like ulog_bin_format()"""
+    out = []
+    pos = 0
+    try:
+        while pos < len(fmt):
+            if fmt[pos] != '%':
+                out.append(fmt[pos])
+                pos += 1
+                continue
+            pos += 1
+
+            flags = 0
+            while pos < len(fmt) and fmt[pos] in '-+ #0':
+                flags |= {'-': LEFT, '+': PLUS, ' ': SPACE, '#': SPECIAL, '0': ZEROPAD}[fmt[pos]]
+                pos += 1
+
+            width = -1
+            if pos < len(fmt) and fmt[pos].isdigit():
+                start = pos
+                while pos < len(fmt) and fmt[pos].isdigit():
+                    pos += 1
+                width = int(fmt[start:pos])
+            elif pos < len(fmt) and fmt[pos] == '*':
+                pos += 1
+                width = args.int32()
+                if width < 0:
+                    width = -width
+                    flags |= LEFT
+
+            precision = -1
+            if pos < len(fmt) and fmt[pos] == '.':
+                pos += 1
+                precision = 0
+                if pos < len(fmt) and fmt[pos].isdigit():
+                    start = pos
+                    while pos < len(fmt) and fmt[pos].isdigit():
+                        pos += 1
+                    precision = int(fmt[start:pos])
+                elif pos < len(fmt) and fmt[pos] == '*':
+                    pos += 1
+                    precision = max(args.int32(), 0)
+
+            qualifier = ''
+            if pos < len(fmt) and (fmt[pos] in 'hlz' or (target.longlong and fmt[pos] == 'L')):
+                qualifier = fmt[pos]
+                pos += 1
+                if target.longlong and qualifier == 'l' and fmt[pos:pos + 1] == 'l':
+                    qualifier = 'L'
+                    pos += 1
+                if qualifier == 'h' and fmt[pos:pos + 1] == 'h':
+                    qualifier = 'H'
+                    pos += 1
+
+            conv = fmt[pos] if pos < len(fmt) else ''
+            pos += 1
+            base = 10
+
+            if conv == 'c':
+                text = chr(args.int32() & 0xff)
+                out.append(text.rjust(width) if not flags & LEFT else text.ljust(width))
+                continue
+            if conv == 's':
+                text = args.string()
+                if width >= 0:
+                    text = text[:width]
+                if precision > 0:
+                    text = text[:precision]
+                out.append(text.ljust(width) if flags & LEFT else text.rjust(width))
+                continue
+            if conv == 'p':
+                if width == -1:
+                    width = target.word * 2 + 2
+                    flags |= SPECIAL | ZEROPAD
+                out.append(print_number(args.word(), 16, qualifier, width, precision, flags, target))
+                continue
+            if conv == '%':
+                out.append('%')
+                continue
+            if conv == 'b':
+                base = 2
+            elif conv == 'o':
+                base = 8
+            elif conv in 'xX' and conv:
+                base = 16
+                if conv == 'X':
+                    flags |= LARGE
+            elif conv in 'di' and conv:
+                flags |= SIGN
+            elif conv != 'u':
+                if conv and conv in 'eEGgfF':
+                    args.double()
+                out.append('%' + conv)
+                if not conv:
+                    break
+                continue
+
+            if qualifier == 'L':
+                num = args.u64()
+            elif qualifier == 'l':
+                num = args.word()
+            elif qualifier == 'H':
+                num = signed(args.int32(), 8)
+            elif qualifier == 'h':
+                num = args.int32() & 0xffff
+                if flags & SIGN:
+                    num = signed(num, 16)
+            elif qualifier == 'z':
+                num = args.word()
+                if flags & SIGN:
+                    num = signed(num, target.word * 8)
+            else:
+                num = args.int32() & 0xffffffff
+            out.append(print_number(num, base, qualifier, width, precision, flags, target))
+    except IndexError:
+        pass
+
+    return ''.join(out)
+
+
+def records(data, target):
+    """The records of the stream, padding skipped"""
+    pos = 0
+    while pos + target.head_size <= len(data):
+        ctrl, = struct.unpack_from('<I', data, pos)
+        magic, level, length = ctrl & 0xff, (ctrl >> 8) & 0xff, ctrl >> 16
+        if magic not in (ULOG_BIN_MAGIC, ULOG_BIN_MAGIC_PAD) or length == 0:
+            raise ValueError('bad record at offset %d' % pos)
+        if magic == ULOG_BIN_MAGIC:
+            word = 'Q' if target.word == 8 else 'I'
+            fmt, tag = struct.unpack_from('<' + word * 2, data, pos + target.word)
+            tick, = struct.unpack_from('<I', data, pos + target.word * 3)
+            yield level, tick, fmt, tag, data[pos + target.head_size:pos + length], length
+        pos += target.align(length)
+
+
+def decode(args):
+    target = Target(args.bits, args.longlong)
+    if args.elf:
+        table = StringTable(elf_strings(args.elf, args.code))
+    else:
+        with open(args.dict) as f:
+            table = StringTable(dict((int(addr, 16), text) for addr, text in json.load(f).items()))
+
+    out = open(args.output, 'w') if args.output else sys.stdout
+    count = binary = text = 0
+    for level, tick, fmt_addr, tag_addr, raw, length in records(load(args.log), target):
+        if fmt_addr == 0:
+            tag = 'ulog'
+            body = '%d logs dropped' % struct.unpack_from('<I', raw)[0]
+        else:
+            fmt = table.get(fmt_addr)
+            tag = table.get(tag_addr) or '0x%x' % tag_addr
+            if fmt is None:
+                body = '<unknown format 0x%x>' % fmt_addr
+            else:
+                body = vsnprintf(fmt, Args(raw, target), target)
+        line = '[%u] %s/%s: %s' % (tick, LEVEL_NAMES.get(level, str(level)), tag, body)
+        out.write(line + '\n')
+        count += 1
+        binary += length
+        # the console line ends with \r\n
+        text += len(line) + 2
+
+    if args.stat and count:
+        sys.stderr.write('%d records, %d bytes binary, %d bytes as text, %.1f%% of the text\n' %
+                         (count, binary, text, 100.0 * binary / text))
+
+
+def make_dict(args):
+    strings = elf_strings(args.elf, args.code)
+    table = dict(('0x%x' % addr, text) for addr, text in strings.items())
+    with open(args.output, 'w') as f:
+        json.dump(table, f, indent=0, sort_keys=True)
+    sys.stderr.write('%d strings\n' % len(table))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the ulog binary log records.')
+    sub = parser.add_subparsers(dest='command')
+
+    dict_parser = sub.add_parser('dict', help='extract the string table of an ELF image')
+    dict_parser.add_argument('elf', help='the image of the target')
+    dict_parser.add_argument('-o', '--output', required=True, help='the JSON string table')
+    dict_parser.add_argument('--code', action='store_true', help='also scan the code sections, for toolchains placing constants there')
+
+    decode_parser = sub.add_parser('decode', help='decode the records to text')
+    decode_parser.add_argument('log', help='a file of records or a console log with the \'ulgb:\' lines')
+    source = decode_parser.add_mutually_exclusive_group(required=True)
+    source.add_argument('-e', '--elf', help='the image of the target')
+    source.add_argument('-d', '--dict', help='the string table made by the dict command')
+    decode_parser.add_argument('--code', action='store_true', help='also scan the code sections of the image')
+    decode_parser.add_argument('--bits', type=int, choices=(32, 64), default=32, help='the word size of the target')
+    decode_parser.add_argument('--longlong', action='store_true', help='the target has RT_KPRINTF_USING_LONGLONG')
+    decode_parser.add_argument('-o', '--output', help='the text file, stdout by default')
+    decode_parser.add_argument('--stat', action='store_true', help='compare the binary and the text size')
+
+    args = parser.parse_args()
+    if args.command == 'dict':
+        make_dict(args)
+    elif args.command == 'decode':
+        decode(args)
+    else:
+        parser.print_help()
+
+
+if __name__ == '__main__':
+    main()
@@ -6,6 +6,8 @@
 /* RT-Thread Kernel */
 
 #define RT_NAME_MAX 16
+#define RT_USING_OBJECT_HASH
+#define RT_OBJECT_HASH_SIZE 16
 #define RT_CPUS_NR 1
 #define RT_ALIGN_SIZE 4
 #define RT_THREAD_PRIORITY_32
@@ -17,6 +19,8 @@
 #define RT_USING_IDLE_HOOK
 #define RT_IDLE_HOOK_LIST_SIZE 4
 #define IDLE_THREAD_STACK_SIZE 256
+#define RT_USING_THREAD_STACK_CACHE
+#define RT_THREAD_STACK_CACHE_NR 4
 #define RT_USING_TIMER_SOFT
 #define RT_TIMER_THREAD_PRIO 4
 #define RT_TIMER_THREAD_STACK_SIZE 512
@@ -45,6 +49,7 @@
 #define RT_MEMHEAP_FAST_MODE
 #define RT_USING_MEMHEAP_AS_HEAP
 #define RT_USING_MEMHEAP_AUTO_BINDING
+#define RT_USING_MEMHEAP_HINT
 #define RT_USING_HEAP
 /* end of Memory Management */
 #define RT_USING_DEVICE
@@ -55,6 +60,7 @@
 #define RT_BACKTRACE_LEVEL_MAX_NR 32
 /* end of RT-Thread Kernel */
 #define RT_USING_CACHE
+#define RT_USING_HW_ATOMIC
 #define RT_USING_CPU_FFS
 #define ARCH_ARM
 #define ARCH_ARM_CORTEX_M
@@ -75,6 +81,7 @@
 #define FINSH_USING_HISTORY
 #define FINSH_HISTORY_LINES 5
 #define FINSH_USING_SYMTAB
+#define FINSH_USING_CMD_INDEX
 #define FINSH_CMD_SIZE 80
 #define MSH_USING_BUILT_IN_COMMANDS
 #define FINSH_USING_DESCRIPTION
@@ -117,6 +124,8 @@
 #define RT_USING_SYSTEM_WORKQUEUE
 #define RT_SYSTEM_WORKQUEUE_STACKSIZE 2048
 #define RT_SYSTEM_WORKQUEUE_PRIORITY 23
+#define RT_SYSTEM_WORKQUEUE_WORKERS 1
+#define RT_USING_WORKQUEUE_POOL
 #define RT_USING_SERIAL
 #define RT_USING_SERIAL_V2
 #define RT_USING_MTD_NOR
@@ -262,6 +271,10 @@
 
 /* Utilities */
 
+#define RT_USING_STACK_AUDIT
+#define RT_STACK_AUDIT_THREAD_NR 32
+#define RT_STACK_AUDIT_SCAN_SIZE 256
+#define RT_STACK_AUDIT_MARGIN 25
 /* end of Utilities */
 /* end of RT-Thread Components */
 